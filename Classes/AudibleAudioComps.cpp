@@ -0,0 +1,72 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AudibleAudioComps.h"
+
+#include "AudioCoreConversions.h"
+#include "Components/AudioComponent.h"
+
+void FAudibleAudioComps::Bake(const AudioCore::FOccupancyGrid& Grid, const TArray<UAudioComponent*>& InAudioComps, const int RegionSize, const FName& StaticEmitterTag)
+{
+	Sets.Init(Grid, RegionSize); 
+	AudioComps.Reset(); 
+
+	// Ids are given out in order, so an audio comp's id is its index in the array 
+	for(UAudioComponent* AudioComp : InAudioComps)
+	{
+		if(AudioComp->Mobility == EComponentMobility::Static || AudioComp->ComponentHasTag(StaticEmitterTag))
+			Sets.AddStaticSource(ToCoreVector(AudioComp->GetComponentLocation()), AudioComp->AttenuationSettings->Attenuation.GetMaxFalloffDistance()); 
+		else
+			Sets.AddMovingSource(); 
+
+		AudioComps.Add(AudioComp); 
+	}
+
+	Sets.Build(); 
+	bBaked = true; 
+}
+
+void FAudibleAudioComps::AddMovingAudioComp(UAudioComponent* AudioComp)
+{
+	// Its id is the next one like during the bake 
+	Sets.AddMovingSource(); 
+	AudioComps.Add(AudioComp); 
+}
+
+void FAudibleAudioComps::GetCandidates(const FVector& ListenerLocation, TArray<UAudioComponent*>& OutAudioComps) const
+{
+	OutAudioComps.Reset(); 
+
+	// Outside the grid there is no region, every audio comp is a candidate 
+	const int Region = Sets.GetRegion(ToCoreVector(ListenerLocation)); 
+	if(Region == AudioCore::InvalidIndex)
+	{
+		for(UAudioComponent* AudioComp : AudioComps)
+		{
+			if(AudioComp)
+				OutAudioComps.Add(AudioComp); 
+		}
+		return; 
+	}
+
+	for(const int Id : Sets.GetSources(Region))
+	{
+		if(AudioComps[Id])
+			OutAudioComps.Add(AudioComps[Id]); 
+	}
+
+	for(const int Id : Sets.GetMovingSources())
+	{
+		if(AudioComps[Id])
+			OutAudioComps.Add(AudioComps[Id]); 
+	}
+}
+
+void FAudibleAudioComps::Remove(const UAudioComponent* AudioComp)
+{
+	// Kept as null so the ids of the others stay the same 
+	for(UAudioComponent*& BakedAudioComp : AudioComps)
+	{
+		if(BakedAudioComp == AudioComp)
+			BakedAudioComp = nullptr; 
+	}
+}
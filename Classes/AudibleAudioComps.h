@@ -0,0 +1,42 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/GridAudibleSets.h"
+
+class UAudioComponent;
+
+/*
+ * The audio comps a component has to consider for where the listener is, from the potentially audible sets baked over
+ * the map grid (see AudioCore::FGridAudibleSets). Audio comps that never move are only candidates in the regions they
+ * can be heard from, the others and every audio comp when the listener is outside the grid are always candidates 
+ */
+class GRIM_API FAudibleAudioComps
+{
+public:
+	// Audio comps that are static or have the tag are baked into the regions 
+	void Bake(const AudioCore::FOccupancyGrid& Grid, const TArray<UAudioComponent*>& AudioComps, const int RegionSize, const FName& StaticEmitterTag);
+
+	bool IsBaked() const { return bBaked; }
+
+	// Adds an audio comp registered after the bake, it is not in any region so it is a candidate everywhere 
+	void AddMovingAudioComp(UAudioComponent* AudioComp);
+
+	// Fills the array with the audio comps that could be heard at the location, in the order they were baked 
+	void GetCandidates(const FVector& ListenerLocation, TArray<UAudioComponent*>& OutAudioComps) const;
+
+	// Call when the audio comp is destroyed so it is no longer a candidate 
+	void Remove(const UAudioComponent* AudioComp);
+
+	size_t GetMemoryUsage() const { return Sets.GetMemoryUsage() + AudioComps.GetAllocatedSize(); }
+
+private:
+
+	AudioCore::FGridAudibleSets Sets; 
+
+	// Audio comps by their id in the sets, null once destroyed 
+	TArray<UAudioComponent*> AudioComps; 
+
+	bool bBaked = false; 
+};
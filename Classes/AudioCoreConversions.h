@@ -0,0 +1,18 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/AudioCoreTypes.h"
+
+// Conversions between engine types and the engine independent types in Core/
+
+inline AudioCore::FVec3 ToCoreVector(const FVector& Vector)
+{
+	return AudioCore::FVec3(Vector.X, Vector.Y, Vector.Z);
+}
+
+inline FVector FromCoreVector(const AudioCore::FVec3& Vector)
+{
+	return FVector(Vector.X, Vector.Y, Vector.Z);
+}
@@ -3,11 +3,19 @@
 
 #include "AudioOcclusionComponent.h"
 
+#include "AudioCoreConversions.h"
+#include "AudioParameterSubsystem.h"
+#include "AudioSystemStats.h"
+#include "AudioTraceCache.h"
+#include "MapGrid.h"
 #include "ParameterSettings.h"
+#include "SoundPropagationComponent.h"
+#include "Async/ParallelFor.h"
 #include "Camera/CameraComponent.h"
 #include "Components/AudioComponent.h"
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetMathLibrary.h"
+#include "Sound/SoundBase.h"
 
 // Sets default values for this component's properties
 UAudioOcclusionComponent::UAudioOcclusionComponent()
@@ -35,6 +43,26 @@ void UAudioOcclusionComponent::BeginPlay()
 	SetAudioComponents();
 
 	CameraComp = GetOwner()->FindComponentByClass<UCameraComponent>();
+
+	ParamUpdates = GetWorld()->GetSubsystem<UAudioParameterSubsystem>(); 
+
+	// Sounds with the smoothing effect in their chain have their volume and low pass ramped on the audio thread 
+	for(UAudioComponent* AudioComp : AudioComponents)
+		ParamUpdates->SetSmoothedOnAudioThread(AudioComp, AudioComp->Sound ? AudioComp->Sound->SourceEffectChain : nullptr); 
+
+	TraceCache = GetWorld()->GetSubsystem<UAudioTraceCache>(); 
+
+	PropComp = GetOwner()->FindComponentByClass<USoundPropagationComponent>(); 
+
+	// Needs a grid covering the whole level, the regions are made from it 
+	const AMapGrid* Grid = Cast<AMapGrid>(UGameplayStatics::GetActorOfClass(this, AMapGrid::StaticClass()));
+	if(Grid && bBakeAudibleSets)
+		AudibleAudioComps.Bake(Grid->GetOccupancyGrid(), AudioComponents, AudibleSetRegionSize, StaticEmitterTag); 
+
+	if(Grid && bUseGridWallDistance && Grid->GetWallDistance().IsBuilt())
+		WallDistance = &Grid->GetWallDistance(); 
+	else if(bUseGridWallDistance)
+		UE_LOG(LogTemp, Warning, TEXT("The grid's wall distances are not baked, the low pass uses the blocking meshes instead"))
 }
 
 void UAudioOcclusionComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
@@ -55,6 +83,8 @@ void UAudioOcclusionComponent::TickComponent(float DeltaTime, ELevelTick TickTyp
 
 	if(!bEnabled)
 		return;
+
+	AUDIO_SYSTEM_SCOPED_TIMER(OcclusionTick); 
 	
 	// Gets all audio components in the level, now every tick in case of spawned audio 
 	// SetAudioComponents();
@@ -62,21 +92,17 @@ void UAudioOcclusionComponent::TickComponent(float DeltaTime, ELevelTick TickTyp
 	// Add to timer 
 	LowPassTimer += DeltaTime;
 
-	// Update all audio components 
-	for(UAudioComponent* AudioComp : AudioComponents)
+	TakeSnapshot(LowPassTimer > LowPassUpdateDelay); 
+
+	// Every source only reads the snapshot and its own trace entry and only writes its own result 
+	SourceResults.resize(SnapshotAudioComps.Num()); 
+	ParallelFor(TEXT("AudioOcclusion"), SnapshotAudioComps.Num(), SourcesPerOcclusionTask, [this](const int32 Source)
 	{
-		if(!IsValid(AudioComp))
-		{
-			//AudioComponents.Remove(AudioComp); 
-			continue; 
-		}
-		
-		const float DistanceToAudio = FVector::Dist(GetOwner()->GetActorLocation(), AudioComp->GetComponentLocation());
+		UpdateSource(Source); 
+	}, bParallelOcclusion ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
 
-		// Only update the audio component if it is within fall off distance 
-		if(AudioComp->AttenuationSettings->Attenuation.FalloffDistance > DistanceToAudio)
-			UpdateAudioComp(AudioComp, DeltaTime);
-	}
+	ResolveMeshResults(); 
+	ApplySourceResults(); 
 
 	// Check if timer exceeded delay after updating all audio comps. If so reset it. Audio Comps have already updated
 	// their low pass by now 
@@ -87,8 +113,14 @@ void UAudioOcclusionComponent::TickComponent(float DeltaTime, ELevelTick TickTyp
 void UAudioOcclusionComponent::AddAudioComponentToOcclusion(UAudioComponent* AudioComponent)
 {
 	// Add if it does not already exist in array 
-	if(!AudioComponents.Contains(AudioComponent)) 
-		AudioComponents.Add(AudioComponent); 
+	if(AudioComponents.Contains(AudioComponent)) 
+		return; 
+
+	AudioComponents.Add(AudioComponent); 
+
+	// It was not baked into the audible sets, without this it would never be a candidate 
+	if(AudibleAudioComps.IsBaked())
+		AudibleAudioComps.AddMovingAudioComp(AudioComponent); 
 }
 
 void UAudioOcclusionComponent::SetAudioComponents()
@@ -139,70 +171,159 @@ bool UAudioOcclusionComponent::ActorShouldBeIgnored(const AActor* Actor)
 	return false; 
 }
 
-bool UAudioOcclusionComponent::DoLineTrace(TArray<FHitResult>& HitResultsOut, const FVector& StartLocation, const FVector& EndLocation, const TArray<AActor*>& ActorsToIgnore) const
+void UAudioOcclusionComponent::TakeSnapshot(const bool bUpdateLowPass)
 {
-	return UKismetSystemLibrary::LineTraceMultiForObjects(GetWorld(), StartLocation, EndLocation, AudioBlockingTypes, false, ActorsToIgnore, EDrawDebugTrace::ForOneFrame, HitResultsOut, true); 
-}
+	SnapshotAudioComps.Reset(); 
+	MeshMaterialValues.Reset(); 
+	SnapshotCameraLocation = CameraComp->GetComponentLocation(); 
+	bSnapshotUpdateLowPass = bUpdateLowPass; 
 
-void UAudioOcclusionComponent::UpdateAudioComp(UAudioComponent* AudioComp, const float DeltaTime)
-{
-	const TArray<AActor*> ActorsToIgnoreInLineTrace { GetOwner(), AudioComp->GetOwner() }; 
-	
-	TArray<FHitResult> HitResultsFromPlayer; 
-	// No blocking objects 
-	if(!DoLineTrace(HitResultsFromPlayer, CameraComp->GetComponentLocation(), AudioComp->GetComponentLocation(), ActorsToIgnoreInLineTrace))
+	// The same for every sound, so it is looked up once instead of per occluded sound 
+	if(WallDistance && bUpdateLowPass)
+		SnapshotWallDistance = WallDistance->GetDistanceToWall(ToCoreVector(SnapshotCameraLocation)); 
+
+	const FVector PlayerLocation = GetOwner()->GetActorLocation(); 
+
+	// Only the audio comps that could be heard from the listener's region if the audible sets are baked 
+	const TArray<UAudioComponent*>* AudioCompsToCheck = &AudioComponents; 
+	if(AudibleAudioComps.IsBaked())
 	{
-		// Reset values when not blocking 
-		ResetAudioComponentOnNoBlock(AudioComp); 
-		return;
+		AudibleAudioComps.GetCandidates(PlayerLocation, CandidateAudioComps); 
+		AudioCompsToCheck = &CandidateAudioComps; 
+		AUDIO_SYSTEM_INC_COUNTER(AudibleSetCandidates, CandidateAudioComps.Num()); 
+	}
+
+	for(UAudioComponent* AudioComp : *AudioCompsToCheck)
+	{
+		if(!IsValid(AudioComp))
+		{
+			//AudioComponents.Remove(AudioComp); 
+			continue; 
+		}
+		
+		const float DistanceToAudio = FVector::Dist(PlayerLocation, AudioComp->GetComponentLocation());
+
+		// Only update the audio component if it is within fall off distance, and the propagation does not muffle it 
+		if(AudioComp->AttenuationSettings->Attenuation.FalloffDistance > DistanceToAudio && !(PropComp && PropComp->HandlesOcclusion(AudioComp)))
+			SnapshotAudioComps.Add(AudioComp); 
 	}
 
+	// The propagation traces the same lines, whichever component traces one first shares it with the other. The
+	// entries store the camera and audio locations, the workers trace between those 
+	TraceCache->PrepareEntries(SnapshotAudioComps, CameraComp, AudioBlockingTypes, TraceEntries); 
+}
+
+void UAudioOcclusionComponent::UpdateSource(const int Source)
+{
+	AudioCore::FSourceOcclusion& Result = SourceResults[Source]; 
+	Result.Reset(); 
+
+	UAudioTraceCache::FTraceEntry& Entry = *TraceEntries[Source]; 
+	Result.NumTraces = TraceCache->FillHits(Entry, SnapshotAudioComps[Source], CameraComp, AudioBlockingTypes); 
+
+	const TArray<FHitResult>& HitResultsFromPlayer = Entry.HitsFromListener; 
+
 	// Used to calculate distances that rays travel within objects by also doing a line trace from the audio source
 	// resulting in a hit on both sides of the object 
-	TArray<FHitResult> HitResultsFromAudio;
-	DoLineTrace(HitResultsFromAudio, AudioComp->GetComponentLocation(), CameraComp->GetComponentLocation(), ActorsToIgnoreInLineTrace);
+	const TArray<FHitResult>& HitResultsFromAudio = Entry.HitsFromSource; 
 	
-	if(HitResultsFromAudio.Num() != HitResultsFromPlayer.Num())
+	if(Entry.bBlocked && HitResultsFromAudio.Num() != HitResultsFromPlayer.Num())
 	{
+		// Not in range leaves the audio comp as it is this tick 
 		UE_LOG(LogTemp, Error, TEXT("Ray trace hits not equal for player and audio!, Audio: %i - Player: %i"), HitResultsFromAudio.Num(), HitResultsFromPlayer.Num())
 		return; 
 	}
 
-	// Reverse the hit results from the audio's perspective so they are in the same order as the player's for easier use 
-	Algo::Reverse(HitResultsFromAudio); 
+	Result.bInRange = true; 
+	Result.bBlocked = Entry.bBlocked; 
 
-	// Adds all blocking meshes' occlusion values to determine how much the sound should be occluded 
-	float TotalOccValue = 0; 
-	for(int i = 0; i < HitResultsFromAudio.Num(); i++)
-		TotalOccValue += GetOcclusionValue(HitResultsFromPlayer[i], HitResultsFromAudio[i]); 
-	
-	TotalOccValue = FMath::Clamp(TotalOccValue, 0, 1); 
+	// No blocking objects 
+	if(!Result.bBlocked)
+		return; 
 
-	// Subtract the volume multiplier with the total occlusion value to determine how low the sound should be, higher
-	// occlusion means lower volume 
-	AudioComp->SetVolumeMultiplier(FMath::Clamp(1 - TotalOccValue, 0.01f, 1)); 
+	// Update LowPass only at set interval for optimization, a negative distance tells the batch to skip it. Without the
+	// wall distances it is measured from the mesh on the game thread 
+	if(bSnapshotUpdateLowPass && WallDistance)
+		Result.DistanceToMesh = SnapshotWallDistance; 
 
-	// Update LowPass only at set interval for optimization 
-	if(LowPassTimer > LowPassUpdateDelay)
-		SetLowPassFilter(AudioComp, HitResultsFromPlayer);
+	// Every blocking mesh adds to the total occlusion value, how far the ray traveled through it and its material
+	// decides how much. The hits from the audio are in reverse order from the player's 
+	const int NumHits = HitResultsFromPlayer.Num(); 
+	for(int i = 0; i < NumHits; i++)
+		Result.TravelDistances.push_back(FVector::Dist(HitResultsFromPlayer[i].ImpactPoint, HitResultsFromAudio[NumHits - 1 - i].ImpactPoint)); 
 }
 
-float UAudioOcclusionComponent::GetOcclusionValue(const FHitResult& HitResultFromPlayer, const FHitResult& HitResultFromAudio) 
+void UAudioOcclusionComponent::ResolveMeshResults()
 {
-	const float ThicknessValue = GetThicknessValue(HitResultFromPlayer, HitResultFromAudio);
+	for(int Source = 0; Source < SnapshotAudioComps.Num(); Source++)
+	{
+		AudioCore::FSourceOcclusion& Result = SourceResults[Source]; 
+		if(!Result.bInRange || !Result.bBlocked)
+			continue; 
 
-	const float MaterialValue = GetMaterialValue(HitResultFromPlayer); 
+		const TArray<FHitResult>& HitResultsFromPlayer = TraceEntries[Source]->HitsFromListener; 
+		if(bSnapshotUpdateLowPass && !WallDistance)
+			Result.DistanceToMesh = GetDistanceToMesh(HitResultsFromPlayer[0]); 
 
-	const float OccValue = ThicknessValue * MaterialValue; 
-	
-	return FMath::Clamp(OccValue, 0, 1); 
+		for(const FHitResult& HitResult : HitResultsFromPlayer)
+			Result.MaterialValues.push_back(GetMaterialValue(HitResult)); 
+	}
+}
+
+void UAudioOcclusionComponent::ApplySourceResults()
+{
+	int NumTraces = 0; 
+	for(int Source = 0; Source < SnapshotAudioComps.Num(); Source++)
+	{
+		const AudioCore::FSourceOcclusion& Result = SourceResults[Source]; 
+		NumTraces += Result.NumTraces; 
+		if(Result.NumTraces > 0)
+		{
+			AUDIO_SYSTEM_INC_COUNTER(TraceCacheMisses, 1); 
+		}
+		else
+		{
+			AUDIO_SYSTEM_INC_COUNTER(TraceCacheHits, 1); 
+		}
+
+		// Reset values when not blocking 
+		if(Result.bInRange && !Result.bBlocked)
+			ResetAudioComponentOnNoBlock(SnapshotAudioComps[Source]); 
+	}
+
+	// Workers can not add to the stats themselves 
+	AUDIO_SYSTEM_INC_COUNTER(LineTraces, NumTraces); 
+
+	OcclusionBatch.Reset();
+	AudioCore::FillOcclusionBatch(SourceResults, OcclusionBatch, BatchedSources); 
+	OcclusionBatch.Compute(GetOcclusionSettings()); 
+
+	for(int i = 0; i < OcclusionBatch.Num(); i++)
+	{
+		UAudioComponent* AudioComp = SnapshotAudioComps[BatchedSources[i]];
+		
+		// Higher occlusion means lower volume 
+		ParamUpdates->SetVolume(AudioComp, OcclusionBatch.GetVolume(i));
+
+		if(!OcclusionBatch.ShouldUpdateLowPass(i))
+			continue;
+
+		// Frequency is based on the distance to the blocking wall, clamped to a min of 200 and max of set variable 
+		ParamUpdates->SetLowPassFilterEnabled(AudioComp, true); 
+		ParamUpdates->SetLowPassFilterFrequency(AudioComp, OcclusionBatch.GetLowPassFrequency(i));
+	}
 }
 
 float UAudioOcclusionComponent::GetMaterialValue(const FHitResult& HitResult)
 {
+	// Many sources are usually behind the same walls 
+	const UPrimitiveComponent* HitComponent = HitResult.GetComponent(); 
+	if(const float* CachedValue = MeshMaterialValues.Find(HitComponent))
+		return *CachedValue; 
+
 	// Get all materials from hit component 
 	TArray<UMaterialInterface*> Materials; 
-	HitResult.GetComponent()->GetUsedMaterials(Materials);
+	HitComponent->GetUsedMaterials(Materials);
 
 	float MaterialValue = 1; 
 	for(const auto& Material : Materials)
@@ -216,63 +337,35 @@ float UAudioOcclusionComponent::GetMaterialValue(const FHitResult& HitResult)
 		}
 	}
 
+	MeshMaterialValues.Add(HitComponent, MaterialValue); 
 	return MaterialValue; 
 }
 
-float UAudioOcclusionComponent::GetLowPassValueBasedOnDistanceToMesh(const FHitResult& HitResultFromPlayer) const
+float UAudioOcclusionComponent::GetDistanceToMesh(const FHitResult& HitResultFromPlayer) const
 {
 	FVector ClosestPointOnMeshToPlayer; // In world coordinates 
-	HitResultFromPlayer.GetComponent()->GetClosestPointOnCollision(CameraComp->GetComponentLocation(), ClosestPointOnMeshToPlayer);
+	HitResultFromPlayer.GetComponent()->GetClosestPointOnCollision(SnapshotCameraLocation, ClosestPointOnMeshToPlayer);
 
-	const float DistanceFromPlayerToMeshPoint = FVector::Dist(ClosestPointOnMeshToPlayer, CameraComp->GetComponentLocation());
-
-	// Clamps Low Pass Value between 0 and the max distance, then divides by max distance to give a value between 0 and 1
-	const float LowPassValue = FMath::Clamp(DistanceFromPlayerToMeshPoint - DistanceToWallOffset, 0, DistanceToWallToStopAddingLowPass) / DistanceToWallToStopAddingLowPass;
-	
-	//UE_LOG(LogTemp, Warning, TEXT("LowPassValue based on distance to wall: %f"), LowPassValue);
-	
-	return LowPassValue;
+	return FVector::Dist(ClosestPointOnMeshToPlayer, SnapshotCameraLocation);
 }
 
-float UAudioOcclusionComponent::GetThicknessValue(const FHitResult& HitResultFromPlayer, const FHitResult& HitResultFromAudio) const
+AudioCore::FOcclusionSettings UAudioOcclusionComponent::GetOcclusionSettings() const
 {
-	// Get how far the ray traveled through the blocking mesh 
-	float RayTravelDistance = FVector::Dist(HitResultFromPlayer.ImpactPoint, HitResultFromAudio.ImpactPoint); 
-
-	// Divide by the max distance to travel before blocking all audio and clamp to get a value between 0 and 1 
-	RayTravelDistance /= MaxMeshDistanceToBlockAllAudio; 
-	RayTravelDistance = FMath::Clamp(RayTravelDistance, 0, 1); 
-
-	//UE_LOG(LogTemp, Warning, TEXT("RayTravelDistance: %f"), FMath::Clamp(RayTravelDistance, 0, 1)) 
-
-	return RayTravelDistance; 
+	AudioCore::FOcclusionSettings Settings;
+	Settings.MaxMeshDistanceToBlockAllAudio = MaxMeshDistanceToBlockAllAudio;
+	Settings.DistanceToWallOffset = DistanceToWallOffset;
+	Settings.DistanceToWallToStopAddingLowPass = DistanceToWallToStopAddingLowPass;
+	Settings.MaxLowPassFrequency = MaxLowPassFrequency;
+	return Settings; 
 }
 
 void UAudioOcclusionComponent::ResetAudioComponentOnNoBlock(UAudioComponent* AudioComponent)
 {
 	//UE_LOG(LogTemp, Warning, TEXT("Volume: 1, Low Pass: Disabled"))
 	
-	if(AudioComponent->VolumeMultiplier != 1)
-		AudioComponent->SetVolumeMultiplier(1);
-
-	// UE seems to not update the low pass filter correctly so if checks are not correct, reset every frame thus needed 
-	// if(AudioComponent->bEnableLowPassFilter)
-		AudioComponent->SetLowPassFilterEnabled(false);
-}
-
-void UAudioOcclusionComponent::SetLowPassFilter(UAudioComponent* AudioComp, const TArray<FHitResult>& HitResultFromPlayer) const
-{
-	// Enable low pass filter 
-	AudioComp->SetLowPassFilterEnabled(true); 
-
-	// Calculate what frequency to filter by, using the distance to the blocking wall 
-	float Frequency = MaxLowPassFrequency * GetLowPassValueBasedOnDistanceToMesh(HitResultFromPlayer[0]); 
-	// Clamp to ensure a min frequency of 200 and max of set variable 
-	Frequency = FMath::Clamp(Frequency, 200, MaxLowPassFrequency); 
-
-	AudioComp->SetLowPassFilterFrequency(Frequency);
-	
-	// UE_LOG(LogTemp, Warning, TEXT("Volume: %f Frequency: %f"), AudioComp->VolumeMultiplier, Frequency); 
+	// Requested every frame but only sent to the audio thread when it changes 
+	ParamUpdates->SetVolume(AudioComponent, 1);
+	ParamUpdates->SetLowPassFilterEnabled(AudioComponent, false);
 }
 
 void UAudioOcclusionComponent::ActorWithCompDestroyed(AActor* DestroyedActor)
@@ -282,7 +375,11 @@ void UAudioOcclusionComponent::ActorWithCompDestroyed(AActor* DestroyedActor)
 	for(const auto Comp : Comps)
 	{
 		if(auto AudioComp = Cast<UAudioComponent>(Comp)) 
+		{
 			AudioComponents.Remove(AudioComp); 
+			AudibleAudioComps.Remove(AudioComp); 
+			ParamUpdates->RemoveAudioComponent(AudioComp); 
+		}
 	}
 
 	DestroyedActor->OnDestroyed.RemoveDynamic(this, &UAudioOcclusionComponent::ActorWithCompDestroyed); 
@@ -3,7 +3,12 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "AudibleAudioComps.h"
+#include "AudioTraceCache.h"
 #include "Components/ActorComponent.h"
+#include "Core/GridWallDistance.h"
+#include "Core/OcclusionBatch.h"
+#include "Core/OcclusionSnapshot.h"
 #include "AudioOcclusionComponent.generated.h"
 
 
@@ -31,6 +36,8 @@ public:
 	// TODO: This is not needed if we find added audio comps ourselves (preferable)
 	void AddAudioComponentToOcclusion(UAudioComponent* AudioComponent); 
 
+	AudioCore::FOcclusionSettings GetOcclusionSettings() const;
+
 private: 
 
 #pragma region DataMembers
@@ -98,6 +105,80 @@ private:
 	UPROPERTY(EditDefaultsOnly)
 	FName OccludeCompTag = FName("Occlude");
 
+	// If the per source traces, thickness and material values run on worker threads, otherwise all on the game thread 
+	UPROPERTY(EditAnywhere)
+	bool bParallelOcclusion = true;
+
+	// The fewest audio comps a worker takes at once, traces are cheap enough that one per task costs more to hand out 
+	UPROPERTY(EditAnywhere, meta=(ClampMin=1))
+	int SourcesPerOcclusionTask = 4;
+
+	/* Uses the map grid's baked wall distances (see AMapGrid::bBakeWallDistance) for the low pass instead of finding
+	 * the closest point on the blocking mesh for every occluded sound. It is the distance to the nearest wall, not the
+	 * blocking one, and one lookup per update for all sounds */
+	UPROPERTY(EditAnywhere)
+	bool bUseGridWallDistance = false; 
+
+	// The grid's wall distances if bUseGridWallDistance is set and they are baked, otherwise null 
+	const AudioCore::FGridWallDistance* WallDistance = nullptr; 
+
+	/* Bakes potentially audible sets over the map grid at begin play, each tick then only considers the static audio
+	 * comps that can be heard from the listener's region (and every audio comp that moves), see FAudibleAudioComps */
+	UPROPERTY(EditAnywhere)
+	bool bBakeAudibleSets = false; 
+
+	UPROPERTY(EditAnywhere, meta=(ClampMin=1, EditCondition="bBakeAudibleSets"))
+	int AudibleSetRegionSize = 8; 
+
+	// Audio comps with this tag are baked into the audible sets even if they are not static 
+	UPROPERTY(EditAnywhere, meta=(EditCondition="bBakeAudibleSets"))
+	FName StaticEmitterTag = FName("StaticEmitter"); 
+
+	FAudibleAudioComps AudibleAudioComps; 
+
+	// The audio comps to consider this tick when the audible sets are baked, kept to not allocate every tick 
+	TArray<UAudioComponent*> CandidateAudioComps; 
+
+	// The valid audio comps within fall off distance at the start of this tick, the per source work reads only these 
+	UPROPERTY()
+	TArray<UAudioComponent*> SnapshotAudioComps; 
+
+	// Each snapshot audio comp's trace entry, holding the camera and audio locations taken at the start of the tick 
+	TArray<UAudioTraceCache::FTraceEntry*> TraceEntries; 
+
+	// Where the traces start this tick 
+	FVector SnapshotCameraLocation = FVector::ZeroVector; 
+
+	bool bSnapshotUpdateLowPass = false; 
+
+	// The camera's distance to the nearest wall this tick when the wall distances are used 
+	float SnapshotWallDistance = 0; 
+
+	// Occlusion value of every mesh hit this tick, looked up once per mesh on the game thread. Emptied with every
+	// snapshot so changed materials are picked up 
+	TMap<const UPrimitiveComponent*, float> MeshMaterialValues; 
+
+	// Each snapshot audio comp's result, every worker only writes its own. Kept between ticks to keep the allocations 
+	std::vector<AudioCore::FSourceOcclusion> SourceResults; 
+
+	// Every blocked audio comp's hits for this tick, computed together once all traces are done 
+	AudioCore::FOcclusionBatch OcclusionBatch;
+
+	// The snapshot index of each source in the batch, in the same order 
+	std::vector<int> BatchedSources; 
+
+	// Volume and low pass changes go through it so only audible changes are sent to the audio thread 
+	UPROPERTY()
+	class UAudioParameterSubsystem* ParamUpdates = nullptr; 
+
+	// Traces shared with the sound propagation component this frame 
+	UPROPERTY()
+	class UAudioTraceCache* TraceCache = nullptr; 
+
+	// Sounds whose occlusion its transmission search does are skipped, see USoundPropagationComponent::bTransmissionSearch 
+	UPROPERTY()
+	class USoundPropagationComponent* PropComp = nullptr; 
+
 #pragma endregion
 
 #pragma region Functions 
@@ -105,31 +186,36 @@ private:
 	// Called in begin play to fill the array with the audio comps in the level 
 	void SetAudioComponents();
 
-	// Helper func to do line trace 
-	bool DoLineTrace(TArray<FHitResult>& HitResultsOut, const FVector& StartLocation, const FVector& EndLocation, const TArray<AActor*>& ActorsToIgnore) const;
-	
-	void UpdateAudioComp(UAudioComponent* AudioComp, const float DeltaTime);
+	// Takes the audio comps to update and the locations they are traced between, before any per source work starts 
+	void TakeSnapshot(const bool bUpdateLowPass);
+
+	/* The per source work, runs on worker threads. Traces whatever the shared trace entry is missing and writes the
+	 * thickness of every blocking mesh to the source's result. Only reads plain data, nothing of the meshes it hit */
+	void UpdateSource(const int Source);
 
-	// Gets the total occlusion value between 0 and 1 
-	float GetOcclusionValue(const FHitResult& HitResultFromPlayer, const FHitResult& HitResultFromAudio);
+	/* Back on the game thread, fills in the material value of every blocking mesh and the distance to the first one,
+	 * which have to ask the meshes themselves */
+	void ResolveMeshResults();
 
-	// Returns a value between zero and i based on player's distance to the blocking wall  
-	float GetLowPassValueBasedOnDistanceToMesh(const FHitResult& HitResultFromPlayer) const;
+	// Back on the game thread, resets unblocked audio comps and sets the volume and low pass of the blocked ones 
+	void ApplySourceResults();
 
-	// Gets a value clamped between 0 and 1 based on the thickness of the meshes between the player and the audio source
-	float GetThicknessValue(const FHitResult& HitResultFromPlayer, const FHitResult& HitResultFromAudio) const;
+	// Returns the player's distance to the blocking wall, used for the low pass. Not used with the grid's wall distances 
+	float GetDistanceToMesh(const FHitResult& HitResultFromPlayer) const;
 
+	// Looked up once per mesh and tick, see MeshMaterialValues 
 	float GetMaterialValue(const FHitResult& HitResult); 
 
 	void ResetAudioComponentOnNoBlock(UAudioComponent* AudioComponent);
 
-	void SetLowPassFilter(UAudioComponent* AudioComp, const TArray<FHitResult>& HitResultFromPlayer) const;
-
 	UFUNCTION()
 	void ActorWithCompDestroyed(AActor* DestroyedActor);
 
 	bool ActorShouldBeIgnored(const AActor* Actor); 
 
+	// So the recorder can read the audio comps 
+	friend class UAudioTrajectoryRecorder; 
+
 #pragma endregion
 	
 };
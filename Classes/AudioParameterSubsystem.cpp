@@ -0,0 +1,108 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AudioParameterSubsystem.h"
+
+#include "AudioSystemStats.h"
+#include "SourceEffectParamSmoothing.h"
+#include "Components/AudioComponent.h"
+
+void UAudioParameterSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Tickable objects tick after every actor and component, so this is after both audio system components 
+	Updates.Flush([this](const void* Target, const AudioCore::EAudioParam Param, const float Value)
+	{
+		// Keys are only ever audio comps, destroyed ones are still valid memory until garbage collected 
+		UAudioComponent* AudioComp = static_cast<UAudioComponent*>(const_cast<void*>(Target)); 
+		if(!IsValid(AudioComp))
+			return; 
+
+		// The smoothing effect ramps to it, the audio comp itself is left as it is 
+		if(FSmoothedAudioComp* SmoothedComp = SmoothedAudioComps.Find(AudioComp))
+		{
+			SetSmoothedParam(*SmoothedComp, Param, Value); 
+			return; 
+		}
+
+		switch(Param)
+		{
+		case AudioCore::EAudioParam::Volume:
+			AudioComp->SetVolumeMultiplier(Value);
+			break;
+		case AudioCore::EAudioParam::LowPassFrequency:
+			AudioComp->SetLowPassFilterFrequency(Value);
+			break;
+		case AudioCore::EAudioParam::LowPassEnabled:
+			AudioComp->SetLowPassFilterEnabled(Value != 0);
+			break;
+		}
+	});
+
+	AUDIO_SYSTEM_INC_COUNTER(ParamRequests, Updates.GetLastStats().Requested); 
+	AUDIO_SYSTEM_INC_COUNTER(ParamCommands, Updates.GetLastStats().Sent); 
+}
+
+TStatId UAudioParameterSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAudioParameterSubsystem, STATGROUP_AudioSystem);
+}
+
+void UAudioParameterSubsystem::SetVolume(UAudioComponent* AudioComp, const float Volume)
+{
+	Updates.Set(AudioComp, AudioCore::EAudioParam::Volume, Volume); 
+}
+
+void UAudioParameterSubsystem::SetLowPassFilterEnabled(UAudioComponent* AudioComp, const bool bEnabled)
+{
+	Updates.Set(AudioComp, AudioCore::EAudioParam::LowPassEnabled, bEnabled ? 1.f : 0.f); 
+}
+
+void UAudioParameterSubsystem::SetLowPassFilterFrequency(UAudioComponent* AudioComp, const float Frequency)
+{
+	Updates.Set(AudioComp, AudioCore::EAudioParam::LowPassFrequency, Frequency); 
+}
+
+float UAudioParameterSubsystem::GetVolume(const UAudioComponent* AudioComp) const
+{
+	return Updates.GetRequested(AudioComp, AudioCore::EAudioParam::Volume, AudioComp->VolumeMultiplier); 
+}
+
+void UAudioParameterSubsystem::SetSmoothedOnAudioThread(UAudioComponent* AudioComp, const USoundEffectSourcePresetChain* Chain)
+{
+	if(!USourceEffectParamSmoothingPreset::IsInChain(Chain))
+		return; 
+
+	FSmoothedAudioComp& SmoothedComp = SmoothedAudioComps.FindOrAdd(AudioComp); 
+	SmoothedComp.AudioComponentId = AudioComp->GetAudioComponentID(); 
+	FSourceEffectParamSmoothing::GetTargetTable().Set(SmoothedComp.AudioComponentId, SmoothedComp.Targets); 
+}
+
+void UAudioParameterSubsystem::RemoveAudioComponent(const UAudioComponent* AudioComp)
+{
+	Updates.Remove(AudioComp); 
+
+	FSmoothedAudioComp SmoothedComp; 
+	if(SmoothedAudioComps.RemoveAndCopyValue(AudioComp, SmoothedComp))
+		FSourceEffectParamSmoothing::GetTargetTable().Remove(SmoothedComp.AudioComponentId); 
+}
+
+void UAudioParameterSubsystem::SetSmoothedParam(FSmoothedAudioComp& SmoothedComp, const AudioCore::EAudioParam Param, const float Value) const
+{
+	switch(Param)
+	{
+	case AudioCore::EAudioParam::Volume:
+		SmoothedComp.Targets.Gain = Value; 
+		break;
+	case AudioCore::EAudioParam::LowPassFrequency:
+		SmoothedComp.LowPassFrequency = Value; 
+		break;
+	case AudioCore::EAudioParam::LowPassEnabled:
+		SmoothedComp.bLowPassEnabled = Value != 0; 
+		break;
+	}
+
+	// A disabled low pass opens up all the way instead of being switched off in one step 
+	SmoothedComp.Targets.CutoffFrequency = SmoothedComp.bLowPassEnabled ? SmoothedComp.LowPassFrequency : AudioCore::BypassedCutoffFrequency; 
+	FSourceEffectParamSmoothing::GetTargetTable().Set(SmoothedComp.AudioComponentId, SmoothedComp.Targets); 
+}
@@ -0,0 +1,64 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/AudioParamUpdates.h"
+#include "Core/ParamSmoothing.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AudioParameterSubsystem.generated.h"
+
+class UAudioComponent;
+class USoundEffectSourcePresetChain;
+
+/*
+ * Every volume and low pass change the audio system makes goes through here instead of directly to the audio
+ * component. Each set on an audio component queues a command to the audio thread, so changes that cannot be heard are
+ * dropped and the rest are sent together once per frame after every component has ticked 
+ */
+UCLASS()
+class GRIM_API UAudioParameterSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	void SetVolume(UAudioComponent* AudioComp, const float Volume);
+
+	void SetLowPassFilterEnabled(UAudioComponent* AudioComp, const bool bEnabled);
+
+	void SetLowPassFilterFrequency(UAudioComponent* AudioComp, const float Frequency);
+
+	/* The volume last set through here, which can be newer than the audio comp's VolumeMultiplier since small changes
+	 * are not sent. Interpolate from this and not from the audio comp */
+	float GetVolume(const UAudioComponent* AudioComp) const;
+
+	/* If the chain has a USourceEffectParamSmoothingPreset, the audio comp's volume and low pass are sent to it as
+	 * targets it ramps to on the audio thread instead of being set on the audio comp. Call before the sound plays */
+	void SetSmoothedOnAudioThread(UAudioComponent* AudioComp, const USoundEffectSourcePresetChain* Chain);
+
+	// Call when the audio comp is destroyed 
+	void RemoveAudioComponent(const UAudioComponent* AudioComp);
+
+private:
+
+	AudioCore::FAudioParamUpdates Updates; 
+
+	// What the smoothing effect of an audio comp is sent, the low pass frequency is kept while the low pass is disabled 
+	struct FSmoothedAudioComp
+	{
+		uint64 AudioComponentId = 0; 
+		AudioCore::FSmoothingTargets Targets; 
+		float LowPassFrequency = AudioCore::BypassedCutoffFrequency; 
+		bool bLowPassEnabled = false; 
+	};
+
+	TMap<const UAudioComponent*, FSmoothedAudioComp> SmoothedAudioComps; 
+
+	// Sends the changed parameter to the audio comp's smoothing effect 
+	void SetSmoothedParam(FSmoothedAudioComp& SmoothedComp, const AudioCore::EAudioParam Param, const float Value) const;
+};
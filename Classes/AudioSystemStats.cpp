@@ -0,0 +1,26 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AudioSystemStats.h"
+
+DEFINE_STAT(STAT_AudioSystem_OcclusionTick);
+DEFINE_STAT(STAT_AudioSystem_PropagationTick);
+DEFINE_STAT(STAT_AudioSystem_FindPath);
+DEFINE_STAT(STAT_AudioSystem_GridBake);
+
+DEFINE_STAT(STAT_AudioSystem_LineTraces);
+DEFINE_STAT(STAT_AudioSystem_NodesExpanded);
+DEFINE_STAT(STAT_AudioSystem_PathCacheHits);
+DEFINE_STAT(STAT_AudioSystem_UnreachableRejections);
+DEFINE_STAT(STAT_AudioSystem_PendingSearches);
+DEFINE_STAT(STAT_AudioSystem_DistanceFieldPaths);
+DEFINE_STAT(STAT_AudioSystem_AudibleSetCandidates);
+DEFINE_STAT(STAT_AudioSystem_TraceCacheHits);
+DEFINE_STAT(STAT_AudioSystem_TraceCacheMisses);
+DEFINE_STAT(STAT_AudioSystem_ParamRequests);
+DEFINE_STAT(STAT_AudioSystem_ParamCommands);
+
+DEFINE_STAT(STAT_AudioSystem_PropagatedEmitters);
+DEFINE_STAT(STAT_AudioSystem_DistanceFieldKB);
+DEFINE_STAT(STAT_AudioSystem_PathArenaKB);
+
+CSV_DEFINE_CATEGORY(AudioSystem, true);
@@ -0,0 +1,69 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+/*
+ * Stats for the audio system's hot paths. Viewed live with "stat AudioSystem" and captured per frame to CSV with
+ * "csvprofile start" / "csvprofile stop" (category AudioSystem). Both compile out when stats and the CSV profiler are
+ * disabled, the CSV profiler stays enabled in Test builds so captures can be taken in shipping-like builds
+ */
+
+DECLARE_STATS_GROUP(TEXT("AudioSystem"), STATGROUP_AudioSystem, STATCAT_Advanced);
+
+// Timers
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Occlusion Tick"), STAT_AudioSystem_OcclusionTick, STATGROUP_AudioSystem, GRIM_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Propagation Tick"), STAT_AudioSystem_PropagationTick, STATGROUP_AudioSystem, GRIM_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Find Path"), STAT_AudioSystem_FindPath, STATGROUP_AudioSystem, GRIM_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Grid Bake"), STAT_AudioSystem_GridBake, STATGROUP_AudioSystem, GRIM_API);
+
+// Counters, reset every frame
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Line Traces"), STAT_AudioSystem_LineTraces, STATGROUP_AudioSystem, GRIM_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Nodes Expanded"), STAT_AudioSystem_NodesExpanded, STATGROUP_AudioSystem, GRIM_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Path Cache Hits"), STAT_AudioSystem_PathCacheHits, STATGROUP_AudioSystem, GRIM_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Unreachable Rejections"), STAT_AudioSystem_UnreachableRejections, STATGROUP_AudioSystem, GRIM_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Pending Searches"), STAT_AudioSystem_PendingSearches, STATGROUP_AudioSystem, GRIM_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Distance Field Paths"), STAT_AudioSystem_DistanceFieldPaths, STATGROUP_AudioSystem, GRIM_API);
+
+// Audio comps the components considered this frame when the potentially audible sets are baked
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Audible Set Candidates"), STAT_AudioSystem_AudibleSetCandidates, STATGROUP_AudioSystem, GRIM_API);
+
+// Source to listener traces reused from the shared trace cache, and the ones that had to be traced
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Trace Cache Hits"), STAT_AudioSystem_TraceCacheHits, STATGROUP_AudioSystem, GRIM_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Trace Cache Misses"), STAT_AudioSystem_TraceCacheMisses, STATGROUP_AudioSystem, GRIM_API);
+
+// Volume and low pass sets requested by the components, and how many of them were sent to the audio thread
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Param Requests"), STAT_AudioSystem_ParamRequests, STATGROUP_AudioSystem, GRIM_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Param Commands"), STAT_AudioSystem_ParamCommands, STATGROUP_AudioSystem, GRIM_API);
+
+// Values that persist between frames
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Propagated Emitters"), STAT_AudioSystem_PropagatedEmitters, STATGROUP_AudioSystem, GRIM_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Distance Field KB"), STAT_AudioSystem_DistanceFieldKB, STATGROUP_AudioSystem, GRIM_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Path Arena KB"), STAT_AudioSystem_PathArenaKB, STATGROUP_AudioSystem, GRIM_API);
+
+CSV_DECLARE_CATEGORY_EXTERN(AudioSystem);
+
+// Times the rest of the scope, StatName is the name after STAT_AudioSystem_. Not wrapped like the others since the
+// timers have to live until the end of the caller's scope
+#define AUDIO_SYSTEM_SCOPED_TIMER(StatName) \
+	SCOPE_CYCLE_COUNTER(STAT_AudioSystem_##StatName); \
+	CSV_SCOPED_TIMING_STAT(AudioSystem, StatName)
+
+// Adds to a per frame counter. One statement so it can be the body of an if without braces
+#define AUDIO_SYSTEM_INC_COUNTER(StatName, Amount) \
+	do \
+	{ \
+		INC_DWORD_STAT_BY(STAT_AudioSystem_##StatName, Amount); \
+		CSV_CUSTOM_STAT(AudioSystem, StatName, static_cast<int32>(Amount), ECsvCustomStatOp::Accumulate); \
+	} while(0)
+
+// Sets a value that persists between frames, one statement like AUDIO_SYSTEM_INC_COUNTER
+#define AUDIO_SYSTEM_SET_VALUE(StatName, Value) \
+	do \
+	{ \
+		SET_DWORD_STAT(STAT_AudioSystem_##StatName, Value); \
+		CSV_CUSTOM_STAT(AudioSystem, StatName, static_cast<int32>(Value), ECsvCustomStatOp::Set); \
+	} while(0)
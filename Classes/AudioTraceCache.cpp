@@ -0,0 +1,151 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AudioTraceCache.h"
+
+#include "AudioSystemStats.h"
+#include "Components/AudioComponent.h"
+#include "Kismet/KismetSystemLibrary.h"
+
+bool UAudioTraceCache::IsBlocked(const UAudioComponent* Source, const USceneComponent* Listener, const TArray<TEnumAsByte<EObjectTypeQuery>>& BlockingTypes)
+{
+	bool bFound = false;
+	FTraceEntry& Entry = FindOrAddEntry(Source, Listener, BlockingTypes, bFound); 
+	if(bFound)
+	{
+		AUDIO_SYSTEM_INC_COUNTER(TraceCacheHits, 1); 
+		return Entry.bBlocked; 
+	}
+
+	AUDIO_SYSTEM_INC_COUNTER(TraceCacheMisses, 1); 
+
+	// Same trace the propagation has always done, from the source to the listener 
+	AUDIO_SYSTEM_INC_COUNTER(LineTraces, 1); 
+	FHitResult HitResult; 
+	UKismetSystemLibrary::LineTraceSingleForObjects(GetWorld(), Entry.SourceLocation, Entry.ListenerLocation, BlockingTypes, false,
+		GetActorsToIgnore(Source, Listener), EDrawDebugTrace::ForOneFrame, HitResult, true); 
+
+	Entry.bTraced = true; 
+	Entry.bBlocked = HitResult.bBlockingHit; 
+	return Entry.bBlocked; 
+}
+
+bool UAudioTraceCache::GetHits(const UAudioComponent* Source, const USceneComponent* Listener, const TArray<TEnumAsByte<EObjectTypeQuery>>& BlockingTypes, const bool bFromListener, TArray<FHitResult>& OutHits)
+{
+	bool bFound = false;
+	FTraceEntry& Entry = FindOrAddEntry(Source, Listener, BlockingTypes, bFound); 
+
+	OutHits.Reset(); 
+
+	// Nothing in the way, there are no hits in either direction 
+	if(bFound && !Entry.bBlocked)
+	{
+		AUDIO_SYSTEM_INC_COUNTER(TraceCacheHits, 1); 
+		return false; 
+	}
+
+	bool& bHasHits = bFromListener ? Entry.bHasHitsFromListener : Entry.bHasHitsFromSource; 
+	TArray<FHitResult>& Hits = bFromListener ? Entry.HitsFromListener : Entry.HitsFromSource; 
+	if(bFound && bHasHits)
+	{
+		AUDIO_SYSTEM_INC_COUNTER(TraceCacheHits, 1); 
+		OutHits = Hits; 
+		return true; 
+	}
+
+	// Only known to be blocked, or not traced at all 
+	AUDIO_SYSTEM_INC_COUNTER(TraceCacheMisses, 1); 
+
+	const FVector Start = bFromListener ? Entry.ListenerLocation : Entry.SourceLocation; 
+	const FVector End = bFromListener ? Entry.SourceLocation : Entry.ListenerLocation; 
+	AUDIO_SYSTEM_INC_COUNTER(LineTraces, 1); 
+	TraceHits(Start, End, Source, Listener, BlockingTypes, EDrawDebugTrace::ForOneFrame, Hits); 
+
+	bHasHits = true; 
+	Entry.bTraced = true; 
+	Entry.bBlocked = !Hits.IsEmpty(); 
+	OutHits = Hits; 
+	return Entry.bBlocked; 
+}
+
+void UAudioTraceCache::PrepareEntries(const TArray<UAudioComponent*>& Sources, const USceneComponent* Listener, const TArray<TEnumAsByte<EObjectTypeQuery>>& BlockingTypes, TArray<FTraceEntry*>& OutEntries)
+{
+	// Every entry is added before any is returned, adding can move the others 
+	for(const UAudioComponent* Source : Sources)
+	{
+		bool bFound = false;
+		FindOrAddEntry(Source, Listener, BlockingTypes, bFound); 
+	}
+
+	OutEntries.Reset(); 
+	for(const UAudioComponent* Source : Sources)
+	{
+		bool bFound = false;
+		OutEntries.Add(&FindOrAddEntry(Source, Listener, BlockingTypes, bFound)); 
+	}
+}
+
+int UAudioTraceCache::FillHits(FTraceEntry& Entry, const UAudioComponent* Source, const USceneComponent* Listener, const TArray<TEnumAsByte<EObjectTypeQuery>>& BlockingTypes) const
+{
+	int NumTraces = 0; 
+
+	// Known to be unblocked means there are no hits in either direction 
+	if(!Entry.bHasHitsFromListener && !(Entry.bTraced && !Entry.bBlocked))
+	{
+		TraceHits(Entry.ListenerLocation, Entry.SourceLocation, Source, Listener, BlockingTypes, EDrawDebugTrace::None, Entry.HitsFromListener); 
+		Entry.bHasHitsFromListener = true; 
+		Entry.bTraced = true; 
+		Entry.bBlocked = !Entry.HitsFromListener.IsEmpty(); 
+		NumTraces++; 
+	}
+
+	if(Entry.bBlocked && !Entry.bHasHitsFromSource)
+	{
+		TraceHits(Entry.SourceLocation, Entry.ListenerLocation, Source, Listener, BlockingTypes, EDrawDebugTrace::None, Entry.HitsFromSource); 
+		Entry.bHasHitsFromSource = true; 
+		NumTraces++; 
+	}
+
+	return NumTraces; 
+}
+
+UAudioTraceCache::FTraceEntry& UAudioTraceCache::FindOrAddEntry(const UAudioComponent* Source, const USceneComponent* Listener, const TArray<TEnumAsByte<EObjectTypeQuery>>& BlockingTypes, bool& bOutFound)
+{
+	// New frame, everything traced last frame can have moved 
+	if(CachedFrame != GFrameCounter)
+	{
+		Entries.Reset(); 
+		CachedFrame = GFrameCounter; 
+	}
+
+	FTraceKey Key;
+	Key.Source = Source;
+	Key.Listener = Listener;
+	for(const TEnumAsByte<EObjectTypeQuery> BlockingType : BlockingTypes)
+		Key.BlockingTypesMask |= uint64(1) << static_cast<uint8>(BlockingType.GetValue()); 
+
+	const FVector SourceLocation = Source->GetComponentLocation(); 
+	const FVector ListenerLocation = Listener->GetComponentLocation(); 
+
+	FTraceEntry* Entry = Entries.Find(Key); 
+	bOutFound = Entry && Entry->SourceLocation.Equals(SourceLocation) && Entry->ListenerLocation.Equals(ListenerLocation); 
+	if(bOutFound)
+		return *Entry; 
+
+	// Not traced this frame or something moved between the components' ticks, start over 
+	FTraceEntry& NewEntry = Entries.Add(Key); 
+	NewEntry.SourceLocation = SourceLocation;
+	NewEntry.ListenerLocation = ListenerLocation; 
+	return NewEntry; 
+}
+
+void UAudioTraceCache::TraceHits(const FVector& Start, const FVector& End, const UAudioComponent* Source, const USceneComponent* Listener, const TArray<TEnumAsByte<EObjectTypeQuery>>& BlockingTypes, const EDrawDebugTrace::Type DrawDebugType, TArray<FHitResult>& OutHits) const
+{
+	UKismetSystemLibrary::LineTraceMultiForObjects(GetWorld(), Start, End, BlockingTypes, false,
+		GetActorsToIgnore(Source, Listener), DrawDebugType, OutHits, true); 
+}
+
+TArray<AActor*> UAudioTraceCache::GetActorsToIgnore(const UAudioComponent* Source, const USceneComponent* Listener) const
+{
+	// The player and the actor making the sound, same as both components ignore 
+	return TArray<AActor*> { Listener->GetOwner(), Source->GetOwner() }; 
+}
@@ -0,0 +1,93 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+#include "Kismet/KismetSystemLibrary.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AudioTraceCache.generated.h"
+
+class UAudioComponent;
+
+/*
+ * Line traces between audio sources and the listener for the current frame, shared by the occlusion and propagation
+ * components so a pair traced by one of them is not traced again by the other. Results are keyed by the source, the
+ * listener and the blocking object types and are only reused while both are where they were when traced. Both
+ * components ignore the player and the source's owner, which is what the traces here ignore. Everything is forgotten
+ * at the start of the next frame 
+ */
+UCLASS()
+class GRIM_API UAudioTraceCache : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/* True if something blocks the line between the source and the listener, from a trace either component has done
+	 * this frame if there is one */
+	bool IsBlocked(const UAudioComponent* Source, const USceneComponent* Listener, const TArray<TEnumAsByte<EObjectTypeQuery>>& BlockingTypes);
+
+	/* Every hit between the listener and the source, ordered from the listener if bFromListener and from the source
+	 * otherwise. Returns false if nothing blocks the line */
+	bool GetHits(const UAudioComponent* Source, const USceneComponent* Listener, const TArray<TEnumAsByte<EObjectTypeQuery>>& BlockingTypes, const bool bFromListener, TArray<FHitResult>& OutHits);
+
+	// What is known about one source and listener pair this frame, the locations are the ones it was traced between 
+	struct FTraceEntry
+	{
+		FVector SourceLocation;
+		FVector ListenerLocation;
+
+		// False for an entry made by PrepareEntries until FillHits traces it 
+		bool bTraced = false;
+		bool bBlocked = false;
+
+		// Only filled when a component needed every hit and not only if the line is blocked 
+		bool bHasHitsFromListener = false;
+		bool bHasHitsFromSource = false;
+		TArray<FHitResult> HitsFromListener;
+		TArray<FHitResult> HitsFromSource;
+	};
+
+	/* Finds or adds the entry of every source for this frame, in the same order, so worker threads can fill them with
+	 * FillHits. The entries stay valid until the cache is used again on the game thread, so every one has to be filled
+	 * before that */
+	void PrepareEntries(const TArray<UAudioComponent*>& Sources, const USceneComponent* Listener, const TArray<TEnumAsByte<EObjectTypeQuery>>& BlockingTypes, TArray<FTraceEntry*>& OutEntries);
+
+	/* Traces the hits in both directions that the entry does not have yet, between the locations stored in it. Safe to
+	 * call from worker threads for different entries, does not draw debug lines. Returns the number of traces done */
+	int FillHits(FTraceEntry& Entry, const UAudioComponent* Source, const USceneComponent* Listener, const TArray<TEnumAsByte<EObjectTypeQuery>>& BlockingTypes) const;
+
+private:
+
+	struct FTraceKey
+	{
+		const UAudioComponent* Source = nullptr;
+		const USceneComponent* Listener = nullptr;
+
+		// Bit per object type query 
+		uint64 BlockingTypesMask = 0;
+
+		bool operator==(const FTraceKey& Other) const
+		{
+			return Source == Other.Source && Listener == Other.Listener && BlockingTypesMask == Other.BlockingTypesMask;
+		}
+
+		friend uint32 GetTypeHash(const FTraceKey& Key)
+		{
+			return HashCombine(HashCombine(GetTypeHash(Key.Source), GetTypeHash(Key.Listener)), GetTypeHash(Key.BlockingTypesMask));
+		}
+	};
+
+	TMap<FTraceKey, FTraceEntry> Entries;
+
+	uint64 CachedFrame = 0;
+
+	// Returns the entry for the pair this frame, a new one if it was not traced or either of them has moved since 
+	FTraceEntry& FindOrAddEntry(const UAudioComponent* Source, const USceneComponent* Listener, const TArray<TEnumAsByte<EObjectTypeQuery>>& BlockingTypes, bool& bOutFound);
+
+	// Debug lines can only be drawn from the game thread, workers pass EDrawDebugTrace::None 
+	void TraceHits(const FVector& Start, const FVector& End, const UAudioComponent* Source, const USceneComponent* Listener, const TArray<TEnumAsByte<EObjectTypeQuery>>& BlockingTypes, const EDrawDebugTrace::Type DrawDebugType, TArray<FHitResult>& OutHits) const;
+
+	TArray<AActor*> GetActorsToIgnore(const UAudioComponent* Source, const USceneComponent* Listener) const;
+};
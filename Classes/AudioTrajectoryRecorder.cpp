@@ -0,0 +1,184 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AudioTrajectoryRecorder.h"
+
+#include "AudioCoreConversions.h"
+#include "AudioOcclusionComponent.h"
+#include "MapGrid.h"
+#include "SoundPropagationComponent.h"
+#include "Camera/CameraComponent.h"
+#include "Components/AudioComponent.h"
+#include "HAL/IConsoleManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectIterator.h"
+
+namespace
+{
+	// Calls the function on every recorder in the world
+	void ForEachRecorder(const UWorld* World, TFunctionRef<void(UAudioTrajectoryRecorder*)> Function)
+	{
+		for(TObjectIterator<UAudioTrajectoryRecorder> It; It; ++It)
+		{
+			if(It->GetWorld() == World && !It->IsTemplate())
+				Function(*It);
+		}
+	}
+
+	FAutoConsoleCommandWithWorld StartRecordingCommand(TEXT("AudioSystem.Recording.Start"),
+		TEXT("Starts recording listener and audio source trajectories"),
+		FConsoleCommandWithWorldDelegate::CreateLambda([](const UWorld* World)
+		{
+			ForEachRecorder(World, [](UAudioTrajectoryRecorder* Recorder) { Recorder->StartRecording(); });
+		}));
+
+	FAutoConsoleCommandWithWorld StopRecordingCommand(TEXT("AudioSystem.Recording.Stop"),
+		TEXT("Stops recording trajectories and saves them to Saved/AudioSystem/"),
+		FConsoleCommandWithWorldDelegate::CreateLambda([](const UWorld* World)
+		{
+			ForEachRecorder(World, [](UAudioTrajectoryRecorder* Recorder) { Recorder->StopRecording(); });
+		}));
+}
+
+// Sets default values for this component's properties
+UAudioTrajectoryRecorder::UAudioTrajectoryRecorder()
+{
+	// Only ticks while recording
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+}
+
+void UAudioTrajectoryRecorder::BeginPlay()
+{
+	Super::BeginPlay();
+
+	PropComp = GetOwner()->FindComponentByClass<USoundPropagationComponent>();
+	OccComp = GetOwner()->FindComponentByClass<UAudioOcclusionComponent>();
+	CameraComp = GetOwner()->FindComponentByClass<UCameraComponent>();
+	Grid = Cast<AMapGrid>(UGameplayStatics::GetActorOfClass(this, AMapGrid::StaticClass()));
+
+	// Record after the components have ticked so the paths are the ones found this frame
+	if(PropComp)
+		AddTickPrerequisiteComponent(PropComp);
+	if(OccComp)
+		AddTickPrerequisiteComponent(OccComp);
+
+	if(bRecordOnBeginPlay)
+		StartRecording();
+}
+
+void UAudioTrajectoryRecorder::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	StopRecording();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UAudioTrajectoryRecorder::StartRecording()
+{
+	if(IsRecording())
+		return;
+
+	if(!Grid || !CameraComp)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Trajectory recorder needs a grid in the level and a camera on its owner"))
+		return;
+	}
+
+	// Save the grid next to the recording so the replay runs on the same data
+	FString GridFilePath;
+	if(!Grid->ExportGrid(GridFilePath))
+		UE_LOG(LogTemp, Warning, TEXT("Could not save grid to %s"), *GridFilePath)
+
+	Writer = MakeUnique<AudioCore::FTrajectoryWriter>(Grid->GetGridHash(), Grid->GetNodeDiameter());
+	SourceIds.Reset();
+	NextSourceId = 0;
+
+	SetComponentTickEnabled(true);
+}
+
+void UAudioTrajectoryRecorder::StopRecording()
+{
+	if(!IsRecording())
+		return;
+
+	SetComponentTickEnabled(false);
+
+	const FString FilePath = FPaths::ProjectSavedDir() / TEXT("AudioSystem") / FString::Printf(TEXT("Trajectory_%s.atrj"), *FDateTime::Now().ToString());
+	const std::vector<uint8_t>& Data = Writer->GetBuffer();
+	if(FFileHelper::SaveArrayToFile(TArrayView<const uint8>(Data.data(), static_cast<int32>(Data.size())), *FilePath))
+	{
+		UE_LOG(LogTemp, Log, TEXT("Saved %i frames (%i bytes) to %s"), Writer->GetNumFrames(), static_cast<int32>(Data.size()), *FilePath)
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("Could not save trajectory recording to %s"), *FilePath)
+	}
+
+	Writer.Reset();
+}
+
+void UAudioTrajectoryRecorder::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if(!IsRecording())
+		return;
+
+	Frame.DeltaTime = DeltaTime;
+	Frame.ListenerLocation = ToCoreVector(GetOwner()->GetActorLocation());
+	Frame.CameraLocation = ToCoreVector(CameraComp->GetComponentLocation());
+	Frame.Sources.clear();
+
+	// Propagated sounds first, then occluded sounds that are not also propagated
+	if(PropComp)
+	{
+		for(const auto AudioComp : PropComp->AudioComponents)
+			AddSource(AudioComp);
+	}
+
+	if(OccComp)
+	{
+		for(const auto AudioComp : OccComp->AudioComponents)
+		{
+			if(!PropComp || !PropComp->AudioComponents.Contains(AudioComp))
+				AddSource(AudioComp);
+		}
+	}
+
+	Writer->WriteFrame(Frame);
+}
+
+void UAudioTrajectoryRecorder::AddSource(UAudioComponent* AudioComp)
+{
+	if(!IsValid(AudioComp) || !AudioComp->AttenuationSettings)
+		return;
+
+	AudioCore::FTrajectorySource Source;
+	Source.Id = GetSourceId(AudioComp);
+	Source.Position = ToCoreVector(AudioComp->GetComponentLocation());
+	Source.FalloffDistance = AudioComp->AttenuationSettings->Attenuation.FalloffDistance;
+
+	// What the propagation found this tick, if it propagated the sound
+	if(PropComp)
+	{
+		const int* PropagatedIndex = PropComp->PropagatedNodeIndices.Find(AudioComp);
+		const AudioCore::FPathHandle* PathHandle = PropComp->PathHandles.Find(AudioComp);
+		if(PropagatedIndex && PathHandle)
+		{
+			Source.RecordedPathLength = PropComp->PathArena.GetNum(*PathHandle);
+			Source.RecordedPropagatedIndex = Grid->GetOccupancyGrid().GetLinearIndex(*PropagatedIndex);
+		}
+	}
+
+	Frame.Sources.push_back(Source);
+}
+
+uint32 UAudioTrajectoryRecorder::GetSourceId(const UAudioComponent* AudioComp)
+{
+	if(const uint32* Id = SourceIds.Find(AudioComp))
+		return *Id;
+
+	return SourceIds.Add(AudioComp, NextSourceId++);
+}
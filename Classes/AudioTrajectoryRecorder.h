@@ -0,0 +1,74 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Core/TrajectoryLog.h"
+#include "AudioTrajectoryRecorder.generated.h"
+
+/*
+ * Records the listener, camera and audio source positions every tick to a compact binary log, together with the paths
+ * the sound propagation found. The log and the grid it was recorded on are written to Saved/AudioSystem/ and can be
+ * replayed headless with the TrajectoryReplay tool (see Headless/) to A/B test performance changes on real play
+ * sessions. Add it to the same actor as the sound propagation and audio occlusion components.
+ * Console commands: AudioSystem.Recording.Start / AudioSystem.Recording.Stop
+ */
+UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
+class GRIM_API UAudioTrajectoryRecorder : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	// Sets default values for this component's properties
+	UAudioTrajectoryRecorder();
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	UFUNCTION(BlueprintCallable)
+	void StartRecording();
+
+	// Stops and saves the recording
+	UFUNCTION(BlueprintCallable)
+	void StopRecording();
+
+	bool IsRecording() const { return Writer.IsValid(); }
+
+protected:
+	// Called when the game starts
+	virtual void BeginPlay() override;
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+
+	// Starts recording as soon as the game starts
+	UPROPERTY(EditAnywhere)
+	bool bRecordOnBeginPlay = false;
+
+	UPROPERTY()
+	class USoundPropagationComponent* PropComp = nullptr;
+
+	UPROPERTY()
+	class UAudioOcclusionComponent* OccComp = nullptr;
+
+	UPROPERTY()
+	class UCameraComponent* CameraComp = nullptr;
+
+	UPROPERTY()
+	class AMapGrid* Grid = nullptr;
+
+	TUniquePtr<AudioCore::FTrajectoryWriter> Writer;
+
+	// Ids written to the log for each audio comp
+	TMap<const UAudioComponent*, uint32> SourceIds;
+
+	uint32 NextSourceId = 0;
+
+	// Reused every tick to not allocate
+	AudioCore::FTrajectoryFrame Frame;
+
+	void AddSource(UAudioComponent* AudioComp);
+
+	uint32 GetSourceId(const UAudioComponent* AudioComp);
+};
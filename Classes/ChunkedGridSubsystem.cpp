@@ -0,0 +1,117 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ChunkedGridSubsystem.h"
+
+#include "AudioCoreConversions.h"
+#include "AudioSystemStats.h"
+#include "MapGridChunk.h"
+#include "Kismet/KismetSystemLibrary.h"
+
+void UChunkedGridSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Pathfinder = MakeUnique<AudioCore::FChunkedGridPathfinder>(ChunkedGrid); 
+}
+
+bool UChunkedGridSubsystem::RegisterChunk(const AMapGridChunk* Chunk)
+{
+	// The first chunk decides the lattice every other chunk has to be on 
+	if(!HasLoadedChunks())
+		ChunkedGrid.Init(Chunk->GetChunkSize(), Chunk->GetNodeDiameter(), ToCoreVector(Chunk->GetGridOrigin())); 
+
+	if(Chunk->GetChunkSize() != ChunkedGrid.GetChunkSize() || !Chunk->GetGridOrigin().Equals(FromCoreVector(ChunkedGrid.GetOrigin())))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Grid chunk %s has another chunk size or grid origin than the loaded chunks"), *Chunk->GetActorNameOrLabel())
+		return false; 
+	}
+
+	AudioCore::FOccupancyGrid ChunkGrid;
+	if(!Chunk->GetBakedGrid(ChunkGrid))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Grid chunk %s has no valid bake, bake it again"), *Chunk->GetActorNameOrLabel())
+		return false; 
+	}
+
+	const FIntVector Coord = Chunk->GetChunkCoord(); 
+	if(!ChunkedGrid.LoadChunk(AudioCore::FGridCoord(Coord.X, Coord.Y, Coord.Z), MoveTemp(ChunkGrid)))
+		return false; 
+
+	// A path blocked at the edge of the loaded chunks could go through the new one 
+	LoadedChunksVersion++; 
+	return true; 
+}
+
+void UChunkedGridSubsystem::UnregisterChunk(const AMapGridChunk* Chunk)
+{
+	const FIntVector Coord = Chunk->GetChunkCoord(); 
+	ChunkedGrid.UnloadChunk(AudioCore::FGridCoord(Coord.X, Coord.Y, Coord.Z)); 
+	LoadedChunksVersion++; 
+}
+
+bool UChunkedGridSubsystem::FindPath(const UAudioComponent* AudioComp, const FVector& From, const FVector& To, const TArray<TEnumAsByte<EObjectTypeQuery>>& BlockingTypes, const TArray<AActor*>& ActorsToIgnore, TArray<FVector>& OutPath)
+{
+	AUDIO_SYSTEM_SCOPED_TIMER(FindPath); 
+
+	const int StartCell = ChunkedGrid.WorldToCell(ToCoreVector(From)); 
+	const int EndCell = GetTargetCell(To, BlockingTypes, ActorsToIgnore); 
+	if(StartCell == AudioCore::InvalidIndex || EndCell == AudioCore::InvalidIndex)
+	{
+		LastSearches.Remove(AudioComp); 
+		OutPath.Reset(); 
+		return false;
+	}
+
+	// Neither end has moved to another cell and the same chunks are loaded, the last path (or lack of one) still holds 
+	const FLastSearch* LastSearch = LastSearches.Find(AudioComp); 
+	if(LastSearch && StartCell == LastSearch->StartCell && EndCell == LastSearch->EndCell && LoadedChunksVersion == LastSearch->LoadedChunksVersion)
+	{
+		AUDIO_SYSTEM_INC_COUNTER(PathCacheHits, 1); 
+		return LastSearch->bFoundPath; 
+	}
+
+	OutPath.Reset(); 
+	
+	const bool bFoundPath = Pathfinder->FindPath(StartCell, EndCell, PathCells); 
+	AUDIO_SYSTEM_INC_COUNTER(NodesExpanded, Pathfinder->GetLastStats().NodesExpanded); 
+
+	LastSearches.Add(AudioComp, { StartCell, EndCell, LoadedChunksVersion, bFoundPath }); 
+	if(!bFoundPath)
+		return false;
+
+	OutPath.Reserve(static_cast<int32>(PathCells.size())); 
+	for(const int Cell : PathCells)
+		OutPath.Add(FromCoreVector(ChunkedGrid.CellToWorld(Cell))); 
+
+	return true; 
+}
+
+int UChunkedGridSubsystem::GetTargetCell(const FVector& TargetLocation, const TArray<TEnumAsByte<EObjectTypeQuery>>& BlockingTypes, const TArray<AActor*>& ActorsToIgnore)
+{
+	const int TargetCell = ChunkedGrid.WorldToCell(ToCoreVector(TargetLocation)); 
+	if(TargetCell == AudioCore::InvalidIndex || ChunkedGrid.IsWalkable(TargetCell))
+		return TargetCell;
+
+	if(TargetCell == LastBlockedTargetCell && LastTargetFrame == GFrameCounter && LastTargetChunksVersion == LoadedChunksVersion)
+		return LastResolvedTargetCell; 
+
+	LastBlockedTargetCell = TargetCell; 
+	LastResolvedTargetCell = TargetCell; 
+	LastTargetFrame = GFrameCounter; 
+	LastTargetChunksVersion = LoadedChunksVersion; 
+
+	// Same as FPathfinder::GetTargetNode, a walkable neighbour is only used if the target can be seen from it so the
+	// path does not end on the other side of a wall 
+	ChunkedGrid.ForEachNeighbour(TargetCell, [&](const int Neighbour, int)
+	{
+		if(LastResolvedTargetCell != TargetCell || !ChunkedGrid.IsWalkable(Neighbour))
+			return; 
+
+		FHitResult HitResult; 
+		AUDIO_SYSTEM_INC_COUNTER(LineTraces, 1); 
+		if(!UKismetSystemLibrary::LineTraceSingleForObjects(this, FromCoreVector(ChunkedGrid.CellToWorld(Neighbour)), TargetLocation, BlockingTypes, false, ActorsToIgnore, EDrawDebugTrace::None, HitResult, true))
+			LastResolvedTargetCell = Neighbour; 
+	});
+
+	return LastResolvedTargetCell; 
+}
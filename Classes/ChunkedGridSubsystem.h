@@ -0,0 +1,82 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/ChunkedGrid.h"
+#include "Core/ChunkedGridPathfinder.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ChunkedGridSubsystem.generated.h"
+
+class AMapGridChunk;
+class UAudioComponent;
+
+/*
+ * Keeps the grid chunks (AMapGridChunk) of the currently loaded levels stitched together into one searchable grid. Only
+ * loaded chunks take memory, a chunk's nodes are freed when its level is streamed out 
+ */
+UCLASS()
+class GRIM_API UChunkedGridSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	// Adds the chunk's baked nodes, returns false if it was not baked or does not match the chunks already loaded 
+	bool RegisterChunk(const AMapGridChunk* Chunk);
+
+	void UnregisterChunk(const AMapGridChunk* Chunk);
+
+	bool HasLoadedChunks() const { return ChunkedGrid.GetNumLoadedChunks() > 0; }
+
+	float GetNodeDiameter() const { return ChunkedGrid.GetNodeDiameter(); }
+
+	const AudioCore::FChunkedGrid& GetChunkedGrid() const { return ChunkedGrid; }
+
+	/* Finds a path across the loaded chunks, returned "backwards" as node locations like FPathfinder::FindPath. If
+	 * neither end is in another cell and no chunk was loaded or unloaded since the audio comp's last search, its last
+	 * result is returned and OutPath is left as it is, so it has to be the array its last path was returned in. The
+	 * blocking types and ignored actors are used for the line traces when To is inside something blocking. Returns
+	 * false if either location is in a chunk that is not loaded or there is no path */
+	bool FindPath(const UAudioComponent* AudioComp, const FVector& From, const FVector& To, const TArray<TEnumAsByte<EObjectTypeQuery>>& BlockingTypes, const TArray<AActor*>& ActorsToIgnore, TArray<FVector>& OutPath);
+
+	// Forgets the audio comp's last search, call when it is destroyed 
+	void RemoveAudioComp(const UAudioComponent* AudioComp) { LastSearches.Remove(AudioComp); }
+
+private:
+
+	AudioCore::FChunkedGrid ChunkedGrid; 
+
+	TUniquePtr<AudioCore::FChunkedGridPathfinder> Pathfinder; 
+
+	// Reused between searches so the path does not allocate every search 
+	std::vector<int> PathCells; 
+
+	// Changed whenever a chunk is loaded or unloaded, cell ids can be reused by another chunk after that 
+	int LoadedChunksVersion = 0; 
+
+	// What an audio comp's last search was between, with which chunks loaded and whether it found a path 
+	struct FLastSearch
+	{
+		int StartCell = AudioCore::InvalidIndex;
+		int EndCell = AudioCore::InvalidIndex;
+		int LoadedChunksVersion = 0;
+		bool bFoundPath = false;
+	};
+
+	// Every audio comp's last search, its result is still valid while none of it has changed 
+	TMap<const UAudioComponent*, FLastSearch> LastSearches; 
+
+	/* Returns the cell at the target, or the first walkable neighbour with line of sight to the target if the target is
+	 * inside something blocking. Every audio comp asks for it so the result is reused for the rest of the frame */
+	int GetTargetCell(const FVector& TargetLocation, const TArray<TEnumAsByte<EObjectTypeQuery>>& BlockingTypes, const TArray<AActor*>& ActorsToIgnore);
+
+	// The blocked cell the target was in when GetTargetCell was last called, the cell it resolved to, the frame and the
+	// loaded chunks 
+	int LastBlockedTargetCell = AudioCore::InvalidIndex; 
+	int LastResolvedTargetCell = AudioCore::InvalidIndex; 
+	uint64 LastTargetFrame = 0; 
+	int LastTargetChunksVersion = 0; 
+};
@@ -0,0 +1,52 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+/*
+ * Engine independent types used by the audio system's core (grid, pathfinding and occlusion math). Nothing in the
+ * Core folder may include engine headers so it can be compiled both by the game module and by the headless
+ * benchmarks/tools in Headless/
+ */
+namespace AudioCore
+{
+	// Minimal 3D vector, the engine side converts to and from FVector
+	struct FVec3
+	{
+		float X = 0;
+		float Y = 0;
+		float Z = 0;
+
+		FVec3() {}
+		FVec3(const float InX, const float InY, const float InZ) : X(InX), Y(InY), Z(InZ) {}
+
+		FVec3 operator+(const FVec3& Other) const { return FVec3(X + Other.X, Y + Other.Y, Z + Other.Z); }
+		FVec3 operator-(const FVec3& Other) const { return FVec3(X - Other.X, Y - Other.Y, Z - Other.Z); }
+		FVec3 operator*(const float Scale) const { return FVec3(X * Scale, Y * Scale, Z * Scale); }
+
+		float Dot(const FVec3& Other) const { return X * Other.X + Y * Other.Y + Z * Other.Z; }
+		float SizeSquared() const { return Dot(*this); }
+		float Size() const { return std::sqrt(SizeSquared()); }
+
+		static float Dist(const FVec3& A, const FVec3& B) { return (A - B).Size(); }
+	};
+
+	// Grid indexes of a cell
+	struct FGridCoord
+	{
+		int X = -1;
+		int Y = -1;
+		int Z = -1;
+
+		FGridCoord() {}
+		FGridCoord(const int InX, const int InY, const int InZ) : X(InX), Y(InY), Z(InZ) {}
+
+		bool operator==(const FGridCoord& Other) const { return X == Other.X && Y == Other.Y && Z == Other.Z; }
+		bool operator!=(const FGridCoord& Other) const { return !(*this == Other); }
+	};
+
+	// Returned by index lookups that do not hit a cell
+	constexpr int InvalidIndex = -1;
+}
@@ -0,0 +1,72 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AudioParamUpdates.h"
+
+#include <cmath>
+
+namespace AudioCore
+{
+	void FAudioParamUpdates::Set(const void* Target, const EAudioParam Param, const float Value)
+	{
+		FrameStats.Requested++;
+
+		FTargetState& State = Targets[Target];
+		const int ParamIndex = static_cast<int>(Param);
+		const uint8_t Bit = static_cast<uint8_t>(1 << ParamIndex);
+		State.Requested[ParamIndex] = Value;
+
+		// Compared to what was sent and not to the previous request so small steps add up until they can be heard
+		const bool bChanged = !(State.SentMask & Bit) || IsPerceptibleChange(Param, State.Sent[ParamIndex], Value, Thresholds);
+		if(!bChanged)
+		{
+			State.PendingMask &= static_cast<uint8_t>(~Bit);
+			return;
+		}
+
+		if(!State.PendingMask)
+			PendingTargets.push_back(Target);
+
+		State.PendingMask |= Bit;
+	}
+
+	float FAudioParamUpdates::GetRequested(const void* Target, const EAudioParam Param, const float Default) const
+	{
+		const auto Found = Targets.find(Target);
+		if(Found == Targets.end())
+			return Default;
+
+		// Requested is only valid once something has been requested or sent
+		const int ParamIndex = static_cast<int>(Param);
+		const uint8_t Bit = static_cast<uint8_t>(1 << ParamIndex);
+		return (Found->second.SentMask | Found->second.PendingMask) & Bit ? Found->second.Requested[ParamIndex] : Default;
+	}
+
+	void FAudioParamUpdates::Remove(const void* Target)
+	{
+		Targets.erase(Target);
+	}
+
+	bool FAudioParamUpdates::IsPerceptibleChange(const EAudioParam Param, const float From, const float To, const FAudioParamThresholds& Thresholds)
+	{
+		switch(Param)
+		{
+		case EAudioParam::Volume:
+		{
+			const bool bFromSilent = From <= Thresholds.SilentVolume;
+			const bool bToSilent = To <= Thresholds.SilentVolume;
+			if(bFromSilent || bToSilent)
+				return bFromSilent != bToSilent;
+
+			return std::abs(20.f * std::log10(To / From)) > Thresholds.VolumeDecibels;
+		}
+		case EAudioParam::LowPassFrequency:
+			if(From <= 0 || To <= 0)
+				return From != To;
+
+			return std::abs(std::log2(To / From)) > Thresholds.LowPassOctaves;
+		case EAudioParam::LowPassEnabled:
+		default:
+			return From != To;
+		}
+	}
+}
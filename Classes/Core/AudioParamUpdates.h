@@ -0,0 +1,129 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace AudioCore
+{
+	// The audio component parameters the audio system sets every frame
+	enum class EAudioParam : uint8_t
+	{
+		Volume,
+		LowPassFrequency,
+		LowPassEnabled,
+	};
+
+	constexpr int NumAudioParams = 3;
+
+	// How much a parameter has to change before it is sent, smaller changes cannot be heard
+	struct FAudioParamThresholds
+	{
+		// Volume changes smaller than this many decibels are not sent
+		float VolumeDecibels = 0.1f;
+
+		// Volumes at or under this are all treated as silent, i.e. equal to each other
+		float SilentVolume = 0.001f;
+
+		// Low pass frequency changes smaller than this fraction of an octave are not sent
+		float LowPassOctaves = 1.f / 24.f;
+	};
+
+	struct FAudioParamStats
+	{
+		// Parameter sets requested, what was sent to the audio thread before the updates were deduplicated
+		int Requested = 0;
+
+		// Parameter sets that were sent
+		int Sent = 0;
+	};
+
+	/*
+	 * Collects the parameter changes of audio components for one frame and sends them together. The value last sent
+	 * for every target is kept and a requested value is only sent if it differs from it by more than the thresholds,
+	 * so a value that drifts slowly is sent once the drift adds up instead of every frame. A target is whatever the
+	 * caller sets the parameters on, e.g. an audio component, and is only used as a key
+	 */
+	class FAudioParamUpdates
+	{
+	public:
+		void SetThresholds(const FAudioParamThresholds& InThresholds) { Thresholds = InThresholds; }
+
+		// Requests the parameter to be set, it is sent by the next Flush if it changed enough since it was last sent
+		void Set(const void* Target, const EAudioParam Param, const float Value);
+
+		// The value last requested for the parameter, or Default if it has never been requested
+		float GetRequested(const void* Target, const EAudioParam Param, const float Default) const;
+
+		// Calls Send(Target, Param, Value) for every pending change and starts a new frame
+		template<typename SendFunctionType>
+		void Flush(SendFunctionType Send);
+
+		// Forgets the target, call when it is destroyed so a new target at the same address starts over
+		void Remove(const void* Target);
+
+		// Counters of the latest flushed frame
+		const FAudioParamStats& GetLastStats() const { return LastStats; }
+
+		int NumTargets() const { return static_cast<int>(Targets.size()); }
+
+		// True if a listener could hear the difference between the values
+		static bool IsPerceptibleChange(const EAudioParam Param, const float From, const float To, const FAudioParamThresholds& Thresholds);
+
+	private:
+		struct FTargetState
+		{
+			float Sent[NumAudioParams] = {};
+			float Requested[NumAudioParams] = {};
+
+			// Bit per parameter, set if it has ever been sent
+			uint8_t SentMask = 0;
+
+			// Bit per parameter, set if it has to be sent by the next flush
+			uint8_t PendingMask = 0;
+		};
+
+		FAudioParamThresholds Thresholds;
+
+		std::unordered_map<const void*, FTargetState> Targets;
+
+		// Targets with pending changes in the order they were first changed this frame
+		std::vector<const void*> PendingTargets;
+
+		FAudioParamStats FrameStats;
+		FAudioParamStats LastStats;
+	};
+
+	template<typename SendFunctionType>
+	void FAudioParamUpdates::Flush(SendFunctionType Send)
+	{
+		for(const void* Target : PendingTargets)
+		{
+			const auto Found = Targets.find(Target);
+			if(Found == Targets.end())
+				continue;
+
+			// Changes can have been requested back to the sent value after the target was added
+			FTargetState& State = Found->second;
+			for(int Param = 0; Param < NumAudioParams; Param++)
+			{
+				const uint8_t Bit = static_cast<uint8_t>(1 << Param);
+				if(!(State.PendingMask & Bit))
+					continue;
+
+				Send(Target, static_cast<EAudioParam>(Param), State.Requested[Param]);
+				State.Sent[Param] = State.Requested[Param];
+				State.SentMask |= Bit;
+				FrameStats.Sent++;
+			}
+
+			State.PendingMask = 0;
+		}
+
+		PendingTargets.clear();
+		LastStats = FrameStats;
+		FrameStats = FAudioParamStats();
+	}
+}
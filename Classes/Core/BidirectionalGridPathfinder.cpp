@@ -0,0 +1,223 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BidirectionalGridPathfinder.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+
+namespace AudioCore
+{
+	namespace
+	{
+		// Same priority as TGridPathfinder, FCost first and HCost on ties
+		template<typename EntryType>
+		bool HasLowerPriority(const EntryType& Left, const EntryType& Right)
+		{
+			if(Left.FCost == Right.FCost)
+				return Left.HCost > Right.HCost;
+
+			return Left.FCost > Right.FCost;
+		}
+	}
+
+	template<int Connectivity>
+	TBidirectionalGridPathfinder<Connectivity>::TBidirectionalGridPathfinder(const FOccupancyGrid& InGrid) : Grid(InGrid)
+	{
+	}
+
+	template<int Connectivity>
+	void TBidirectionalGridPathfinder<Connectivity>::BeginSearch(const int StartIndex, const int EndIndex)
+	{
+		if(!Neighbours.IsBuiltFor(Grid))
+			Neighbours.Init(Grid);
+
+		const float Diameter = Grid.GetNodeDiameter();
+		for(int Direction = 0; Direction < Connectivity; Direction++)
+			StepCosts[Direction] = static_cast<int>(Diameter * Diameter * static_cast<float>(Neighbours.GetDistanceSquared(Direction)));
+
+		const size_t NumCells = static_cast<size_t>(Grid.Num());
+		if(Forward.GCosts.size() != NumCells)
+		{
+			for(FSide* Side : { &Forward, &Backward })
+			{
+				Side->GCosts.assign(NumCells, 0);
+				Side->Parents.assign(NumCells, InvalidIndex);
+				Side->OpenedGeneration.assign(NumCells, 0);
+				Side->ClosedGeneration.assign(NumCells, 0);
+			}
+
+			Generation = 0;
+		}
+
+		// Generation wrapped around, old stamps could be mistaken for this search's so clear them
+		if(++Generation == 0)
+		{
+			for(FSide* Side : { &Forward, &Backward })
+			{
+				std::fill(Side->OpenedGeneration.begin(), Side->OpenedGeneration.end(), 0);
+				std::fill(Side->ClosedGeneration.begin(), Side->ClosedGeneration.end(), 0);
+			}
+
+			Generation = 1;
+		}
+
+		BestCost = INT_MAX;
+		MeetingIndex = InvalidIndex;
+		LastStats = FGridSearchStats();
+
+		const bool bUseLandmarks = Landmarks && Landmarks->Num() > 0 && Landmarks->IsBuiltFor(Grid);
+		StartDistances = bUseLandmarks ? Landmarks->GetDistances(StartIndex) : nullptr;
+		EndDistances = bUseLandmarks ? Landmarks->GetDistances(EndIndex) : nullptr;
+
+		BeginSide(Forward, StartIndex, EndIndex);
+		BeginSide(Backward, EndIndex, StartIndex);
+	}
+
+	template<int Connectivity>
+	void TBidirectionalGridPathfinder<Connectivity>::BeginSide(FSide& Side, const int FirstIndex, const int TargetIndex)
+	{
+		Side.FirstIndex = FirstIndex;
+		Side.TargetIndex = TargetIndex;
+
+		Side.GCosts[FirstIndex] = 0;
+		Side.Parents[FirstIndex] = InvalidIndex;
+		Side.OpenedGeneration[FirstIndex] = Generation;
+		Side.OpenSet.clear();
+
+		int HCost = 0;
+		const int64_t Potential = GetDoublePotential(Side, FirstIndex, HCost);
+		Side.OpenSet.push_back({ Potential, HCost, 0, FirstIndex });
+		LastStats.NodesPushed++;
+	}
+
+	template<int Connectivity>
+	bool TBidirectionalGridPathfinder<Connectivity>::FindPath(const int StartIndex, const int EndIndex, std::vector<int>& OutPath)
+	{
+		OutPath.clear();
+		if(StartIndex == EndIndex)
+			return true;
+
+		// The end cell is never entered if it is blocked, same as for the single search
+		if(!Grid.IsWalkable(EndIndex))
+			return false;
+
+		BeginSearch(StartIndex, EndIndex);
+
+		while(!Forward.OpenSet.empty() && !Backward.OpenSet.empty())
+		{
+			// A path not found yet goes through a cell open on both sides, and twice its cost is at least the sum of the
+			// sides' lowest FCosts since the potentials cancel out
+			if(GetLowestFCost(Forward) + GetLowestFCost(Backward) >= static_cast<int64_t>(BestCost) * 2)
+				break;
+
+			// The side with the smaller frontier is the cheaper one to grow
+			if(GetLowestFCost(Forward) <= GetLowestFCost(Backward))
+				ExpandSide(Forward, Backward);
+			else
+				ExpandSide(Backward, Forward);
+		}
+
+		if(MeetingIndex == InvalidIndex)
+			return false;
+
+		BuildPath(OutPath);
+		return true;
+	}
+
+	template<int Connectivity>
+	void TBidirectionalGridPathfinder<Connectivity>::ExpandSide(FSide& Side, const FSide& OtherSide)
+	{
+		const auto LowerPriority = [](const FOpenEntry& Left, const FOpenEntry& Right) { return HasLowerPriority(Left, Right); };
+
+		std::pop_heap(Side.OpenSet.begin(), Side.OpenSet.end(), LowerPriority);
+		const FOpenEntry Current = Side.OpenSet.back();
+		Side.OpenSet.pop_back();
+
+		// Already expanded or a cheaper way to it was found after this entry was pushed
+		if(Side.ClosedGeneration[Current.Index] == Generation || Current.GCost != Side.GCosts[Current.Index])
+			return;
+
+		Side.ClosedGeneration[Current.Index] = Generation;
+		LastStats.NodesExpanded++;
+
+		const uint8_t BoundaryMask = Neighbours.GetBoundaryMask(Current.Index);
+
+		for(int Direction = 0; Direction < Connectivity; Direction++)
+		{
+			if(!Neighbours.IsInside(BoundaryMask, Direction))
+				continue;
+
+			const int Neighbour = Neighbours.GetNeighbour(Current.Index, Direction);
+
+			// The backward side has to be able to reach the start cell even if it is blocked
+			const bool bCanEnter = Grid.IsWalkable(Neighbour) || (&Side == &Backward && Neighbour == Forward.FirstIndex);
+			if(!bCanEnter || Side.ClosedGeneration[Neighbour] == Generation)
+				continue;
+
+			const int NewGCostToNeighbour = Current.GCost + StepCosts[Direction];
+			if(Side.OpenedGeneration[Neighbour] == Generation && NewGCostToNeighbour >= Side.GCosts[Neighbour])
+				continue;
+
+			Side.OpenedGeneration[Neighbour] = Generation;
+			Side.GCosts[Neighbour] = NewGCostToNeighbour;
+			Side.Parents[Neighbour] = Current.Index;
+
+			// Reached by the other side too, a path goes through it
+			if(OtherSide.OpenedGeneration[Neighbour] == Generation && NewGCostToNeighbour + OtherSide.GCosts[Neighbour] < BestCost)
+			{
+				BestCost = NewGCostToNeighbour + OtherSide.GCosts[Neighbour];
+				MeetingIndex = Neighbour;
+			}
+
+			int HCost = 0;
+			const int64_t Potential = GetDoublePotential(Side, Neighbour, HCost);
+			Side.OpenSet.push_back({ static_cast<int64_t>(NewGCostToNeighbour) * 2 + Potential, HCost, NewGCostToNeighbour, Neighbour });
+			std::push_heap(Side.OpenSet.begin(), Side.OpenSet.end(), LowerPriority);
+			LastStats.NodesPushed++;
+		}
+	}
+
+	template<int Connectivity>
+	int TBidirectionalGridPathfinder<Connectivity>::GetHeuristic(const int Index, const int TargetIndex, const uint16_t* TargetDistances) const
+	{
+		// Same as TGridPathfinder::GetLandmarkCostToNode, without landmarks it is only the steps along the axes
+		const FGridCoord FromCoord = Grid.GetCoord(Index);
+		const FGridCoord ToCoord = Grid.GetCoord(TargetIndex);
+		const int Steps = std::abs(ToCoord.X - FromCoord.X) + std::abs(ToCoord.Y - FromCoord.Y) + std::abs(ToCoord.Z - FromCoord.Z);
+		const int LandmarkSteps = TargetDistances ? Landmarks->GetLowerBound(Index, TargetDistances) : 0;
+		const float Diameter = Grid.GetNodeDiameter();
+		return static_cast<int>(Diameter * Diameter) * std::max(Steps, LandmarkSteps);
+	}
+
+	template<int Connectivity>
+	int64_t TBidirectionalGridPathfinder<Connectivity>::GetDoublePotential(const FSide& Side, const int Index, int& OutHCost) const
+	{
+		const int ToEnd = GetHeuristic(Index, Forward.TargetIndex, EndDistances);
+		const int ToStart = GetHeuristic(Index, Backward.TargetIndex, StartDistances);
+
+		// Ties are broken on the distance left to the side's target, like the single search
+		const bool bForward = &Side == &Forward;
+		OutHCost = bForward ? ToEnd : ToStart;
+		return bForward ? static_cast<int64_t>(ToEnd) - ToStart : static_cast<int64_t>(ToStart) - ToEnd;
+	}
+
+	template<int Connectivity>
+	void TBidirectionalGridPathfinder<Connectivity>::BuildPath(std::vector<int>& OutPath) const
+	{
+		// From the end cell to the meeting cell, the backward side's parents point towards the end cell so they are
+		// followed from the meeting cell and reversed
+		for(int Current = Backward.Parents[MeetingIndex]; Current != InvalidIndex; Current = Backward.Parents[Current])
+			OutPath.push_back(Current);
+
+		std::reverse(OutPath.begin(), OutPath.end());
+
+		// Then on to the cell after the start cell, same order as a single search from the start cell builds
+		for(int Current = MeetingIndex; Current != Forward.FirstIndex; Current = Forward.Parents[Current])
+			OutPath.push_back(Current);
+	}
+
+	template class TBidirectionalGridPathfinder<6>;
+	template class TBidirectionalGridPathfinder<18>;
+	template class TBidirectionalGridPathfinder<26>;
+}
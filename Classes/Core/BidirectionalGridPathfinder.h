@@ -0,0 +1,117 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "GridLandmarks.h"
+#include "GridNeighbours.h"
+#include "GridPathfinder.h"
+#include "OccupancyGrid.h"
+
+#include <vector>
+
+namespace AudioCore
+{
+	/*
+	 * A* searching from the start cell and the end cell at the same time until the two searches meet, for long paths
+	 * where a single search's frontier grows wide before it reaches the end. Both sides use the average of the two
+	 * heuristics, (h(Cell, End) - h(Cell, Start)) / 2 forwards and the negative of it backwards, with the heuristic of
+	 * TGridPathfinder (or the landmarks if set). Since the two sides' potentials add up to 0 the search can stop as soon
+	 * as the lowest FCosts of the sides add up to the cheapest path found through a cell both sides have reached, which
+	 * is soon after they meet instead of when one side alone has ruled out everything cheaper. The side with the smaller
+	 * open set is expanded next. Paths are returned in the same order as TGridPathfinder::FindPath
+	 */
+	template<int Connectivity>
+	class TBidirectionalGridPathfinder
+	{
+	public:
+		explicit TBidirectionalGridPathfinder(const FOccupancyGrid& InGrid);
+
+		/* Finds a path from the start cell to the end cell, returned "backwards" from the end cell to the cell after the
+		 * start cell like TGridPathfinder::FindPath. Returns false and empties the path if the end cell cannot be reached */
+		bool FindPath(const int StartIndex, const int EndIndex, std::vector<int>& OutPath);
+
+		// Nodes expanded and pushed by both sides together
+		const FGridSearchStats& GetLastStats() const { return LastStats; }
+
+		// See TGridPathfinder::SetLandmarks
+		void SetLandmarks(const FGridLandmarks* InLandmarks) { Landmarks = InLandmarks; }
+
+		// Bytes of search state and neighbour data per grid cell
+		static constexpr int GetBytesPerNode() { return (sizeof(int) * 2 + sizeof(uint32_t) * 2) * 2 + TGridNeighbours<Connectivity>::GetBytesPerCell(); }
+
+	private:
+		// FCost is 2 * GCost + the side's potential times 2, so it stays an integer. 64 bits since the squared distance
+		// heuristic gets large
+		struct FOpenEntry
+		{
+			int64_t FCost;
+			int HCost;
+			int GCost;
+			int Index;
+		};
+
+		// Search state of one side, Parents point towards the side's first cell
+		struct FSide
+		{
+			std::vector<int> GCosts;
+			std::vector<int> Parents;
+			std::vector<uint32_t> OpenedGeneration;
+			std::vector<uint32_t> ClosedGeneration;
+			std::vector<FOpenEntry> OpenSet;
+
+			// The cell the side started from and the cell its heuristic aims for
+			int FirstIndex = InvalidIndex;
+			int TargetIndex = InvalidIndex;
+		};
+
+		const FOccupancyGrid& Grid;
+
+		TGridNeighbours<Connectivity> Neighbours;
+
+		int StepCosts[Connectivity] = {};
+
+		const FGridLandmarks* Landmarks = nullptr;
+
+		FSide Forward;
+		FSide Backward;
+
+		// The landmarks' distances to the start and end cells, nullptr if not using landmarks
+		const uint16_t* StartDistances = nullptr;
+		const uint16_t* EndDistances = nullptr;
+
+		uint32_t Generation = 0;
+
+		// Cheapest path found so far and the cell the two sides met in
+		int BestCost = 0;
+		int MeetingIndex = InvalidIndex;
+
+		FGridSearchStats LastStats;
+
+		void BeginSearch(const int StartIndex, const int EndIndex);
+
+		void BeginSide(FSide& Side, const int FirstIndex, const int TargetIndex);
+
+		/* Expands the side's best open cell, skipping stale entries. A cell reached by both sides is a meeting point and
+		 * updates BestCost. The start cell is the only blocked cell a search can go through, so the backward side may
+		 * step into it */
+		void ExpandSide(FSide& Side, const FSide& OtherSide);
+
+		// Lowest FCost in the side's open set, may be from a stale entry which only makes it lower
+		static int64_t GetLowestFCost(const FSide& Side) { return Side.OpenSet.front().FCost; }
+
+		// Same heuristic as TGridPathfinder, from the cell to the target with the target's landmark distances
+		int GetHeuristic(const int Index, const int TargetIndex, const uint16_t* TargetDistances) const;
+
+		// h(Cell, End) - h(Cell, Start) for the forward side and the negative of it for the backward side
+		int64_t GetDoublePotential(const FSide& Side, const int Index, int& OutHCost) const;
+
+		void BuildPath(std::vector<int>& OutPath) const;
+	};
+
+	// Defined in BidirectionalGridPathfinder.cpp for these connectivities
+	extern template class TBidirectionalGridPathfinder<6>;
+	extern template class TBidirectionalGridPathfinder<18>;
+	extern template class TBidirectionalGridPathfinder<26>;
+
+	using FBidirectionalGridPathfinder = TBidirectionalGridPathfinder<26>;
+}
@@ -0,0 +1,173 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "AudioCoreTypes.h"
+
+#include <cstring>
+#include <vector>
+
+namespace AudioCore
+{
+	/*
+	 * Little helpers to write and read the compact binary files used by the audio system (saved grids and trajectory
+	 * logs). Integers that are usually small are written as varints. Everything is little endian
+	 */
+	class FByteWriter
+	{
+	public:
+		void WriteU8(const uint8_t Value) { Buffer.push_back(Value); }
+
+		void WriteU32(const uint32_t Value)
+		{
+			for(int i = 0; i < 4; i++)
+				Buffer.push_back(static_cast<uint8_t>(Value >> (i * 8)));
+		}
+
+		void WriteU64(const uint64_t Value)
+		{
+			for(int i = 0; i < 8; i++)
+				Buffer.push_back(static_cast<uint8_t>(Value >> (i * 8)));
+		}
+
+		void WriteFloat(const float Value)
+		{
+			uint32_t Bits;
+			std::memcpy(&Bits, &Value, sizeof(Bits));
+			WriteU32(Bits);
+		}
+
+		void WriteVec3(const FVec3& Value)
+		{
+			WriteFloat(Value.X);
+			WriteFloat(Value.Y);
+			WriteFloat(Value.Z);
+		}
+
+		// 7 bits per byte, high bit set if more bytes follow
+		void WriteVarUInt(uint64_t Value)
+		{
+			while(Value >= 0x80)
+			{
+				Buffer.push_back(static_cast<uint8_t>(Value | 0x80));
+				Value >>= 7;
+			}
+			Buffer.push_back(static_cast<uint8_t>(Value));
+		}
+
+		// Zigzag encoded so small negative numbers stay small
+		void WriteVarInt(const int64_t Value)
+		{
+			WriteVarUInt((static_cast<uint64_t>(Value) << 1) ^ static_cast<uint64_t>(Value >> 63));
+		}
+
+		void WriteBytes(const uint8_t* Data, const size_t Size) { Buffer.insert(Buffer.end(), Data, Data + Size); }
+
+		const std::vector<uint8_t>& GetBuffer() const { return Buffer; }
+
+		void Reset() { Buffer.clear(); }
+
+	private:
+		std::vector<uint8_t> Buffer;
+	};
+
+	// Reads what FByteWriter wrote. Reading past the end sets the error flag and returns zeros
+	class FByteReader
+	{
+	public:
+		FByteReader(const uint8_t* InData, const size_t InSize) : Data(InData), Size(InSize) {}
+
+		uint8_t ReadU8() { return HasBytes(1) ? Data[Offset++] : 0; }
+
+		uint32_t ReadU32()
+		{
+			if(!HasBytes(4))
+				return 0;
+
+			uint32_t Value = 0;
+			for(int i = 0; i < 4; i++)
+				Value |= static_cast<uint32_t>(Data[Offset++]) << (i * 8);
+			return Value;
+		}
+
+		uint64_t ReadU64()
+		{
+			if(!HasBytes(8))
+				return 0;
+
+			uint64_t Value = 0;
+			for(int i = 0; i < 8; i++)
+				Value |= static_cast<uint64_t>(Data[Offset++]) << (i * 8);
+			return Value;
+		}
+
+		float ReadFloat()
+		{
+			const uint32_t Bits = ReadU32();
+			float Value;
+			std::memcpy(&Value, &Bits, sizeof(Value));
+			return Value;
+		}
+
+		FVec3 ReadVec3()
+		{
+			const float X = ReadFloat();
+			const float Y = ReadFloat();
+			const float Z = ReadFloat();
+			return FVec3(X, Y, Z);
+		}
+
+		uint64_t ReadVarUInt()
+		{
+			uint64_t Value = 0;
+			for(int Shift = 0; Shift < 64; Shift += 7)
+			{
+				if(!HasBytes(1))
+					return 0;
+
+				const uint8_t Byte = Data[Offset++];
+				Value |= static_cast<uint64_t>(Byte & 0x7F) << Shift;
+				if((Byte & 0x80) == 0)
+					return Value;
+			}
+
+			bError = true;
+			return 0;
+		}
+
+		int64_t ReadVarInt()
+		{
+			const uint64_t Value = ReadVarUInt();
+			return static_cast<int64_t>(Value >> 1) ^ -static_cast<int64_t>(Value & 1);
+		}
+
+		bool ReadBytes(uint8_t* Out, const size_t Count)
+		{
+			if(!HasBytes(Count))
+				return false;
+
+			std::memcpy(Out, Data + Offset, Count);
+			Offset += Count;
+			return true;
+		}
+
+		bool IsAtEnd() const { return Offset >= Size; }
+		bool HasError() const { return bError; }
+
+	private:
+		const uint8_t* Data;
+		size_t Size;
+		size_t Offset = 0;
+		bool bError = false;
+
+		bool HasBytes(const size_t Count)
+		{
+			if(Offset + Count > Size)
+			{
+				bError = true;
+				return false;
+			}
+			return true;
+		}
+	};
+}
@@ -0,0 +1,183 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ChunkedGrid.h"
+#include "GridSerialization.h"
+
+#include <cmath>
+
+namespace AudioCore
+{
+	void FChunkedGrid::Init(const int InChunkSize, const float InNodeDiameter, const FVec3& InOrigin)
+	{
+		ChunkSize = InChunkSize;
+		NodeDiameter = InNodeDiameter;
+		Origin = InOrigin;
+
+		Slots.clear();
+		FreeSlots.clear();
+		SlotsByChunk.clear();
+
+		// Only the dimensions matter for the neighbour table
+		FOccupancyGrid ChunkShape;
+		ChunkShape.Init(ChunkSize, ChunkSize, ChunkSize, NodeDiameter, Origin);
+		ChunkNeighbours.Init(ChunkShape);
+	}
+
+	FVec3 FChunkedGrid::GetChunkBottomLeft(const FGridCoord& ChunkCoord) const
+	{
+		const float ChunkLength = ChunkSize * NodeDiameter;
+		return Origin + FVec3(ChunkCoord.X * ChunkLength, ChunkCoord.Y * ChunkLength, ChunkCoord.Z * ChunkLength);
+	}
+
+	FGridCoord FChunkedGrid::WorldToChunk(const FVec3& WorldLoc) const
+	{
+		const FVec3 Relative = (WorldLoc - Origin) * (1.f / (ChunkSize * NodeDiameter));
+		return FGridCoord(static_cast<int>(std::floor(Relative.X)), static_cast<int>(std::floor(Relative.Y)), static_cast<int>(std::floor(Relative.Z)));
+	}
+
+	bool FChunkedGrid::LoadChunk(const FGridCoord& ChunkCoord, FOccupancyGrid&& ChunkGrid)
+	{
+		if(ChunkGrid.GetLengthX() != ChunkSize || ChunkGrid.GetLengthY() != ChunkSize || ChunkGrid.GetLengthZ() != ChunkSize)
+			return false;
+
+		if(ChunkGrid.GetNodeDiameter() != NodeDiameter || IsChunkLoaded(ChunkCoord))
+			return false;
+
+		// Reuse a slot from an unloaded chunk before growing
+		int Slot = InvalidIndex;
+		if(!FreeSlots.empty())
+		{
+			Slot = FreeSlots.back();
+			FreeSlots.pop_back();
+		}
+		else
+		{
+			Slot = static_cast<int>(Slots.size());
+			Slots.emplace_back();
+		}
+
+		FChunkSlot& ChunkSlot = Slots[Slot];
+		ChunkSlot.ChunkCoord = ChunkCoord;
+		ChunkSlot.bLoaded = true;
+		ChunkSlot.Grid = std::move(ChunkGrid);
+		SlotsByChunk[GetChunkKey(ChunkCoord)] = Slot;
+
+		LinkNeighbours(ChunkCoord);
+		return true;
+	}
+
+	bool FChunkedGrid::LoadChunk(const FGridCoord& ChunkCoord, const uint8_t* Data, const size_t Size)
+	{
+		FOccupancyGrid ChunkGrid;
+		if(!LoadGrid(Data, Size, ChunkGrid))
+			return false;
+
+		return LoadChunk(ChunkCoord, std::move(ChunkGrid));
+	}
+
+	void FChunkedGrid::UnloadChunk(const FGridCoord& ChunkCoord)
+	{
+		const int Slot = FindSlot(ChunkCoord);
+		if(Slot == InvalidIndex)
+			return;
+
+		SlotsByChunk.erase(GetChunkKey(ChunkCoord));
+
+		// Release the cells, the slot's search state is reused by the next chunk loaded into it
+		FChunkSlot& ChunkSlot = Slots[Slot];
+		ChunkSlot.bLoaded = false;
+		ChunkSlot.Grid = FOccupancyGrid();
+		FreeSlots.push_back(Slot);
+
+		LinkNeighbours(ChunkCoord);
+	}
+
+	int FChunkedGrid::WorldToCell(const FVec3& WorldLoc) const
+	{
+		const FGridCoord ChunkCoord = WorldToChunk(WorldLoc);
+		const int Slot = FindSlot(ChunkCoord);
+		if(Slot == InvalidIndex)
+			return InvalidIndex;
+
+		return Slot * GetCellsPerChunk() + Slots[Slot].Grid.WorldToIndex(WorldLoc);
+	}
+
+	FVec3 FChunkedGrid::CellToWorld(const int Cell) const
+	{
+		const int CellsPerChunk = GetCellsPerChunk();
+		return Slots[Cell / CellsPerChunk].Grid.IndexToWorld(Cell % CellsPerChunk);
+	}
+
+	FGridCoord FChunkedGrid::GetGlobalCoord(const int Cell) const
+	{
+		const int CellsPerChunk = GetCellsPerChunk();
+		const FChunkSlot& ChunkSlot = Slots[Cell / CellsPerChunk];
+		const FGridCoord Local = ChunkSlot.Grid.GetCoord(Cell % CellsPerChunk);
+		return FGridCoord(ChunkSlot.ChunkCoord.X * ChunkSize + Local.X, ChunkSlot.ChunkCoord.Y * ChunkSize + Local.Y, ChunkSlot.ChunkCoord.Z * ChunkSize + Local.Z);
+	}
+
+	size_t FChunkedGrid::GetMemoryUsage() const
+	{
+		return SlotsByChunk.size() * static_cast<size_t>(GetCellsPerChunk()) * FOccupancyGrid::GetBytesPerCell() + Slots.size() * sizeof(FChunkSlot);
+	}
+
+	uint64_t FChunkedGrid::GetChunkKey(const FGridCoord& ChunkCoord)
+	{
+		// 21 bits per axis is a million chunks in each direction
+		const auto Pack = [](const int Value) { return static_cast<uint64_t>(Value + (1 << 20)) & 0x1fffff; };
+		return Pack(ChunkCoord.X) << 42 | Pack(ChunkCoord.Y) << 21 | Pack(ChunkCoord.Z);
+	}
+
+	int FChunkedGrid::FindSlot(const FGridCoord& ChunkCoord) const
+	{
+		const auto Found = SlotsByChunk.find(GetChunkKey(ChunkCoord));
+		return Found != SlotsByChunk.end() ? Found->second : InvalidIndex;
+	}
+
+	void FChunkedGrid::LinkNeighbours(const FGridCoord& ChunkCoord)
+	{
+		// The chunk's own links and its neighbours' links to it, the links of a chunk that was unloaded are never read
+		for(int x = -1; x <= 1; x++)
+		{
+			for(int y = -1; y <= 1; y++)
+			{
+				for(int z = -1; z <= 1; z++)
+				{
+					const FGridCoord Neighbour(ChunkCoord.X + x, ChunkCoord.Y + y, ChunkCoord.Z + z);
+					const int NeighbourSlot = FindSlot(Neighbour);
+					if(NeighbourSlot == InvalidIndex)
+						continue;
+
+					for(int i = -1; i <= 1; i++)
+					{
+						for(int j = -1; j <= 1; j++)
+						{
+							for(int k = -1; k <= 1; k++)
+								Slots[NeighbourSlot].NeighbourSlots[GetNeighbourSlotIndex(i, j, k)] = FindSlot(FGridCoord(Neighbour.X + i, Neighbour.Y + j, Neighbour.Z + k));
+						}
+					}
+				}
+			}
+		}
+	}
+
+	FOccupancyGrid ExtractChunk(const FOccupancyGrid& Source, const FGridCoord& ChunkCoord, const int ChunkSize)
+	{
+		const float Diameter = Source.GetNodeDiameter();
+		const float ChunkLength = ChunkSize * Diameter;
+		FOccupancyGrid Chunk;
+		Chunk.Init(ChunkSize, ChunkSize, ChunkSize, Diameter, Source.GetBottomLeft() + FVec3(ChunkCoord.X * ChunkLength, ChunkCoord.Y * ChunkLength, ChunkCoord.Z * ChunkLength));
+
+		for(int Index = 0; Index < Chunk.Num(); Index++)
+		{
+			const FGridCoord Local = Chunk.GetCoord(Index);
+			const int X = ChunkCoord.X * ChunkSize + Local.X;
+			const int Y = ChunkCoord.Y * ChunkSize + Local.Y;
+			const int Z = ChunkCoord.Z * ChunkSize + Local.Z;
+			if(!Source.IsOutOfBounds(X, Y, Z))
+				Chunk.SetWalkable(Index, Source.IsWalkable(Source.GetIndex(X, Y, Z)));
+		}
+
+		return Chunk;
+	}
+}
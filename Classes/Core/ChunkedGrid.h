@@ -0,0 +1,159 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "GridNeighbours.h"
+#include "OccupancyGrid.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace AudioCore
+{
+	/*
+	 * A grid made of equally sized cubic chunks that are loaded and unloaded independently, e.g. one per streamed level.
+	 * Every chunk lies on the same lattice (chunk (0, 0, 0) starts at the origin) so chunks next to each other line up
+	 * cell for cell and searches cross chunk edges as if it was one grid. Cells in chunks that are not loaded are blocked.
+	 * Loaded chunks are kept in slots that are reused after unloading, so memory follows the number of loaded chunks
+	 * instead of the size of the world. A cell is identified by Slot * GetCellsPerChunk() + its index in the chunk, ids
+	 * of a chunk's cells are only valid while it is loaded
+	 */
+	class FChunkedGrid
+	{
+	public:
+		// ChunkSize is the number of cells along each axis of a chunk
+		void Init(const int InChunkSize, const float InNodeDiameter, const FVec3& InOrigin);
+
+		int GetChunkSize() const { return ChunkSize; }
+		int GetCellsPerChunk() const { return ChunkSize * ChunkSize * ChunkSize; }
+		float GetNodeDiameter() const { return NodeDiameter; }
+		FVec3 GetOrigin() const { return Origin; }
+
+		// World location of the chunk's bottom left corner, which is what its occupancy grid has to be baked with
+		FVec3 GetChunkBottomLeft(const FGridCoord& ChunkCoord) const;
+
+		// The chunk the world location is in
+		FGridCoord WorldToChunk(const FVec3& WorldLoc) const;
+
+		/* Adds a chunk baked with GetChunkBottomLeft and ChunkSize cells along each axis. Returns false if the grid does
+		 * not match or the chunk is already loaded */
+		bool LoadChunk(const FGridCoord& ChunkCoord, FOccupancyGrid&& ChunkGrid);
+
+		// Same as LoadChunk but reads the chunk from data written by SaveGrid
+		bool LoadChunk(const FGridCoord& ChunkCoord, const uint8_t* Data, const size_t Size);
+
+		void UnloadChunk(const FGridCoord& ChunkCoord);
+
+		bool IsChunkLoaded(const FGridCoord& ChunkCoord) const { return FindSlot(ChunkCoord) != InvalidIndex; }
+
+		int GetNumLoadedChunks() const { return static_cast<int>(SlotsByChunk.size()); }
+
+		// Number of slots ever needed, search state is sized from it
+		int GetNumSlots() const { return static_cast<int>(Slots.size()); }
+
+		// Returns the cell at the world location, or InvalidIndex if its chunk is not loaded
+		int WorldToCell(const FVec3& WorldLoc) const;
+
+		// World location of the cell's center
+		FVec3 CellToWorld(const int Cell) const;
+
+		// Cell coordinates across the whole lattice, chunk (0, 0, 0) has the cells from (0, 0, 0) to ChunkSize - 1
+		FGridCoord GetGlobalCoord(const int Cell) const;
+
+		bool IsWalkable(const int Cell) const
+		{
+			return Slots[Cell / GetCellsPerChunk()].Grid.IsWalkable(Cell % GetCellsPerChunk());
+		}
+
+		/* Calls Function(NeighbourCell, DistanceSquared) for each of the 26 neighbours that is in a loaded chunk. Cells
+		 * inside a chunk use the chunk's neighbour table, only cells on a chunk's faces look up the chunks around it */
+		template<typename FunctionType>
+		void ForEachNeighbour(const int Cell, FunctionType Function) const;
+
+		// Bytes used by the loaded chunks, not counting search state
+		size_t GetMemoryUsage() const;
+
+	private:
+		struct FChunkSlot
+		{
+			FGridCoord ChunkCoord;
+			bool bLoaded = false;
+			FOccupancyGrid Grid;
+
+			// Slots of the chunk and the 26 around it, indexed by GetNeighbourSlotIndex. InvalidIndex if not loaded
+			int NeighbourSlots[27];
+		};
+
+		int ChunkSize = 32;
+		float NodeDiameter = 100.f;
+		FVec3 Origin;
+
+		std::vector<FChunkSlot> Slots;
+		std::vector<int> FreeSlots;
+		std::unordered_map<uint64_t, int> SlotsByChunk;
+
+		// Neighbour offsets inside a chunk, same for every chunk
+		TGridNeighbours<26> ChunkNeighbours;
+
+		static uint64_t GetChunkKey(const FGridCoord& ChunkCoord);
+
+		static int GetNeighbourSlotIndex(const int X, const int Y, const int Z) { return (X + 1) * 9 + (Y + 1) * 3 + (Z + 1); }
+
+		int FindSlot(const FGridCoord& ChunkCoord) const;
+
+		// Updates the neighbour slots of the chunk and the chunks around it
+		void LinkNeighbours(const FGridCoord& ChunkCoord);
+	};
+
+	// Copies the part of Source covered by the chunk into a grid for FChunkedGrid, cells outside Source are blocked
+	FOccupancyGrid ExtractChunk(const FOccupancyGrid& Source, const FGridCoord& ChunkCoord, const int ChunkSize);
+
+	template<typename FunctionType>
+	void FChunkedGrid::ForEachNeighbour(const int Cell, FunctionType Function) const
+	{
+		const int CellsPerChunk = GetCellsPerChunk();
+		const int Slot = Cell / CellsPerChunk;
+		const int Local = Cell - Slot * CellsPerChunk;
+
+		// Inside the chunk, no chunk lookups needed
+		const uint8_t BoundaryMask = ChunkNeighbours.GetBoundaryMask(Local);
+		if(BoundaryMask == 0)
+		{
+			for(int Direction = 0; Direction < TGridNeighbours<26>::NumDirections; Direction++)
+				Function(Slot * CellsPerChunk + ChunkNeighbours.GetNeighbour(Local, Direction), ChunkNeighbours.GetDistanceSquared(Direction));
+
+			return;
+		}
+
+		// On a face of the chunk, neighbours can be in the chunks around it. Same direction order as TGridNeighbours
+		const FChunkSlot& ChunkSlot = Slots[Slot];
+		const FGridCoord Coord = ChunkSlot.Grid.GetCoord(Local);
+		for(int x = -1; x <= 1; x++)
+		{
+			for(int y = -1; y <= 1; y++)
+			{
+				for(int z = -1; z <= 1; z++)
+				{
+					if(x == 0 && y == 0 && z == 0)
+						continue;
+
+					int LocalX = Coord.X + x;
+					int LocalY = Coord.Y + y;
+					int LocalZ = Coord.Z + z;
+					const int ChunkX = LocalX < 0 ? -1 : LocalX >= ChunkSize ? 1 : 0;
+					const int ChunkY = LocalY < 0 ? -1 : LocalY >= ChunkSize ? 1 : 0;
+					const int ChunkZ = LocalZ < 0 ? -1 : LocalZ >= ChunkSize ? 1 : 0;
+
+					const int NeighbourSlot = ChunkSlot.NeighbourSlots[GetNeighbourSlotIndex(ChunkX, ChunkY, ChunkZ)];
+					if(NeighbourSlot == InvalidIndex)
+						continue;
+
+					LocalX -= ChunkX * ChunkSize;
+					LocalY -= ChunkY * ChunkSize;
+					LocalZ -= ChunkZ * ChunkSize;
+					Function(NeighbourSlot * CellsPerChunk + ChunkSlot.Grid.GetIndex(LocalX, LocalY, LocalZ), x * x + y * y + z * z);
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,127 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ChunkedGridPathfinder.h"
+
+#include <algorithm>
+
+namespace AudioCore
+{
+	namespace
+	{
+		// Same priority as FGridPathfinder, FCost first and then HCost
+		template<typename EntryType>
+		bool HasLowerPriority(const EntryType& Left, const EntryType& Right)
+		{
+			if(Left.FCost == Right.FCost)
+				return Left.HCost > Right.HCost;
+
+			return Left.FCost > Right.FCost;
+		}
+	}
+
+	FChunkedGridPathfinder::FChunkedGridPathfinder(const FChunkedGrid& InGrid) : Grid(InGrid)
+	{
+	}
+
+	void FChunkedGridPathfinder::BeginSearch()
+	{
+		// Slots are only ever added so the state only grows when more chunks than before are loaded at once
+		const size_t NumCells = static_cast<size_t>(Grid.GetNumSlots()) * Grid.GetCellsPerChunk();
+		if(GCosts.size() < NumCells)
+		{
+			GCosts.resize(NumCells, 0);
+			Parents.resize(NumCells, InvalidIndex);
+			OpenedGeneration.resize(NumCells, 0);
+			ClosedGeneration.resize(NumCells, 0);
+		}
+
+		// Generation wrapped around, old stamps could be mistaken for this search's so clear them
+		if(++Generation == 0)
+		{
+			std::fill(OpenedGeneration.begin(), OpenedGeneration.end(), 0);
+			std::fill(ClosedGeneration.begin(), ClosedGeneration.end(), 0);
+			Generation = 1;
+		}
+
+		OpenSet.clear();
+		LastStats = FGridSearchStats();
+	}
+
+	bool FChunkedGridPathfinder::FindPath(const int StartCell, const int EndCell, std::vector<int>& OutPath)
+	{
+		BeginSearch();
+		OutPath.clear();
+
+		if(StartCell == InvalidIndex || EndCell == InvalidIndex)
+			return false;
+
+		const auto LowerPriority = [](const FOpenEntry& Left, const FOpenEntry& Right) { return HasLowerPriority(Left, Right); };
+		const FGridCoord EndCoord = Grid.GetGlobalCoord(EndCell);
+		const float Diameter = Grid.GetNodeDiameter();
+
+		GCosts[StartCell] = 0;
+		Parents[StartCell] = InvalidIndex;
+		OpenedGeneration[StartCell] = Generation;
+		OpenSet.push_back({ 0, 0, 0, StartCell });
+		LastStats.NodesPushed++;
+
+		while(!OpenSet.empty())
+		{
+			std::pop_heap(OpenSet.begin(), OpenSet.end(), LowerPriority);
+			const FOpenEntry Current = OpenSet.back();
+			OpenSet.pop_back();
+
+			// Already expanded or a cheaper way to it was found after this entry was pushed
+			if(ClosedGeneration[Current.Index] == Generation || Current.GCost != GCosts[Current.Index])
+				continue;
+
+			ClosedGeneration[Current.Index] = Generation;
+			LastStats.NodesExpanded++;
+
+			if(Current.Index == EndCell)
+			{
+				for(int Cell = EndCell; Cell != StartCell; Cell = Parents[Cell])
+					OutPath.push_back(Cell);
+
+				return true;
+			}
+
+			Grid.ForEachNeighbour(Current.Index, [&](const int Neighbour, const int DistanceSquared)
+			{
+				if(!Grid.IsWalkable(Neighbour) || ClosedGeneration[Neighbour] == Generation)
+					return;
+
+				// Same as FGridPathfinder::GetCostToNode for a single step
+				const int NewGCost = Current.GCost + static_cast<int>(Diameter * Diameter * static_cast<float>(DistanceSquared));
+				if(OpenedGeneration[Neighbour] == Generation && NewGCost >= GCosts[Neighbour])
+					return;
+
+				OpenedGeneration[Neighbour] = Generation;
+				GCosts[Neighbour] = NewGCost;
+				Parents[Neighbour] = Current.Index;
+
+				const int HCost = GetHeuristic(Neighbour, EndCoord);
+				OpenSet.push_back({ NewGCost + HCost, HCost, NewGCost, Neighbour });
+				std::push_heap(OpenSet.begin(), OpenSet.end(), LowerPriority);
+				LastStats.NodesPushed++;
+			});
+		}
+
+		return false;
+	}
+
+	int FChunkedGridPathfinder::GetHeuristic(const int Cell, const FGridCoord& EndCoord) const
+	{
+		const FGridCoord Coord = Grid.GetGlobalCoord(Cell);
+		const int DeltaX = EndCoord.X - Coord.X;
+		const int DeltaY = EndCoord.Y - Coord.Y;
+		const int DeltaZ = EndCoord.Z - Coord.Z;
+		const float Diameter = Grid.GetNodeDiameter();
+		return static_cast<int>(Diameter * Diameter * static_cast<float>(DeltaX * DeltaX + DeltaY * DeltaY + DeltaZ * DeltaZ));
+	}
+
+	size_t FChunkedGridPathfinder::GetMemoryUsage() const
+	{
+		return GCosts.size() * (sizeof(int) * 2 + sizeof(uint32_t) * 2) + OpenSet.capacity() * sizeof(FOpenEntry);
+	}
+}
@@ -0,0 +1,59 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "ChunkedGrid.h"
+#include "GridPathfinder.h"
+
+#include <vector>
+
+namespace AudioCore
+{
+	/*
+	 * The A* from FGridPathfinder over the loaded chunks of an FChunkedGrid, paths cross chunk edges like any other cell.
+	 * The search state is sized from the number of chunk slots so it grows with the most chunks loaded at once and not
+	 * with the world. Costs and tie breaking are the same as FGridPathfinder's so a world split into chunks gives the
+	 * same paths as the same world in one grid
+	 */
+	class FChunkedGridPathfinder
+	{
+	public:
+		explicit FChunkedGridPathfinder(const FChunkedGrid& InGrid);
+
+		/* Finds a path between two cells, returned "backwards" like FGridPathfinder::FindPath. Returns false and empties
+		 * the path if the end cannot be reached through loaded chunks */
+		bool FindPath(const int StartCell, const int EndCell, std::vector<int>& OutPath);
+
+		const FGridSearchStats& GetLastStats() const { return LastStats; }
+
+		// Bytes of search state, grows with the number of chunk slots
+		size_t GetMemoryUsage() const;
+
+	private:
+
+		const FChunkedGrid& Grid;
+
+		std::vector<int> GCosts;
+		std::vector<int> Parents;
+		std::vector<uint32_t> OpenedGeneration;
+		std::vector<uint32_t> ClosedGeneration;
+
+		uint32_t Generation = 0;
+
+		struct FOpenEntry
+		{
+			int FCost;
+			int HCost;
+			int GCost;
+			int Index;
+		};
+
+		std::vector<FOpenEntry> OpenSet;
+
+		FGridSearchStats LastStats;
+
+		void BeginSearch();
+
+		int GetHeuristic(const int Cell, const FGridCoord& EndCoord) const;
+	};
+}
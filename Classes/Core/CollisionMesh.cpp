@@ -0,0 +1,114 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CollisionMesh.h"
+#include "BinaryStream.h"
+
+namespace AudioCore
+{
+	namespace
+	{
+		constexpr uint32_t MeshFileMagic = 0x4c4f4341; // "ACOL"
+		constexpr uint32_t MeshFileVersion = 1;
+	}
+
+	int FCollisionMesh::NumTriangles() const
+	{
+		int Num = 0;
+		for(const FCollisionBody& Body : Bodies)
+			Num += Body.NumTriangles();
+		return Num;
+	}
+
+	FCollisionBody MakeBoxBody(const FVec3& Center, const FVec3& HalfAxisX, const FVec3& HalfAxisY, const FVec3& HalfAxisZ)
+	{
+		FCollisionBody Body;
+		for(int Corner = 0; Corner < 8; Corner++)
+		{
+			const float SignX = Corner & 1 ? 1.f : -1.f, SignY = Corner & 2 ? 1.f : -1.f, SignZ = Corner & 4 ? 1.f : -1.f;
+			Body.Vertices.push_back(Center + HalfAxisX * SignX + HalfAxisY * SignY + HalfAxisZ * SignZ);
+		}
+
+		// Two triangles per face, corners are numbered by their signs along X (bit 0), Y (bit 1) and Z (bit 2)
+		Body.Indices = { 0, 2, 3, 0, 3, 1, 4, 5, 7, 4, 7, 6, 0, 1, 5, 0, 5, 4, 2, 6, 7, 2, 7, 3, 0, 4, 6, 0, 6, 2, 1, 3, 7, 1, 7, 5 };
+		return Body;
+	}
+
+	std::vector<uint8_t> SaveCollisionMesh(const FCollisionMesh& Mesh)
+	{
+		FByteWriter Writer;
+		Writer.WriteU32(MeshFileMagic);
+		Writer.WriteU32(MeshFileVersion);
+		Writer.WriteVarUInt(Mesh.LengthX);
+		Writer.WriteVarUInt(Mesh.LengthY);
+		Writer.WriteVarUInt(Mesh.LengthZ);
+		Writer.WriteFloat(Mesh.NodeDiameter);
+		Writer.WriteVec3(Mesh.BottomLeft);
+
+		Writer.WriteVarUInt(Mesh.Bodies.size());
+		for(const FCollisionBody& Body : Mesh.Bodies)
+		{
+			Writer.WriteU8(Body.bClosed ? 1 : 0);
+			Writer.WriteVarUInt(Body.Vertices.size());
+			for(const FVec3& Vertex : Body.Vertices)
+				Writer.WriteVec3(Vertex);
+
+			Writer.WriteVarUInt(Body.Indices.size());
+			for(const int Index : Body.Indices)
+				Writer.WriteVarUInt(static_cast<uint64_t>(Index));
+		}
+
+		return Writer.GetBuffer();
+	}
+
+	bool LoadCollisionMesh(const uint8_t* Data, const size_t Size, FCollisionMesh& OutMesh)
+	{
+		FByteReader Reader(Data, Size);
+		if(Reader.ReadU32() != MeshFileMagic || Reader.ReadU32() != MeshFileVersion)
+			return false;
+
+		OutMesh.LengthX = static_cast<int>(Reader.ReadVarUInt());
+		OutMesh.LengthY = static_cast<int>(Reader.ReadVarUInt());
+		OutMesh.LengthZ = static_cast<int>(Reader.ReadVarUInt());
+		OutMesh.NodeDiameter = Reader.ReadFloat();
+		OutMesh.BottomLeft = Reader.ReadVec3();
+		if(Reader.HasError() || OutMesh.NodeDiameter <= 0)
+			return false;
+
+		// Sizes are checked against what is left so a corrupt file can not make it allocate huge arrays
+		const uint64_t NumBodies = Reader.ReadVarUInt();
+		if(NumBodies > Size)
+			return false;
+
+		OutMesh.Bodies.assign(static_cast<size_t>(NumBodies), FCollisionBody());
+		for(FCollisionBody& Body : OutMesh.Bodies)
+		{
+			Body.bClosed = Reader.ReadU8() != 0;
+
+			const uint64_t NumVertices = Reader.ReadVarUInt();
+			if(NumVertices > Size)
+				return false;
+
+			Body.Vertices.resize(static_cast<size_t>(NumVertices));
+			for(FVec3& Vertex : Body.Vertices)
+				Vertex = Reader.ReadVec3();
+
+			const uint64_t NumIndices = Reader.ReadVarUInt();
+			if(NumIndices > Size || NumIndices % 3 != 0)
+				return false;
+
+			Body.Indices.resize(static_cast<size_t>(NumIndices));
+			for(int& Index : Body.Indices)
+			{
+				const uint64_t Value = Reader.ReadVarUInt();
+				if(Value >= NumVertices)
+					return false;
+				Index = static_cast<int>(Value);
+			}
+
+			if(Reader.HasError())
+				return false;
+		}
+
+		return !Reader.HasError();
+	}
+}
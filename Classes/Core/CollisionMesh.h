@@ -0,0 +1,51 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "AudioCoreTypes.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace AudioCore
+{
+	// One collision shape (a box, convex hull or triangle mesh) as triangles in world space
+	struct FCollisionBody
+	{
+		std::vector<FVec3> Vertices;
+
+		// Three per triangle
+		std::vector<int> Indices;
+
+		// The triangles enclose a solid (simple collision shapes do), so the space inside them blocks too. Open meshes
+		// (e.g. complex collision) only block near their surface
+		bool bClosed = true;
+
+		int NumTriangles() const { return static_cast<int>(Indices.size() / 3); }
+	};
+
+	/*
+	 * The static collision of a level exported by AMapGrid, together with the size and location of the grid it is baked
+	 * into, so the grid can be voxelized offline (see VoxelizeGrid) instead of with one physics overlap per node
+	 */
+	struct FCollisionMesh
+	{
+		int LengthX = 0;
+		int LengthY = 0;
+		int LengthZ = 0;
+		float NodeDiameter = 100.f;
+		FVec3 BottomLeft;
+
+		std::vector<FCollisionBody> Bodies;
+
+		int NumTriangles() const;
+	};
+
+	// A box as 12 triangles, from its center and the vectors from the center to its faces along its own X, Y and Z
+	FCollisionBody MakeBoxBody(const FVec3& Center, const FVec3& HalfAxisX, const FVec3& HalfAxisY, const FVec3& HalfAxisZ);
+
+	std::vector<uint8_t> SaveCollisionMesh(const FCollisionMesh& Mesh);
+
+	// Reads a mesh written by SaveCollisionMesh, returns false if the data is not a valid mesh
+	bool LoadCollisionMesh(const uint8_t* Data, const size_t Size, FCollisionMesh& OutMesh);
+}
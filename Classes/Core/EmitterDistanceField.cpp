@@ -0,0 +1,150 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "EmitterDistanceField.h"
+
+#include <algorithm>
+
+namespace AudioCore
+{
+	namespace
+	{
+		// The most expensive step, along all three axes
+		constexpr int MaxStepCost = 3;
+
+		// Every neighbour direction in the same order as TGridNeighbours, so ties are broken the same way
+		struct FDirections
+		{
+			FGridCoord Offsets[26];
+			int Costs[26] = {};
+
+			FDirections()
+			{
+				int Direction = 0;
+				for(int x = -1; x <= 1; x++)
+				{
+					for(int y = -1; y <= 1; y++)
+					{
+						for(int z = -1; z <= 1; z++)
+						{
+							if(x == 0 && y == 0 && z == 0)
+								continue;
+
+							Offsets[Direction] = FGridCoord(x, y, z);
+							Costs[Direction] = x * x + y * y + z * z;
+							Direction++;
+						}
+					}
+				}
+			}
+		};
+
+		const FDirections Directions;
+	}
+
+	void FEmitterDistanceField::Build(const FOccupancyGrid& Grid, const int InSourceIndex, const int MaxPathNodes)
+	{
+		SourceIndex = InSourceIndex;
+		NumReachableCells = 0;
+
+		const FGridCoord Source = Grid.GetCoord(SourceIndex);
+		Min = FGridCoord(std::max(Source.X - MaxPathNodes, 0), std::max(Source.Y - MaxPathNodes, 0), std::max(Source.Z - MaxPathNodes, 0));
+		Max = FGridCoord(std::min(Source.X + MaxPathNodes, Grid.GetLengthX() - 1), std::min(Source.Y + MaxPathNodes, Grid.GetLengthY() - 1), std::min(Source.Z + MaxPathNodes, Grid.GetLengthZ() - 1));
+		SizeX = Max.X - Min.X + 1;
+		SizeY = Max.Y - Min.Y + 1;
+		SizeZ = Max.Z - Min.Z + 1;
+
+		Distances.assign(static_cast<size_t>(SizeX) * SizeY * SizeZ, Unreachable);
+
+		// Small enough to fit in 16 bits for any path length a sound can be heard over
+		const int MaxCost = std::min(MaxPathNodes * MaxStepCost, static_cast<int>(Unreachable) - 1);
+
+		// Dial's algorithm, step costs are at most MaxStepCost so the cells to expand only ever are in one of four buckets
+		std::vector<FGridCoord> Buckets[MaxStepCost + 1];
+		Distances[GetLocalIndex(Source)] = 0;
+		Buckets[0].push_back(Source);
+		int NumQueued = 1;
+
+		for(int Cost = 0; NumQueued > 0 && Cost <= MaxCost; Cost++)
+		{
+			std::vector<FGridCoord>& Bucket = Buckets[Cost % (MaxStepCost + 1)];
+			while(!Bucket.empty())
+			{
+				const FGridCoord Current = Bucket.back();
+				Bucket.pop_back();
+				NumQueued--;
+
+				// A cheaper way to it was found after it was queued
+				if(Distances[GetLocalIndex(Current)] != Cost)
+					continue;
+
+				NumReachableCells++;
+
+				for(int Direction = 0; Direction < 26; Direction++)
+				{
+					const FGridCoord Neighbour(Current.X + Directions.Offsets[Direction].X, Current.Y + Directions.Offsets[Direction].Y, Current.Z + Directions.Offsets[Direction].Z);
+					const int LocalIndex = GetLocalIndex(Neighbour);
+					const int NewCost = Cost + Directions.Costs[Direction];
+					if(LocalIndex == InvalidIndex || NewCost > MaxCost || NewCost >= Distances[LocalIndex] || !Grid.IsWalkable(Grid.GetIndex(Neighbour)))
+						continue;
+
+					Distances[LocalIndex] = static_cast<uint16_t>(NewCost);
+					Buckets[NewCost % (MaxStepCost + 1)].push_back(Neighbour);
+					NumQueued++;
+				}
+			}
+		}
+	}
+
+	uint16_t FEmitterDistanceField::GetDistance(const FOccupancyGrid& Grid, const int Index) const
+	{
+		const int LocalIndex = GetLocalIndex(Grid.GetCoord(Index));
+		return LocalIndex == InvalidIndex ? Unreachable : Distances[LocalIndex];
+	}
+
+	bool FEmitterDistanceField::GetPath(const FOccupancyGrid& Grid, const int FromIndex, std::vector<int>& OutPath) const
+	{
+		OutPath.clear();
+
+		FGridCoord Current = Grid.GetCoord(FromIndex);
+		int LocalIndex = GetLocalIndex(Current);
+		if(LocalIndex == InvalidIndex || Distances[LocalIndex] == Unreachable)
+			return false;
+
+		// Every reachable cell other than the emitter's has a neighbour that costs less by exactly the step to it, the one it
+		// was reached from
+		while(Distances[LocalIndex] != 0)
+		{
+			OutPath.push_back(Grid.GetIndex(Current));
+
+			const int Cost = Distances[LocalIndex];
+			for(int Direction = 0; Direction < 26; Direction++)
+			{
+				const FGridCoord Neighbour(Current.X + Directions.Offsets[Direction].X, Current.Y + Directions.Offsets[Direction].Y, Current.Z + Directions.Offsets[Direction].Z);
+				const int NeighbourLocalIndex = GetLocalIndex(Neighbour);
+				if(NeighbourLocalIndex != InvalidIndex && Distances[NeighbourLocalIndex] + Directions.Costs[Direction] == Cost)
+				{
+					Current = Neighbour;
+					LocalIndex = NeighbourLocalIndex;
+					break;
+				}
+			}
+
+			// No such neighbour, which a built field always has. Stops instead of looping forever
+			if(Distances[LocalIndex] == Cost)
+			{
+				OutPath.clear();
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	int FEmitterDistanceField::GetLocalIndex(const FGridCoord& Coord) const
+	{
+		if(Coord.X < Min.X || Coord.Y < Min.Y || Coord.Z < Min.Z || Coord.X > Max.X || Coord.Y > Max.Y || Coord.Z > Max.Z)
+			return InvalidIndex;
+
+		return ((Coord.X - Min.X) * SizeY + Coord.Y - Min.Y) * SizeZ + Coord.Z - Min.Z;
+	}
+}
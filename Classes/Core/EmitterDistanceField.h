@@ -0,0 +1,67 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "OccupancyGrid.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace AudioCore
+{
+	/*
+	 * The cost of the shortest path from one emitter's cell to every cell around it, for sources that never move. The
+	 * path from the listener is then found by stepping down the distances from the listener's cell to the emitter, with
+	 * no search at all. Costs are in the pathfinder's steps (a step costs the number of axes it moves along), so the path
+	 * is one of the shortest ones the pathfinder can find. Only the cells at most MaxPathNodes cells away along every
+	 * axis are stored, 16 bits each, and cells whose cost is more than MaxPathNodes of the most expensive steps are left
+	 * unreachable since no path that long is shorter than MaxPathNodes nodes
+	 */
+	class FEmitterDistanceField
+	{
+	public:
+		// Stored for cells the emitter cannot reach within the path length
+		static constexpr uint16_t Unreachable = 0xffff;
+
+		/* Computes the costs from the emitter's cell to every cell within MaxPathNodes of it. The grid is not copied, it
+		 * is only read while building */
+		void Build(const FOccupancyGrid& Grid, const int SourceIndex, const int MaxPathNodes);
+
+		bool IsBuilt() const { return !Distances.empty(); }
+
+		int GetSourceIndex() const { return SourceIndex; }
+
+		// Cost of the shortest path from the emitter to the cell, Unreachable if it is outside the field or too far away
+		uint16_t GetDistance(const FOccupancyGrid& Grid, const int Index) const;
+
+		/* The path from the cell to the emitter in the same order as TGridPathfinder::FindPath, i.e. from the cell to
+		 * the one before the emitter's cell. Returns false and empties the path if the emitter cannot reach the cell */
+		bool GetPath(const FOccupancyGrid& Grid, const int FromIndex, std::vector<int>& OutPath) const;
+
+		// The corners of the stored box of cells (inclusive)
+		FGridCoord GetMin() const { return Min; }
+		FGridCoord GetMax() const { return Max; }
+
+		int GetNumReachableCells() const { return NumReachableCells; }
+
+		size_t GetMemoryUsage() const { return Distances.capacity() * sizeof(uint16_t); }
+
+	private:
+		int SourceIndex = InvalidIndex;
+
+		FGridCoord Min;
+		FGridCoord Max;
+
+		int SizeX = 0;
+		int SizeY = 0;
+		int SizeZ = 0;
+
+		int NumReachableCells = 0;
+
+		// One per cell in the box, X major like the Linear cell layout
+		std::vector<uint16_t> Distances;
+
+		// Index into Distances, InvalidIndex if the cell is outside the box
+		int GetLocalIndex(const FGridCoord& Coord) const;
+	};
+}
@@ -0,0 +1,129 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "GridAudibleSets.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace AudioCore
+{
+	namespace
+	{
+		// Distance from the value to the range along one axis, 0 inside it
+		float GetAxisDistance(const float Value, const float Min, const float Max)
+		{
+			return Value < Min ? Min - Value : Value > Max ? Value - Max : 0.f;
+		}
+	}
+
+	void FGridAudibleSets::Init(const FOccupancyGrid& Grid, const int InRegionSize)
+	{
+		RegionSize = std::max(InRegionSize, 1);
+		RegionsX = (Grid.GetLengthX() + RegionSize - 1) / RegionSize;
+		RegionsY = (Grid.GetLengthY() + RegionSize - 1) / RegionSize;
+		RegionsZ = (Grid.GetLengthZ() + RegionSize - 1) / RegionSize;
+
+		const float NodeDiameter = Grid.GetNodeDiameter();
+		BottomLeft = Grid.GetBottomLeft();
+		TopRight = BottomLeft + FVec3(Grid.GetLengthX() * NodeDiameter, Grid.GetLengthY() * NodeDiameter, Grid.GetLengthZ() * NodeDiameter);
+		RegionLength = RegionSize * NodeDiameter;
+
+		NumAddedSources = 0;
+		StaticSources.clear();
+		MovingSources.clear();
+		RegionOffsets.assign(static_cast<size_t>(NumRegions()) + 1, 0);
+		RegionSources.clear();
+	}
+
+	int FGridAudibleSets::AddStaticSource(const FVec3& Location, const float FalloffDistance)
+	{
+		StaticSources.push_back({ NumAddedSources, Location, FalloffDistance });
+		return NumAddedSources++;
+	}
+
+	int FGridAudibleSets::AddMovingSource()
+	{
+		MovingSources.push_back(NumAddedSources);
+		return NumAddedSources++;
+	}
+
+	void FGridAudibleSets::Build()
+	{
+		// Every region each source can be heard from, only the regions inside the box around its falloff sphere are tested
+		std::vector<std::pair<int, int>> Pairs;
+		for(const FStaticSource& Source : StaticSources)
+		{
+			const auto GetRange = [&](const float Value, const float Min, const int NumRegionsOnAxis, int& OutFirst, int& OutLast)
+			{
+				OutFirst = std::clamp(static_cast<int>(std::floor((Value - Source.FalloffDistance - Min) / RegionLength)), 0, NumRegionsOnAxis - 1);
+				OutLast = std::clamp(static_cast<int>(std::floor((Value + Source.FalloffDistance - Min) / RegionLength)), 0, NumRegionsOnAxis - 1);
+			};
+
+			int FirstX, LastX, FirstY, LastY, FirstZ, LastZ;
+			GetRange(Source.Location.X, BottomLeft.X, RegionsX, FirstX, LastX);
+			GetRange(Source.Location.Y, BottomLeft.Y, RegionsY, FirstY, LastY);
+			GetRange(Source.Location.Z, BottomLeft.Z, RegionsZ, FirstZ, LastZ);
+
+			const float FalloffSquared = Source.FalloffDistance * Source.FalloffDistance;
+			for(int X = FirstX; X <= LastX; X++)
+			{
+				for(int Y = FirstY; Y <= LastY; Y++)
+				{
+					for(int Z = FirstZ; Z <= LastZ; Z++)
+					{
+						if(GetDistanceSquaredToRegion(Source.Location, X, Y, Z) <= FalloffSquared)
+							Pairs.push_back({ GetRegionIndex(X, Y, Z), Source.Id });
+					}
+				}
+			}
+		}
+
+		// Counting sort by region, the sources were added in id order so each list stays sorted
+		RegionOffsets.assign(static_cast<size_t>(NumRegions()) + 1, 0);
+		for(const auto& [Region, Id] : Pairs)
+			RegionOffsets[Region + 1]++;
+
+		for(int Region = 0; Region < NumRegions(); Region++)
+			RegionOffsets[Region + 1] += RegionOffsets[Region];
+
+		RegionSources.resize(Pairs.size());
+		std::vector<int> Next(RegionOffsets.begin(), RegionOffsets.end() - 1);
+		for(const auto& [Region, Id] : Pairs)
+			RegionSources[Next[Region]++] = Id;
+	}
+
+	int FGridAudibleSets::GetRegion(const FVec3& WorldLoc) const
+	{
+		if(WorldLoc.X < BottomLeft.X || WorldLoc.Y < BottomLeft.Y || WorldLoc.Z < BottomLeft.Z ||
+			WorldLoc.X >= TopRight.X || WorldLoc.Y >= TopRight.Y || WorldLoc.Z >= TopRight.Z)
+			return InvalidIndex;
+
+		const FVec3 Relative = (WorldLoc - BottomLeft) * (1.f / RegionLength);
+		return GetRegionIndex(std::min(static_cast<int>(Relative.X), RegionsX - 1), std::min(static_cast<int>(Relative.Y), RegionsY - 1),
+			std::min(static_cast<int>(Relative.Z), RegionsZ - 1));
+	}
+
+	FAudibleSourceList FGridAudibleSets::GetSources(const int Region) const
+	{
+		if(Region == InvalidIndex || RegionSources.empty())
+			return FAudibleSourceList();
+
+		return { RegionSources.data() + RegionOffsets[Region], RegionOffsets[Region + 1] - RegionOffsets[Region] };
+	}
+
+	size_t FGridAudibleSets::GetMemoryUsage() const
+	{
+		return RegionOffsets.capacity() * sizeof(int) + RegionSources.capacity() * sizeof(int) + MovingSources.capacity() * sizeof(int) +
+			StaticSources.capacity() * sizeof(FStaticSource);
+	}
+
+	float FGridAudibleSets::GetDistanceSquaredToRegion(const FVec3& Location, const int X, const int Y, const int Z) const
+	{
+		const FVec3 Min = BottomLeft + FVec3(X * RegionLength, Y * RegionLength, Z * RegionLength);
+		const FVec3 Distance(GetAxisDistance(Location.X, Min.X, std::min(Min.X + RegionLength, TopRight.X)),
+			GetAxisDistance(Location.Y, Min.Y, std::min(Min.Y + RegionLength, TopRight.Y)),
+			GetAxisDistance(Location.Z, Min.Z, std::min(Min.Z + RegionLength, TopRight.Z)));
+		return Distance.SizeSquared();
+	}
+}
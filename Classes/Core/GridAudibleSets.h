@@ -0,0 +1,94 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "OccupancyGrid.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace AudioCore
+{
+	// The sources of one region, only valid until the sets are built again
+	struct FAudibleSourceList
+	{
+		const int* Sources = nullptr;
+		int Num = 0;
+
+		const int* begin() const { return Sources; }
+		const int* end() const { return Sources + Num; }
+	};
+
+	/*
+	 * Potentially audible sets: the grid is split into boxes of RegionSize cells along every axis and each box gets the
+	 * list of sources that could be heard from somewhere inside it, so the sources to consider for a listener are its
+	 * box's list instead of every source in the level. A source is in a box's list if the box is closer to it than its
+	 * falloff distance. That covers the direct sound, muffled or not, and the propagated sound as well since a path is
+	 * never shorter than the straight line. Walls do not matter, so the sets stay valid when the grid changes. Sources
+	 * that move can not be baked into boxes and are candidates everywhere
+	 */
+	class FGridAudibleSets
+	{
+	public:
+		// Splits the grid into regions and forgets every source. The grid is not copied
+		void Init(const FOccupancyGrid& Grid, const int InRegionSize);
+
+		// Returns the source's id, ids are given out in order from 0 for static and moving sources alike
+		int AddStaticSource(const FVec3& Location, const float FalloffDistance);
+
+		// Can also be called after Build, the source is a candidate everywhere right away
+		int AddMovingSource();
+
+		// Fills every region's list from the sources added since Init
+		void Build();
+
+		// The region the world location is in, InvalidIndex if it is outside the grid
+		int GetRegion(const FVec3& WorldLoc) const;
+
+		// Static sources that could be heard from the region, sorted by id
+		FAudibleSourceList GetSources(const int Region) const;
+
+		const std::vector<int>& GetMovingSources() const { return MovingSources; }
+
+		int NumSources() const { return NumAddedSources; }
+
+		int NumRegions() const { return RegionsX * RegionsY * RegionsZ; }
+
+		int GetRegionSize() const { return RegionSize; }
+
+		size_t GetMemoryUsage() const;
+
+	private:
+		int RegionSize = 8;
+
+		int RegionsX = 0;
+		int RegionsY = 0;
+		int RegionsZ = 0;
+
+		// Grid bounds in world units, a region's box is its cells clipped to them
+		FVec3 BottomLeft;
+		FVec3 TopRight;
+		float RegionLength = 0;
+
+		int NumAddedSources = 0;
+
+		struct FStaticSource
+		{
+			int Id;
+			FVec3 Location;
+			float FalloffDistance;
+		};
+
+		std::vector<FStaticSource> StaticSources;
+		std::vector<int> MovingSources;
+
+		// Every region's sources one after another, a region's start is at its offset and it ends at the next one's
+		std::vector<int> RegionOffsets;
+		std::vector<int> RegionSources;
+
+		int GetRegionIndex(const int X, const int Y, const int Z) const { return (X * RegionsY + Y) * RegionsZ + Z; }
+
+		// Squared distance from the location to the closest point of the region's box
+		float GetDistanceSquaredToRegion(const FVec3& Location, const int X, const int Y, const int Z) const;
+	};
+}
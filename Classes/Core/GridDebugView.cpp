@@ -0,0 +1,85 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "GridDebugView.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace AudioCore
+{
+	void CollectDebugCells(const FOccupancyGrid& Grid, const FGridCoord& Center, const FGridCoord& Min, const FGridCoord& Max, const int MaxCells, const bool bIncludeWalkable, FGridDebugCells& OutCells)
+	{
+		OutCells.Reset();
+
+		const FGridCoord From(std::max(Min.X, 0), std::max(Min.Y, 0), std::max(Min.Z, 0));
+		const FGridCoord To(std::min(Max.X, Grid.GetLengthX() - 1), std::min(Max.Y, Grid.GetLengthY() - 1), std::min(Max.Z, Grid.GetLengthZ() - 1));
+		if(From.X > To.X || From.Y > To.Y || From.Z > To.Z)
+			return;
+
+		// Far enough that the last shell reaches every corner of the area
+		const int MaxShell = std::max({ std::abs(Center.X - From.X), std::abs(Center.X - To.X), std::abs(Center.Y - From.Y),
+			std::abs(Center.Y - To.Y), std::abs(Center.Z - From.Z), std::abs(Center.Z - To.Z) });
+
+		// Returns false once the cap is reached
+		const auto AddCell = [&](const int X, const int Y, const int Z)
+		{
+			const int Index = Grid.GetIndex(X, Y, Z);
+			const bool bWalkable = Grid.IsWalkable(Index);
+			if(bWalkable && !bIncludeWalkable)
+				return true;
+
+			if(OutCells.Num() >= MaxCells)
+			{
+				OutCells.bCapped = true;
+				return false;
+			}
+
+			(bWalkable ? OutCells.WalkableCells : OutCells.BlockedCells).push_back(Index);
+			return true;
+		};
+
+		// Returns false once the cap is reached
+		const auto AddColumn = [&](const int X, const int Y, const int Shell)
+		{
+			for(int Z = std::max(Center.Z - Shell, From.Z); Z <= std::min(Center.Z + Shell, To.Z); Z++)
+			{
+				if(!AddCell(X, Y, Z))
+					return false;
+			}
+			return true;
+		};
+
+		/* Every cell whose largest offset from the center along any axis is Shell. The columns on the shell's sides are
+		 * whole and the others only have their top and bottom cell on it, which are often outside the area (always for
+		 * a Z slice) and then only the side columns are visited */
+		for(int Shell = 0; Shell <= MaxShell; Shell++)
+		{
+			const bool bTopInArea = Center.Z + Shell <= To.Z;
+			const bool bBottomInArea = Center.Z - Shell >= From.Z;
+			for(int X = std::max(Center.X - Shell, From.X); X <= std::min(Center.X + Shell, To.X); X++)
+			{
+				if(std::abs(X - Center.X) == Shell || bTopInArea || bBottomInArea)
+				{
+					for(int Y = std::max(Center.Y - Shell, From.Y); Y <= std::min(Center.Y + Shell, To.Y); Y++)
+					{
+						if(std::abs(X - Center.X) == Shell || std::abs(Y - Center.Y) == Shell)
+						{
+							if(!AddColumn(X, Y, Shell))
+								return;
+						}
+						else if((bBottomInArea && !AddCell(X, Y, Center.Z - Shell)) || (bTopInArea && !AddCell(X, Y, Center.Z + Shell)))
+							return;
+					}
+				}
+				else
+				{
+					for(const int Y : { Center.Y - Shell, Center.Y + Shell })
+					{
+						if(Y >= From.Y && Y <= To.Y && !AddColumn(X, Y, Shell))
+							return;
+					}
+				}
+			}
+		}
+	}
+}
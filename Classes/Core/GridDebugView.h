@@ -0,0 +1,37 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "OccupancyGrid.h"
+
+#include <vector>
+
+namespace AudioCore
+{
+	// The cells picked to be drawn, split by walkability since they are drawn with different colours
+	struct FGridDebugCells
+	{
+		std::vector<int> WalkableCells;
+		std::vector<int> BlockedCells;
+
+		// True if the cap was reached before every cell in the area was picked
+		bool bCapped = false;
+
+		void Reset()
+		{
+			WalkableCells.clear();
+			BlockedCells.clear();
+			bCapped = false;
+		}
+
+		int Num() const { return static_cast<int>(WalkableCells.size() + BlockedCells.size()); }
+	};
+
+	/*
+	 * Picks the cells from Min to Max (inclusive, clamped to the grid) to draw, in shells of growing distance from Center
+	 * so that when more than MaxCells are in the area the ones closest to Center are drawn. A Z slice is an area one cell
+	 * high. Walkable cells are only picked if bIncludeWalkable is set, most of a grid is walkable and drawing them hides
+	 * the walls
+	 */
+	void CollectDebugCells(const FOccupancyGrid& Grid, const FGridCoord& Center, const FGridCoord& Min, const FGridCoord& Max, const int MaxCells, const bool bIncludeWalkable, FGridDebugCells& OutCells);
+}
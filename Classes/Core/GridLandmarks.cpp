@@ -0,0 +1,148 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "GridLandmarks.h"
+#include "GridNeighbours.h"
+#include "ParallelFor.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+
+namespace AudioCore
+{
+	namespace
+	{
+		constexpr int MaxLandmarks = 8;
+
+		// Corners of the grid as 0 (min) or 1 (max) per axis, every corner is followed by the one opposite it
+		constexpr int Corners[MaxLandmarks][3] = { { 0, 0, 0 }, { 1, 1, 1 }, { 1, 1, 0 }, { 0, 0, 1 }, { 1, 0, 0 }, { 0, 1, 1 }, { 0, 1, 0 }, { 1, 0, 1 } };
+
+		/* Dijkstra from the start cell, step costs are only 1, 2 or 3 so the open set is four buckets of cells indexed by
+		 * distance modulo 4 instead of a heap. Unreached cells get INT_MAX */
+		void ComputeDistances(const FOccupancyGrid& Grid, const TGridNeighbours<26>& Neighbours, const int StartIndex, std::vector<int>& OutDistances)
+		{
+			OutDistances.assign(static_cast<size_t>(Grid.Num()), INT_MAX);
+
+			std::vector<int> Buckets[4];
+			OutDistances[StartIndex] = 0;
+			Buckets[0].push_back(StartIndex);
+			int NumQueued = 1;
+
+			for(int Distance = 0; NumQueued > 0; Distance++)
+			{
+				// Cells pushed to the current bucket while it is emptied are one step further and go to another bucket
+				std::vector<int>& Bucket = Buckets[Distance % 4];
+				while(!Bucket.empty())
+				{
+					const int Index = Bucket.back();
+					Bucket.pop_back();
+					NumQueued--;
+
+					// A shorter way to it was found after it was pushed
+					if(OutDistances[Index] != Distance)
+						continue;
+
+					const uint8_t BoundaryMask = Neighbours.GetBoundaryMask(Index);
+					for(int Direction = 0; Direction < TGridNeighbours<26>::NumDirections; Direction++)
+					{
+						if(!Neighbours.IsInside(BoundaryMask, Direction))
+							continue;
+
+						const int Neighbour = Neighbours.GetNeighbour(Index, Direction);
+						const int NewDistance = Distance + Neighbours.GetDistanceSquared(Direction);
+						if(!Grid.IsWalkable(Neighbour) || NewDistance >= OutDistances[Neighbour])
+							continue;
+
+						OutDistances[Neighbour] = NewDistance;
+						Buckets[NewDistance % 4].push_back(Neighbour);
+						NumQueued++;
+					}
+				}
+			}
+		}
+	}
+
+	void FGridLandmarks::Build(const FOccupancyGrid& InGrid, const int NumLandmarks, const int NumThreads)
+	{
+		Grid = &InGrid;
+		LandmarkCells.clear();
+		Distances.clear();
+		Scale = 1;
+
+		SelectLandmarks(std::min(NumLandmarks, MaxLandmarks));
+		if(LandmarkCells.empty())
+			return;
+
+		const TGridNeighbours<26> Neighbours(*Grid);
+
+		// Every landmark is searched on its own thread
+		std::vector<std::vector<int>> LandmarkDistances(LandmarkCells.size());
+		ParallelFor(Num(), NumThreads, [&](const int Landmark)
+		{
+			ComputeDistances(*Grid, Neighbours, LandmarkCells[Landmark], LandmarkDistances[Landmark]);
+		});
+
+		// Distances that do not fit in 16 bits are stored in units of several steps
+		int MaxDistance = 0;
+		for(const std::vector<int>& LandmarkDistance : LandmarkDistances)
+		{
+			for(const int Distance : LandmarkDistance)
+			{
+				if(Distance != INT_MAX)
+					MaxDistance = std::max(MaxDistance, Distance);
+			}
+		}
+
+		Scale = MaxDistance / Unreachable + 1;
+
+		// Quantised and interleaved so a cell's distances are next to each other, in blocks of cells per thread
+		const size_t NumCells = static_cast<size_t>(Grid->Num());
+		const size_t NumStored = LandmarkCells.size();
+		constexpr int CellsPerBlock = 1 << 16;
+		Distances.resize(NumCells * NumStored);
+		ParallelFor(static_cast<int>((NumCells + CellsPerBlock - 1) / CellsPerBlock), NumThreads, [&](const int Block)
+		{
+			const size_t End = std::min(NumCells, static_cast<size_t>(Block + 1) * CellsPerBlock);
+			for(size_t Index = static_cast<size_t>(Block) * CellsPerBlock; Index < End; Index++)
+			{
+				for(size_t Landmark = 0; Landmark < NumStored; Landmark++)
+				{
+					const int Distance = LandmarkDistances[Landmark][Index];
+					Distances[Index * NumStored + Landmark] = Distance == INT_MAX ? Unreachable : static_cast<uint16_t>(Distance / Scale);
+				}
+			}
+		});
+	}
+
+	void FGridLandmarks::SelectLandmarks(const int NumLandmarks)
+	{
+		for(int Landmark = 0; Landmark < NumLandmarks; Landmark++)
+		{
+			const int CornerX = Corners[Landmark][0] * (Grid->GetLengthX() - 1);
+			const int CornerY = Corners[Landmark][1] * (Grid->GetLengthY() - 1);
+			const int CornerZ = Corners[Landmark][2] * (Grid->GetLengthZ() - 1);
+
+			int Closest = InvalidIndex;
+			int ClosestDistance = INT_MAX;
+			for(int Index = 0; Index < Grid->Num(); Index++)
+			{
+				if(!Grid->IsWalkable(Index))
+					continue;
+
+				const FGridCoord Coord = Grid->GetCoord(Index);
+				const int Distance = std::abs(Coord.X - CornerX) + std::abs(Coord.Y - CornerY) + std::abs(Coord.Z - CornerZ);
+				if(Distance < ClosestDistance && std::find(LandmarkCells.begin(), LandmarkCells.end(), Index) == LandmarkCells.end())
+				{
+					Closest = Index;
+					ClosestDistance = Distance;
+				}
+			}
+
+			// No walkable cells left
+			if(Closest == InvalidIndex)
+				return;
+
+			LandmarkCells.push_back(Closest);
+		}
+	}
+}
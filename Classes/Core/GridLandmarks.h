@@ -0,0 +1,75 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "OccupancyGrid.h"
+
+#include <vector>
+
+namespace AudioCore
+{
+	/*
+	 * Distances from a few landmark cells to every cell, used by the pathfinder as an ALT (A*, landmarks and triangle
+	 * inequality) heuristic. For any landmark L, |d(L, Goal) - d(L, Cell)| can never be more than d(Cell, Goal), so the
+	 * heuristic knows about walls between the cell and the goal, which the straight line distance does not. Distances
+	 * are in steps where a step costs the number of axes it moves along (the pathfinder's step cost divided by the node
+	 * diameter squared) and are stored as 16 bits per landmark and cell, all landmarks of a cell next to each other
+	 */
+	class FGridLandmarks
+	{
+	public:
+		// Stored for cells the landmark cannot reach
+		static constexpr uint16_t Unreachable = 0xffff;
+
+		/* Picks NumLandmarks walkable cells spread out to the grid's corners and computes their distances, one landmark
+		 * per thread on up to NumThreads threads. The grid is not copied and has to outlive this */
+		void Build(const FOccupancyGrid& InGrid, const int NumLandmarks, const int NumThreads);
+
+		// Number of landmarks, 0 if not built
+		int Num() const { return static_cast<int>(LandmarkCells.size()); }
+
+		int GetLandmarkCell(const int Landmark) const { return LandmarkCells[Landmark]; }
+
+		// Quantised distances of every landmark to the cell
+		const uint16_t* GetDistances(const int Index) const { return &Distances[static_cast<size_t>(Index) * LandmarkCells.size()]; }
+
+		/* Lower bound of the steps from the cell to the goal, GoalDistances is GetDistances(Goal). Landmarks that cannot
+		 * reach both cells do not add anything */
+		int GetLowerBound(const int Index, const uint16_t* GoalDistances) const
+		{
+			const uint16_t* CellDistances = GetDistances(Index);
+			int Bound = 0;
+			for(size_t Landmark = 0; Landmark < LandmarkCells.size(); Landmark++)
+			{
+				if(CellDistances[Landmark] == Unreachable || GoalDistances[Landmark] == Unreachable)
+					continue;
+
+				const int Difference = CellDistances[Landmark] > GoalDistances[Landmark] ? CellDistances[Landmark] - GoalDistances[Landmark] : GoalDistances[Landmark] - CellDistances[Landmark];
+				Bound = Difference > Bound ? Difference : Bound;
+			}
+
+			// A stored distance can be up to Scale - 1 steps shorter than the real one
+			return Bound > 0 ? Bound * Scale - (Scale - 1) : 0;
+		}
+
+		// Steps per stored unit, 1 unless the grid is too large for the distances to fit in 16 bits
+		int GetScale() const { return Scale; }
+
+		bool IsBuiltFor(const FOccupancyGrid& InGrid) const { return Grid == &InGrid && Distances.size() == static_cast<size_t>(InGrid.Num()) * LandmarkCells.size(); }
+
+		size_t GetMemoryUsage() const { return Distances.capacity() * sizeof(uint16_t) + LandmarkCells.capacity() * sizeof(int); }
+
+	private:
+		const FOccupancyGrid* Grid = nullptr;
+
+		std::vector<int> LandmarkCells;
+
+		// NumLandmarks per cell
+		std::vector<uint16_t> Distances;
+
+		int Scale = 1;
+
+		// Picks the walkable cells closest to the grid's corners, opposite corners first
+		void SelectLandmarks(const int NumLandmarks);
+	};
+}
@@ -0,0 +1,140 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "GridLevels.h"
+
+#include <algorithm>
+
+namespace AudioCore
+{
+	void FGridLevels::Build(const FOccupancyGrid& InBaseGrid, const int NumCoarseLevels)
+	{
+		BaseGrid = &InBaseGrid;
+		CoarseLevels.clear();
+		RepresentativeChildren.clear();
+
+		for(int Level = 1; Level <= NumCoarseLevels; Level++)
+		{
+			const FOccupancyGrid& Fine = GetLevel(Level - 1);
+
+			// Odd lengths round up, the last coarse cell along that axis then only has children on one side
+			FOccupancyGrid Coarse;
+			Coarse.Init((Fine.GetLengthX() + 1) / 2, (Fine.GetLengthY() + 1) / 2, (Fine.GetLengthZ() + 1) / 2, Fine.GetNodeDiameter() * 2, Fine.GetBottomLeft());
+
+			std::vector<int> Representatives(static_cast<size_t>(Coarse.Num()), InvalidIndex);
+			for(int FineIndex = 0; FineIndex < Fine.Num(); FineIndex++)
+			{
+				const FGridCoord FineCoord = Fine.GetCoord(FineIndex);
+				if(Fine.IsOutOfBounds(FineCoord.X, FineCoord.Y, FineCoord.Z))
+					continue;
+
+				const int CoarseIndex = Coarse.GetIndex(FineCoord.X / 2, FineCoord.Y / 2, FineCoord.Z / 2);
+
+				// Walkable if any child is
+				if(Fine.IsWalkable(FineIndex) && !Coarse.IsWalkable(CoarseIndex))
+				{
+					Coarse.SetWalkable(CoarseIndex, true);
+					Representatives[CoarseIndex] = FineIndex;
+				}
+				else if(Representatives[CoarseIndex] == InvalidIndex)
+				{
+					Representatives[CoarseIndex] = FineIndex;
+				}
+			}
+
+			CoarseLevels.push_back(std::move(Coarse));
+			RepresentativeChildren.push_back(std::move(Representatives));
+		}
+	}
+
+	void FGridLevels::UpdateCells(const std::vector<int>& ChangedBaseCells)
+	{
+		// Cells changed on the level below, a parent only goes on to the next level if it changed as well
+		std::vector<int> Changed = ChangedBaseCells;
+		std::vector<int> Parents;
+		for(int Level = 1; Level < Num() && !Changed.empty(); Level++)
+		{
+			const FOccupancyGrid& Fine = GetLevel(Level - 1);
+			FOccupancyGrid& Coarse = CoarseLevels[Level - 1];
+			std::vector<int>& Representatives = RepresentativeChildren[Level - 1];
+
+			Parents.clear();
+			for(const int FineIndex : Changed)
+			{
+				const FGridCoord FineCoord = Fine.GetCoord(FineIndex);
+				Parents.push_back(Coarse.GetIndex(FineCoord.X / 2, FineCoord.Y / 2, FineCoord.Z / 2));
+			}
+			std::sort(Parents.begin(), Parents.end());
+			Parents.erase(std::unique(Parents.begin(), Parents.end()), Parents.end());
+
+			// Same as Build, which visits the children in index order: the first walkable child or the first child
+			Changed.clear();
+			for(const int CoarseIndex : Parents)
+			{
+				const FGridCoord CoarseCoord = Coarse.GetCoord(CoarseIndex);
+				int FirstChild = InvalidIndex;
+				int FirstWalkableChild = InvalidIndex;
+				for(int x = CoarseCoord.X * 2; x <= CoarseCoord.X * 2 + 1; x++)
+				{
+					for(int y = CoarseCoord.Y * 2; y <= CoarseCoord.Y * 2 + 1; y++)
+					{
+						for(int z = CoarseCoord.Z * 2; z <= CoarseCoord.Z * 2 + 1; z++)
+						{
+							if(Fine.IsOutOfBounds(x, y, z))
+								continue;
+
+							const int Child = Fine.GetIndex(x, y, z);
+							if(FirstChild == InvalidIndex || Child < FirstChild)
+								FirstChild = Child;
+							if(Fine.IsWalkable(Child) && (FirstWalkableChild == InvalidIndex || Child < FirstWalkableChild))
+								FirstWalkableChild = Child;
+						}
+					}
+				}
+
+				const bool bWalkable = FirstWalkableChild != InvalidIndex;
+				Representatives[CoarseIndex] = bWalkable ? FirstWalkableChild : FirstChild;
+				if(bWalkable != Coarse.IsWalkable(CoarseIndex))
+				{
+					Coarse.SetWalkable(CoarseIndex, bWalkable);
+					Changed.push_back(CoarseIndex);
+				}
+			}
+		}
+	}
+
+	int FGridLevels::GetCoarseIndex(const int Level, const int BaseIndex) const
+	{
+		if(Level == 0)
+			return BaseIndex;
+
+		const FGridCoord Coord = BaseGrid->GetCoord(BaseIndex);
+		return GetLevel(Level).GetIndex(Coord.X >> Level, Coord.Y >> Level, Coord.Z >> Level);
+	}
+
+	int FGridLevels::GetBaseIndex(const int Level, const int Index) const
+	{
+		int Current = Index;
+		for(int CurrentLevel = Level; CurrentLevel > 0; CurrentLevel--)
+			Current = RepresentativeChildren[CurrentLevel - 1][Current];
+
+		return Current;
+	}
+
+	size_t FGridLevels::GetMemoryUsage() const
+	{
+		size_t Bytes = 0;
+		for(size_t Level = 0; Level < CoarseLevels.size(); Level++)
+			Bytes += CoarseLevels[Level].Num() * (FOccupancyGrid::GetBytesPerCell() + sizeof(int));
+
+		return Bytes;
+	}
+
+	int SelectGridLevel(const float DistanceFraction, const float* LevelStartFractions, const int NumFractions, const int NumLevels)
+	{
+		int Level = 0;
+		while(Level < NumFractions && DistanceFraction >= LevelStartFractions[Level])
+			Level++;
+
+		return std::min(Level, std::max(NumLevels - 1, 0));
+	}
+}
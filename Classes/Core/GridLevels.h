@@ -0,0 +1,55 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "OccupancyGrid.h"
+
+#include <vector>
+
+namespace AudioCore
+{
+	/*
+	 * Coarser copies of an FOccupancyGrid, each level has cells twice as large along every axis (8 times fewer cells)
+	 * than the one below it. A coarse cell is blocked only if all of its children are blocked, so anything that can be
+	 * reached on a finer level can also be reached on a coarser one (the opposite is not true, a coarse cell can let
+	 * sound through a gap that is smaller than the cell). Level 0 is the grid the levels were built from
+	 */
+	class FGridLevels
+	{
+	public:
+		// Builds NumCoarseLevels levels on top of the base grid. The base grid is not copied and has to outlive this
+		void Build(const FOccupancyGrid& InBaseGrid, const int NumCoarseLevels);
+
+		/* Updates the coarse cells above base grid cells whose walkability has changed, only their parents on each level
+		 * are computed again. The levels are changed in place so pathfinders made for them stay valid */
+		void UpdateCells(const std::vector<int>& ChangedBaseCells);
+
+		// Number of levels including the base grid
+		int Num() const { return BaseGrid ? static_cast<int>(CoarseLevels.size()) + 1 : 0; }
+
+		const FOccupancyGrid& GetLevel(const int Level) const { return Level == 0 ? *BaseGrid : CoarseLevels[Level - 1]; }
+
+		// Index of the cell on the level that contains the base grid cell
+		int GetCoarseIndex(const int Level, const int BaseIndex) const;
+
+		/* Index of a base grid cell inside the cell on the level, walkable if the cell is walkable. Used to map paths
+		 * found on a coarse level back to the base grid */
+		int GetBaseIndex(const int Level, const int Index) const;
+
+		// Bytes used by the coarse levels, the base grid not included
+		size_t GetMemoryUsage() const;
+
+	private:
+		const FOccupancyGrid* BaseGrid = nullptr;
+
+		std::vector<FOccupancyGrid> CoarseLevels;
+
+		// Per coarse level and cell, a child on the level below that is walkable (or the first child if none is)
+		std::vector<std::vector<int>> RepresentativeChildren;
+	};
+
+	/* Picks the level to search for a source at DistanceFraction (distance to the listener divided by the falloff
+	 * distance). LevelStartFractions[i] is the fraction where level i + 1 starts being used, in increasing order. The
+	 * result is clamped to the levels that exist */
+	int SelectGridLevel(const float DistanceFraction, const float* LevelStartFractions, const int NumFractions, const int NumLevels);
+}
@@ -0,0 +1,158 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "GridNearestWalkable.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace AudioCore
+{
+	namespace
+	{
+		constexpr int OffsetRange = FGridNearestWalkable::MaxOffset * 2 + 1;
+
+		// Largest squared distance to a walkable cell that can be stored
+		constexpr int MaxDistanceSquared = FGridNearestWalkable::MaxOffset * FGridNearestWalkable::MaxOffset * 3;
+
+		// Stored for cells without a walkable cell close enough
+		constexpr uint8_t NoOffset = 0xff;
+
+		static_assert(OffsetRange * OffsetRange * OffsetRange <= NoOffset, "Offsets have to fit in a byte");
+
+		// The offset from a cell to its walkable cell as a number from 0 to OffsetRange^3 - 1, walkable cells store (0, 0, 0)
+		constexpr uint8_t EncodeOffset(const int X, const int Y, const int Z)
+		{
+			return static_cast<uint8_t>(((X + FGridNearestWalkable::MaxOffset) * OffsetRange + Y + FGridNearestWalkable::MaxOffset) * OffsetRange + Z + FGridNearestWalkable::MaxOffset);
+		}
+
+		FGridCoord DecodeOffset(const uint8_t Offset)
+		{
+			return { Offset / (OffsetRange * OffsetRange) - FGridNearestWalkable::MaxOffset, Offset / OffsetRange % OffsetRange - FGridNearestWalkable::MaxOffset, Offset % OffsetRange - FGridNearestWalkable::MaxOffset };
+		}
+
+		int GetDistanceSquared(const FGridCoord& Offset) { return Offset.X * Offset.X + Offset.Y * Offset.Y + Offset.Z * Offset.Z; }
+	}
+
+	void FGridNearestWalkable::Build(const FOccupancyGrid& InGrid)
+	{
+		Grid = &InGrid;
+		Offsets.assign(static_cast<size_t>(InGrid.Num()), NoOffset);
+		if(InGrid.Num() == 0)
+			return;
+
+		UpdateArea({ 0, 0, 0 }, { InGrid.GetLengthX() - 1, InGrid.GetLengthY() - 1, InGrid.GetLengthZ() - 1 });
+	}
+
+	void FGridNearestWalkable::UpdateCells(const std::vector<int>& ChangedCells)
+	{
+		if(ChangedCells.empty())
+			return;
+
+		FGridCoord Min = Grid->GetCoord(ChangedCells[0]);
+		FGridCoord Max = Min;
+		for(const int Cell : ChangedCells)
+		{
+			const FGridCoord Coord = Grid->GetCoord(Cell);
+			Min = { std::min(Min.X, Coord.X), std::min(Min.Y, Coord.Y), std::min(Min.Z, Coord.Z) };
+			Max = { std::max(Max.X, Coord.X), std::max(Max.Y, Coord.Y), std::max(Max.Z, Coord.Z) };
+		}
+
+		// Only cells that a changed cell is close enough to be the nearest walkable cell of can change
+		UpdateArea({ std::max(Min.X - MaxOffset, 0), std::max(Min.Y - MaxOffset, 0), std::max(Min.Z - MaxOffset, 0) },
+			{ std::min(Max.X + MaxOffset, Grid->GetLengthX() - 1), std::min(Max.Y + MaxOffset, Grid->GetLengthY() - 1), std::min(Max.Z + MaxOffset, Grid->GetLengthZ() - 1) });
+	}
+
+	int FGridNearestWalkable::GetNearestWalkable(const int Index) const
+	{
+		if(Offsets[Index] == NoOffset)
+			return InvalidIndex;
+
+		const FGridCoord Coord = Grid->GetCoord(Index);
+		const FGridCoord Offset = DecodeOffset(Offsets[Index]);
+		return Grid->GetIndex(Coord.X + Offset.X, Coord.Y + Offset.Y, Coord.Z + Offset.Z);
+	}
+
+	void FGridNearestWalkable::UpdateArea(const FGridCoord& Min, const FGridCoord& Max)
+	{
+		// The walkable cells that can be the nearest of a cell in the area are at most MaxOffset outside of it, and so
+		// are the cells between them and the area that their location spreads through
+		const FGridCoord SpreadMin { std::max(Min.X - MaxOffset, 0), std::max(Min.Y - MaxOffset, 0), std::max(Min.Z - MaxOffset, 0) };
+		const FGridCoord SpreadMax { std::min(Max.X + MaxOffset, Grid->GetLengthX() - 1), std::min(Max.Y + MaxOffset, Grid->GetLengthY() - 1), std::min(Max.Z + MaxOffset, Grid->GetLengthZ() - 1) };
+		const int LengthX = SpreadMax.X - SpreadMin.X + 1;
+		const int LengthY = SpreadMax.Y - SpreadMin.Y + 1;
+		const int LengthZ = SpreadMax.Z - SpreadMin.Z + 1;
+		const auto GetAreaIndex = [&](const int X, const int Y, const int Z) { return (X * LengthY + Y) * LengthZ + Z; };
+
+		AreaOffsets.assign(static_cast<size_t>(LengthX) * LengthY * LengthZ, NoOffset);
+		Buckets.resize(MaxDistanceSquared + 1);
+
+		// Walkable cells are their own nearest cell and spread from there
+		for(int X = 0; X < LengthX; X++)
+		{
+			for(int Y = 0; Y < LengthY; Y++)
+			{
+				for(int Z = 0; Z < LengthZ; Z++)
+				{
+					if(!Grid->IsWalkable(Grid->GetIndex(SpreadMin.X + X, SpreadMin.Y + Y, SpreadMin.Z + Z)))
+						continue;
+
+					AreaOffsets[GetAreaIndex(X, Y, Z)] = EncodeOffset(0, 0, 0);
+					Buckets[0].push_back(GetAreaIndex(X, Y, Z));
+				}
+			}
+		}
+
+		// Cells are spread from in order of the squared distance to their walkable cell, so a cell is reached from its
+		// nearest walkable cell before it spreads further (except when every way there is taken by other walkable cells,
+		// which only happens for cells almost as close to one as the other)
+		for(int Distance = 0; Distance <= MaxDistanceSquared; Distance++)
+		{
+			std::vector<int>& Bucket = Buckets[Distance];
+			for(size_t Entry = 0; Entry < Bucket.size(); Entry++)
+			{
+				const int AreaIndex = Bucket[Entry];
+				const FGridCoord Offset = DecodeOffset(AreaOffsets[AreaIndex]);
+
+				// A closer walkable cell was found after it was pushed
+				if(GetDistanceSquared(Offset) != Distance)
+					continue;
+
+				const int X = AreaIndex / (LengthY * LengthZ), Y = AreaIndex / LengthZ % LengthY, Z = AreaIndex % LengthZ;
+				for(int x = std::max(X - 1, 0); x <= std::min(X + 1, LengthX - 1); x++)
+				{
+					for(int y = std::max(Y - 1, 0); y <= std::min(Y + 1, LengthY - 1); y++)
+					{
+						for(int z = std::max(Z - 1, 0); z <= std::min(Z + 1, LengthZ - 1); z++)
+						{
+							// The same walkable cell seen from the neighbour
+							const FGridCoord NeighbourOffset { Offset.X + X - x, Offset.Y + Y - y, Offset.Z + Z - z };
+							if(std::abs(NeighbourOffset.X) > MaxOffset || std::abs(NeighbourOffset.Y) > MaxOffset || std::abs(NeighbourOffset.Z) > MaxOffset)
+								continue;
+
+							const int NeighbourDistance = GetDistanceSquared(NeighbourOffset);
+							const int NeighbourIndex = GetAreaIndex(x, y, z);
+							const uint8_t OldOffset = AreaOffsets[NeighbourIndex];
+							if(NeighbourDistance < Distance || (OldOffset != NoOffset && GetDistanceSquared(DecodeOffset(OldOffset)) <= NeighbourDistance))
+								continue;
+
+							AreaOffsets[NeighbourIndex] = EncodeOffset(NeighbourOffset.X, NeighbourOffset.Y, NeighbourOffset.Z);
+							Buckets[NeighbourDistance].push_back(NeighbourIndex);
+						}
+					}
+				}
+			}
+
+			Bucket.clear();
+		}
+
+		// Only the area is written back, the cells around it were only there to spread from
+		for(int X = Min.X; X <= Max.X; X++)
+		{
+			for(int Y = Min.Y; Y <= Max.Y; Y++)
+			{
+				for(int Z = Min.Z; Z <= Max.Z; Z++)
+					Offsets[Grid->GetIndex(X, Y, Z)] = AreaOffsets[GetAreaIndex(X - SpreadMin.X, Y - SpreadMin.Y, Z - SpreadMin.Z)];
+			}
+		}
+	}
+}
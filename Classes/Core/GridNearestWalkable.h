@@ -0,0 +1,50 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "OccupancyGrid.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace AudioCore
+{
+	/*
+	 * The nearest walkable cell of every blocked cell close to walkable space, so a listener standing in a blocked cell
+	 * (e.g. inside the edge of a wall) is moved to the walkable cell next to it with one lookup. Every cell stores the
+	 * offset to its nearest walkable cell in one byte, found with a distance transform that spreads each walkable cell's
+	 * location out through the blocked cells around it in order of squared distance. Walkable cells are their own
+	 * nearest cell and blocked cells more than MaxOffset cells away along any axis have none
+	 */
+	class FGridNearestWalkable
+	{
+	public:
+		// How far along each axis the nearest walkable cell can be, small enough for an offset to fit in a byte
+		static constexpr int MaxOffset = 2;
+
+		// Finds the nearest walkable cell of every cell. The grid is not copied and has to outlive this
+		void Build(const FOccupancyGrid& InGrid);
+
+		// Updates the cells whose nearest walkable cell may have changed after the walkability of the cells changed
+		void UpdateCells(const std::vector<int>& ChangedCells);
+
+		// The nearest walkable cell, the cell itself if it is walkable and InvalidIndex if there is none close enough
+		int GetNearestWalkable(const int Index) const;
+
+		size_t GetMemoryUsage() const { return Offsets.capacity() * sizeof(uint8_t); }
+
+	private:
+		const FOccupancyGrid* Grid = nullptr;
+
+		// Offset to the nearest walkable cell per cell, see EncodeOffset
+		std::vector<uint8_t> Offsets;
+
+		// Reused between updates, the offsets of the cells in the area being updated and the cells to spread from sorted
+		// by their squared distance to their walkable cell
+		std::vector<uint8_t> AreaOffsets;
+		std::vector<std::vector<int>> Buckets;
+
+		// Finds the nearest walkable cell again for the cells from Min to Max (inclusive)
+		void UpdateArea(const FGridCoord& Min, const FGridCoord& Max);
+	};
+}
@@ -0,0 +1,190 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "OccupancyGrid.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace AudioCore
+{
+	/*
+	 * Neighbour lookup for an FOccupancyGrid without allocations or per neighbour bounds checks. The linear index offset
+	 * to every neighbour direction is computed once, and every cell stores a mask of which grid faces it touches. A
+	 * direction is skipped only if it points out through one of those faces, so interior cells (mask 0) never skip any.
+	 * With the Bricks cell layout the offset depends on where in its brick a cell is, so there is one set of offsets per
+	 * brick position (the same for every brick). Padding cells have every face set and no neighbours.
+	 * Connectivity is 6 (faces), 18 (faces and edges) or 26 (faces, edges and corners). The directions are in the same
+	 * order as the old -1 to 1 triple loop so searches break ties the same way
+	 */
+	template<int Connectivity>
+	class TGridNeighbours
+	{
+		static_assert(Connectivity == 6 || Connectivity == 18 || Connectivity == 26, "Connectivity has to be 6, 18 or 26");
+
+	public:
+		static constexpr int NumDirections = Connectivity;
+
+		// Bits in a cell's boundary mask, set if the cell is on that face of the grid
+		enum EBoundary : uint8_t
+		{
+			MinX = 1 << 0,
+			MaxX = 1 << 1,
+			MinY = 1 << 2,
+			MaxY = 1 << 3,
+			MinZ = 1 << 4,
+			MaxZ = 1 << 5,
+		};
+
+		TGridNeighbours() {}
+
+		explicit TGridNeighbours(const FOccupancyGrid& Grid) { Init(Grid); }
+
+		void Init(const FOccupancyGrid& Grid)
+		{
+			LengthX = Grid.GetLengthX();
+			LengthY = Grid.GetLengthY();
+			LengthZ = Grid.GetLengthZ();
+			Layout = Grid.GetLayout();
+			PositionMask = Layout == ECellLayout::Bricks ? NumBrickPositions - 1 : 0;
+
+			int Direction = 0;
+			for(int x = -1; x <= 1; x++)
+			{
+				for(int y = -1; y <= 1; y++)
+				{
+					for(int z = -1; z <= 1; z++)
+					{
+						// Number of axes moved along, 1 for faces, 2 for edges and 3 for corners
+						const int NumAxes = (x != 0) + (y != 0) + (z != 0);
+						if(NumAxes == 0 || NumAxes > GetMaxAxes())
+							continue;
+
+						// Moving along an axis is the same as adding that axis' stride to the index
+						if(Layout == ECellLayout::Linear)
+							Offsets[0][Direction] = x * LengthY * LengthZ + z * LengthY + y;
+
+						// The same for every brick, so the offset is measured from a cell in the first brick at each position.
+						// Works for neighbours in bricks before it too since indexes are only added to
+						for(int Position = 0; Layout == ECellLayout::Bricks && Position < NumBrickPositions; Position++)
+						{
+							const int BrickX = Position >> 4, BrickZ = Position >> 2 & 3, BrickY = Position & 3;
+							const int Cell = Grid.GetIndex(BrickX + FOccupancyGrid::BrickSize, BrickY + FOccupancyGrid::BrickSize, BrickZ + FOccupancyGrid::BrickSize);
+							Offsets[Position][Direction] = Grid.GetIndex(BrickX + FOccupancyGrid::BrickSize + x, BrickY + FOccupancyGrid::BrickSize + y, BrickZ + FOccupancyGrid::BrickSize + z) - Cell;
+						}
+
+						DistancesSquared[Direction] = NumAxes;
+						DirectionMasks[Direction] = static_cast<uint8_t>((x < 0 ? MinX : 0) | (x > 0 ? MaxX : 0) |
+							(y < 0 ? MinY : 0) | (y > 0 ? MaxY : 0) | (z < 0 ? MinZ : 0) | (z > 0 ? MaxZ : 0));
+						Direction++;
+					}
+				}
+			}
+
+			BoundaryMasks.resize(static_cast<size_t>(Grid.Num()));
+			for(int Index = 0; Index < Grid.Num(); Index++)
+			{
+				const FGridCoord Coord = Grid.GetCoord(Index);
+				if(Grid.IsOutOfBounds(Coord.X, Coord.Y, Coord.Z))
+				{
+					BoundaryMasks[Index] = MinX | MaxX | MinY | MaxY | MinZ | MaxZ;
+					continue;
+				}
+
+				BoundaryMasks[Index] = static_cast<uint8_t>((Coord.X == 0 ? MinX : 0) | (Coord.X == LengthX - 1 ? MaxX : 0) |
+					(Coord.Y == 0 ? MinY : 0) | (Coord.Y == LengthY - 1 ? MaxY : 0) |
+					(Coord.Z == 0 ? MinZ : 0) | (Coord.Z == LengthZ - 1 ? MaxZ : 0));
+			}
+		}
+
+		// True if the table was built for a grid with the same dimensions
+		bool IsBuiltFor(const FOccupancyGrid& Grid) const
+		{
+			return LengthX == Grid.GetLengthX() && LengthY == Grid.GetLengthY() && LengthZ == Grid.GetLengthZ() &&
+				Layout == Grid.GetLayout() && static_cast<int>(BoundaryMasks.size()) == Grid.Num();
+		}
+
+		uint8_t GetBoundaryMask(const int Index) const { return BoundaryMasks[Index]; }
+
+		// True if moving in the direction from a cell with the boundary mask stays inside the grid
+		bool IsInside(const uint8_t BoundaryMask, const int Direction) const { return (BoundaryMask & DirectionMasks[Direction]) == 0; }
+
+		// The neighbour of the cell in the direction, only valid if IsInside for the cell's boundary mask
+		int GetNeighbour(const int Index, const int Direction) const { return Index + Offsets[Index & PositionMask][Direction]; }
+
+		// Squared length of the direction in cells, 1 for faces, 2 for edges and 3 for corners
+		int GetDistanceSquared(const int Direction) const { return DistancesSquared[Direction]; }
+
+		// Iterates the in bounds neighbour indexes of a cell, use through GetNeighbours in a range based for loop
+		class FIterator
+		{
+		public:
+			FIterator(const TGridNeighbours& InTable, const int InIndex, const uint8_t InMask, const int InDirection)
+				: Table(InTable), Index(InIndex), Mask(InMask), Direction(InDirection)
+			{
+				SkipOutside();
+			}
+
+			int operator*() const { return Table.GetNeighbour(Index, Direction); }
+
+			FIterator& operator++()
+			{
+				Direction++;
+				SkipOutside();
+				return *this;
+			}
+
+			bool operator!=(const FIterator& Other) const { return Direction != Other.Direction; }
+
+		private:
+			const TGridNeighbours& Table;
+			int Index;
+			uint8_t Mask;
+			int Direction;
+
+			void SkipOutside()
+			{
+				while(Direction < NumDirections && !Table.IsInside(Mask, Direction))
+					Direction++;
+			}
+		};
+
+		struct FRange
+		{
+			const TGridNeighbours& Table;
+			int Index;
+			uint8_t Mask;
+
+			FIterator begin() const { return FIterator(Table, Index, Mask, 0); }
+			FIterator end() const { return FIterator(Table, Index, Mask, NumDirections); }
+		};
+
+		// Every in bounds neighbour of the cell, walkable or not
+		FRange GetNeighbours(const int Index) const { return { *this, Index, BoundaryMasks[Index] }; }
+
+		// Bytes used per cell by the table
+		static constexpr int GetBytesPerCell() { return sizeof(uint8_t); }
+
+	private:
+		static constexpr int GetMaxAxes() { return Connectivity == 6 ? 1 : Connectivity == 18 ? 2 : 3; }
+
+		static constexpr int NumBrickPositions = FOccupancyGrid::BrickSize * FOccupancyGrid::BrickSize * FOccupancyGrid::BrickSize;
+
+		int LengthX = 0;
+		int LengthY = 0;
+		int LengthZ = 0;
+
+		ECellLayout Layout = ECellLayout::Linear;
+
+		// Index & PositionMask is the cell's position in its brick, always 0 with the Linear layout
+		int PositionMask = 0;
+
+		// Per brick position (only the first is used with the Linear layout)
+		int Offsets[NumBrickPositions][NumDirections] = {};
+		int DistancesSquared[NumDirections] = {};
+		uint8_t DirectionMasks[NumDirections] = {};
+
+		std::vector<uint8_t> BoundaryMasks;
+	};
+}
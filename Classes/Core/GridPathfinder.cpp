@@ -0,0 +1,201 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "GridPathfinder.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+
+namespace AudioCore
+{
+	namespace
+	{
+		// std heaps are max heaps so the predicate returns true when Left has lower priority. If FCost is the same,
+		// HCost decides, otherwise FCost decides priority
+		template<typename EntryType>
+		bool HasLowerPriority(const EntryType& Left, const EntryType& Right)
+		{
+			if(Left.FCost == Right.FCost)
+				return Left.HCost > Right.HCost;
+
+			return Left.FCost > Right.FCost;
+		}
+	}
+
+	template<int Connectivity>
+	TGridPathfinder<Connectivity>::TGridPathfinder(const FOccupancyGrid& InGrid) : Grid(InGrid)
+	{
+	}
+
+	template<int Connectivity>
+	void TGridPathfinder<Connectivity>::BeginSearch()
+	{
+		if(!Neighbours.IsBuiltFor(Grid))
+			Neighbours.Init(Grid);
+
+		// Same as GetCostToNode for a single step
+		const float Diameter = Grid.GetNodeDiameter();
+		for(int Direction = 0; Direction < Connectivity; Direction++)
+			StepCosts[Direction] = static_cast<int>(Diameter * Diameter * static_cast<float>(Neighbours.GetDistanceSquared(Direction)));
+
+		const size_t NumCells = static_cast<size_t>(Grid.Num());
+		if(GCosts.size() != NumCells)
+		{
+			GCosts.assign(NumCells, 0);
+			Parents.assign(NumCells, InvalidIndex);
+			OpenedGeneration.assign(NumCells, 0);
+			ClosedGeneration.assign(NumCells, 0);
+			Generation = 0;
+		}
+
+		// Generation wrapped around, old stamps could be mistaken for this search's so clear them
+		if(++Generation == 0)
+		{
+			std::fill(OpenedGeneration.begin(), OpenedGeneration.end(), 0);
+			std::fill(ClosedGeneration.begin(), ClosedGeneration.end(), 0);
+			Generation = 1;
+		}
+
+		OpenSet.clear();
+		LastStats = FGridSearchStats();
+		EndDistances = nullptr;
+	}
+
+	template<int Connectivity>
+	bool TGridPathfinder<Connectivity>::FindPath(const int StartIndex, const int EndIndex, std::vector<int>& OutPath)
+	{
+		BeginPath(StartIndex, EndIndex);
+		return ContinuePath(INT_MAX, OutPath) == EGridSearchStatus::Found;
+	}
+
+	template<int Connectivity>
+	void TGridPathfinder<Connectivity>::BeginPath(const int StartIndex, const int EndIndex)
+	{
+		BeginSearch();
+
+		if(Landmarks && Landmarks->Num() > 0 && Landmarks->IsBuiltFor(Grid))
+			EndDistances = Landmarks->GetDistances(EndIndex);
+
+		SearchStart = StartIndex;
+		SearchEnd = EndIndex;
+		Status = EGridSearchStatus::Searching;
+
+		// Reset the start cell and add it to be checked
+		GCosts[StartIndex] = 0;
+		Parents[StartIndex] = InvalidIndex;
+		OpenedGeneration[StartIndex] = Generation;
+		OpenSet.push_back({ 0, 0, 0, StartIndex });
+		LastStats.NodesPushed++;
+	}
+
+	template<int Connectivity>
+	EGridSearchStatus TGridPathfinder<Connectivity>::ContinuePath(const int MaxExpansions, std::vector<int>& OutPath)
+	{
+		if(Status != EGridSearchStatus::Searching)
+			return Status;
+
+		const auto LowerPriority = [](const FOpenEntry& Left, const FOpenEntry& Right) { return HasLowerPriority(Left, Right); };
+
+		// While there are still cells to check and the slice has budget left
+		for(int NumExpanded = 0; !OpenSet.empty() && NumExpanded < MaxExpansions; )
+		{
+			// Remove the cell with highest priority (most promising path)
+			std::pop_heap(OpenSet.begin(), OpenSet.end(), LowerPriority);
+			const FOpenEntry Current = OpenSet.back();
+			OpenSet.pop_back();
+
+			// Already expanded or a cheaper way to it was found after this entry was pushed
+			if(ClosedGeneration[Current.Index] == Generation || Current.GCost != GCosts[Current.Index])
+				continue;
+
+			ClosedGeneration[Current.Index] = Generation;
+			LastStats.NodesExpanded++;
+			NumExpanded++;
+
+			// If we have reached the end cell, a path has been found
+			if(Current.Index == SearchEnd)
+			{
+				BuildPath(SearchStart, SearchEnd, OutPath);
+				Status = EGridSearchStatus::Found;
+				return Status;
+			}
+
+			const uint8_t BoundaryMask = Neighbours.GetBoundaryMask(Current.Index);
+
+			for(int Direction = 0; Direction < Connectivity; Direction++)
+			{
+				if(!Neighbours.IsInside(BoundaryMask, Direction))
+					continue;
+
+				const int Neighbour = Neighbours.GetNeighbour(Current.Index, Direction);
+
+				// Check if it's walkable or has already been visited, if so skip it
+				if(!Grid.IsWalkable(Neighbour) || ClosedGeneration[Neighbour] == Generation)
+					continue;
+
+				const int NewGCostToNeighbour = Current.GCost + StepCosts[Direction];
+
+				// Only update if it has not been added to be checked or the new GCost is lower
+				if(OpenedGeneration[Neighbour] == Generation && NewGCostToNeighbour >= GCosts[Neighbour])
+					continue;
+
+				OpenedGeneration[Neighbour] = Generation;
+				GCosts[Neighbour] = NewGCostToNeighbour;
+
+				// Set its parent to current to keep track of where we came from (shortest path to the cell)
+				Parents[Neighbour] = Current.Index;
+
+				const int HCost = EndDistances ? GetLandmarkCostToNode(Neighbour, SearchEnd) : GetCostToNode(Neighbour, SearchEnd);
+				OpenSet.push_back({ NewGCostToNeighbour + HCost, HCost, NewGCostToNeighbour, Neighbour });
+				std::push_heap(OpenSet.begin(), OpenSet.end(), LowerPriority);
+				LastStats.NodesPushed++;
+			}
+		}
+
+		// Out of budget, the open set and the state arrays are left as they are for the next slice
+		if(!OpenSet.empty())
+			return Status;
+
+		// No path found, clear path and return
+		OutPath.clear();
+		Status = EGridSearchStatus::NotFound;
+		return Status;
+	}
+
+	template<int Connectivity>
+	void TGridPathfinder<Connectivity>::BuildPath(const int StartIndex, const int EndIndex, std::vector<int>& OutPath) const
+	{
+		// Construct the path by following the cells' parents from the end cell. It is not reversed since the path is
+		// searched from the audio source but handled as if it is from the player
+		OutPath.clear();
+		for(int Current = EndIndex; Current != StartIndex; Current = Parents[Current])
+			OutPath.push_back(Current);
+	}
+
+	template<int Connectivity>
+	int TGridPathfinder<Connectivity>::GetCostToNode(const int From, const int To) const
+	{
+		// Squared Euclidean distance, punishes diagonal movement but gives better looking paths than the real distance
+		const FGridCoord FromCoord = Grid.GetCoord(From);
+		const FGridCoord ToCoord = Grid.GetCoord(To);
+		const int DeltaX = ToCoord.X - FromCoord.X;
+		const int DeltaY = ToCoord.Y - FromCoord.Y;
+		const int DeltaZ = ToCoord.Z - FromCoord.Z;
+		const float Diameter = Grid.GetNodeDiameter();
+		return static_cast<int>(Diameter * Diameter * static_cast<float>(DeltaX * DeltaX + DeltaY * DeltaY + DeltaZ * DeltaZ));
+	}
+
+	template<int Connectivity>
+	int TGridPathfinder<Connectivity>::GetLandmarkCostToNode(const int From, const int To) const
+	{
+		const FGridCoord FromCoord = Grid.GetCoord(From);
+		const FGridCoord ToCoord = Grid.GetCoord(To);
+		const int Steps = std::abs(ToCoord.X - FromCoord.X) + std::abs(ToCoord.Y - FromCoord.Y) + std::abs(ToCoord.Z - FromCoord.Z);
+		const float Diameter = Grid.GetNodeDiameter();
+		return static_cast<int>(Diameter * Diameter) * std::max(Steps, Landmarks->GetLowerBound(From, EndDistances));
+	}
+
+	template class TGridPathfinder<6>;
+	template class TGridPathfinder<18>;
+	template class TGridPathfinder<26>;
+}
@@ -0,0 +1,136 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "GridLandmarks.h"
+#include "GridNeighbours.h"
+#include "OccupancyGrid.h"
+
+#include <vector>
+
+namespace AudioCore
+{
+	// Counters from the latest search, used by the benchmarks and the stats
+	struct FGridSearchStats
+	{
+		// Nodes popped from the open set and had their neighbours checked
+		int NodesExpanded = 0;
+
+		// Nodes pushed to the open set (including re-pushes with a lower cost)
+		int NodesPushed = 0;
+	};
+
+	// Where a search that can be spread over several calls is, see TGridPathfinder::ContinuePath
+	enum class EGridSearchStatus : uint8_t
+	{
+		Idle,
+		Searching,
+		Found,
+		NotFound
+	};
+
+	/*
+	 * A* over an FOccupancyGrid. The search state lives in arrays indexed by cell index instead of in the nodes so the
+	 * grid can stay const and several pathfinders can search the same grid. The state arrays are stamped with a search
+	 * generation so they do not have to be cleared between searches. Connectivity is the number of neighbours a cell
+	 * has (6, 18 or 26), see TGridNeighbours. A search does not allocate once the arrays have grown to fit the grid.
+	 * Since the whole search state is kept in the pathfinder, a search can also be split into slices of a limited number
+	 * of expanded nodes with BeginPath and ContinuePath, e.g. to spread a long search over several frames
+	 */
+	template<int Connectivity>
+	class TGridPathfinder
+	{
+	public:
+		explicit TGridPathfinder(const FOccupancyGrid& InGrid);
+
+		/* Finds a path from the start cell to the end cell. The path is returned "backwards", i.e. from the end cell to
+		 * the cell after the start cell, the start cell is not included. Returns false and empties the path if the end
+		 * cell cannot be reached */
+		bool FindPath(const int StartIndex, const int EndIndex, std::vector<int>& OutPath);
+
+		// Starts a search from the start cell to the end cell without expanding any nodes, replaces any unfinished search
+		void BeginPath(const int StartIndex, const int EndIndex);
+
+		/* Expands at most MaxExpansions more nodes of the search started with BeginPath and returns Searching if it has
+		 * not finished by then, the search can be continued by calling it again. Once it returns Found the path is in
+		 * OutPath in the same order as FindPath, OutPath is not touched while searching */
+		EGridSearchStatus ContinuePath(const int MaxExpansions, std::vector<int>& OutPath);
+
+		EGridSearchStatus GetStatus() const { return Status; }
+
+		// Start and end cells of the latest search
+		int GetSearchStart() const { return SearchStart; }
+		int GetSearchEnd() const { return SearchEnd; }
+
+		// Counters of the latest search, summed over every ContinuePath call of it
+		const FGridSearchStats& GetLastStats() const { return LastStats; }
+
+		// Returns an approximate cost to travel between cells (ignoring obstacles)
+		int GetCostToNode(const int From, const int To) const;
+
+		/* Searches with the landmarks' ALT heuristic instead of GetCostToNode if they are built for the grid, nullptr
+		 * goes back to GetCostToNode. The ALT heuristic never overestimates, so paths are the shortest ones (which the
+		 * squared distance does not promise) and far fewer nodes are expanded when walls are in the way */
+		void SetLandmarks(const FGridLandmarks* InLandmarks) { Landmarks = InLandmarks; }
+
+		// Bytes of search state and neighbour data per grid cell
+		static constexpr int GetBytesPerNode() { return sizeof(int) * 2 + sizeof(uint32_t) * 2 + TGridNeighbours<Connectivity>::GetBytesPerCell(); }
+
+	private:
+
+		const FOccupancyGrid& Grid;
+
+		TGridNeighbours<Connectivity> Neighbours;
+
+		// Cost of moving one step in each neighbour direction, see GetCostToNode
+		int StepCosts[Connectivity] = {};
+
+		const FGridLandmarks* Landmarks = nullptr;
+
+		// The landmarks' distances to the end cell this search, nullptr if searching with GetCostToNode
+		const uint16_t* EndDistances = nullptr;
+
+		// Per cell search state
+		std::vector<int> GCosts;
+		std::vector<int> Parents;
+		std::vector<uint32_t> OpenedGeneration; // Cell has been pushed this search if equal to Generation
+		std::vector<uint32_t> ClosedGeneration; // Cell has been expanded this search if equal to Generation
+
+		uint32_t Generation = 0;
+
+		struct FOpenEntry
+		{
+			int FCost;
+			int HCost;
+			int GCost;
+			int Index;
+		};
+
+		// Binary heap, stale entries (a lower cost has been found since they were pushed) are skipped when popped
+		std::vector<FOpenEntry> OpenSet;
+
+		FGridSearchStats LastStats;
+
+		EGridSearchStatus Status = EGridSearchStatus::Idle;
+
+		int SearchStart = InvalidIndex;
+		int SearchEnd = InvalidIndex;
+
+		// Makes sure the state arrays match the grid and starts a new generation
+		void BeginSearch();
+
+		void BuildPath(const int StartIndex, const int EndIndex, std::vector<int>& OutPath) const;
+
+		/* Steps along the axes (the cost without walls when a step costs the number of axes it moves along) or the
+		 * landmarks' bound, whichever is larger, times the cost of a one axis step */
+		int GetLandmarkCostToNode(const int From, const int To) const;
+	};
+
+	// Defined in GridPathfinder.cpp for these connectivities
+	extern template class TGridPathfinder<6>;
+	extern template class TGridPathfinder<18>;
+	extern template class TGridPathfinder<26>;
+
+	// Every neighbour including diagonals, which is what the audio propagation has always searched with
+	using FGridPathfinder = TGridPathfinder<26>;
+}
@@ -0,0 +1,36 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "GridRaycast.h"
+
+namespace AudioCore
+{
+	FGridTraceResult TraceGrid(const FOccupancyGrid& Grid, const FVec3& From, const FVec3& To, const bool bStopAtFirstHit)
+	{
+		FGridTraceResult Result;
+
+		bool bInBlockedRun = false;
+		ForEachCellOnSegment(Grid, From, To, [&](const int Index, const float EnterDistance, const float ExitDistance)
+		{
+			const bool bBlockedCell = Index != InvalidIndex && !Grid.IsWalkable(Index);
+			if(bBlockedCell)
+			{
+				if(!Result.bBlocked)
+				{
+					Result.bBlocked = true;
+					Result.FirstHitDistance = EnterDistance;
+					if(bStopAtFirstHit)
+						return false;
+				}
+
+				if(!bInBlockedRun)
+					Result.NumBlockedRuns++;
+
+				Result.BlockedDistance += ExitDistance - EnterDistance;
+			}
+			bInBlockedRun = bBlockedCell;
+			return true;
+		});
+
+		return Result;
+	}
+}
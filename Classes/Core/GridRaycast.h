@@ -0,0 +1,101 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "OccupancyGrid.h"
+
+#include <cmath>
+#include <limits>
+
+namespace AudioCore
+{
+	// What a ray through the grid hit. Distances are in world units
+	struct FGridTraceResult
+	{
+		bool bBlocked = false;
+
+		// Distance from the start to the first blocked cell
+		float FirstHitDistance = 0;
+
+		// Total distance the ray traveled inside blocked cells, the grid's version of the mesh thickness
+		float BlockedDistance = 0;
+
+		// Number of separate blocked runs along the ray (roughly the number of walls)
+		int NumBlockedRuns = 0;
+	};
+
+	/* Walks the cells along the segment (Amanatides & Woo) and calls Visit(Index, EnterDistance, ExitDistance) for each
+	 * in order, Index is InvalidIndex for cells outside the grid. Distances are from From in world units. Stops early if
+	 * Visit returns false */
+	template<typename VisitFunctionType>
+	void ForEachCellOnSegment(const FOccupancyGrid& Grid, const FVec3& From, const FVec3& To, VisitFunctionType Visit);
+
+	/* Measures how much of the segment is inside blocked cells. The headless tools use it in place of physics line
+	 * traces, cells outside the grid count as open */
+	FGridTraceResult TraceGrid(const FOccupancyGrid& Grid, const FVec3& From, const FVec3& To, const bool bStopAtFirstHit = false);
+
+	inline bool HasLineOfSight(const FOccupancyGrid& Grid, const FVec3& From, const FVec3& To)
+	{
+		return !TraceGrid(Grid, From, To, true).bBlocked;
+	}
+
+	template<typename VisitFunctionType>
+	void ForEachCellOnSegment(const FOccupancyGrid& Grid, const FVec3& From, const FVec3& To, VisitFunctionType Visit)
+	{
+		const float Length = FVec3::Dist(From, To);
+		if(Length <= 0 || Grid.Num() == 0)
+			return;
+
+		// Work in grid space where a cell is one unit big
+		const float InvDiameter = 1.f / Grid.GetNodeDiameter();
+		const FVec3 Start = (From - Grid.GetBottomLeft()) * InvDiameter;
+		const FVec3 Delta = (To - From) * InvDiameter;
+
+		const float StartAxes[3] { Start.X, Start.Y, Start.Z };
+		const float DeltaAxes[3] { Delta.X, Delta.Y, Delta.Z };
+
+		int Cell[3];
+		int Step[3];
+		float NextT[3]; // Ray parameter where the next cell boundary is crossed on each axis
+		float StepT[3]; // Ray parameter change for crossing a whole cell on each axis
+
+		constexpr float Infinity = std::numeric_limits<float>::infinity();
+		for(int Axis = 0; Axis < 3; Axis++)
+		{
+			Cell[Axis] = static_cast<int>(std::floor(StartAxes[Axis]));
+			if(DeltaAxes[Axis] > 0)
+			{
+				Step[Axis] = 1;
+				StepT[Axis] = 1.f / DeltaAxes[Axis];
+				NextT[Axis] = (Cell[Axis] + 1 - StartAxes[Axis]) * StepT[Axis];
+			}
+			else if(DeltaAxes[Axis] < 0)
+			{
+				Step[Axis] = -1;
+				StepT[Axis] = -1.f / DeltaAxes[Axis];
+				NextT[Axis] = (StartAxes[Axis] - Cell[Axis]) * StepT[Axis];
+			}
+			else
+			{
+				Step[Axis] = 0;
+				StepT[Axis] = Infinity;
+				NextT[Axis] = Infinity;
+			}
+		}
+
+		float EnterT = 0;
+		while(EnterT < 1)
+		{
+			const int Axis = NextT[0] < NextT[1] ? (NextT[0] < NextT[2] ? 0 : 2) : (NextT[1] < NextT[2] ? 1 : 2);
+			const float ExitT = NextT[Axis] < 1 ? NextT[Axis] : 1;
+
+			const int Index = Grid.IsOutOfBounds(Cell[0], Cell[1], Cell[2]) ? InvalidIndex : Grid.GetIndex(Cell[0], Cell[1], Cell[2]);
+			if(!Visit(Index, EnterT * Length, ExitT * Length))
+				return;
+
+			EnterT = ExitT;
+			Cell[Axis] += Step[Axis];
+			NextT[Axis] += StepT[Axis];
+		}
+	}
+}
@@ -0,0 +1,256 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "GridRegions.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+namespace AudioCore
+{
+	namespace
+	{
+		// Position in the 3x3x3 block around a cell, the cell itself is 13
+		constexpr int GetBlockPosition(const int X, const int Y, const int Z) { return (X + 1) * 9 + (Y + 1) * 3 + (Z + 1); }
+
+		// Per block position, a bit for every other position next to it (diagonals included)
+		struct FBlockAdjacency
+		{
+			uint32_t Masks[27] = {};
+
+			FBlockAdjacency()
+			{
+				for(int Position = 0; Position < 27; Position++)
+				{
+					const int X = Position / 9 - 1, Y = Position / 3 % 3 - 1, Z = Position % 3 - 1;
+					for(int Other = 0; Other < 27; Other++)
+					{
+						const int OtherX = Other / 9 - 1, OtherY = Other / 3 % 3 - 1, OtherZ = Other % 3 - 1;
+						if(Other != Position && std::abs(OtherX - X) <= 1 && std::abs(OtherY - Y) <= 1 && std::abs(OtherZ - Z) <= 1)
+							Masks[Position] |= 1u << Other;
+					}
+				}
+			}
+		};
+
+		// True if the cells in the mask are connected to each other without going through the center of the block
+		bool IsConnectedInBlock(const uint32_t WalkableMask)
+		{
+			static const FBlockAdjacency Adjacency;
+
+			if(WalkableMask == 0)
+				return true;
+
+			uint32_t Reached = WalkableMask & (~WalkableMask + 1); // Lowest set bit
+			uint32_t Frontier = Reached;
+			while(Frontier)
+			{
+				uint32_t Next = 0;
+				for(uint32_t Bits = Frontier; Bits; Bits &= Bits - 1)
+				{
+					int Position = 0;
+					while(!(Bits & (1u << Position)))
+						Position++;
+
+					Next |= Adjacency.Masks[Position];
+				}
+
+				Frontier = Next & WalkableMask & ~Reached;
+				Reached |= Frontier;
+			}
+
+			return Reached == WalkableMask;
+		}
+	}
+
+	void FGridRegions::Build(const FOccupancyGrid& InGrid)
+	{
+		Grid = &InGrid;
+		Neighbours.Init(InGrid);
+
+		Labels.assign(static_cast<size_t>(InGrid.Num()), InvalidRegion);
+		RegionSizes.clear();
+		FreeRegions.clear();
+		NumLiveRegions = 0;
+
+		for(int Index = 0; Index < InGrid.Num(); Index++)
+		{
+			if(!InGrid.IsWalkable(Index) || Labels[Index] != InvalidRegion)
+				continue;
+
+			const int Region = MakeRegion();
+			RegionSizes[Region] = Fill(Index, Region);
+		}
+	}
+
+	void FGridRegions::UpdateCells(const std::vector<int>& ChangedCells)
+	{
+		// Closed cells are removed one at a time. If the cells around one are still connected to each other without it
+		// (and without the cells removed before it) its region cannot have split, which is the usual case and saves
+		// filling the whole region again
+		std::vector<int> ClosedCells;
+		std::vector<int> ClosedRegions;
+		std::vector<int> SplitRegions;
+		for(const int Index : ChangedCells)
+		{
+			const int Region = Labels[Index];
+			if(Grid->IsWalkable(Index) || Region == InvalidRegion)
+				continue;
+
+			Labels[Index] = InvalidRegion;
+			ClosedCells.push_back(Index);
+			ClosedRegions.push_back(Region);
+
+			if(--RegionSizes[Region] == 0)
+			{
+				ReleaseRegion(Region);
+				continue;
+			}
+
+			const FGridCoord Coord = Grid->GetCoord(Index);
+			uint32_t WalkableMask = 0;
+			for(const int Neighbour : Neighbours.GetNeighbours(Index))
+			{
+				if(Labels[Neighbour] == InvalidRegion)
+					continue;
+
+				const FGridCoord NeighbourCoord = Grid->GetCoord(Neighbour);
+				WalkableMask |= 1u << GetBlockPosition(NeighbourCoord.X - Coord.X, NeighbourCoord.Y - Coord.Y, NeighbourCoord.Z - Coord.Z);
+			}
+
+			if(!IsConnectedInBlock(WalkableMask) && std::find(SplitRegions.begin(), SplitRegions.end(), Region) == SplitRegions.end())
+				SplitRegions.push_back(Region);
+		}
+
+		// Every part of a split region touches one of its closed cells, so the parts are filled from the cells around them
+		// and each gets a new id. Cells already reached by an earlier part's fill have the new id and are skipped
+		for(const int Region : SplitRegions)
+		{
+			// Every cell of it was closed
+			if(RegionSizes[Region] == 0)
+				continue;
+
+			for(size_t i = 0; i < ClosedCells.size(); i++)
+			{
+				if(ClosedRegions[i] != Region)
+					continue;
+
+				for(const int Neighbour : Neighbours.GetNeighbours(ClosedCells[i]))
+				{
+					if(Labels[Neighbour] != Region)
+						continue;
+
+					const int PartRegion = MakeRegion();
+					RegionSizes[PartRegion] = Fill(Neighbour, PartRegion);
+				}
+			}
+
+			ReleaseRegion(Region);
+		}
+
+		// Opened cells join every region around them, the largest one keeps its id so the fewest cells are labelled again
+		for(const int Index : ChangedCells)
+		{
+			if(!Grid->IsWalkable(Index) || Labels[Index] != InvalidRegion)
+				continue;
+
+			int Largest = InvalidRegion;
+			for(const int Neighbour : Neighbours.GetNeighbours(Index))
+			{
+				const int Region = Labels[Neighbour];
+				if(Region != InvalidRegion && (Largest == InvalidRegion || RegionSizes[Region] > RegionSizes[Largest]))
+					Largest = Region;
+			}
+
+			if(Largest == InvalidRegion)
+				Largest = MakeRegion();
+
+			Labels[Index] = Largest;
+			RegionSizes[Largest]++;
+
+			for(const int Neighbour : Neighbours.GetNeighbours(Index))
+			{
+				const int Region = Labels[Neighbour];
+				if(Region == InvalidRegion || Region == Largest)
+					continue;
+
+				RegionSizes[Largest] += Fill(Neighbour, Largest);
+				ReleaseRegion(Region);
+			}
+		}
+	}
+
+	bool FGridRegions::CanReach(const int StartIndex, const int EndIndex) const
+	{
+		if(StartIndex == EndIndex)
+			return true;
+
+		const int EndRegion = Labels[EndIndex];
+		if(EndRegion == InvalidRegion)
+			return false;
+
+		if(Labels[StartIndex] != InvalidRegion)
+			return Labels[StartIndex] == EndRegion;
+
+		// Searches from a blocked cell go straight to its walkable neighbours
+		for(const int Neighbour : Neighbours.GetNeighbours(StartIndex))
+		{
+			if(Labels[Neighbour] == EndRegion)
+				return true;
+		}
+
+		return false;
+	}
+
+	int FGridRegions::MakeRegion()
+	{
+		NumLiveRegions++;
+
+		if(!FreeRegions.empty())
+		{
+			const int Region = FreeRegions.back();
+			FreeRegions.pop_back();
+			RegionSizes[Region] = 0;
+			return Region;
+		}
+
+		RegionSizes.push_back(0);
+		return static_cast<int>(RegionSizes.size()) - 1;
+	}
+
+	void FGridRegions::ReleaseRegion(const int Region)
+	{
+		RegionSizes[Region] = 0;
+		FreeRegions.push_back(Region);
+		NumLiveRegions--;
+	}
+
+	int FGridRegions::Fill(const int StartIndex, const int Region)
+	{
+		// Only cells with the same label as the start cell are filled, blocked cells are never labelled
+		const int FromRegion = Labels[StartIndex];
+		int NumFilled = 0;
+
+		Stack.clear();
+		Stack.push_back(StartIndex);
+		Labels[StartIndex] = Region;
+
+		while(!Stack.empty())
+		{
+			const int Index = Stack.back();
+			Stack.pop_back();
+			NumFilled++;
+
+			for(const int Neighbour : Neighbours.GetNeighbours(Index))
+			{
+				if(Labels[Neighbour] != FromRegion || (FromRegion == InvalidRegion && !Grid->IsWalkable(Neighbour)))
+					continue;
+
+				Labels[Neighbour] = Region;
+				Stack.push_back(Neighbour);
+			}
+		}
+
+		return NumFilled;
+	}
+}
@@ -0,0 +1,69 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "GridNeighbours.h"
+#include "OccupancyGrid.h"
+
+#include <vector>
+
+namespace AudioCore
+{
+	/*
+	 * Labels every group of walkable cells that are connected to each other (with the same 26 neighbours the pathfinder
+	 * uses) with a region id, so whether a path can exist between two cells is a comparison of their ids instead of a
+	 * search that has to visit every reachable cell to find out that there is none. When cells change, only the regions
+	 * they touch are labelled again
+	 */
+	class FGridRegions
+	{
+	public:
+		static constexpr int InvalidRegion = -1;
+
+		// Labels every cell of the grid. The grid is not copied and has to outlive this
+		void Build(const FOccupancyGrid& InGrid);
+
+		/* Updates the labels after the walkability of the cells has changed in the grid. Opened cells merge the regions
+		 * around them and closed cells can split their region, which is labelled again from the cells around them */
+		void UpdateCells(const std::vector<int>& ChangedCells);
+
+		// The cell's region, InvalidRegion if it is blocked
+		int GetRegion(const int Index) const { return Labels[Index]; }
+
+		/* True if a path can exist from the start cell to the end cell. A blocked start cell is searched from like the
+		 * pathfinder does (through its walkable neighbours) but a blocked end cell can never be reached */
+		bool CanReach(const int StartIndex, const int EndIndex) const;
+
+		// Number of regions with at least one cell
+		int NumRegions() const { return NumLiveRegions; }
+
+		size_t GetMemoryUsage() const { return Labels.capacity() * sizeof(int) + RegionSizes.capacity() * sizeof(int); }
+
+	private:
+		const FOccupancyGrid* Grid = nullptr;
+
+		TGridNeighbours<26> Neighbours;
+
+		// Region per cell
+		std::vector<int> Labels;
+
+		// Cells per region id, 0 for ids that are no longer used
+		std::vector<int> RegionSizes;
+
+		// Region ids that no longer have any cells, reused before new ones are made
+		std::vector<int> FreeRegions;
+
+		int NumLiveRegions = 0;
+
+		// Reused between flood fills
+		std::vector<int> Stack;
+
+		int MakeRegion();
+
+		void ReleaseRegion(const int Region);
+
+		/* Gives the cells connected to the start cell that have the same label as it the label Region (unlabelled
+		 * walkable cells if the start cell is unlabelled). Returns the number of cells labelled */
+		int Fill(const int StartIndex, const int Region);
+	};
+}
@@ -0,0 +1,120 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "GridSerialization.h"
+#include "BinaryStream.h"
+
+#include <cstring>
+
+namespace AudioCore
+{
+	namespace
+	{
+		constexpr uint32_t GridFileMagic = 0x44524741; // "AGRD"
+		constexpr uint32_t GridFileVersion = 1;
+
+		// FNV-1a
+		void HashBytes(uint64_t& Hash, const void* Data, const size_t Size)
+		{
+			const uint8_t* Bytes = static_cast<const uint8_t*>(Data);
+			for(size_t i = 0; i < Size; i++)
+			{
+				Hash ^= Bytes[i];
+				Hash *= 0x100000001b3ull;
+			}
+		}
+
+		// Calls Function(Index) for every cell in the Linear layout's order, so files and hashes do not depend on the
+		// grid's layout
+		template<typename FunctionType>
+		void ForEachCellInLinearOrder(const FOccupancyGrid& Grid, FunctionType Function)
+		{
+			for(int X = 0; X < Grid.GetLengthX(); X++)
+			{
+				for(int Z = 0; Z < Grid.GetLengthZ(); Z++)
+				{
+					for(int Y = 0; Y < Grid.GetLengthY(); Y++)
+						Function(Grid.GetIndex(X, Y, Z));
+				}
+			}
+		}
+	}
+
+	uint64_t GetGridHash(const FOccupancyGrid& Grid)
+	{
+		uint64_t Hash = 0xcbf29ce484222325ull;
+
+		const int Lengths[3] { Grid.GetLengthX(), Grid.GetLengthY(), Grid.GetLengthZ() };
+		const float NodeDiameter = Grid.GetNodeDiameter();
+		HashBytes(Hash, Lengths, sizeof(Lengths));
+		HashBytes(Hash, &NodeDiameter, sizeof(NodeDiameter));
+
+		ForEachCellInLinearOrder(Grid, [&](const int Index)
+		{
+			const uint8_t Walkable = Grid.IsWalkable(Index) ? 1 : 0;
+			HashBytes(Hash, &Walkable, 1);
+		});
+
+		return Hash;
+	}
+
+	std::vector<uint8_t> SaveGrid(const FOccupancyGrid& Grid)
+	{
+		FByteWriter Writer;
+		Writer.WriteU32(GridFileMagic);
+		Writer.WriteU32(GridFileVersion);
+		Writer.WriteVarUInt(Grid.GetLengthX());
+		Writer.WriteVarUInt(Grid.GetLengthY());
+		Writer.WriteVarUInt(Grid.GetLengthZ());
+		Writer.WriteFloat(Grid.GetNodeDiameter());
+		Writer.WriteVec3(Grid.GetBottomLeft());
+
+		// 8 cells per byte
+		uint8_t Packed = 0;
+		int i = 0;
+		ForEachCellInLinearOrder(Grid, [&](const int Index)
+		{
+			if(Grid.IsWalkable(Index))
+				Packed |= static_cast<uint8_t>(1 << (i % 8));
+
+			if(i++ % 8 == 7)
+			{
+				Writer.WriteU8(Packed);
+				Packed = 0;
+			}
+		});
+
+		if(i % 8 != 0)
+			Writer.WriteU8(Packed);
+
+		return Writer.GetBuffer();
+	}
+
+	bool LoadGrid(const uint8_t* Data, const size_t Size, FOccupancyGrid& OutGrid, const ECellLayout Layout)
+	{
+		FByteReader Reader(Data, Size);
+		if(Reader.ReadU32() != GridFileMagic || Reader.ReadU32() != GridFileVersion)
+			return false;
+
+		const int LengthX = static_cast<int>(Reader.ReadVarUInt());
+		const int LengthY = static_cast<int>(Reader.ReadVarUInt());
+		const int LengthZ = static_cast<int>(Reader.ReadVarUInt());
+		const float NodeDiameter = Reader.ReadFloat();
+		const FVec3 BottomLeft = Reader.ReadVec3();
+		if(Reader.HasError() || NodeDiameter <= 0)
+			return false;
+
+		OutGrid.Init(LengthX, LengthY, LengthZ, NodeDiameter, BottomLeft, Layout);
+
+		uint8_t Packed = 0;
+		int i = 0;
+		ForEachCellInLinearOrder(OutGrid, [&](const int Index)
+		{
+			if(i % 8 == 0)
+				Packed = Reader.ReadU8();
+
+			OutGrid.SetWalkable(Index, (Packed >> (i++ % 8)) & 1);
+		});
+
+		return !Reader.HasError();
+	}
+}
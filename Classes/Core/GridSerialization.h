@@ -0,0 +1,20 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "OccupancyGrid.h"
+
+#include <vector>
+
+namespace AudioCore
+{
+	// Identifies a baked grid, two grids with the same size, node diameter and walkability give the same hash (whatever
+	// their cell layouts)
+	uint64_t GetGridHash(const FOccupancyGrid& Grid);
+
+	// Writes the grid to a compact buffer (walkability is stored as one bit per cell, in the Linear layout's order)
+	std::vector<uint8_t> SaveGrid(const FOccupancyGrid& Grid);
+
+	// Reads a grid written by SaveGrid into a grid with the layout, returns false if the data is not a valid grid
+	bool LoadGrid(const uint8_t* Data, const size_t Size, FOccupancyGrid& OutGrid, const ECellLayout Layout = ECellLayout::Linear);
+}
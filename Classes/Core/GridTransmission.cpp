@@ -0,0 +1,47 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "GridTransmission.h"
+
+#include "GridRaycast.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace AudioCore
+{
+	void FGridTransmission::Init(const FOccupancyGrid& Grid)
+	{
+		Occlusions.resize(Grid.Num());
+		for(int Index = 0; Index < Grid.Num(); Index++)
+			Occlusions[Index] = Grid.IsWalkable(Index) ? 0 : Opaque;
+	}
+
+	void FGridTransmission::SetOcclusion(const int Index, const float Occlusion)
+	{
+		const float Clamped = std::max(Occlusion, 0.f);
+		Occlusions[Index] = Clamped >= 1 ? Opaque : static_cast<uint8_t>(std::lround(Clamped * FullOcclusion));
+	}
+
+	FTransmissionTraceResult TraceTransmission(const FOccupancyGrid& Grid, const FGridTransmission& Transmission, const FVec3& From, const FVec3& To)
+	{
+		FTransmissionTraceResult Result;
+
+		const float InvDiameter = 1.f / Grid.GetNodeDiameter();
+		ForEachCellOnSegment(Grid, From, To, [&](const int Index, const float EnterDistance, const float ExitDistance)
+		{
+			if(Index == InvalidIndex || Grid.IsWalkable(Index))
+				return true;
+
+			if(!Result.bBlocked)
+			{
+				Result.bBlocked = true;
+				Result.FirstHitDistance = EnterDistance;
+			}
+
+			Result.Occlusion += Transmission.GetOcclusion(Index) * (ExitDistance - EnterDistance) * InvDiameter;
+			return true;
+		});
+
+		return Result;
+	}
+}
@@ -0,0 +1,67 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "OcclusionMath.h"
+#include "OccupancyGrid.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace AudioCore
+{
+	/*
+	 * How much sound every blocked cell lets through, baked from the materials of the meshes that block it. Each cell
+	 * stores the occlusion (see GetOcclusionValue) the sound picks up passing one node diameter through it in one byte.
+	 * Walkable cells let everything through and blocked cells that block all sound, or have no material baked, are
+	 * Opaque. Searches can then go through walls that are cheap enough instead of only around them
+	 */
+	class FGridTransmission
+	{
+	public:
+		static constexpr uint8_t Opaque = 0xff;
+
+		// Occlusion of 1 is stored as this, anything at or above it blocks all sound
+		static constexpr uint8_t FullOcclusion = 0xfe;
+
+		// Every walkable cell lets all sound through and every blocked cell is Opaque
+		void Init(const FOccupancyGrid& Grid);
+
+		bool IsBuilt() const { return !Occlusions.empty(); }
+
+		// Occlusion of sound passing one node diameter through the cell, 1 or more makes it Opaque
+		void SetOcclusion(const int Index, const float Occlusion);
+
+		// Occlusion per node diameter, 1 for Opaque cells
+		float GetOcclusion(const int Index) const { return Occlusions[Index] == Opaque ? 1.f : Occlusions[Index] / static_cast<float>(FullOcclusion); }
+
+		bool IsOpaque(const int Index) const { return Occlusions[Index] == Opaque; }
+
+		size_t GetMemoryUsage() const { return Occlusions.capacity() * sizeof(uint8_t); }
+
+	private:
+		std::vector<uint8_t> Occlusions;
+	};
+
+	// Occlusion of one cell of a mesh with the material value, the same as a trace through a mesh one node diameter thick
+	inline float GetCellOcclusion(const float NodeDiameter, const float MaterialValue, const float MaxMeshDistanceToBlockAllAudio)
+	{
+		return GetOcclusionValue(GetThicknessValue(NodeDiameter, MaxMeshDistanceToBlockAllAudio), MaterialValue);
+	}
+
+	// What a segment through the transmission grid picks up, distances are in world units
+	struct FTransmissionTraceResult
+	{
+		bool bBlocked = false;
+
+		// Distance from the start to the first blocked cell
+		float FirstHitDistance = 0;
+
+		// Summed occlusion of every blocked cell scaled by how far the segment goes through it, unclamped
+		float Occlusion = 0;
+	};
+
+	/* The grid's version of the occlusion component's traces, the occlusion of every wall between the points from the
+	 * baked materials instead of from thickness traces in both directions. Cells outside the grid count as open */
+	FTransmissionTraceResult TraceTransmission(const FOccupancyGrid& Grid, const FGridTransmission& Transmission, const FVec3& From, const FVec3& To);
+}
@@ -0,0 +1,346 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "GridVoxelizer.h"
+#include "ParallelFor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+namespace AudioCore
+{
+	namespace
+	{
+		// Bounds of a closed body's cell centers, rows of cells outside them can not be inside it. Empty by default
+		struct FClosedBody
+		{
+			int FirstTriangle = 0;
+			int NumTriangles = 0;
+			FGridCoord Min { 0, 0, 0 };
+			FGridCoord Max { -1, -1, -1 };
+		};
+
+		FVec3 Cross(const FVec3& A, const FVec3& B)
+		{
+			return FVec3(A.Y * B.Z - A.Z * B.Y, A.Z * B.X - A.X * B.Z, A.X * B.Y - A.Y * B.X);
+		}
+
+		float GetComponent(const FVec3& Vector, const int Axis) { return Axis == 0 ? Vector.X : Axis == 1 ? Vector.Y : Vector.Z; }
+
+		/* Separating axis test of a triangle against a cube (Akenine-Möller). The axes are the cube's faces, the triangle's
+		 * normal and the cross products of their edges. The triangle's bounds were already tested against the cube when
+		 * the cell was picked, which covers the face axes, the other 10 axes only depend on the triangle so the
+		 * triangle's extent along them is computed once for all the cells it is tested against */
+		struct FTriangleAxes
+		{
+			static constexpr int NumAxes = 10;
+
+			FVec3 Axes[NumAxes];
+
+			// The triangle projected on each axis, and the projected half extent of the cube
+			float Min[NumAxes];
+			float Max[NumAxes];
+			float Radius[NumAxes];
+
+			void Init(const FVec3& A, const FVec3& B, const FVec3& C, const float HalfExtent)
+			{
+				const FVec3 Edges[3] { B - A, C - B, A - C };
+				for(int Edge = 0; Edge < 3; Edge++)
+				{
+					// The cross products of the edge with the X, Y and Z axes
+					Axes[Edge * 3] = FVec3(0, -Edges[Edge].Z, Edges[Edge].Y);
+					Axes[Edge * 3 + 1] = FVec3(Edges[Edge].Z, 0, -Edges[Edge].X);
+					Axes[Edge * 3 + 2] = FVec3(-Edges[Edge].Y, Edges[Edge].X, 0);
+				}
+				Axes[9] = Cross(Edges[0], Edges[1]);
+
+				for(int Axis = 0; Axis < NumAxes; Axis++)
+				{
+					const float ProjectedA = A.Dot(Axes[Axis]), ProjectedB = B.Dot(Axes[Axis]), ProjectedC = C.Dot(Axes[Axis]);
+					Min[Axis] = std::min({ ProjectedA, ProjectedB, ProjectedC });
+					Max[Axis] = std::max({ ProjectedA, ProjectedB, ProjectedC });
+					Radius[Axis] = HalfExtent * (std::abs(Axes[Axis].X) + std::abs(Axes[Axis].Y) + std::abs(Axes[Axis].Z));
+				}
+			}
+
+			bool OverlapsBox(const FVec3& BoxCenter) const
+			{
+				for(int Axis = 0; Axis < NumAxes; Axis++)
+				{
+					const float Projected = BoxCenter.Dot(Axes[Axis]);
+					if(Min[Axis] > Projected + Radius[Axis] || Max[Axis] < Projected - Radius[Axis])
+						return false;
+				}
+				return true;
+			}
+		};
+
+		struct FPreparedTriangle
+		{
+			FVec3 A;
+			FVec3 B;
+			FVec3 C;
+
+			// Cells whose boxes the triangle's bounds touch, clamped to the grid
+			FGridCoord Min;
+			FGridCoord Max;
+		};
+
+		// Closest point on the triangle to the origin, by the Voronoi region of the triangle the origin is in (Ericson)
+		FVec3 GetClosestPointToOrigin(const FVec3& A, const FVec3& B, const FVec3& C)
+		{
+			const FVec3 AB = B - A, AC = C - A;
+			const FVec3 AP = A * -1;
+			const float D1 = AB.Dot(AP), D2 = AC.Dot(AP);
+			if(D1 <= 0 && D2 <= 0)
+				return A;
+
+			const FVec3 BP = B * -1;
+			const float D3 = AB.Dot(BP), D4 = AC.Dot(BP);
+			if(D3 >= 0 && D4 <= D3)
+				return B;
+
+			const float VC = D1 * D4 - D3 * D2;
+			if(VC <= 0 && D1 >= 0 && D3 <= 0)
+				return A + AB * (D1 / (D1 - D3));
+
+			const FVec3 CP = C * -1;
+			const float D5 = AB.Dot(CP), D6 = AC.Dot(CP);
+			if(D6 >= 0 && D5 <= D6)
+				return C;
+
+			const float VB = D5 * D2 - D1 * D6;
+			if(VB <= 0 && D2 >= 0 && D6 <= 0)
+				return A + AC * (D2 / (D2 - D6));
+
+			const float VA = D3 * D6 - D5 * D4;
+			if(VA <= 0 && D4 - D3 >= 0 && D5 - D6 >= 0)
+				return B + (C - B) * ((D4 - D3) / ((D4 - D3) + (D5 - D6)));
+
+			const float Denominator = 1 / (VA + VB + VC);
+			return A + AB * (VB * Denominator) + AC * (VC * Denominator);
+		}
+
+		// First and last cell along the axis whose box touches the range, false if none does
+		bool GetCellRange(const float Min, const float Max, const float GridMin, const float NodeDiameter, const int Length, int& OutFirst, int& OutLast)
+		{
+			OutFirst = std::max(static_cast<int>(std::floor((Min - GridMin) / NodeDiameter)), 0);
+			OutLast = std::min(static_cast<int>(std::floor((Max - GridMin) / NodeDiameter)), Length - 1);
+			return OutFirst <= OutLast;
+		}
+
+		// First and last cell along the axis whose center is in the range, false if none is
+		bool GetCenterRange(const float Min, const float Max, const float GridMin, const float NodeDiameter, const int Length, int& OutFirst, int& OutLast)
+		{
+			OutFirst = std::max(static_cast<int>(std::ceil((Min - GridMin) / NodeDiameter - 0.5f)), 0);
+			OutLast = std::min(static_cast<int>(std::floor((Max - GridMin) / NodeDiameter - 0.5f)), Length - 1);
+			return OutFirst <= OutLast;
+		}
+	}
+
+	FVoxelizerStats VoxelizeGrid(const FCollisionMesh& Mesh, FOccupancyGrid& OutGrid, const int NumThreads, const ECellLayout Layout)
+	{
+		FVoxelizerStats Stats;
+		OutGrid.Init(Mesh.LengthX, Mesh.LengthY, Mesh.LengthZ, Mesh.NodeDiameter, Mesh.BottomLeft, Layout);
+		for(int X = 0; X < Mesh.LengthX; X++)
+		{
+			for(int Y = 0; Y < Mesh.LengthY; Y++)
+			{
+				for(int Z = 0; Z < Mesh.LengthZ; Z++)
+					OutGrid.SetWalkable(OutGrid.GetIndex(X, Y, Z), true);
+			}
+		}
+
+		const float NodeDiameter = Mesh.NodeDiameter;
+		const float NodeRadius = NodeDiameter / 2;
+		const FVec3& GridMin = Mesh.BottomLeft;
+		const int Lengths[3] { Mesh.LengthX, Mesh.LengthY, Mesh.LengthZ };
+
+		// Where each body's triangles start in the list of all triangles
+		std::vector<int> FirstTriangles(Mesh.Bodies.size() + 1, 0);
+		for(size_t Body = 0; Body < Mesh.Bodies.size(); Body++)
+			FirstTriangles[Body + 1] = FirstTriangles[Body] + Mesh.Bodies[Body].NumTriangles();
+
+		// Triangles in world space with the cells they can touch, a body per task. Triangles outside the grid touch no
+		// cells but closed bodies still need them to find their insides
+		std::vector<FPreparedTriangle> Triangles(static_cast<size_t>(FirstTriangles.back()));
+		std::vector<FClosedBody> BodyBounds(Mesh.Bodies.size());
+		ParallelFor(static_cast<int>(Mesh.Bodies.size()), NumThreads, [&](const int BodyIndex)
+		{
+			const FCollisionBody& Body = Mesh.Bodies[BodyIndex];
+			FVec3 BodyMin(INFINITY, INFINITY, INFINITY);
+			FVec3 BodyMax(-INFINITY, -INFINITY, -INFINITY);
+
+			for(int Triangle = 0; Triangle < Body.NumTriangles(); Triangle++)
+			{
+				FPreparedTriangle& Prepared = Triangles[FirstTriangles[BodyIndex] + Triangle];
+				Prepared.A = Body.Vertices[Body.Indices[Triangle * 3]];
+				Prepared.B = Body.Vertices[Body.Indices[Triangle * 3 + 1]];
+				Prepared.C = Body.Vertices[Body.Indices[Triangle * 3 + 2]];
+
+				int First[3], Last[3];
+				bool bInGrid = true;
+				for(int Axis = 0; Axis < 3; Axis++)
+				{
+					const float A = GetComponent(Prepared.A, Axis), B = GetComponent(Prepared.B, Axis), C = GetComponent(Prepared.C, Axis);
+					const float Min = std::min(A, std::min(B, C)), Max = std::max(A, std::max(B, C));
+					bInGrid &= GetCellRange(Min, Max, GetComponent(GridMin, Axis), NodeDiameter, Lengths[Axis], First[Axis], Last[Axis]);
+
+					if(Axis == 0)
+						BodyMin.X = std::min(BodyMin.X, Min), BodyMax.X = std::max(BodyMax.X, Max);
+					else if(Axis == 1)
+						BodyMin.Y = std::min(BodyMin.Y, Min), BodyMax.Y = std::max(BodyMax.Y, Max);
+					else
+						BodyMin.Z = std::min(BodyMin.Z, Min), BodyMax.Z = std::max(BodyMax.Z, Max);
+				}
+
+				Prepared.Min = bInGrid ? FGridCoord(First[0], First[1], First[2]) : FGridCoord(0, 0, 0);
+				Prepared.Max = bInGrid ? FGridCoord(Last[0], Last[1], Last[2]) : FGridCoord(-1, -1, -1);
+			}
+
+			FClosedBody& Bounds = BodyBounds[BodyIndex];
+			Bounds.FirstTriangle = FirstTriangles[BodyIndex];
+			Bounds.NumTriangles = Body.NumTriangles();
+
+			int First[3], Last[3];
+			bool bInGrid = Body.bClosed && Bounds.NumTriangles > 0;
+			for(int Axis = 0; Axis < 3; Axis++)
+				bInGrid &= GetCenterRange(GetComponent(BodyMin, Axis), GetComponent(BodyMax, Axis), GetComponent(GridMin, Axis), NodeDiameter, Lengths[Axis], First[Axis], Last[Axis]);
+
+			if(bInGrid)
+			{
+				Bounds.Min = FGridCoord(First[0], First[1], First[2]);
+				Bounds.Max = FGridCoord(Last[0], Last[1], Last[2]);
+			}
+		});
+
+		std::vector<FClosedBody> ClosedBodies;
+		for(const FClosedBody& Bounds : BodyBounds)
+		{
+			if(Bounds.Min.X <= Bounds.Max.X)
+				ClosedBodies.push_back(Bounds);
+		}
+
+		Stats.NumTriangles = static_cast<int>(Triangles.size());
+
+		// The triangles touching each slab of cells along X, every slab is voxelized on its own so threads never write
+		// the same cell
+		std::vector<std::vector<int>> Slabs(static_cast<size_t>(std::max(Mesh.LengthX, 0)));
+		for(int Triangle = 0; Triangle < static_cast<int>(Triangles.size()); Triangle++)
+		{
+			for(int X = Triangles[Triangle].Min.X; X <= Triangles[Triangle].Max.X; X++)
+				Slabs[X].push_back(Triangle);
+		}
+
+		std::atomic<long long> NumBoxTests { 0 };
+		std::atomic<long long> NumSphereTests { 0 };
+		ParallelFor(Mesh.LengthX, NumThreads, [&](const int X)
+		{
+			long long SlabBoxTests = 0;
+			long long SlabSphereTests = 0;
+			FTriangleAxes Axes;
+			for(const int TriangleIndex : Slabs[X])
+			{
+				const FPreparedTriangle& Triangle = Triangles[TriangleIndex];
+
+				// Only set up once a cell needs the test, most triangles of detailed meshes only touch cells that an
+				// earlier triangle blocked
+				bool bHasAxes = false;
+				for(int Y = Triangle.Min.Y; Y <= Triangle.Max.Y; Y++)
+				{
+					for(int Z = Triangle.Min.Z; Z <= Triangle.Max.Z; Z++)
+					{
+						const int Index = OutGrid.GetIndex(X, Y, Z);
+						if(!OutGrid.IsWalkable(Index))
+							continue;
+
+						// The box is the sphere's bounds so a triangle outside it can not touch the sphere
+						const FVec3 Center = OutGrid.CoordToWorld(FGridCoord(X, Y, Z));
+						if(!bHasAxes)
+						{
+							Axes.Init(Triangle.A, Triangle.B, Triangle.C, NodeRadius);
+							bHasAxes = true;
+						}
+
+						SlabBoxTests++;
+						if(!Axes.OverlapsBox(Center))
+							continue;
+
+						SlabSphereTests++;
+						if(GetClosestPointToOrigin(Triangle.A - Center, Triangle.B - Center, Triangle.C - Center).SizeSquared() <= NodeRadius * NodeRadius)
+							OutGrid.SetWalkable(Index, false);
+					}
+				}
+			}
+
+			NumBoxTests += SlabBoxTests;
+			NumSphereTests += SlabSphereTests;
+		});
+
+		Stats.NumBoxTests = NumBoxTests;
+		Stats.NumSphereTests = NumSphereTests;
+
+		/* Cells whose centers are inside a closed body, by counting where a ray along X through the row of centers
+		 * crosses the body. A ray through an edge or vertex would count it twice or not at all, so the ray is moved a
+		 * fraction of a cell off the centers. That only changes the result for centers closer than that to the surface,
+		 * which are blocked by the surface test anyway */
+		const float OffsetY = NodeDiameter * 0.000618f;
+		const float OffsetZ = NodeDiameter * 0.000414f;
+		ParallelFor(ClosedBodies.empty() ? 0 : Mesh.LengthY, NumThreads, [&](const int Y)
+		{
+			std::vector<float> Crossings;
+			for(const FClosedBody& Body : ClosedBodies)
+			{
+				if(Y < Body.Min.Y || Y > Body.Max.Y)
+					continue;
+
+				for(int Z = Body.Min.Z; Z <= Body.Max.Z; Z++)
+				{
+					const float RayY = GridMin.Y + (Y + 0.5f) * NodeDiameter + OffsetY;
+					const float RayZ = GridMin.Z + (Z + 0.5f) * NodeDiameter + OffsetZ;
+
+					Crossings.clear();
+					for(int TriangleIndex = Body.FirstTriangle; TriangleIndex < Body.FirstTriangle + Body.NumTriangles; TriangleIndex++)
+					{
+						const FPreparedTriangle& Triangle = Triangles[TriangleIndex];
+
+						// Is the ray inside the triangle seen along X, the signs of the edge functions all agree
+						const float EdgeAB = (Triangle.B.Y - Triangle.A.Y) * (RayZ - Triangle.A.Z) - (Triangle.B.Z - Triangle.A.Z) * (RayY - Triangle.A.Y);
+						const float EdgeBC = (Triangle.C.Y - Triangle.B.Y) * (RayZ - Triangle.B.Z) - (Triangle.C.Z - Triangle.B.Z) * (RayY - Triangle.B.Y);
+						const float EdgeCA = (Triangle.A.Y - Triangle.C.Y) * (RayZ - Triangle.C.Z) - (Triangle.A.Z - Triangle.C.Z) * (RayY - Triangle.C.Y);
+						if(!((EdgeAB > 0 && EdgeBC > 0 && EdgeCA > 0) || (EdgeAB < 0 && EdgeBC < 0 && EdgeCA < 0)))
+							continue;
+
+						// Where the ray hits the triangle's plane
+						const FVec3 Normal = Cross(Triangle.B - Triangle.A, Triangle.C - Triangle.A);
+						Crossings.push_back(Triangle.A.X - (Normal.Y * (RayY - Triangle.A.Y) + Normal.Z * (RayZ - Triangle.A.Z)) / Normal.X);
+					}
+
+					// Inside between every pair of crossings. A body that is not watertight can leave one unpaired, its
+					// last crossing is ignored
+					std::sort(Crossings.begin(), Crossings.end());
+					for(size_t Crossing = 0; Crossing + 1 < Crossings.size(); Crossing += 2)
+					{
+						int First, Last;
+						if(!GetCenterRange(Crossings[Crossing], Crossings[Crossing + 1], GridMin.X, NodeDiameter, Mesh.LengthX, First, Last))
+							continue;
+
+						for(int X = First; X <= Last; X++)
+							OutGrid.SetWalkable(OutGrid.GetIndex(X, Y, Z), false);
+					}
+				}
+			}
+		});
+
+		for(int X = 0; X < Mesh.LengthX; X++)
+		{
+			for(int Y = 0; Y < Mesh.LengthY; Y++)
+			{
+				for(int Z = 0; Z < Mesh.LengthZ; Z++)
+					Stats.NumBlockedCells += OutGrid.IsWalkable(OutGrid.GetIndex(X, Y, Z)) ? 0 : 1;
+			}
+		}
+
+		return Stats;
+	}
+}
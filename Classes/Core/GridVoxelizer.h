@@ -0,0 +1,31 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CollisionMesh.h"
+#include "OccupancyGrid.h"
+
+namespace AudioCore
+{
+	// What a voxelization did, to see where the time went
+	struct FVoxelizerStats
+	{
+		int NumTriangles = 0;
+
+		// Cell boxes tested against a triangle and how many of them needed the exact sphere test after
+		long long NumBoxTests = 0;
+		long long NumSphereTests = 0;
+
+		int NumBlockedCells = 0;
+	};
+
+	/*
+	 * Bakes the mesh's grid from its triangles without the physics engine. A cell blocks audio if a triangle is within
+	 * the node radius of its center or its center is inside a closed body, which is what AMapGrid's sphere overlap at
+	 * the node finds for the same collision. Every triangle is only tested against the cells its bounds touch, first
+	 * with a triangle/box overlap test against the cell (the box around the node's sphere) and then with the exact
+	 * distance. The grid is split into slabs along X (and rows along Y for the insides of closed bodies) that are
+	 * voxelized on up to NumThreads threads
+	 */
+	FVoxelizerStats VoxelizeGrid(const FCollisionMesh& Mesh, FOccupancyGrid& OutGrid, const int NumThreads, const ECellLayout Layout = ECellLayout::Linear);
+}
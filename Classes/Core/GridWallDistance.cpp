@@ -0,0 +1,238 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "GridWallDistance.h"
+#include "GridRaycast.h"
+#include "ParallelFor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace AudioCore
+{
+	namespace
+	{
+		constexpr float Infinity = std::numeric_limits<float>::infinity();
+
+		// Length of a cell's diagonal in steps of the stored distances, a bit longer so a step never ends exactly on a
+		// blocked cell's corner
+		constexpr int StepMargin = 14;
+
+		// Cells a step has to skip to be worth starting the cell walk again after it, closer to walls the walk goes on
+		constexpr int MinStep = 2 * FGridWallDistance::StepsPerCell;
+
+		// Scratch of the transform along one line, every task has its own
+		struct FLineScratch
+		{
+			std::vector<int> Indexes;
+			std::vector<float> Values;
+			std::vector<float> Output;
+
+			// The cells whose parabolas make up the lower envelope, and where each one's part of it starts
+			std::vector<int> Parabolas;
+			std::vector<float> Starts;
+
+			explicit FLineScratch(const int Length) : Indexes(Length), Values(Length), Output(Length), Parabolas(Length), Starts(Length + 1) {}
+		};
+
+		/* The 1D squared distance transform of Values into Output: the lower envelope of the parabolas rooted at every cell
+		 * with a finite value, each cell then reads the parabola it is under. Cells without a finite value are skipped so
+		 * no infinities are subtracted */
+		void TransformLine(FLineScratch& Scratch, const int Length)
+		{
+			const std::vector<float>& Values = Scratch.Values;
+			const auto GetIntersection = [&](const int Q, const int V)
+			{
+				return ((Values[Q] + static_cast<float>(Q * Q)) - (Values[V] + static_cast<float>(V * V))) / static_cast<float>(2 * Q - 2 * V);
+			};
+
+			int Last = -1;
+			for(int Q = 0; Q < Length; Q++)
+			{
+				if(Values[Q] == Infinity)
+					continue;
+
+				if(Last < 0)
+				{
+					Last = 0;
+					Scratch.Parabolas[0] = Q;
+					Scratch.Starts[0] = -Infinity;
+					Scratch.Starts[1] = Infinity;
+					continue;
+				}
+
+				// Parabolas the new one is below everywhere they were the lowest are removed from the envelope
+				float Start = GetIntersection(Q, Scratch.Parabolas[Last]);
+				while(Start <= Scratch.Starts[Last])
+				{
+					Last--;
+					Start = GetIntersection(Q, Scratch.Parabolas[Last]);
+				}
+
+				Last++;
+				Scratch.Parabolas[Last] = Q;
+				Scratch.Starts[Last] = Start;
+				Scratch.Starts[Last + 1] = Infinity;
+			}
+
+			if(Last < 0)
+			{
+				std::fill(Scratch.Output.begin(), Scratch.Output.begin() + Length, Infinity);
+				return;
+			}
+
+			int Parabola = 0;
+			for(int Q = 0; Q < Length; Q++)
+			{
+				while(Scratch.Starts[Parabola + 1] < static_cast<float>(Q))
+					Parabola++;
+
+				const int Offset = Q - Scratch.Parabolas[Parabola];
+				Scratch.Output[Q] = static_cast<float>(Offset * Offset) + Values[Scratch.Parabolas[Parabola]];
+			}
+		}
+
+		// Runs the transform over every line of cells along the axis, a task per plane of lines so tasks write different cells
+		void TransformAxis(const FOccupancyGrid& Grid, const int Axis, const int NumThreads, std::vector<float>& InOutSquared)
+		{
+			const int Lengths[3] { Grid.GetLengthX(), Grid.GetLengthY(), Grid.GetLengthZ() };
+			const int PlaneAxis = Axis == 0 ? 1 : 0;
+			const int LineAxis = 3 - Axis - PlaneAxis;
+			const int Length = Lengths[Axis];
+
+			ParallelFor(Lengths[PlaneAxis], NumThreads, [&](const int Plane)
+			{
+				FLineScratch Scratch(Length);
+				int Coord[3];
+				Coord[PlaneAxis] = Plane;
+				for(int Line = 0; Line < Lengths[LineAxis]; Line++)
+				{
+					Coord[LineAxis] = Line;
+					for(int i = 0; i < Length; i++)
+					{
+						Coord[Axis] = i;
+						Scratch.Indexes[i] = Grid.GetIndex(Coord[0], Coord[1], Coord[2]);
+						Scratch.Values[i] = InOutSquared[Scratch.Indexes[i]];
+					}
+
+					TransformLine(Scratch, Length);
+
+					for(int i = 0; i < Length; i++)
+						InOutSquared[Scratch.Indexes[i]] = Scratch.Output[i];
+				}
+			});
+		}
+
+		// Clips the segment to the grid's box, as fractions of the segment. Returns false if it misses the box
+		bool ClipToGrid(const FOccupancyGrid& Grid, const FVec3& From, const FVec3& To, float& OutEnter, float& OutExit)
+		{
+			const FVec3 Min = Grid.GetBottomLeft();
+			const FVec3 Max = Min + FVec3(static_cast<float>(Grid.GetLengthX()), static_cast<float>(Grid.GetLengthY()), static_cast<float>(Grid.GetLengthZ())) * Grid.GetNodeDiameter();
+			const float Starts[3] { From.X, From.Y, From.Z };
+			const float Deltas[3] { To.X - From.X, To.Y - From.Y, To.Z - From.Z };
+			const float Mins[3] { Min.X, Min.Y, Min.Z };
+			const float Maxs[3] { Max.X, Max.Y, Max.Z };
+
+			OutEnter = 0;
+			OutExit = 1;
+			for(int Axis = 0; Axis < 3; Axis++)
+			{
+				if(Deltas[Axis] == 0)
+				{
+					if(Starts[Axis] < Mins[Axis] || Starts[Axis] > Maxs[Axis])
+						return false;
+					continue;
+				}
+
+				const float T0 = (Mins[Axis] - Starts[Axis]) / Deltas[Axis];
+				const float T1 = (Maxs[Axis] - Starts[Axis]) / Deltas[Axis];
+				OutEnter = std::max(OutEnter, std::min(T0, T1));
+				OutExit = std::min(OutExit, std::max(T0, T1));
+			}
+
+			return OutEnter <= OutExit;
+		}
+	}
+
+	void FGridWallDistance::Build(const FOccupancyGrid& InGrid, const int NumThreads)
+	{
+		Grid = &InGrid;
+
+		// Squared distances in cells, the padding of the brick layout is never read
+		std::vector<float> Squared(static_cast<size_t>(InGrid.Num()));
+		for(int Index = 0; Index < InGrid.Num(); Index++)
+			Squared[Index] = InGrid.IsWalkable(Index) ? Infinity : 0.f;
+
+		// Y is the innermost ordering of the linear layout, so the first pass reads the grid in order
+		TransformAxis(InGrid, 1, NumThreads, Squared);
+		TransformAxis(InGrid, 2, NumThreads, Squared);
+		TransformAxis(InGrid, 0, NumThreads, Squared);
+
+		// Rounded down so a step from the stored distance never goes further than the real one allows
+		Distances.resize(Squared.size());
+		for(size_t Index = 0; Index < Squared.size(); Index++)
+			Distances[Index] = static_cast<uint16_t>(std::floor(std::min(std::sqrt(Squared[Index]), MaxDistance) * StepsPerCell));
+	}
+
+	float FGridWallDistance::GetDistanceToWall(const FVec3& WorldLoc) const
+	{
+		return std::max(GetDistance(Grid->WorldToIndex(WorldLoc)) - Grid->GetNodeRadius(), 0.f);
+	}
+
+	bool FGridWallDistance::HasLineOfSight(const FVec3& From, const FVec3& To) const
+	{
+		// Outside the grid is open, only the part inside it can be blocked
+		float Enter, Exit;
+		const float Length = FVec3::Dist(From, To);
+		if(Length <= 0 || Grid->Num() == 0 || !ClipToGrid(*Grid, From, To, Enter, Exit))
+			return true;
+
+		const FVec3 Direction = (To - From) * (1.f / Length);
+		const FVec3 ClippedEnd = From + Direction * (Exit * Length);
+		const float WorldPerStep = Grid->GetNodeDiameter() * CellsPerStep;
+		const float End = Exit * Length;
+		float Traveled = Enter * Length;
+		while(Traveled < End)
+		{
+			/* Both this cell's center and the center of any cell within the step are at most half a diagonal from the
+			 * segment, so no cell within the step can be closer to this cell than its distance to the nearest blocked one */
+			const FVec3 Location = From + Direction * Traveled;
+			const int Step = Distances[Grid->WorldToIndex(Location)] - StepMargin;
+			if(Step >= MinStep)
+			{
+				Traveled += Step * WorldPerStep;
+				continue;
+			}
+
+			// Too close to a wall to skip anything, walk cell by cell until a cell is far enough from walls to step from
+			bool bBlocked = false;
+			float Walked = End - Traveled;
+			ForEachCellOnSegment(*Grid, Location, ClippedEnd, [&](const int Index, const float EnterDistance, const float)
+			{
+				if(Index == InvalidIndex)
+					return true;
+
+				if(!Grid->IsWalkable(Index))
+				{
+					bBlocked = true;
+					return false;
+				}
+
+				// The step is valid from anywhere in the cell, so it is taken from where the segment enters it
+				const int CellStep = Distances[Index] - StepMargin;
+				if(CellStep < MinStep)
+					return true;
+
+				Walked = EnterDistance + CellStep * WorldPerStep;
+				return false;
+			});
+
+			if(bBlocked)
+				return false;
+
+			Traveled += Walked;
+		}
+
+		return true;
+	}
+}
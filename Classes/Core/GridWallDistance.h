@@ -0,0 +1,56 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "OccupancyGrid.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace AudioCore
+{
+	/*
+	 * The Euclidean distance from every cell to the nearest blocked cell, baked with an exact distance transform
+	 * (Felzenszwalb & Huttenlocher) that runs one pass along each axis. Every line of cells along the axis is
+	 * independent of the others, so each pass is spread over threads one plane of lines at a time. The distance is
+	 * between cell centers, 0 for blocked cells, and cells outside the grid count as open like TraceGrid does. Every
+	 * cell stores it in two bytes as eighths of a cell rounded down (floats made the traces miss the cache far more
+	 * often than the grid's own data does), and every distance is MaxDistance if no cell is blocked
+	 */
+	class FGridWallDistance
+	{
+	public:
+		static constexpr int StepsPerCell = 8;
+
+		// Furthest distance in cells that can be stored
+		static constexpr float MaxDistance = 65535.f / StepsPerCell;
+
+		// Bakes the distance of every cell. The grid is not copied and has to outlive this
+		void Build(const FOccupancyGrid& InGrid, const int NumThreads);
+
+		bool IsBuilt() const { return Grid != nullptr; }
+
+		// In world units, see MaxDistance
+		float GetDistance(const int Index) const { return Distances[Index] * CellsPerStep * Grid->GetNodeDiameter(); }
+
+		/* Roughly how far the location is from the surface of the nearest wall, the distance of its cell less half a cell
+		 * since the wall is somewhere in the blocked cell. Locations outside the grid use the closest cell's */
+		float GetDistanceToWall(const FVec3& WorldLoc) const;
+
+		/* Same answer as AudioCore::HasLineOfSight, but away from walls the segment is sphere traced: every cell's
+		 * distance guarantees there is no blocked cell within it, so the whole stretch is skipped in one step. Only the
+		 * stretches close to walls are walked cell by cell */
+		bool HasLineOfSight(const FVec3& From, const FVec3& To) const;
+
+		size_t GetMemoryUsage() const { return Distances.capacity() * sizeof(uint16_t); }
+
+	private:
+		static constexpr float CellsPerStep = 1.f / StepsPerCell;
+
+		const FOccupancyGrid* Grid = nullptr;
+
+		// Distance to the nearest blocked cell per cell in eighths of a cell, at most MaxDistance
+		std::vector<uint16_t> Distances;
+	};
+}
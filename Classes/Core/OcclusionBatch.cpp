@@ -0,0 +1,190 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "OcclusionBatch.h"
+#include "OcclusionMath.h"
+#include "SimdMath.h"
+
+namespace AudioCore
+{
+	using namespace Simd;
+
+	void FOcclusionBatch::Reset()
+	{
+		HitTravelDistances.clear();
+		HitMaterialValues.clear();
+		HitOcclusionValues.clear();
+		HitStarts.clear();
+		DistancesToMesh.clear();
+		TotalOcclusionValues.clear();
+		Volumes.clear();
+		LowPassFrequencies.clear();
+	}
+
+	int FOcclusionBatch::AddSource(const float DistanceToMesh)
+	{
+		HitStarts.push_back(NumHits());
+		DistancesToMesh.push_back(DistanceToMesh);
+		return Num() - 1;
+	}
+
+	void FOcclusionBatch::AddHit(const float RayTravelDistance, const float MaterialValue)
+	{
+		HitTravelDistances.push_back(RayTravelDistance);
+		HitMaterialValues.push_back(MaterialValue);
+	}
+
+	void FOcclusionBatch::SumHitsPerSource()
+	{
+		// Sources have few hits each so the reduction stays scalar
+		TotalOcclusionValues.resize(Num());
+		for(int Source = 0; Source < Num(); Source++)
+		{
+			const int HitEnd = Source + 1 < Num() ? HitStarts[Source + 1] : NumHits();
+			float Total = 0;
+			for(int Hit = HitStarts[Source]; Hit < HitEnd; Hit++)
+				Total += HitOcclusionValues[Hit];
+			TotalOcclusionValues[Source] = Total;
+		}
+	}
+
+	void FOcclusionBatch::Compute(const FOcclusionSettings& Settings)
+	{
+		const FFloat4 Zero = Set1(0);
+		const FFloat4 One = Set1(1);
+
+		// Occlusion value per hit, see GetThicknessValue and GetOcclusionValue
+		HitOcclusionValues.resize(NumHits());
+		const FFloat4 MaxMeshDistance = Set1(Settings.MaxMeshDistanceToBlockAllAudio);
+		int Hit = 0;
+		for(; Hit + Width <= NumHits(); Hit += Width)
+		{
+			const FFloat4 Thickness = Clamp(Div(Load(&HitTravelDistances[Hit]), MaxMeshDistance), Zero, One);
+			Store(&HitOcclusionValues[Hit], Clamp(Mul(Thickness, Load(&HitMaterialValues[Hit])), Zero, One));
+		}
+		for(; Hit < NumHits(); Hit++)
+		{
+			const float Thickness = GetThicknessValue(HitTravelDistances[Hit], Settings.MaxMeshDistanceToBlockAllAudio);
+			HitOcclusionValues[Hit] = GetOcclusionValue(Thickness, HitMaterialValues[Hit]);
+		}
+
+		SumHitsPerSource();
+
+		// Volume and low pass frequency per source, see GetOccludedVolume, GetLowPassValue and GetLowPassFrequency.
+		// Sources that skip the low pass this frame get a value too, it is just not applied
+		Volumes.resize(Num());
+		LowPassFrequencies.resize(Num());
+		const FFloat4 MinVolume = Set1(0.01f);
+		const FFloat4 WallOffset = Set1(Settings.DistanceToWallOffset);
+		const FFloat4 StopDistance = Set1(Settings.DistanceToWallToStopAddingLowPass);
+		const FFloat4 MinFrequency = Set1(200.f);
+		const FFloat4 MaxFrequency = Set1(Settings.MaxLowPassFrequency);
+		int Source = 0;
+		for(; Source + Width <= Num(); Source += Width)
+		{
+			const FFloat4 Total = Clamp(Load(&TotalOcclusionValues[Source]), Zero, One);
+			Store(&Volumes[Source], Clamp(Sub(One, Total), MinVolume, One));
+
+			const FFloat4 LowPassValue = Div(Clamp(Sub(Load(&DistancesToMesh[Source]), WallOffset), Zero, StopDistance), StopDistance);
+			Store(&LowPassFrequencies[Source], Clamp(Mul(MaxFrequency, LowPassValue), MinFrequency, MaxFrequency));
+		}
+		for(; Source < Num(); Source++)
+		{
+			Volumes[Source] = GetOccludedVolume(TotalOcclusionValues[Source]);
+			const float LowPassValue = GetLowPassValue(DistancesToMesh[Source], Settings.DistanceToWallOffset, Settings.DistanceToWallToStopAddingLowPass);
+			LowPassFrequencies[Source] = AudioCore::GetLowPassFrequency(LowPassValue, Settings.MaxLowPassFrequency);
+		}
+	}
+
+	void FOcclusionBatch::ComputeScalar(const FOcclusionSettings& Settings)
+	{
+		HitOcclusionValues.resize(NumHits());
+		for(int Hit = 0; Hit < NumHits(); Hit++)
+		{
+			const float Thickness = GetThicknessValue(HitTravelDistances[Hit], Settings.MaxMeshDistanceToBlockAllAudio);
+			HitOcclusionValues[Hit] = GetOcclusionValue(Thickness, HitMaterialValues[Hit]);
+		}
+
+		SumHitsPerSource();
+
+		Volumes.resize(Num());
+		LowPassFrequencies.resize(Num());
+		for(int Source = 0; Source < Num(); Source++)
+		{
+			Volumes[Source] = GetOccludedVolume(TotalOcclusionValues[Source]);
+			const float LowPassValue = GetLowPassValue(DistancesToMesh[Source], Settings.DistanceToWallOffset, Settings.DistanceToWallToStopAddingLowPass);
+			LowPassFrequencies[Source] = AudioCore::GetLowPassFrequency(LowPassValue, Settings.MaxLowPassFrequency);
+		}
+	}
+
+	void FPropagatedVolumeBatch::Reset()
+	{
+		CurrentVolumes.clear();
+		PathDistances.clear();
+		FalloffDistances.clear();
+		RemovedMasks.clear();
+		NewVolumes.clear();
+	}
+
+	int FPropagatedVolumeBatch::AddPropagated(const float CurrentVolume, const int PathSize, const float NodeDiameter, const float FalloffDistance)
+	{
+		CurrentVolumes.push_back(CurrentVolume);
+
+		// Truncated like GetPropagatedVolume does
+		PathDistances.push_back(static_cast<float>(static_cast<int>(PathSize * NodeDiameter)));
+		FalloffDistances.push_back(FalloffDistance);
+		RemovedMasks.push_back(0);
+		return Num() - 1;
+	}
+
+	int FPropagatedVolumeBatch::AddRemoved(const float CurrentVolume)
+	{
+		CurrentVolumes.push_back(CurrentVolume);
+		PathDistances.push_back(0);
+		FalloffDistances.push_back(1);
+		RemovedMasks.push_back(1);
+		return Num() - 1;
+	}
+
+	void FPropagatedVolumeBatch::Compute(const float DeltaTime, const float InterpSpeed)
+	{
+		NewVolumes.resize(Num());
+
+		const FFloat4 Zero = Set1(0);
+		const FFloat4 One = Set1(1);
+		const FFloat4 Half = Set1(0.5f);
+		const FFloat4 Removed = Set1(RemovedVolume);
+		const FFloat4 Step = Set1(InterpSpeed * DeltaTime);
+		const FFloat4 NegativeStep = Set1(-InterpSpeed * DeltaTime);
+		const FFloat4 SnapDistanceSquared = Set1(1.e-8f);
+
+		int i = 0;
+		for(; i + Width <= Num(); i += Width)
+		{
+			// See GetPropagatedVolume
+			const FFloat4 PathTarget = Sub(One, Clamp(Div(Load(&PathDistances[i]), Load(&FalloffDistances[i])), Zero, One));
+			const FFloat4 Target = Select(CompareLess(Half, Load(&RemovedMasks[i])), Removed, PathTarget);
+
+			// See InterpConstantTo
+			const FFloat4 Current = Load(&CurrentVolumes[i]);
+			const FFloat4 Dist = Sub(Target, Current);
+			const FFloat4 Interpolated = Add(Current, Clamp(Dist, NegativeStep, Step));
+			Store(&NewVolumes[i], Select(CompareLess(Mul(Dist, Dist), SnapDistanceSquared), Target, Interpolated));
+		}
+
+		for(; i < Num(); i++)
+		{
+			const float Target = RemovedMasks[i] > 0.5f ? RemovedVolume : 1 - std::clamp(PathDistances[i] / FalloffDistances[i], 0.f, 1.f);
+			NewVolumes[i] = InterpConstantTo(CurrentVolumes[i], Target, DeltaTime, InterpSpeed);
+		}
+	}
+
+	void FPropagatedVolumeBatch::ComputeScalar(const float DeltaTime, const float InterpSpeed)
+	{
+		NewVolumes.resize(Num());
+		for(int i = 0; i < Num(); i++)
+		{
+			const float Target = RemovedMasks[i] > 0.5f ? RemovedVolume : 1 - std::clamp(PathDistances[i] / FalloffDistances[i], 0.f, 1.f);
+			NewVolumes[i] = InterpConstantTo(CurrentVolumes[i], Target, DeltaTime, InterpSpeed);
+		}
+	}
+}
@@ -0,0 +1,98 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include <vector>
+
+namespace AudioCore
+{
+	// Same defaults as UAudioOcclusionComponent
+	struct FOcclusionSettings
+	{
+		float MaxMeshDistanceToBlockAllAudio = 900.f;
+		float DistanceToWallOffset = 60.f;
+		float DistanceToWallToStopAddingLowPass = 700.f;
+		float MaxLowPassFrequency = 17000.f;
+	};
+
+	/*
+	 * Structure of arrays batch of every occluded source and its trace hits for one frame. The traces fill it, Compute
+	 * runs the math from OcclusionMath.h four sources/hits at a time and the results are applied to the audio
+	 * components afterwards in one pass. ComputeScalar runs the same math one call at a time, kept as reference and
+	 * for the benchmarks. Reset keeps the allocations so a steady state frame does not allocate
+	 */
+	class FOcclusionBatch
+	{
+	public:
+		void Reset();
+
+		/* Adds a source and returns its index in the batch. DistanceToMesh is the listener's distance to the first
+		 * blocking mesh, pass a negative value if the low pass should not be updated this frame */
+		int AddSource(const float DistanceToMesh);
+
+		// Adds a hit to the latest added source
+		void AddHit(const float RayTravelDistance, const float MaterialValue);
+
+		void Compute(const FOcclusionSettings& Settings);
+
+		void ComputeScalar(const FOcclusionSettings& Settings);
+
+		int Num() const { return static_cast<int>(DistancesToMesh.size()); }
+
+		int NumHits() const { return static_cast<int>(HitTravelDistances.size()); }
+
+		float GetVolume(const int Source) const { return Volumes[Source]; }
+
+		bool ShouldUpdateLowPass(const int Source) const { return DistancesToMesh[Source] >= 0; }
+
+		float GetLowPassFrequency(const int Source) const { return LowPassFrequencies[Source]; }
+
+	private:
+		// Per hit
+		std::vector<float> HitTravelDistances;
+		std::vector<float> HitMaterialValues;
+		std::vector<float> HitOcclusionValues;
+
+		// Per source, the source's hits are [HitStarts[i], HitStarts[i + 1]) with the end of the last one being NumHits
+		std::vector<int> HitStarts;
+		std::vector<float> DistancesToMesh;
+		std::vector<float> TotalOcclusionValues;
+		std::vector<float> Volumes;
+		std::vector<float> LowPassFrequencies;
+
+		void SumHitsPerSource();
+	};
+
+	/*
+	 * Batch of propagated sounds whose volume is interpolated towards a target each frame. The target comes from the
+	 * path length, or is near silent for propagated sounds that are being removed (see
+	 * USoundPropagationComponent::SetPropagatedSoundVolume and RemovePropagatedSound)
+	 */
+	class FPropagatedVolumeBatch
+	{
+	public:
+		void Reset();
+
+		int AddPropagated(const float CurrentVolume, const int PathSize, const float NodeDiameter, const float FalloffDistance);
+
+		int AddRemoved(const float CurrentVolume);
+
+		void Compute(const float DeltaTime, const float InterpSpeed);
+
+		void ComputeScalar(const float DeltaTime, const float InterpSpeed);
+
+		int Num() const { return static_cast<int>(CurrentVolumes.size()); }
+
+		float GetVolume(const int Index) const { return NewVolumes[Index]; }
+
+		// The volume removed sounds fade to, not zero since UE would stop them and they would go out of sync
+		static constexpr float RemovedVolume = 0.01f;
+
+	private:
+		std::vector<float> CurrentVolumes;
+		std::vector<float> PathDistances;
+		std::vector<float> FalloffDistances;
+		std::vector<float> RemovedMasks; // 1 if the sound is being removed
+		std::vector<float> NewVolumes;
+	};
+}
@@ -0,0 +1,68 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include <algorithm>
+
+/*
+ * The math used by UAudioOcclusionComponent and USoundPropagationComponent to go from trace results to volume and
+ * low pass values. Kept engine independent so the headless benchmarks measure the same code the game runs
+ */
+namespace AudioCore
+{
+	// Gets a value clamped between 0 and 1 based on how far the ray traveled through the blocking mesh
+	inline float GetThicknessValue(const float RayTravelDistance, const float MaxMeshDistanceToBlockAllAudio)
+	{
+		// Divide by the max distance to travel before blocking all audio and clamp to get a value between 0 and 1
+		return std::clamp(RayTravelDistance / MaxMeshDistanceToBlockAllAudio, 0.f, 1.f);
+	}
+
+	// Occlusion value between 0 and 1 for one blocking mesh, a higher material value blocks more sound
+	inline float GetOcclusionValue(const float ThicknessValue, const float MaterialValue)
+	{
+		return std::clamp(ThicknessValue * MaterialValue, 0.f, 1.f);
+	}
+
+	// Higher occlusion means lower volume. Never fully silent since UE would stop the sound and it would go out of sync
+	inline float GetOccludedVolume(const float TotalOcclusionValue)
+	{
+		return std::clamp(1 - std::clamp(TotalOcclusionValue, 0.f, 1.f), 0.01f, 1.f);
+	}
+
+	// Returns a value between zero and one based on the listener's distance to the blocking wall
+	inline float GetLowPassValue(const float DistanceToMesh, const float DistanceToWallOffset, const float DistanceToWallToStopAddingLowPass)
+	{
+		// Clamps Low Pass Value between 0 and the max distance, then divides by max distance to give a value between 0 and 1
+		return std::clamp(DistanceToMesh - DistanceToWallOffset, 0.f, DistanceToWallToStopAddingLowPass) / DistanceToWallToStopAddingLowPass;
+	}
+
+	// Frequency to filter by, with a min frequency of 200 and max of the passed max
+	inline float GetLowPassFrequency(const float LowPassValue, const float MaxLowPassFrequency)
+	{
+		return std::clamp(MaxLowPassFrequency * LowPassValue, 200.f, MaxLowPassFrequency);
+	}
+
+	/* Volume for a propagated sound based on the path length from the original source. This is an approximation that
+	 * assumes each node traveled is the same length (diagonal travels are longer) */
+	inline float GetPropagatedVolume(const int PathSize, const float NodeDiameter, const float FalloffDistance)
+	{
+		const int DistanceFromPropToOriginal = static_cast<int>(PathSize * NodeDiameter);
+
+		// How much percentage the distance from the source is of the max fall off distance, giving a value close to 0
+		// when it's close to the audio source and vice versa. That's why 1 - Value is needed
+		return 1 - std::clamp(DistanceFromPropToOriginal / FalloffDistance, 0.f, 1.f);
+	}
+
+	// Same as FMath::FInterpConstantTo, moves Current towards Target at a constant speed
+	inline float InterpConstantTo(const float Current, const float Target, const float DeltaTime, const float InterpSpeed)
+	{
+		const float Dist = Target - Current;
+
+		// If distance is too small, just set the desired location
+		if(Dist * Dist < 1.e-8f)
+			return Target;
+
+		const float Step = InterpSpeed * DeltaTime;
+		return Current + std::clamp(Dist, -Step, Step);
+	}
+}
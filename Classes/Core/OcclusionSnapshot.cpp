@@ -0,0 +1,62 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "OcclusionSnapshot.h"
+#include "GridRaycast.h"
+#include "ParallelFor.h"
+
+#include <algorithm>
+
+namespace AudioCore
+{
+	namespace
+	{
+		// Enough work per task that handing out tasks costs little next to the traces
+		constexpr int SourcesPerTask = 16;
+	}
+
+	void FillOcclusionBatch(const std::vector<FSourceOcclusion>& Results, FOcclusionBatch& Batch, std::vector<int>& OutSources)
+	{
+		OutSources.clear();
+		for(int Source = 0; Source < static_cast<int>(Results.size()); Source++)
+		{
+			const FSourceOcclusion& Result = Results[Source];
+			if(!Result.bInRange || !Result.bBlocked)
+				continue;
+
+			Batch.AddSource(Result.DistanceToMesh);
+			for(size_t Hit = 0; Hit < Result.TravelDistances.size(); Hit++)
+				Batch.AddHit(Result.TravelDistances[Hit], Result.MaterialValues[Hit]);
+			OutSources.push_back(Source);
+		}
+	}
+
+	void TraceOcclusionOnGrid(const FOccupancyGrid& Grid, const FOcclusionSnapshot& Snapshot, FTaskThreads& Threads, std::vector<FSourceOcclusion>& OutResults)
+	{
+		OutResults.resize(Snapshot.Num());
+
+		const int NumTasks = (Snapshot.Num() + SourcesPerTask - 1) / SourcesPerTask;
+		Threads.ParallelFor(NumTasks, [&](const int Task)
+		{
+			const int End = std::min((Task + 1) * SourcesPerTask, Snapshot.Num());
+			for(int Source = Task * SourcesPerTask; Source < End; Source++)
+			{
+				FSourceOcclusion& Result = OutResults[Source];
+				Result.Reset();
+
+				Result.bInRange = Snapshot.IsInRange(Source);
+				if(!Result.bInRange)
+					continue;
+
+				Result.NumTraces++;
+				const FGridTraceResult Trace = TraceGrid(Grid, Snapshot.CameraLocation, Snapshot.SourceLocations[Source]);
+				Result.bBlocked = Trace.bBlocked;
+				if(!Result.bBlocked)
+					continue;
+
+				Result.DistanceToMesh = Snapshot.bUpdateLowPass ? Trace.FirstHitDistance : -1.f;
+				Result.TravelDistances.push_back(Trace.BlockedDistance);
+				Result.MaterialValues.push_back(1.f);
+			}
+		});
+	}
+}
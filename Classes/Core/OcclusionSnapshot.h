@@ -0,0 +1,87 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "AudioCoreTypes.h"
+#include "OcclusionBatch.h"
+#include "OccupancyGrid.h"
+
+#include <vector>
+
+namespace AudioCore
+{
+	class FTaskThreads;
+
+	/*
+	 * The listener and source locations taken at the start of the occlusion tick. The per source work runs in parallel
+	 * and only reads this, so sources that move while it runs (or are destroyed) can not change the frame's result
+	 */
+	struct FOcclusionSnapshot
+	{
+		// Sources further from the listener than their fall off distance are not updated
+		FVec3 ListenerLocation;
+
+		// Where the traces start (the player's camera)
+		FVec3 CameraLocation;
+
+		// Low pass values are only updated every LowPassUpdateDelay
+		bool bUpdateLowPass = false;
+
+		std::vector<FVec3> SourceLocations;
+		std::vector<float> FalloffDistances;
+
+		void Reset()
+		{
+			SourceLocations.clear();
+			FalloffDistances.clear();
+		}
+
+		void AddSource(const FVec3& Location, const float FalloffDistance)
+		{
+			SourceLocations.push_back(Location);
+			FalloffDistances.push_back(FalloffDistance);
+		}
+
+		int Num() const { return static_cast<int>(SourceLocations.size()); }
+
+		bool IsInRange(const int Source) const { return FalloffDistances[Source] > FVec3::Dist(ListenerLocation, SourceLocations[Source]); }
+	};
+
+	/* What the per source work found for one source, each worker only writes its own sources'. The results are kept
+	 * between frames so the hit arrays keep their allocations */
+	struct FSourceOcclusion
+	{
+		bool bInRange = false;
+		bool bBlocked = false;
+
+		// The listener's distance to the first blocking mesh, negative if the low pass is not updated this frame
+		float DistanceToMesh = -1;
+
+		// Per blocking mesh, how far the ray traveled through it and its material's occlusion multiplier
+		std::vector<float> TravelDistances;
+		std::vector<float> MaterialValues;
+
+		// How many traces the source needed (for the stats, workers can not add to them)
+		int NumTraces = 0;
+
+		void Reset()
+		{
+			bInRange = false;
+			bBlocked = false;
+			DistanceToMesh = -1;
+			TravelDistances.clear();
+			MaterialValues.clear();
+			NumTraces = 0;
+		}
+	};
+
+	/* Adds the blocked sources to the batch in snapshot order, once every source's work is done. OutSources gets the
+	 * snapshot index of each source in the batch */
+	void FillOcclusionBatch(const std::vector<FSourceOcclusion>& Results, FOcclusionBatch& Batch, std::vector<int>& OutSources);
+
+	/* The per source work of UAudioOcclusionComponent with grid ray marches in place of physics traces, the distance
+	 * the ray travels through blocked cells is one blocking mesh with a material value of 1 (like TrajectoryReplay).
+	 * Sources are split into blocks that run on the threads, which are kept between frames like the engine's task
+	 * threads. OutResults is resized to the snapshot's sources */
+	void TraceOcclusionOnGrid(const FOccupancyGrid& Grid, const FOcclusionSnapshot& Snapshot, FTaskThreads& Threads, std::vector<FSourceOcclusion>& OutResults);
+}
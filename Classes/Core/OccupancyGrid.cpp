@@ -0,0 +1,96 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "OccupancyGrid.h"
+
+#include <algorithm>
+
+namespace AudioCore
+{
+	void FOccupancyGrid::Init(const int InLengthX, const int InLengthY, const int InLengthZ, const float InNodeDiameter, const FVec3& InBottomLeft, const ECellLayout InLayout)
+	{
+		LengthX = std::max(InLengthX, 0);
+		LengthY = std::max(InLengthY, 0);
+		LengthZ = std::max(InLengthZ, 0);
+		NodeDiameter = InNodeDiameter;
+		BottomLeft = InBottomLeft;
+		Layout = InLayout;
+
+		if(Layout == ECellLayout::Linear)
+		{
+			Walkable.assign(static_cast<size_t>(LengthX) * LengthY * LengthZ, 0);
+			return;
+		}
+
+		const auto ToBricks = [](const int Length) { return (Length + BrickSize - 1) / BrickSize; };
+		BricksY = ToBricks(LengthY);
+		BricksZ = ToBricks(LengthZ);
+		Walkable.assign(static_cast<size_t>(ToBricks(LengthX)) * BricksY * BricksZ * BrickSize * BrickSize * BrickSize, 0);
+	}
+
+	FGridCoord FOccupancyGrid::GetCoord(const int Index) const
+	{
+		// Reverse of GetIndex
+		if(Layout == ECellLayout::Bricks)
+		{
+			const int Brick = Index >> 6;
+			const int BrickX = Brick / (BricksY * BricksZ);
+			const int Remainder = Brick - BrickX * BricksY * BricksZ;
+			const int BrickZ = Remainder / BricksY;
+			const int BrickY = Remainder - BrickZ * BricksY;
+			return FGridCoord(BrickX << 2 | (Index >> 4 & 3), BrickY << 2 | (Index & 3), BrickZ << 2 | (Index >> 2 & 3));
+		}
+
+		const int PlaneSize = LengthY * LengthZ;
+		const int X = Index / PlaneSize;
+		const int Remainder = Index - X * PlaneSize;
+		const int Z = Remainder / LengthY;
+		const int Y = Remainder - Z * LengthY;
+		return FGridCoord(X, Y, Z);
+	}
+
+	int FOccupancyGrid::GetLinearIndex(const int Index) const
+	{
+		if(Layout == ECellLayout::Linear || Index == InvalidIndex)
+			return Index;
+
+		const FGridCoord Coord = GetCoord(Index);
+		return Coord.X * LengthY * LengthZ + Coord.Z * LengthY + Coord.Y;
+	}
+
+	FGridCoord FOccupancyGrid::WorldToCoord(const FVec3& WorldLoc) const
+	{
+		// Get coordinates relative to the grid's bottom left corner, then check how many nodes "fit" in the relative
+		// position for array indexes
+		const FVec3 GridRelative = (WorldLoc - BottomLeft - FVec3(1, 1, 1) * GetNodeRadius()) * (1.f / NodeDiameter);
+
+		// Round to nearest and clamp the result between array index bounds
+		const auto ToIndex = [](const float Value, const int Length)
+		{
+			return std::clamp(static_cast<int>(std::floor(Value + 0.5f)), 0, Length - 1);
+		};
+
+		return FGridCoord(ToIndex(GridRelative.X, LengthX), ToIndex(GridRelative.Y, LengthY), ToIndex(GridRelative.Z, LengthZ));
+	}
+
+	FVec3 FOccupancyGrid::CoordToWorld(const FGridCoord& Coord) const
+	{
+		const float Radius = GetNodeRadius();
+		return BottomLeft + FVec3(Coord.X * NodeDiameter + Radius, Coord.Y * NodeDiameter + Radius, Coord.Z * NodeDiameter + Radius);
+	}
+
+	FOccupancyGrid CopyWithLayout(const FOccupancyGrid& Source, const ECellLayout Layout)
+	{
+		FOccupancyGrid Copy;
+		Copy.Init(Source.GetLengthX(), Source.GetLengthY(), Source.GetLengthZ(), Source.GetNodeDiameter(), Source.GetBottomLeft(), Layout);
+		for(int X = 0; X < Source.GetLengthX(); X++)
+		{
+			for(int Z = 0; Z < Source.GetLengthZ(); Z++)
+			{
+				for(int Y = 0; Y < Source.GetLengthY(); Y++)
+					Copy.SetWalkable(Copy.GetIndex(X, Y, Z), Source.IsWalkable(Source.GetIndex(X, Y, Z)));
+			}
+		}
+
+		return Copy;
+	}
+}
@@ -0,0 +1,114 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "AudioCoreTypes.h"
+
+#include <vector>
+
+namespace AudioCore
+{
+	// How cells are ordered in the grid's 1D array, see FOccupancyGrid
+	enum class ECellLayout : uint8_t
+	{
+		// X-major with Z and then Y as the inner orderings
+		Linear,
+
+		// 4x4x4 bricks, ordered like Linear, with the cells of a brick next to each other (also ordered like Linear)
+		Bricks,
+	};
+
+	/*
+	 * The walkability data of the map grid without any engine dependencies. AMapGrid bakes it with physics overlaps and
+	 * the headless tools create it synthetically or load it from disk. Cells are stored in a 1D array used as if it was
+	 * 3D, by default X-major with Z and then Y as the inner orderings (same layout as the grid has always used). With
+	 * that layout, neighbours along X are a whole YZ plane away in memory, so on large grids a search misses the cache
+	 * on most steps. The Bricks layout keeps each 4x4x4 block of cells in one 64 byte run instead, so most neighbours
+	 * are in the same cache line. Its lengths are padded to multiples of 4 with blocked cells, Num() includes the padding
+	 */
+	class FOccupancyGrid
+	{
+	public:
+		static constexpr int BrickSize = 4;
+
+		FOccupancyGrid() {}
+
+		// Sets up the grid with every cell blocked, call SetWalkable to open cells
+		void Init(const int InLengthX, const int InLengthY, const int InLengthZ, const float InNodeDiameter, const FVec3& InBottomLeft, const ECellLayout InLayout = ECellLayout::Linear);
+
+		ECellLayout GetLayout() const { return Layout; }
+
+		int GetLengthX() const { return LengthX; }
+		int GetLengthY() const { return LengthY; }
+		int GetLengthZ() const { return LengthZ; }
+
+		// Total number of cells
+		int Num() const { return static_cast<int>(Walkable.size()); }
+
+		float GetNodeDiameter() const { return NodeDiameter; }
+		float GetNodeRadius() const { return NodeDiameter / 2; }
+		FVec3 GetBottomLeft() const { return BottomLeft; }
+
+		int GetIndex(const int X, const int Y, const int Z) const
+		{
+			// Source: https://stackoverflow.com/a/34363187 (reworked)
+			if(Layout == ECellLayout::Linear)
+				return X * LengthY * LengthZ + Z * LengthY + Y;
+
+			// The brick's index times the cells in a brick, then the cell's index inside the brick
+			const int Brick = (X >> 2) * BricksY * BricksZ + (Z >> 2) * BricksY + (Y >> 2);
+			return Brick << 6 | (X & 3) << 4 | (Z & 3) << 2 | (Y & 3);
+		}
+
+		int GetIndex(const FGridCoord& Coord) const { return GetIndex(Coord.X, Coord.Y, Coord.Z); }
+
+		FGridCoord GetCoord(const int Index) const;
+
+		// The index the cell has with the Linear layout, for indexes stored outside the game (e.g. recordings)
+		int GetLinearIndex(const int Index) const;
+
+		bool IsOutOfBounds(const int X, const int Y, const int Z) const
+		{
+			return X < 0 || X > LengthX - 1 || Y < 0 || Y > LengthY - 1 || Z < 0 || Z > LengthZ - 1;
+		}
+
+		bool IsWalkable(const int Index) const { return Walkable[Index] != 0; }
+
+		void SetWalkable(const int Index, const bool bWalkable) { Walkable[Index] = bWalkable ? 1 : 0; }
+
+		// Returns the coordinates of the cell that the world location is in, clamped to the grid's bounds
+		FGridCoord WorldToCoord(const FVec3& WorldLoc) const;
+
+		int WorldToIndex(const FVec3& WorldLoc) const { return GetIndex(WorldToCoord(WorldLoc)); }
+
+		// World location of the cell's center
+		FVec3 CoordToWorld(const FGridCoord& Coord) const;
+
+		FVec3 IndexToWorld(const int Index) const { return CoordToWorld(GetCoord(Index)); }
+
+		// Bytes used per cell by the grid itself (not including search state)
+		static constexpr int GetBytesPerCell() { return sizeof(uint8_t); }
+
+	private:
+
+		int LengthX = 0;
+		int LengthY = 0;
+		int LengthZ = 0;
+
+		ECellLayout Layout = ECellLayout::Linear;
+
+		// Number of bricks along Y and Z with the Bricks layout
+		int BricksY = 0;
+		int BricksZ = 0;
+
+		float NodeDiameter = 100.f;
+
+		FVec3 BottomLeft;
+
+		// 1 if audio can travel through the cell, 0 if it is blocked (always for padding)
+		std::vector<uint8_t> Walkable;
+	};
+
+	// The same grid with its cells in another layout, indexes differ but coordinates are the same
+	FOccupancyGrid CopyWithLayout(const FOccupancyGrid& Source, const ECellLayout Layout);
+}
@@ -0,0 +1,74 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ParallelFor.h"
+
+namespace AudioCore
+{
+	FTaskThreads::FTaskThreads(const int NumThreads)
+	{
+		for(int i = 1; i < NumThreads; i++)
+			Threads.emplace_back(&FTaskThreads::RunWorker, this);
+	}
+
+	FTaskThreads::~FTaskThreads()
+	{
+		{
+			const std::lock_guard<std::mutex> Lock(Mutex);
+			bStopping = true;
+		}
+		WorkStarted.notify_all();
+
+		for(std::thread& Thread : Threads)
+			Thread.join();
+	}
+
+	void FTaskThreads::ParallelFor(const int InNumTasks, const std::function<void(int)>& InFunction)
+	{
+		{
+			const std::lock_guard<std::mutex> Lock(Mutex);
+			Function = &InFunction;
+			NumTasks = InNumTasks;
+			NextTask = 0;
+			NumBusyThreads = static_cast<int>(Threads.size());
+			Generation++;
+		}
+		WorkStarted.notify_all();
+
+		RunTasks();
+
+		// Every thread has to be done with this call before the next one can change the work
+		std::unique_lock<std::mutex> Lock(Mutex);
+		WorkDone.wait(Lock, [&]() { return NumBusyThreads == 0; });
+		Function = nullptr;
+	}
+
+	void FTaskThreads::RunWorker()
+	{
+		int LastGeneration = 0;
+		while(true)
+		{
+			{
+				std::unique_lock<std::mutex> Lock(Mutex);
+				WorkStarted.wait(Lock, [&]() { return bStopping || Generation != LastGeneration; });
+				if(bStopping)
+					return;
+
+				LastGeneration = Generation;
+			}
+
+			RunTasks();
+
+			{
+				const std::lock_guard<std::mutex> Lock(Mutex);
+				NumBusyThreads--;
+			}
+			WorkDone.notify_one();
+		}
+	}
+
+	void FTaskThreads::RunTasks()
+	{
+		for(int Task = NextTask++; Task < NumTasks; Task = NextTask++)
+			(*Function)(Task);
+	}
+}
@@ -0,0 +1,81 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace AudioCore
+{
+	/* Calls Function(Task) for every task from 0 to NumTasks - 1, spread over up to NumThreads threads (the calling
+	 * thread is one of them). Tasks are handed out one at a time so uneven tasks still keep every thread busy. The
+	 * engine's task graph is not available in Core, so the threads are started and joined on every call */
+	template<typename FunctionType>
+	void ParallelFor(const int NumTasks, const int NumThreads, FunctionType Function)
+	{
+		std::atomic<int> NextTask { 0 };
+		const auto Worker = [&]()
+		{
+			for(int Task = NextTask++; Task < NumTasks; Task = NextTask++)
+				Function(Task);
+		};
+
+		std::vector<std::thread> Threads;
+		for(int i = 1; i < std::min(NumThreads, NumTasks); i++)
+			Threads.emplace_back(Worker);
+
+		Worker();
+
+		for(std::thread& Thread : Threads)
+			Thread.join();
+	}
+
+	/*
+	 * Threads that are started once and then wait for work, for work that is spread over threads every frame where
+	 * ParallelFor would spend much of the frame starting and joining threads (the engine's task graph keeps its threads
+	 * the same way). NumThreads counts the calling thread like ParallelFor
+	 */
+	class FTaskThreads
+	{
+	public:
+		explicit FTaskThreads(const int NumThreads);
+		~FTaskThreads();
+
+		FTaskThreads(const FTaskThreads&) = delete;
+		FTaskThreads& operator=(const FTaskThreads&) = delete;
+
+		int Num() const { return static_cast<int>(Threads.size()) + 1; }
+
+		/* Same as ParallelFor on these threads and the calling one, returns once every task is done. Only one thread may
+		 * call it at a time */
+		void ParallelFor(const int InNumTasks, const std::function<void(int)>& InFunction);
+
+	private:
+		std::vector<std::thread> Threads;
+
+		std::mutex Mutex;
+		std::condition_variable WorkStarted;
+		std::condition_variable WorkDone;
+
+		// The call the threads are working on, only changed while none of them is
+		const std::function<void(int)>* Function = nullptr;
+		int NumTasks = 0;
+		std::atomic<int> NextTask { 0 };
+
+		// Changed by every call so each thread knows when there is new work, and the threads not done with it yet
+		int Generation = 0;
+		int NumBusyThreads = 0;
+
+		bool bStopping = false;
+
+		void RunWorker();
+
+		// Takes tasks until there are none left
+		void RunTasks();
+	};
+}
@@ -0,0 +1,166 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ParamSmoothing.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace AudioCore
+{
+	namespace
+	{
+		constexpr float TwoPi = 6.28318530718f;
+
+		// The value a ramp from Start has after NumSteps steps towards Target, lands exactly on it
+		float GetRampValue(const float Start, const float Target, const float Step, const int NumSteps)
+		{
+			const float Moved = Step * static_cast<float>(NumSteps);
+			return Target > Start ? std::min(Start + Moved, Target) : std::max(Start - Moved, Target);
+		}
+
+		// Like FMath::FInterpConstantTo, no speed means the value jumps to its target
+		float GetStepPerSample(const float SpeedPerSecond, const float SampleRate)
+		{
+			return SpeedPerSecond > 0 ? SpeedPerSecond / SampleRate : std::numeric_limits<float>::max();
+		}
+	}
+
+	void FSmoothedGainFilter::Init(const float InSampleRate, const int InNumChannels, const FSmoothingTargets& Initial)
+	{
+		SampleRate = InSampleRate;
+		NumChannels = InNumChannels;
+		FilterStates.assign(static_cast<size_t>(NumChannels), 0.f);
+
+		Gain = TargetGain = Initial.Gain;
+		Octave = TargetOctave = std::log2(std::max(Initial.CutoffFrequency, 1.f));
+		SetSpeeds(FSmoothingSpeeds());
+		UpdateCoefficient();
+	}
+
+	void FSmoothedGainFilter::SetSpeeds(const FSmoothingSpeeds& Speeds)
+	{
+		GainStep = GetStepPerSample(Speeds.GainPerSecond, SampleRate);
+		OctaveStep = GetStepPerSample(Speeds.OctavesPerSecond, SampleRate);
+		RestartRamps();
+	}
+
+	void FSmoothedGainFilter::SetTargets(const FSmoothingTargets& Targets)
+	{
+		TargetGain = Targets.Gain;
+		TargetOctave = std::log2(std::max(Targets.CutoffFrequency, 1.f));
+		RestartRamps();
+	}
+
+	void FSmoothedGainFilter::Process(const float* In, float* Out, const int NumFrames)
+	{
+		// Nothing moves, the common case once the targets are reached
+		if(!IsRamping())
+		{
+			const int NumSamples = NumFrames * NumChannels;
+			if(IsBypassed())
+			{
+				for(int i = 0; i < NumSamples; i++)
+					Out[i] = In[i] * Gain;
+
+				// Kept at the input so the filter starts where the sound is when it is used again
+				for(int Channel = 0; Channel < NumChannels && NumFrames > 0; Channel++)
+					FilterStates[Channel] = In[NumSamples - NumChannels + Channel];
+				return;
+			}
+
+			for(int Frame = 0; Frame < NumFrames; Frame++)
+			{
+				for(int Channel = 0; Channel < NumChannels; Channel++)
+				{
+					const int i = Frame * NumChannels + Channel;
+					FilterStates[Channel] += Coefficient * (In[i] - FilterStates[Channel]);
+					Out[i] = FilterStates[Channel] * Gain;
+				}
+			}
+			return;
+		}
+
+		// A step every sample, the coefficient follows the cutoff while it moves
+		for(int Frame = 0; Frame < NumFrames; Frame++)
+		{
+			if(Gain != TargetGain)
+				Gain = GetRampValue(GainRampStart, TargetGain, GainStep, ++GainRampSamples);
+
+			if(Octave != TargetOctave)
+			{
+				Octave = GetRampValue(OctaveRampStart, TargetOctave, OctaveStep, ++OctaveRampSamples);
+				UpdateCoefficient();
+			}
+
+			const bool bBypassed = IsBypassed();
+			for(int Channel = 0; Channel < NumChannels; Channel++)
+			{
+				const int i = Frame * NumChannels + Channel;
+				FilterStates[Channel] = bBypassed ? In[i] : FilterStates[Channel] + Coefficient * (In[i] - FilterStates[Channel]);
+				Out[i] = FilterStates[Channel] * Gain;
+			}
+		}
+	}
+
+	float FSmoothedGainFilter::GetCutoffFrequency() const
+	{
+		return std::exp2(Octave);
+	}
+
+	bool FSmoothedGainFilter::IsBypassed() const
+	{
+		return Octave == TargetOctave && GetCutoffFrequency() >= BypassedCutoffFrequency;
+	}
+
+	void FSmoothedGainFilter::UpdateCoefficient()
+	{
+		Coefficient = std::min(1.f - std::exp(-TwoPi * GetCutoffFrequency() / SampleRate), 1.f);
+	}
+
+	void FSmoothedGainFilter::RestartRamps()
+	{
+		GainRampStart = Gain;
+		OctaveRampStart = Octave;
+		GainRampSamples = 0;
+		OctaveRampSamples = 0;
+	}
+
+	void FSmoothingTargetTable::Set(const uint64_t Id, const FSmoothingTargets& Targets)
+	{
+		const std::lock_guard<std::mutex> Lock(Mutex);
+		FEntry& Entry = Entries[Id];
+		if(Entry.Targets == Targets)
+			return;
+
+		Entry.Targets = Targets;
+		Entry.Version++;
+	}
+
+	void FSmoothingTargetTable::Remove(const uint64_t Id)
+	{
+		const std::lock_guard<std::mutex> Lock(Mutex);
+		Entries.erase(Id);
+	}
+
+	bool FSmoothingTargetTable::TryGet(const uint64_t Id, FSmoothingTargets& OutTargets, uint32_t& InOutVersion) const
+	{
+		const std::unique_lock<std::mutex> Lock(Mutex, std::try_to_lock);
+		if(!Lock.owns_lock())
+			return false;
+
+		const auto Found = Entries.find(Id);
+		if(Found == Entries.end() || Found->second.Version == InOutVersion)
+			return false;
+
+		OutTargets = Found->second.Targets;
+		InOutVersion = Found->second.Version;
+		return true;
+	}
+
+	int FSmoothingTargetTable::Num() const
+	{
+		const std::lock_guard<std::mutex> Lock(Mutex);
+		return static_cast<int>(Entries.size());
+	}
+}
@@ -0,0 +1,125 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace AudioCore
+{
+	// Cutoff the smoothing filter is let through at, a disabled low pass ramps up to it and is then bypassed
+	constexpr float BypassedCutoffFrequency = 20000.f;
+
+	// What the game thread wants a smoothed sound to be at
+	struct FSmoothingTargets
+	{
+		float Gain = 1.f;
+		float CutoffFrequency = BypassedCutoffFrequency;
+
+		bool operator==(const FSmoothingTargets& Other) const { return Gain == Other.Gain && CutoffFrequency == Other.CutoffFrequency; }
+	};
+
+	// How fast the values move towards their targets, at a constant speed like InterpConstantTo
+	struct FSmoothingSpeeds
+	{
+		// Gain per second, same default as USoundPropagationComponent::PropVolumeLerpSpeed
+		float GainPerSecond = 0.5f;
+
+		// Cutoff frequency in octaves per second, from 200 Hz to fully open in about half a second
+		float OctavesPerSecond = 12.f;
+	};
+
+	/*
+	 * Gain and a one pole low pass (the same kind of filter as an audio component's low pass) whose values are moved
+	 * towards their targets one sample at a time, so changes are as smooth at any frame rate and the game thread only has
+	 * to send new targets. The cutoff moves in octaves so it sounds as fast at low frequencies as at high ones. Used on
+	 * the audio render thread, nothing allocates after Init
+	 */
+	class FSmoothedGainFilter
+	{
+	public:
+		// Starts at the targets without ramping
+		void Init(const float InSampleRate, const int InNumChannels, const FSmoothingTargets& Initial);
+
+		void SetSpeeds(const FSmoothingSpeeds& Speeds);
+
+		void SetTargets(const FSmoothingTargets& Targets);
+
+		// Interleaved frames of NumChannels samples, In and Out can be the same buffer
+		void Process(const float* In, float* Out, const int NumFrames);
+
+		float GetGain() const { return Gain; }
+
+		float GetCutoffFrequency() const;
+
+		int GetNumChannels() const { return NumChannels; }
+
+		bool IsRamping() const { return Gain != TargetGain || Octave != TargetOctave; }
+
+	private:
+		float SampleRate = 48000.f;
+		int NumChannels = 0;
+
+		float Gain = 1.f;
+		float TargetGain = 1.f;
+		float GainStep = 0.f;
+
+		// Cutoff as log2 of the frequency
+		float Octave = 0.f;
+		float TargetOctave = 0.f;
+		float OctaveStep = 0.f;
+
+		/* Where the ramps started and how many samples they have moved since, the values are computed from them so the
+		 * steps do not add up rounding errors and a ramp takes exactly as long as its speed says */
+		float GainRampStart = 1.f;
+		float OctaveRampStart = 0.f;
+		int GainRampSamples = 0;
+		int OctaveRampSamples = 0;
+
+		float Coefficient = 1.f;
+
+		// Last output of the filter per channel
+		std::vector<float> FilterStates;
+
+		bool IsBypassed() const;
+
+		void UpdateCoefficient();
+
+		// Restarts both ramps from the current values
+		void RestartRamps();
+	};
+
+	/*
+	 * Targets of every smoothed sound, written by the game thread and read by the smoothing effects on the audio render
+	 * thread. The render thread never waits for the lock, if the game thread is writing it keeps the targets it has and
+	 * tries again the next buffer
+	 */
+	class FSmoothingTargetTable
+	{
+	public:
+		void Set(const uint64_t Id, const FSmoothingTargets& Targets);
+
+		void Remove(const uint64_t Id);
+
+		/* Fills OutTargets and returns true if the id's targets changed since InOutVersion, which is updated. False if
+		 * they did not, the id has none or the table is being written */
+		bool TryGet(const uint64_t Id, FSmoothingTargets& OutTargets, uint32_t& InOutVersion) const;
+
+		int Num() const;
+
+	private:
+		struct FEntry
+		{
+			FSmoothingTargets Targets;
+
+			// Starts at 1 so an effect that has never read its targets, at version 0, gets them
+			uint32_t Version = 1;
+		};
+
+		mutable std::mutex Mutex;
+
+		std::unordered_map<uint64_t, FEntry> Entries;
+	};
+}
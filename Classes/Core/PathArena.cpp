@@ -0,0 +1,122 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "PathArena.h"
+
+#include <algorithm>
+
+namespace AudioCore
+{
+	namespace
+	{
+		// A path that moves gets a quarter of its length extra so it does not have to move again when it gets a bit longer
+		int GetSlotCapacity(const int Num)
+		{
+			return Num + Num / 4;
+		}
+	}
+
+	void FPathArena::SetPath(FPathHandle& Handle, const int32_t* PathCells, const int Num)
+	{
+		if(!Handle.IsValid())
+		{
+			if(FreeSlots.empty())
+			{
+				Handle.Slot = static_cast<int>(Slots.size());
+				Slots.emplace_back();
+			}
+			else
+			{
+				Handle.Slot = FreeSlots.back();
+				FreeSlots.pop_back();
+			}
+
+			Slots[Handle.Slot].bUsed = true;
+		}
+
+		FSlot& Slot = Slots[Handle.Slot];
+		if(Num > Slot.Capacity)
+		{
+			// The old cells are dead, a slot without capacity has none for the compaction to move
+			NumDeadCells += Slot.Capacity;
+			NumLiveCells -= Slot.Capacity;
+			Slot.Capacity = 0;
+			Slot.Num = 0;
+
+			const int Capacity = GetSlotCapacity(Num);
+			if(NumDeadCells > 0 && (NumDeadCells >= NumLiveCells || Cells.size() + Capacity > Cells.capacity()))
+				Compact();
+
+			Slot.Offset = static_cast<int>(Cells.size());
+			Slot.Capacity = Capacity;
+			Cells.resize(Cells.size() + Capacity);
+			NumLiveCells += Capacity;
+		}
+
+		std::copy(PathCells, PathCells + Num, Cells.data() + Slot.Offset);
+		Slot.Num = Num;
+	}
+
+	FPathView FPathArena::GetPath(const FPathHandle& Handle) const
+	{
+		if(!Handle.IsValid())
+			return FPathView();
+
+		const FSlot& Slot = Slots[Handle.Slot];
+		return { Cells.data() + Slot.Offset, Slot.Num };
+	}
+
+	void FPathArena::Release(FPathHandle& Handle)
+	{
+		if(!Handle.IsValid())
+			return;
+
+		FSlot& Slot = Slots[Handle.Slot];
+		NumDeadCells += Slot.Capacity;
+		NumLiveCells -= Slot.Capacity;
+		Slot = FSlot();
+
+		FreeSlots.push_back(Handle.Slot);
+		Handle.Slot = InvalidIndex;
+	}
+
+	void FPathArena::Reset()
+	{
+		Cells.clear();
+		Slots.clear();
+		FreeSlots.clear();
+		NumLiveCells = 0;
+		NumDeadCells = 0;
+	}
+
+	size_t FPathArena::GetMemoryUsage() const
+	{
+		return Cells.capacity() * sizeof(int32_t) + Slots.capacity() * sizeof(FSlot) + (FreeSlots.capacity() + CompactionOrder.capacity()) * sizeof(int);
+	}
+
+	void FPathArena::Compact()
+	{
+		CompactionOrder.clear();
+		for(int i = 0; i < static_cast<int>(Slots.size()); i++)
+		{
+			if(Slots[i].bUsed && Slots[i].Capacity > 0)
+				CompactionOrder.push_back(i);
+		}
+
+		std::sort(CompactionOrder.begin(), CompactionOrder.end(), [this](const int A, const int B) { return Slots[A].Offset < Slots[B].Offset; });
+
+		// Every path only moves down, so copying them in order never overwrites one that has not moved yet
+		int WriteOffset = 0;
+		for(const int i : CompactionOrder)
+		{
+			FSlot& Slot = Slots[i];
+			std::copy(Cells.data() + Slot.Offset, Cells.data() + Slot.Offset + Slot.Num, Cells.data() + WriteOffset);
+			Slot.Offset = WriteOffset;
+			WriteOffset += Slot.Capacity;
+		}
+
+		// Shrinking keeps the capacity
+		Cells.resize(WriteOffset);
+		NumDeadCells = 0;
+		NumCompactions++;
+	}
+}
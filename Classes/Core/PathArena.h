@@ -0,0 +1,92 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "AudioCoreTypes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace AudioCore
+{
+	// A path stored in an FPathArena, InvalidIndex until the arena gives it a slot
+	struct FPathHandle
+	{
+		int Slot = InvalidIndex;
+
+		bool IsValid() const { return Slot != InvalidIndex; }
+	};
+
+	// The cells of a stored path, only valid until the arena's next SetPath or Release
+	struct FPathView
+	{
+		const int32_t* Cells = nullptr;
+		int Num = 0;
+
+		int32_t operator[](const int i) const { return Cells[i]; }
+	};
+
+	/*
+	 * Every source's path as grid cell indexes in one array that is kept between frames. A path that fits in its slot is
+	 * overwritten in place, a longer one is moved to the end with some room to grow and the cells it left behind are
+	 * reclaimed by moving the paths down once there are as many of them as there are cells in use, or when the array
+	 * would have to grow otherwise. Once the array is big enough for the paths, storing them does not allocate
+	 */
+	class FPathArena
+	{
+	public:
+		/* Stores the path in the handle's slot, giving the handle one if it has none. PathCells must not point into the
+		 * arena. A path of no cells keeps the slot */
+		void SetPath(FPathHandle& Handle, const int32_t* PathCells, const int Num);
+
+		void SetPath(FPathHandle& Handle, const std::vector<int>& PathCells) { SetPath(Handle, PathCells.data(), static_cast<int>(PathCells.size())); }
+
+		// Empty if the handle has no slot
+		FPathView GetPath(const FPathHandle& Handle) const;
+
+		int GetNum(const FPathHandle& Handle) const { return Handle.IsValid() ? Slots[Handle.Slot].Num : 0; }
+
+		// Gives the handle's slot back to the arena and invalidates the handle
+		void Release(FPathHandle& Handle);
+
+		// Forgets every path, handles given out before are no longer valid. Keeps the memory
+		void Reset();
+
+		int GetNumLiveCells() const { return NumLiveCells; }
+
+		int GetNumDeadCells() const { return NumDeadCells; }
+
+		int GetNumCompactions() const { return NumCompactions; }
+
+		size_t GetMemoryUsage() const;
+
+	private:
+		// Where in Cells a slot's path is, Capacity cells are kept for it
+		struct FSlot
+		{
+			int Offset = 0;
+			int Num = 0;
+			int Capacity = 0;
+			bool bUsed = false;
+		};
+
+		std::vector<int32_t> Cells;
+		std::vector<FSlot> Slots;
+
+		// Released slots to give out again before adding new ones
+		std::vector<int> FreeSlots;
+
+		// Cells kept for paths (with their room to grow), and cells no path uses anymore since it moved or was released
+		int NumLiveCells = 0;
+		int NumDeadCells = 0;
+
+		int NumCompactions = 0;
+
+		// The used slots in the order of their cells, reused so compacting does not allocate
+		std::vector<int> CompactionOrder;
+
+		// Moves every path down over the dead cells, the slots keep their capacity
+		void Compact();
+	};
+}
@@ -0,0 +1,76 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "PropagationSearch.h"
+
+#include <cmath>
+#include <cstdlib>
+
+namespace AudioCore
+{
+	FPropagationSearch::FPropagationSearch(const FOccupancyGrid& InGrid) : Grid(InGrid)
+	{
+	}
+
+	void FPropagationSearch::BeginSearch()
+	{
+		if(!Neighbours.IsBuiltFor(Grid))
+			Neighbours.Init(Grid);
+
+		for(int Direction = 0; Direction < TGridNeighbours<26>::NumDirections; Direction++)
+			StepLengths[Direction] = Grid.GetNodeDiameter() * std::sqrt(static_cast<float>(Neighbours.GetDistanceSquared(Direction)));
+
+		const size_t NumCells = static_cast<size_t>(Grid.Num());
+		if(Distances.size() != NumCells)
+		{
+			Distances.assign(NumCells, 0);
+			Steps.assign(NumCells, 0);
+			OpenedGeneration.assign(NumCells, 0);
+			ClosedGeneration.assign(NumCells, 0);
+			Generation = 0;
+		}
+
+		// Generation wrapped around, old stamps could be mistaken for this search's so clear them
+		if(++Generation == 0)
+		{
+			std::fill(OpenedGeneration.begin(), OpenedGeneration.end(), 0);
+			std::fill(ClosedGeneration.begin(), ClosedGeneration.end(), 0);
+			Generation = 1;
+		}
+
+		OpenSet.clear();
+		LastStats = FPropagationSearchStats();
+	}
+
+	void FPropagationSearch::Push(const int Index, const float Distance, const int NumSteps)
+	{
+		OpenedGeneration[Index] = Generation;
+		Distances[Index] = Distance;
+		Steps[Index] = NumSteps;
+		OpenSet.push_back({ Distance, Index });
+		std::push_heap(OpenSet.begin(), OpenSet.end());
+	}
+
+	bool FPropagationSearch::IsSeparated(const int Index, const float MinSeparation, const std::vector<FPropagationOpening>& Openings) const
+	{
+		const FGridCoord Coord = Grid.GetCoord(Index);
+		for(const FPropagationOpening& Opening : Openings)
+		{
+			const FGridCoord OpeningCoord = Grid.GetCoord(Opening.Index);
+			const float DeltaX = static_cast<float>(Coord.X - OpeningCoord.X);
+			const float DeltaY = static_cast<float>(Coord.Y - OpeningCoord.Y);
+			const float DeltaZ = static_cast<float>(Coord.Z - OpeningCoord.Z);
+			if(DeltaX * DeltaX + DeltaY * DeltaY + DeltaZ * DeltaZ < MinSeparation * MinSeparation)
+				return false;
+		}
+
+		return true;
+	}
+
+	int FPropagationSearch::GetStepsBetween(const int From, const int To) const
+	{
+		// Diagonal steps move along every axis at once so the longest axis decides
+		const FGridCoord FromCoord = Grid.GetCoord(From);
+		const FGridCoord ToCoord = Grid.GetCoord(To);
+		return std::max({ std::abs(ToCoord.X - FromCoord.X), std::abs(ToCoord.Y - FromCoord.Y), std::abs(ToCoord.Z - FromCoord.Z) });
+	}
+}
@@ -0,0 +1,168 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "GridNeighbours.h"
+#include "OccupancyGrid.h"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace AudioCore
+{
+	// A place the sound is heard from, the first cell visible from the listener along a path from the source
+	struct FPropagationOpening
+	{
+		int Index = InvalidIndex;
+
+		/* Number of cells from the listener to the source through the opening, the same as the size of the single path
+		 * (see FGridPathfinder::FindPath) so it can be used with GetPropagatedVolume */
+		int PathSize = 0;
+
+		// Distance the sound travels from the source to the opening, in world units
+		float Distance = 0;
+	};
+
+	struct FPropagationSearchSettings
+	{
+		// How many openings to find at most, the closest one is always first
+		int MaxOpenings = 1;
+
+		// Openings closer to each other than this (in cells) count as the same opening, e.g. two cells of one doorway
+		float MinOpeningSeparation = 3.f;
+
+		// Cells further than this from the source (in world units) are not searched, 0 searches the whole grid
+		float MaxDistance = 0.f;
+	};
+
+	struct FPropagationSearchStats
+	{
+		int NodesExpanded = 0;
+
+		// Number of times the visibility function was called
+		int VisibilityTests = 0;
+	};
+
+	/*
+	 * Finds several openings a sound can be heard through with one Dijkstra expansion from the source. Cells are expanded
+	 * in order of their distance from the source, a cell visible from the listener is an opening and is not expanded
+	 * further (everything past it is reached through it). Openings too close to an earlier, closer, opening are skipped,
+	 * which keeps one per doorway. Compared to running A* once per opening the search is never repeated, but it does
+	 * expand in every direction instead of towards the listener
+	 */
+	class FPropagationSearch
+	{
+	public:
+		explicit FPropagationSearch(const FOccupancyGrid& InGrid);
+
+		/* Finds up to Settings.MaxOpenings openings sorted by distance from the source. IsVisible(CellIndex) returns
+		 * true if the listener can see the cell. Returns the number of openings found */
+		template<typename VisibilityFunctionType>
+		int FindOpenings(const int SourceIndex, const int ListenerIndex, const FPropagationSearchSettings& Settings,
+			VisibilityFunctionType IsVisible, std::vector<FPropagationOpening>& OutOpenings);
+
+		const FPropagationSearchStats& GetLastStats() const { return LastStats; }
+
+	private:
+
+		const FOccupancyGrid& Grid;
+
+		TGridNeighbours<26> Neighbours;
+
+		// World distance of one step in each neighbour direction
+		float StepLengths[26] = {};
+
+		// Per cell search state, stamped with a generation like in FGridPathfinder
+		std::vector<float> Distances;
+		std::vector<int> Steps;
+		std::vector<uint32_t> OpenedGeneration;
+		std::vector<uint32_t> ClosedGeneration;
+
+		uint32_t Generation = 0;
+
+		struct FOpenEntry
+		{
+			float Distance;
+			int Index;
+
+			// std heaps are max heaps, so the closest cell has to compare as the largest
+			bool operator<(const FOpenEntry& Other) const { return Distance > Other.Distance; }
+		};
+
+		std::vector<FOpenEntry> OpenSet;
+
+		FPropagationSearchStats LastStats;
+
+		void BeginSearch();
+
+		void Push(const int Index, const float Distance, const int NumSteps);
+
+		// Returns true if the cell is far enough from every opening found so far
+		bool IsSeparated(const int Index, const float MinSeparation, const std::vector<FPropagationOpening>& Openings) const;
+
+		// Number of cells on a straight path between the cells, the opening is visible from the listener
+		int GetStepsBetween(const int From, const int To) const;
+	};
+
+	template<typename VisibilityFunctionType>
+	int FPropagationSearch::FindOpenings(const int SourceIndex, const int ListenerIndex, const FPropagationSearchSettings& Settings,
+		VisibilityFunctionType IsVisible, std::vector<FPropagationOpening>& OutOpenings)
+	{
+		BeginSearch();
+		OutOpenings.clear();
+
+		const float MaxDistance = Settings.MaxDistance > 0 ? Settings.MaxDistance : std::numeric_limits<float>::max();
+		Push(SourceIndex, 0, 0);
+
+		while(!OpenSet.empty() && static_cast<int>(OutOpenings.size()) < Settings.MaxOpenings)
+		{
+			std::pop_heap(OpenSet.begin(), OpenSet.end());
+			const FOpenEntry Current = OpenSet.back();
+			OpenSet.pop_back();
+
+			// Already expanded or a shorter way to it was found after this entry was pushed
+			if(ClosedGeneration[Current.Index] == Generation || Current.Distance != Distances[Current.Index])
+				continue;
+
+			// Cells are popped in order of distance so everything left is further away
+			if(Current.Distance > MaxDistance)
+				break;
+
+			ClosedGeneration[Current.Index] = Generation;
+			LastStats.NodesExpanded++;
+
+			// The source is not tested, the caller only searches when the listener cannot see it
+			if(Current.Index != SourceIndex)
+			{
+				LastStats.VisibilityTests++;
+				if(IsVisible(Current.Index))
+				{
+					if(IsSeparated(Current.Index, Settings.MinOpeningSeparation, OutOpenings))
+						OutOpenings.push_back({ Current.Index, Steps[Current.Index] + GetStepsBetween(Current.Index, ListenerIndex), Current.Distance });
+
+					continue;
+				}
+			}
+
+			const uint8_t BoundaryMask = Neighbours.GetBoundaryMask(Current.Index);
+			for(int Direction = 0; Direction < TGridNeighbours<26>::NumDirections; Direction++)
+			{
+				if(!Neighbours.IsInside(BoundaryMask, Direction))
+					continue;
+
+				const int Neighbour = Neighbours.GetNeighbour(Current.Index, Direction);
+				if(!Grid.IsWalkable(Neighbour) || ClosedGeneration[Neighbour] == Generation)
+					continue;
+
+				const float NewDistance = Current.Distance + StepLengths[Direction];
+				if(OpenedGeneration[Neighbour] == Generation && NewDistance >= Distances[Neighbour])
+					continue;
+
+				Push(Neighbour, NewDistance, Steps[Current.Index] + 1);
+			}
+		}
+
+		return static_cast<int>(OutOpenings.size());
+	}
+}
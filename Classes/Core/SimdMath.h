@@ -0,0 +1,112 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include <algorithm>
+
+/*
+ * Four wide float vectors for the batch kernels. Maps to SSE2 on x64 and NEON on arm64, other platforms get a scalar
+ * fallback with the same interface so kernels are written once. Loads and stores are unaligned
+ */
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define AUDIO_CORE_SIMD_SSE 1
+	#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+	#define AUDIO_CORE_SIMD_NEON 1
+	#include <arm_neon.h>
+#else
+	#define AUDIO_CORE_SIMD_SCALAR 1
+#endif
+
+namespace AudioCore
+{
+	namespace Simd
+	{
+		constexpr int Width = 4;
+
+#if AUDIO_CORE_SIMD_SSE
+
+		struct FFloat4 { __m128 V; };
+
+		inline FFloat4 Load(const float* Data) { return { _mm_loadu_ps(Data) }; }
+		inline void Store(float* Data, const FFloat4 A) { _mm_storeu_ps(Data, A.V); }
+		inline FFloat4 Set1(const float Value) { return { _mm_set1_ps(Value) }; }
+
+		inline FFloat4 Add(const FFloat4 A, const FFloat4 B) { return { _mm_add_ps(A.V, B.V) }; }
+		inline FFloat4 Sub(const FFloat4 A, const FFloat4 B) { return { _mm_sub_ps(A.V, B.V) }; }
+		inline FFloat4 Mul(const FFloat4 A, const FFloat4 B) { return { _mm_mul_ps(A.V, B.V) }; }
+		inline FFloat4 Div(const FFloat4 A, const FFloat4 B) { return { _mm_div_ps(A.V, B.V) }; }
+		inline FFloat4 Min(const FFloat4 A, const FFloat4 B) { return { _mm_min_ps(A.V, B.V) }; }
+		inline FFloat4 Max(const FFloat4 A, const FFloat4 B) { return { _mm_max_ps(A.V, B.V) }; }
+
+		// All bits set in lanes where A < B
+		inline FFloat4 CompareLess(const FFloat4 A, const FFloat4 B) { return { _mm_cmplt_ps(A.V, B.V) }; }
+
+		// Picks A in lanes where the mask is set, B otherwise
+		inline FFloat4 Select(const FFloat4 Mask, const FFloat4 A, const FFloat4 B)
+		{
+			return { _mm_or_ps(_mm_and_ps(Mask.V, A.V), _mm_andnot_ps(Mask.V, B.V)) };
+		}
+
+#elif AUDIO_CORE_SIMD_NEON
+
+		struct FFloat4 { float32x4_t V; };
+
+		inline FFloat4 Load(const float* Data) { return { vld1q_f32(Data) }; }
+		inline void Store(float* Data, const FFloat4 A) { vst1q_f32(Data, A.V); }
+		inline FFloat4 Set1(const float Value) { return { vdupq_n_f32(Value) }; }
+
+		inline FFloat4 Add(const FFloat4 A, const FFloat4 B) { return { vaddq_f32(A.V, B.V) }; }
+		inline FFloat4 Sub(const FFloat4 A, const FFloat4 B) { return { vsubq_f32(A.V, B.V) }; }
+		inline FFloat4 Mul(const FFloat4 A, const FFloat4 B) { return { vmulq_f32(A.V, B.V) }; }
+		inline FFloat4 Div(const FFloat4 A, const FFloat4 B) { return { vdivq_f32(A.V, B.V) }; }
+		inline FFloat4 Min(const FFloat4 A, const FFloat4 B) { return { vminq_f32(A.V, B.V) }; }
+		inline FFloat4 Max(const FFloat4 A, const FFloat4 B) { return { vmaxq_f32(A.V, B.V) }; }
+
+		inline FFloat4 CompareLess(const FFloat4 A, const FFloat4 B) { return { vreinterpretq_f32_u32(vcltq_f32(A.V, B.V)) }; }
+
+		inline FFloat4 Select(const FFloat4 Mask, const FFloat4 A, const FFloat4 B)
+		{
+			return { vbslq_f32(vreinterpretq_u32_f32(Mask.V), A.V, B.V) };
+		}
+
+#else
+
+		struct FFloat4 { float V[4]; };
+
+		inline FFloat4 Load(const float* Data) { return { { Data[0], Data[1], Data[2], Data[3] } }; }
+		inline void Store(float* Data, const FFloat4 A) { for(int i = 0; i < 4; i++) Data[i] = A.V[i]; }
+		inline FFloat4 Set1(const float Value) { return { { Value, Value, Value, Value } }; }
+
+		template<typename FunctionType>
+		FFloat4 PerLane(const FFloat4 A, const FFloat4 B, FunctionType Function)
+		{
+			FFloat4 Result;
+			for(int i = 0; i < 4; i++)
+				Result.V[i] = Function(A.V[i], B.V[i]);
+			return Result;
+		}
+
+		inline FFloat4 Add(const FFloat4 A, const FFloat4 B) { return PerLane(A, B, [](float X, float Y) { return X + Y; }); }
+		inline FFloat4 Sub(const FFloat4 A, const FFloat4 B) { return PerLane(A, B, [](float X, float Y) { return X - Y; }); }
+		inline FFloat4 Mul(const FFloat4 A, const FFloat4 B) { return PerLane(A, B, [](float X, float Y) { return X * Y; }); }
+		inline FFloat4 Div(const FFloat4 A, const FFloat4 B) { return PerLane(A, B, [](float X, float Y) { return X / Y; }); }
+		inline FFloat4 Min(const FFloat4 A, const FFloat4 B) { return PerLane(A, B, [](float X, float Y) { return std::min(X, Y); }); }
+		inline FFloat4 Max(const FFloat4 A, const FFloat4 B) { return PerLane(A, B, [](float X, float Y) { return std::max(X, Y); }); }
+
+		// Non zero in lanes where A < B
+		inline FFloat4 CompareLess(const FFloat4 A, const FFloat4 B) { return PerLane(A, B, [](float X, float Y) { return X < Y ? 1.f : 0.f; }); }
+
+		inline FFloat4 Select(const FFloat4 Mask, const FFloat4 A, const FFloat4 B)
+		{
+			FFloat4 Result;
+			for(int i = 0; i < 4; i++)
+				Result.V[i] = Mask.V[i] != 0 ? A.V[i] : B.V[i];
+			return Result;
+		}
+
+#endif
+
+		inline FFloat4 Clamp(const FFloat4 A, const FFloat4 MinValue, const FFloat4 MaxValue) { return Min(Max(A, MinValue), MaxValue); }
+	}
+}
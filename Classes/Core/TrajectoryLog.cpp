@@ -0,0 +1,123 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "TrajectoryLog.h"
+
+namespace AudioCore
+{
+	namespace
+	{
+		constexpr uint32_t TrajectoryFileMagic = 0x4A525441; // "ATRJ"
+		constexpr uint32_t TrajectoryFileVersion = 1;
+
+		// Per source flags saying which fields follow
+		enum ESourceFlags : uint8_t
+		{
+			SourceFlag_Position = 1 << 0,
+			SourceFlag_Falloff = 1 << 1,
+			SourceFlag_RecordedPath = 1 << 2,
+		};
+
+		bool IsSameLocation(const FVec3& A, const FVec3& B)
+		{
+			return A.X == B.X && A.Y == B.Y && A.Z == B.Z;
+		}
+	}
+
+	FTrajectoryWriter::FTrajectoryWriter(const uint64_t GridHash, const float NodeDiameter)
+	{
+		Writer.WriteU32(TrajectoryFileMagic);
+		Writer.WriteU32(TrajectoryFileVersion);
+		Writer.WriteU64(GridHash);
+		Writer.WriteFloat(NodeDiameter);
+	}
+
+	void FTrajectoryWriter::WriteFrame(const FTrajectoryFrame& Frame)
+	{
+		Writer.WriteFloat(Frame.DeltaTime);
+		Writer.WriteVec3(Frame.ListenerLocation);
+		Writer.WriteVec3(Frame.CameraLocation);
+		Writer.WriteVarUInt(Frame.Sources.size());
+
+		for(const FTrajectorySource& Source : Frame.Sources)
+		{
+			const auto Last = LastSources.find(Source.Id);
+			const bool bNew = Last == LastSources.end();
+
+			uint8_t Flags = 0;
+			if(bNew || !IsSameLocation(Last->second.Position, Source.Position))
+				Flags |= SourceFlag_Position;
+			if(bNew || Last->second.FalloffDistance != Source.FalloffDistance)
+				Flags |= SourceFlag_Falloff;
+			if(Source.RecordedPathLength >= 0)
+				Flags |= SourceFlag_RecordedPath;
+
+			Writer.WriteVarUInt(Source.Id);
+			Writer.WriteU8(Flags);
+			if(Flags & SourceFlag_Position)
+				Writer.WriteVec3(Source.Position);
+			if(Flags & SourceFlag_Falloff)
+				Writer.WriteFloat(Source.FalloffDistance);
+			if(Flags & SourceFlag_RecordedPath)
+			{
+				Writer.WriteVarUInt(static_cast<uint64_t>(Source.RecordedPathLength));
+				Writer.WriteVarInt(Source.RecordedPropagatedIndex);
+			}
+
+			LastSources[Source.Id] = Source;
+		}
+
+		NumFrames++;
+	}
+
+	FTrajectoryReader::FTrajectoryReader(const uint8_t* Data, const size_t Size) : Reader(Data, Size)
+	{
+	}
+
+	bool FTrajectoryReader::ReadHeader()
+	{
+		if(Reader.ReadU32() != TrajectoryFileMagic || Reader.ReadU32() != TrajectoryFileVersion)
+			return false;
+
+		GridHash = Reader.ReadU64();
+		NodeDiameter = Reader.ReadFloat();
+		return !Reader.HasError();
+	}
+
+	bool FTrajectoryReader::ReadFrame(FTrajectoryFrame& OutFrame)
+	{
+		if(Reader.IsAtEnd() || Reader.HasError())
+			return false;
+
+		OutFrame.DeltaTime = Reader.ReadFloat();
+		OutFrame.ListenerLocation = Reader.ReadVec3();
+		OutFrame.CameraLocation = Reader.ReadVec3();
+
+		const uint64_t NumSources = Reader.ReadVarUInt();
+		OutFrame.Sources.clear();
+		for(uint64_t i = 0; i < NumSources && !Reader.HasError(); i++)
+		{
+			const uint32_t Id = static_cast<uint32_t>(Reader.ReadVarUInt());
+			const uint8_t Flags = Reader.ReadU8();
+
+			// Start from the last known state and overwrite what was written this frame
+			FTrajectorySource& Source = LastSources[Id];
+			Source.Id = Id;
+			if(Flags & SourceFlag_Position)
+				Source.Position = Reader.ReadVec3();
+			if(Flags & SourceFlag_Falloff)
+				Source.FalloffDistance = Reader.ReadFloat();
+
+			Source.RecordedPathLength = -1;
+			Source.RecordedPropagatedIndex = InvalidIndex;
+			if(Flags & SourceFlag_RecordedPath)
+			{
+				Source.RecordedPathLength = static_cast<int>(Reader.ReadVarUInt());
+				Source.RecordedPropagatedIndex = static_cast<int>(Reader.ReadVarInt());
+			}
+
+			OutFrame.Sources.push_back(Source);
+		}
+
+		return !Reader.HasError();
+	}
+}
@@ -0,0 +1,85 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "BinaryStream.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace AudioCore
+{
+	// One audio source in a recorded frame
+	struct FTrajectorySource
+	{
+		// Stable for the whole recording, assigned by the recorder
+		uint32_t Id = 0;
+
+		FVec3 Position;
+
+		float FalloffDistance = 0;
+
+		// What the game's propagation computed this frame, -1 if it had no path. The index is the one the node has with
+		// the Linear cell layout
+		int RecordedPathLength = -1;
+		int RecordedPropagatedIndex = InvalidIndex;
+	};
+
+	// Everything the propagation and occlusion pipeline reads in one tick
+	struct FTrajectoryFrame
+	{
+		float DeltaTime = 0;
+		FVec3 ListenerLocation;
+		FVec3 CameraLocation;
+		std::vector<FTrajectorySource> Sources;
+	};
+
+	/*
+	 * Writes frames to a compact binary log. Source positions and falloffs are only written when they change (most
+	 * sources never move) and integers are varints
+	 */
+	class FTrajectoryWriter
+	{
+	public:
+		// The grid hash ties the log to the grid it was recorded on, see GetGridHash
+		FTrajectoryWriter(const uint64_t GridHash, const float NodeDiameter);
+
+		void WriteFrame(const FTrajectoryFrame& Frame);
+
+		const std::vector<uint8_t>& GetBuffer() const { return Writer.GetBuffer(); }
+
+		int GetNumFrames() const { return NumFrames; }
+
+	private:
+		FByteWriter Writer;
+
+		// Last written state per source id
+		std::unordered_map<uint32_t, FTrajectorySource> LastSources;
+
+		int NumFrames = 0;
+	};
+
+	// Reads a log written by FTrajectoryWriter. The data has to outlive the reader
+	class FTrajectoryReader
+	{
+	public:
+		FTrajectoryReader(const uint8_t* Data, const size_t Size);
+
+		// Returns false if the data is not a trajectory log
+		bool ReadHeader();
+
+		uint64_t GetGridHash() const { return GridHash; }
+		float GetNodeDiameter() const { return NodeDiameter; }
+
+		// Returns false at the end of the log or on corrupt data
+		bool ReadFrame(FTrajectoryFrame& OutFrame);
+
+	private:
+		FByteReader Reader;
+
+		uint64_t GridHash = 0;
+		float NodeDiameter = 0;
+
+		std::unordered_map<uint32_t, FTrajectorySource> LastSources;
+	};
+}
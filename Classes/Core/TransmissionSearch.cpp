@@ -0,0 +1,162 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "TransmissionSearch.h"
+
+#include "GridRaycast.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace AudioCore
+{
+	FTransmissionSearch::FTransmissionSearch(const FOccupancyGrid& InGrid, const FGridTransmission& InTransmission) : Grid(InGrid), Transmission(InTransmission)
+	{
+	}
+
+	bool FTransmissionSearch::Search(const int SourceIndex, const int ListenerIndex, const FVec3& SourceLocation, const FVec3& ListenerLocation,
+		const FTransmissionSettings& Settings, FTransmissionResult& OutResult, std::vector<int>& OutPath)
+	{
+		BeginSearch();
+		OutResult = FTransmissionResult();
+		OutPath.clear();
+
+		// The straight line decides the low pass, and the direct sound unless the route finds less occlusion
+		const FTransmissionTraceResult StraightLine = TraceTransmission(Grid, Transmission, ListenerLocation, SourceLocation);
+		OutResult.DistanceToWall = StraightLine.FirstHitDistance;
+		OutResult.DirectOcclusion = StraightLine.Occlusion;
+
+		const float MaxDistance = Settings.MaxDistance > 0 ? Settings.MaxDistance : std::numeric_limits<float>::max();
+		const float InvDiameter = 1.f / Grid.GetNodeDiameter();
+
+		// Straight line distance to the listener's cell, no step is shorter than it so the route is still the cheapest
+		const FVec3 ListenerCenter = Grid.IndexToWorld(ListenerIndex);
+		const auto GetHeuristic = [&](const int Index) { return FVec3::Dist(Grid.IndexToWorld(Index), ListenerCenter); };
+
+		OpenedGeneration[SourceIndex] = Generation;
+		Costs[SourceIndex] = 0;
+		Distances[SourceIndex] = 0;
+		Occlusions[SourceIndex] = 0;
+		Parents[SourceIndex] = InvalidIndex;
+		OpenSet.push_back({ GetHeuristic(SourceIndex), 0, SourceIndex });
+
+		bool bFound = false;
+		while(!OpenSet.empty())
+		{
+			std::pop_heap(OpenSet.begin(), OpenSet.end());
+			const FOpenEntry Current = OpenSet.back();
+			OpenSet.pop_back();
+
+			// Already expanded or a cheaper way to it was found after this entry was pushed
+			if(ClosedGeneration[Current.Index] == Generation || Current.Cost != Costs[Current.Index])
+				continue;
+
+			ClosedGeneration[Current.Index] = Generation;
+			LastStats.NodesExpanded++;
+
+			if(Current.Index == ListenerIndex)
+			{
+				bFound = true;
+				break;
+			}
+
+			if(Distances[Current.Index] > MaxDistance)
+				continue;
+
+			const uint8_t BoundaryMask = Neighbours.GetBoundaryMask(Current.Index);
+			for(int Direction = 0; Direction < TGridNeighbours<26>::NumDirections; Direction++)
+			{
+				if(!Neighbours.IsInside(BoundaryMask, Direction))
+					continue;
+
+				const int Neighbour = Neighbours.GetNeighbour(Current.Index, Direction);
+				if(ClosedGeneration[Neighbour] == Generation)
+					continue;
+
+				// The listener's own cell is always entered, it can be inside the edge of a wall
+				const bool bBlocked = !Grid.IsWalkable(Neighbour) && Neighbour != ListenerIndex;
+				if(bBlocked && Transmission.IsOpaque(Neighbour))
+					continue;
+
+				const float StepOcclusion = bBlocked ? Transmission.GetOcclusion(Neighbour) * StepLengths[Direction] * InvDiameter : 0;
+				const float NewCost = Costs[Current.Index] + StepLengths[Direction] + StepOcclusion * Settings.OcclusionDistance;
+				if(OpenedGeneration[Neighbour] == Generation && NewCost >= Costs[Neighbour])
+					continue;
+
+				OpenedGeneration[Neighbour] = Generation;
+				Costs[Neighbour] = NewCost;
+				Distances[Neighbour] = Distances[Current.Index] + StepLengths[Direction];
+				Occlusions[Neighbour] = Occlusions[Current.Index] + StepOcclusion;
+				Parents[Neighbour] = Current.Index;
+				OpenSet.push_back({ NewCost + GetHeuristic(Neighbour), NewCost, Neighbour });
+				std::push_heap(OpenSet.begin(), OpenSet.end());
+			}
+		}
+
+		if(!bFound)
+			return false;
+
+		for(int Index = ListenerIndex; Index != SourceIndex; Index = Parents[Index])
+			OutPath.push_back(Index);
+
+		OutResult.bFound = true;
+		OutResult.RouteDistance = Distances[ListenerIndex];
+		OutResult.RouteOcclusion = Occlusions[ListenerIndex];
+
+		// Through a wall is cheaper than any way around it, there is nothing to propagate
+		if(OutResult.RouteOcclusion > 0)
+			OutResult.DirectOcclusion = std::min(OutResult.DirectOcclusion, OutResult.RouteOcclusion);
+		else
+			FindOpening(ListenerIndex, OutPath, OutResult);
+
+		return true;
+	}
+
+	void FTransmissionSearch::BeginSearch()
+	{
+		if(!Neighbours.IsBuiltFor(Grid))
+			Neighbours.Init(Grid);
+
+		for(int Direction = 0; Direction < TGridNeighbours<26>::NumDirections; Direction++)
+			StepLengths[Direction] = Grid.GetNodeDiameter() * std::sqrt(static_cast<float>(Neighbours.GetDistanceSquared(Direction)));
+
+		const size_t NumCells = static_cast<size_t>(Grid.Num());
+		if(Costs.size() != NumCells)
+		{
+			Costs.assign(NumCells, 0);
+			Distances.assign(NumCells, 0);
+			Occlusions.assign(NumCells, 0);
+			Parents.assign(NumCells, InvalidIndex);
+			OpenedGeneration.assign(NumCells, 0);
+			ClosedGeneration.assign(NumCells, 0);
+			Generation = 0;
+		}
+
+		// Generation wrapped around, old stamps could be mistaken for this search's so clear them
+		if(++Generation == 0)
+		{
+			std::fill(OpenedGeneration.begin(), OpenedGeneration.end(), 0);
+			std::fill(ClosedGeneration.begin(), ClosedGeneration.end(), 0);
+			Generation = 1;
+		}
+
+		OpenSet.clear();
+		LastStats = FTransmissionSearchStats();
+	}
+
+	void FTransmissionSearch::FindOpening(const int ListenerIndex, const std::vector<int>& Path, FTransmissionResult& OutResult)
+	{
+		// Walked from the listener, the cell before the first one the listener cannot see is where the sound comes from
+		const FVec3 ListenerCenter = Grid.IndexToWorld(ListenerIndex);
+		for(size_t i = 1; i < Path.size(); i++)
+		{
+			LastStats.VisibilityTests++;
+			if(HasLineOfSight(Grid, Grid.IndexToWorld(Path[i]), ListenerCenter))
+				continue;
+
+			OutResult.OpeningIndex = Path[i - 1];
+			OutResult.OpeningPathSize = static_cast<int>(Path.size());
+			return;
+		}
+	}
+}
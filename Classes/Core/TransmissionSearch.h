@@ -0,0 +1,119 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "GridNeighbours.h"
+#include "GridTransmission.h"
+#include "OccupancyGrid.h"
+
+#include <vector>
+
+namespace AudioCore
+{
+	struct FTransmissionSettings
+	{
+		/* How many world units longer a route around the walls may be than going through walls that occlude the sound
+		 * fully before going through is cheaper. A route's cost is its length plus this times the occlusion it picks up */
+		float OcclusionDistance = 1000.f;
+
+		// Routes longer than this (in world units) are not searched, 0 searches the whole grid
+		float MaxDistance = 0.f;
+	};
+
+	// How a source is heard by the listener, decided by one search
+	struct FTransmissionResult
+	{
+		// If the search reached the listener at all, without a route the sound is only heard through the straight line
+		bool bFound = false;
+
+		/* Occlusion of the sound heard from the source itself (unclamped, see GetOccludedVolume). The straight line's, or
+		 * the route's if it goes through walls and picks up less on the way */
+		float DirectOcclusion = 0;
+
+		// Distance from the listener to the first blocked cell on the straight line to the source, for the low pass
+		float DistanceToWall = 0;
+
+		/* The cell the sound is propagated to if the route goes around every wall, the first one on it the listener can
+		 * see, and the size of the route (see FPropagationOpening::PathSize). InvalidIndex if the route goes through a
+		 * wall, the direct sound is all that is heard then */
+		int OpeningIndex = InvalidIndex;
+		int OpeningPathSize = 0;
+
+		// Length of the route in world units and the occlusion it picks up
+		float RouteDistance = 0;
+		float RouteOcclusion = 0;
+	};
+
+	struct FTransmissionSearchStats
+	{
+		int NodesExpanded = 0;
+
+		// Cells on the route tested for whether the listener sees them
+		int VisibilityTests = 0;
+	};
+
+	/*
+	 * A* from the source to the listener where walls are not impassable, a blocked cell that is not Opaque can be
+	 * crossed for the occlusion it adds (see FTransmissionSettings::OcclusionDistance). The cheapest route then decides
+	 * both what is heard: a route around every wall puts a propagated sound where the listener first sees it and leaves
+	 * the direct sound muffled by the walls on the straight line, a route through a wall means the direct sound muffled
+	 * by it is the best the listener gets. Line of sight is tested on the grid, so a source needs no traces besides the
+	 * one that finds it is blocked
+	 */
+	class FTransmissionSearch
+	{
+	public:
+		FTransmissionSearch(const FOccupancyGrid& InGrid, const FGridTransmission& InTransmission);
+
+		/* Searches from the source to the listener's cell and fills the result, the route is returned in OutPath in the
+		 * same order as TGridPathfinder::FindPath (from the listener's cell to the cell after the source's). Returns
+		 * false and empties the path if the listener cannot be reached */
+		bool Search(const int SourceIndex, const int ListenerIndex, const FVec3& SourceLocation, const FVec3& ListenerLocation,
+			const FTransmissionSettings& Settings, FTransmissionResult& OutResult, std::vector<int>& OutPath);
+
+		const FTransmissionSearchStats& GetLastStats() const { return LastStats; }
+
+		// Bytes of search state per grid cell
+		static constexpr int GetBytesPerNode() { return sizeof(float) * 3 + sizeof(int) + sizeof(uint32_t) * 2; }
+
+	private:
+
+		const FOccupancyGrid& Grid;
+
+		const FGridTransmission& Transmission;
+
+		TGridNeighbours<26> Neighbours;
+
+		// World distance of one step in each neighbour direction
+		float StepLengths[26] = {};
+
+		// Per cell search state, stamped with a generation like in FGridPathfinder
+		std::vector<float> Costs;
+		std::vector<float> Distances;
+		std::vector<float> Occlusions;
+		std::vector<int> Parents;
+		std::vector<uint32_t> OpenedGeneration;
+		std::vector<uint32_t> ClosedGeneration;
+
+		uint32_t Generation = 0;
+
+		struct FOpenEntry
+		{
+			float FCost;
+			float Cost;
+			int Index;
+
+			// std heaps are max heaps, so the cheapest cell has to compare as the largest
+			bool operator<(const FOpenEntry& Other) const { return FCost > Other.FCost; }
+		};
+
+		std::vector<FOpenEntry> OpenSet;
+
+		FTransmissionSearchStats LastStats;
+
+		void BeginSearch();
+
+		// Finds the opening on an open route, the same way the propagation walks its path with line traces
+		void FindOpening(const int ListenerIndex, const std::vector<int>& Path, FTransmissionResult& OutResult);
+	};
+}
@@ -17,20 +17,12 @@ public:
 
 	FVector GetWorldCoordinate() const { return WorldCoordinate; }
 
-	// Will be used to keep track of the path, where the previous/next node is 
-	FGridNode* Parent = nullptr; 
-
 	// Grid index(es) (the array), can prob be made private and have getters 
 	int GridX = -1;
 	int GridY = -1;
 	int GridZ = -1;
 
-	// costs 
-	int GCost = -1; // cost to get to the this node from start (or cost to start node)
-	int HCost = -1; // estimated cost to get to target from this node 
-
-	// F cost, sum of GCost and HCost 
-	int GetFCost() const { return GCost + HCost; }
+	// NOTE: search state (costs and parents) is kept by AudioCore::FGridPathfinder and not in the nodes 
 	
 private:
 
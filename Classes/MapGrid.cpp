@@ -2,8 +2,75 @@
 
 #include "MapGrid.h"
 
+#include "AudioCoreConversions.h"
+#include "AudioSystemStats.h"
+#include "Core/CollisionMesh.h"
+#include "Core/GridSerialization.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetSystemLibrary.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "PhysicsEngine/BodySetup.h"
+#include "StaticMeshResources.h"
+
+namespace
+{
+	// Vertices of the shape in world space 
+	AudioCore::FCollisionBody MakeTransformedBody(const TArray<FVector>& Vertices, const TArray<int32>& Indices, const FTransform& Transform, const bool bClosed)
+	{
+		AudioCore::FCollisionBody Body; 
+		Body.bClosed = bClosed; 
+		for(const FVector& Vertex : Vertices)
+			Body.Vertices.push_back(ToCoreVector(Transform.TransformPosition(Vertex))); 
+		Body.Indices.assign(Indices.GetData(), Indices.GetData() + Indices.Num()); 
+		return Body; 
+	}
+
+	// A capsule along Z (a sphere if HalfLength is 0) as triangles, its faces are slightly inside the real shape 
+	AudioCore::FCollisionBody MakeSphylBody(const FTransform& Transform, const float Radius, const float HalfLength)
+	{
+		constexpr int Segments = 16; 
+		constexpr int RingsPerCap = 4; 
+
+		// Rings from the bottom pole to the top one, the equator is there twice with the cylinder between them 
+		TArray<FVector> Vertices; 
+		Vertices.Add(FVector(0, 0, -HalfLength - Radius)); 
+		for(int Ring = 1; Ring <= RingsPerCap * 2; Ring++)
+		{
+			const int Step = Ring <= RingsPerCap ? Ring : Ring - 1; 
+			const float Angle = PI * Step / (RingsPerCap * 2) - HALF_PI; 
+			const float Offset = Ring <= RingsPerCap ? -HalfLength : HalfLength; 
+			for(int Segment = 0; Segment < Segments; Segment++)
+			{
+				const float SegmentAngle = 2 * PI * Segment / Segments; 
+				Vertices.Add(FVector(FMath::Cos(SegmentAngle) * FMath::Cos(Angle) * Radius, FMath::Sin(SegmentAngle) * FMath::Cos(Angle) * Radius, FMath::Sin(Angle) * Radius + Offset)); 
+			}
+		}
+		Vertices.Add(FVector(0, 0, HalfLength + Radius)); 
+
+		const int NumRings = (Vertices.Num() - 2) / Segments; 
+		const auto GetVertex = [&](const int Ring, const int Segment) { return 1 + Ring * Segments + Segment % Segments; }; 
+
+		TArray<int32> Indices; 
+		for(int Segment = 0; Segment < Segments; Segment++)
+		{
+			Indices.Append({ 0, GetVertex(0, Segment + 1), GetVertex(0, Segment) }); 
+			Indices.Append({ Vertices.Num() - 1, GetVertex(NumRings - 1, Segment), GetVertex(NumRings - 1, Segment + 1) }); 
+			for(int Ring = 0; Ring < NumRings - 1; Ring++)
+			{
+				Indices.Append({ GetVertex(Ring, Segment), GetVertex(Ring, Segment + 1), GetVertex(Ring + 1, Segment + 1) }); 
+				Indices.Append({ GetVertex(Ring, Segment), GetVertex(Ring + 1, Segment + 1), GetVertex(Ring + 1, Segment) }); 
+			}
+		}
+
+		return MakeTransformedBody(Vertices, Indices, Transform, true); 
+	}
+}
 
 // Sets default values
 AMapGrid::AMapGrid()
@@ -30,35 +97,44 @@ void AMapGrid::BeginPlay()
 	if(bDrawGridNodes && !bDrawOnlyBoxExtentOnTick) 
 		DrawDebugStuff();
 
-	// Only enable tick if debugging grid size 
-	SetActorTickEnabled(bDrawOnlyBoxExtentOnTick); 
+	// Only enable tick if debugging grid size or drawing the nodes around the listener 
+	SetActorTickEnabled(bDrawOnlyBoxExtentOnTick || bDrawGridNodes); 
 }
 
 void AMapGrid::Tick(float DeltaSeconds)
 {
 	Super::Tick(DeltaSeconds);
+
+	if(!bDrawOnlyBoxExtentOnTick)
+	{
+		UpdateDebugNodes(); 
+		return; 
+	}
 	
 	DrawDebugBox(GetWorld(), GetActorLocation() + FVector::UpVector * (GridSize.Z / 2), GridSize / 2, FColor::Red, false, -1, 0, 10); 
 }
 
 void AMapGrid::CreateGrid()
 {
-	GridArrayLengthX = FMath::RoundToInt(GridSize.X / NodeDiameter); 
-	GridArrayLengthY = FMath::RoundToInt(GridSize.Y / NodeDiameter); 
-	GridArrayLengthZ = FMath::RoundToInt(GridSize.Z / NodeDiameter); 
+	AUDIO_SYSTEM_SCOPED_TIMER(GridBake); 
+	const double BakeStartTime = FPlatformTime::Seconds(); 
+	
+	int GridArrayLengthX, GridArrayLengthY, GridArrayLengthZ; 
+	FVector GridBottomLeft; 
+	GetGridLayout(GridArrayLengthX, GridArrayLengthY, GridArrayLengthZ, GridBottomLeft); 
 
-	Nodes = new FGridNode[GridArrayLengthX * GridArrayLengthY * GridArrayLengthZ]; 
+	GridBottomLeftLocation = GridBottomLeft; 
 
-	// The grid's pivot is in the center, need its position as if pivot was in the bottom left corner 
-	FVector GridBottomLeft = GetActorLocation();
-	GridBottomLeft.X -= GridSize.X / 2;
-	GridBottomLeft.Y -= GridSize.Y / 2;
-	//GridBottomLeft.Z -= GridSize.Z / 2; // Is Z already correct? 
+	const AudioCore::ECellLayout Layout = bBrickCellLayout ? AudioCore::ECellLayout::Bricks : AudioCore::ECellLayout::Linear; 
+	OccupancyGrid.Init(GridArrayLengthX, GridArrayLengthY, GridArrayLengthZ, NodeDiameter, ToCoreVector(GridBottomLeft), Layout); 
 
-	GridBottomLeftLocation = GridBottomLeft; 
+	// Same indexes as the occupancy grid, including its padding with the brick layout 
+	Nodes = new FGridNode[OccupancyGrid.Num()]; 
+
+	// Walkability from the offline bake if there is one, saves one overlap per node 
+	AudioCore::FOccupancyGrid VoxelizedGrid; 
+	const bool bUseVoxelizedGrid = LoadVoxelizedGrid(VoxelizedGrid); 
 
-	TArray<AActor*> ActorsToIgnore; 
-	
 	for(int x = 0; x < GridArrayLengthX; x++)
 	{
 		for(int y = 0; y < GridArrayLengthY; y++)
@@ -70,106 +146,373 @@ void AMapGrid::CreateGrid()
 				NodePos.Y += y * NodeDiameter + NodeRadius;
 				NodePos.Z += z * NodeDiameter + NodeRadius; // Pos now in node center 
 
-				// Check overlap to see if the node is un-walkable 
-				TArray<AActor*> OverlappingActors; 
-				UKismetSystemLibrary::SphereOverlapActors(this, NodePos, NodeRadius, AudioBlockingObjects, AActor::StaticClass(), ActorsToIgnore, OverlappingActors);
-
-				AddToArray(x, y, z, FGridNode(OverlappingActors.IsEmpty(), NodePos, x, y, z));
+				const bool bWalkable = bUseVoxelizedGrid ? VoxelizedGrid.IsWalkable(VoxelizedGrid.GetIndex(x, y, z)) : IsNodeWalkable(NodePos); 
+				AddToArray(x, y, z, FGridNode(bWalkable, NodePos, x, y, z));
 			}
 		}
 	}
+
+	NeighbourTable.Init(OccupancyGrid); 
+	GridLevels.Build(OccupancyGrid, NumCoarseLevels); 
+	GridRegions.Build(OccupancyGrid); 
+	NearestWalkable.Build(OccupancyGrid); 
+
+	// Only the blocked nodes have a material, the walkable ones let everything through 
+	Transmission.Init(OccupancyGrid); 
+	if(bBakeTransmission)
+	{
+		for(int Index = 0; Index < OccupancyGrid.Num(); Index++)
+		{
+			// Padding of the brick layout stays opaque 
+			const AudioCore::FGridCoord Coord = OccupancyGrid.GetCoord(Index); 
+			if(!OccupancyGrid.IsWalkable(Index) && !OccupancyGrid.IsOutOfBounds(Coord.X, Coord.Y, Coord.Z))
+				Transmission.SetOcclusion(Index, GetNodeOcclusion(Nodes[Index].GetWorldCoordinate())); 
+		}
+	}
+	Landmarks.Build(OccupancyGrid, NumLandmarks, FPlatformMisc::NumberOfWorkerThreadsToSpawn()); 
+
+	if(bBakeWallDistance)
+		WallDistance.Build(OccupancyGrid, FPlatformMisc::NumberOfWorkerThreadsToSpawn()); 
+
+	GridHash = AudioCore::GetGridHash(OccupancyGrid); 
+
+	UE_LOG(LogTemp, Log, TEXT("Grid baked %i nodes in %.2f ms, %i connected regions"), OccupancyGrid.Num(), (FPlatformTime::Seconds() - BakeStartTime) * 1000, GridRegions.NumRegions())
 }
 
-int AMapGrid::GetIndex (const int IndexX, const int IndexY, const int IndexZ) const
+void AMapGrid::GetGridLayout(int& OutLengthX, int& OutLengthY, int& OutLengthZ, FVector& OutBottomLeft) const
 {
-	// Source: https://stackoverflow.com/a/34363187 (reworked) 
-	return IndexX * GridArrayLengthY * GridArrayLengthZ + IndexZ * GridArrayLengthY + IndexY; 
+	// NodeDiameter is only set in BeginPlay, the collision can be exported before that 
+	OutLengthX = FMath::RoundToInt(GridSize.X / (NodeRadius * 2)); 
+	OutLengthY = FMath::RoundToInt(GridSize.Y / (NodeRadius * 2)); 
+	OutLengthZ = FMath::RoundToInt(GridSize.Z / (NodeRadius * 2)); 
+
+	// The grid's pivot is in the center, need its position as if pivot was in the bottom left corner 
+	OutBottomLeft = GetActorLocation();
+	OutBottomLeft.X -= GridSize.X / 2;
+	OutBottomLeft.Y -= GridSize.Y / 2;
+	//OutBottomLeft.Z -= GridSize.Z / 2; // Is Z already correct? 
 }
 
-void AMapGrid::AddToArray(const int IndexX, const int IndexY, const int IndexZ, const FGridNode Node)
+bool AMapGrid::LoadVoxelizedGrid(AudioCore::FOccupancyGrid& OutGrid) const
 {
-	Nodes[GetIndex(IndexX, IndexY, IndexZ)] = Node;
+	if(VoxelizedGridFile.FilePath.IsEmpty())
+		return false; 
+
+	const FString FilePath = FPaths::IsRelative(VoxelizedGridFile.FilePath) ? FPaths::ProjectDir() / VoxelizedGridFile.FilePath : VoxelizedGridFile.FilePath; 
+	TArray<uint8> Data; 
+	if(!FFileHelper::LoadFileToArray(Data, *FilePath) || !AudioCore::LoadGrid(Data.GetData(), Data.Num(), OutGrid))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Could not load the voxelized grid %s, baking with overlaps instead"), *FilePath)
+		return false; 
+	}
+
+	// Has to be made from the collision exported for this grid 
+	const bool bSameLayout = OutGrid.GetLengthX() == OccupancyGrid.GetLengthX() && OutGrid.GetLengthY() == OccupancyGrid.GetLengthY() && OutGrid.GetLengthZ() == OccupancyGrid.GetLengthZ()
+		&& FMath::IsNearlyEqual(OutGrid.GetNodeDiameter(), OccupancyGrid.GetNodeDiameter()) && FromCoreVector(OutGrid.GetBottomLeft()).Equals(GridBottomLeftLocation, 1.f); 
+	if(!bSameLayout)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("The voxelized grid %s was made for another grid size or location, baking with overlaps instead"), *FilePath)
+		return false; 
+	}
+
+	return true; 
 }
 
-FGridNode* AMapGrid::GetNodeFromArray(const int IndexX, const int IndexY, const int IndexZ) const
+bool AMapGrid::IsNodeWalkable(const FVector& NodePos) const
 {
-	return &Nodes[GetIndex(IndexX, IndexY, IndexZ)]; 
+	// Check overlap to see if the node is un-walkable 
+	const TArray<AActor*> ActorsToIgnore; 
+	TArray<AActor*> OverlappingActors; 
+	UKismetSystemLibrary::SphereOverlapActors(this, NodePos, NodeRadius, AudioBlockingObjects, AActor::StaticClass(), ActorsToIgnore, OverlappingActors);
+	return OverlappingActors.IsEmpty(); 
 }
 
-FGridNode* AMapGrid::GetNodeFromWorldLocation(const FVector WorldLoc) const
+float AMapGrid::GetNodeOcclusion(const FVector& NodePos) const
 {
-	// Get coordinates relative to the grid's bottom left corner 
-	FVector GridRelative = WorldLoc - GridBottomLeftLocation;
-	
-	// checks how many nodes "fit" in the relative position for array indexes 
-	GridRelative = (GridRelative - NodeRadius) / NodeDiameter;
+	const TArray<AActor*> ActorsToIgnore; 
+	TArray<UPrimitiveComponent*> OverlappingComps; 
+	UKismetSystemLibrary::SphereOverlapComponents(this, NodePos, NodeRadius, AudioBlockingObjects, UPrimitiveComponent::StaticClass(), ActorsToIgnore, OverlappingComps);
+
+	// The material values are looked up the same way as the occlusion component does for its hits 
+	float MaterialValue = OverlappingComps.IsEmpty() ? 1 : 0; 
+	for(const UPrimitiveComponent* Comp : OverlappingComps)
+	{
+		TArray<UMaterialInterface*> Materials; 
+		Comp->GetUsedMaterials(Materials); 
 
-	// Clamp the result between array index bounds 
-	const int x = FMath::Clamp(FMath::RoundToInt(GridRelative.X), 0, GridArrayLengthX - 1); 
-	const int y = FMath::Clamp(FMath::RoundToInt(GridRelative.Y), 0, GridArrayLengthY - 1); 
-	const int z = FMath::Clamp(FMath::RoundToInt(GridRelative.Z), 0, GridArrayLengthZ - 1); 
+		float CompValue = 1; 
+		for(const UMaterialInterface* Material : Materials)
+		{
+			if(const float* Value = MaterialOcclusionMap.Find(Material))
+			{
+				CompValue = *Value; 
+				break; 
+			}
+		}
 
-	return GetNodeFromArray(x, y, z); 
+		MaterialValue = FMath::Max(MaterialValue, CompValue); 
+	}
+
+	return AudioCore::GetCellOcclusion(NodeDiameter, MaterialValue, MaxMeshDistanceToBlockAllAudio); 
 }
 
-TArray<FGridNode*> AMapGrid::GetNeighbours(const FGridNode* Node) const
+void AMapGrid::UpdateGridInArea(const FBox& Area)
 {
-	TArray<FGridNode*> Neighbours;
+	AUDIO_SYSTEM_SCOPED_TIMER(GridBake); 
 
-	// -1 to plus 1 in each direction to get every neighbour node 
-	for(int x = -1; x <= 1; x++)
+	// Nodes whose centers are inside the area, clamped to the grid 
+	const AudioCore::FGridCoord Min = OccupancyGrid.WorldToCoord(ToCoreVector(Area.Min)); 
+	const AudioCore::FGridCoord Max = OccupancyGrid.WorldToCoord(ToCoreVector(Area.Max)); 
+
+	std::vector<int> ChangedNodes; 
+	FChangedBox ChangedBox { Max, Min }; 
+	for(int x = Min.X; x <= Max.X; x++)
 	{
-		for(int y = -1; y <= 1; y++)
+		for(int y = Min.Y; y <= Max.Y; y++)
 		{
-			for(int z = -1; z <= 1; z++)
+			for(int z = Min.Z; z <= Max.Z; z++)
 			{
-				if(x == 0 && y == 0 && z == 0) // itself 
-					continue;
-
-				const int GridX = Node->GridX + x; // Grid indexes 
-				const int GridY = Node->GridY + y;
-				const int GridZ = Node->GridZ + z; 
-
-				// if any index is out of bounds 
-				if(IsOutOfBounds(GridX, GridY, GridZ))
+				const FGridNode* Node = GetNodeFromArray(x, y, z); 
+				const bool bWalkable = IsNodeWalkable(Node->GetWorldCoordinate()); 
+				if(bWalkable == Node->IsWalkable())
 					continue;
 
-				Neighbours.Add(GetNodeFromArray(GridX, GridY, GridZ));
+				AddToArray(x, y, z, FGridNode(bWalkable, Node->GetWorldCoordinate(), x, y, z)); 
+				ChangedNodes.push_back(GetIndex(x, y, z)); 
+				ChangedBox.Min = AudioCore::FGridCoord(FMath::Min(ChangedBox.Min.X, x), FMath::Min(ChangedBox.Min.Y, y), FMath::Min(ChangedBox.Min.Z, z)); 
+				ChangedBox.Max = AudioCore::FGridCoord(FMath::Max(ChangedBox.Max.X, x), FMath::Max(ChangedBox.Max.Y, y), FMath::Max(ChangedBox.Max.Z, z)); 
+
+				if(bWalkable)
+					Transmission.SetOcclusion(GetIndex(x, y, z), 0); 
+				else if(bBakeTransmission)
+					Transmission.SetOcclusion(GetIndex(x, y, z), GetNodeOcclusion(Node->GetWorldCoordinate())); 
+				else
+					Transmission.SetOcclusion(GetIndex(x, y, z), 1); 
 			}
 		}
 	}
 
-	return Neighbours; 
+	if(ChangedNodes.empty())
+		return; 
+
+	GridRegions.UpdateCells(ChangedNodes); 
+	NearestWalkable.UpdateCells(ChangedNodes); 
+
+	// The coarse levels are updated in place, the pathfinders searching them keep references to them. The landmark and
+	// wall distances can change anywhere so they are built again 
+	GridLevels.UpdateCells(ChangedNodes); 
+	Landmarks.Build(OccupancyGrid, NumLandmarks, FPlatformMisc::NumberOfWorkerThreadsToSpawn()); 
+	if(bBakeWallDistance)
+		WallDistance.Build(OccupancyGrid, FPlatformMisc::NumberOfWorkerThreadsToSpawn()); 
+
+	GridHash = AudioCore::GetGridHash(OccupancyGrid); 
+	ChangedBoxes.Add(ChangedBox); 
+	GridVersion++; 
 }
 
-bool AMapGrid::IsOutOfBounds(const int GridX, const int GridY, const int GridZ) const
+bool AMapGrid::HasChangedInBox(const int SinceVersion, const AudioCore::FGridCoord& Min, const AudioCore::FGridCoord& Max) const
 {
-	return GridX < 0 || GridX > GridArrayLengthX - 1 || GridY < 0 || GridY > GridArrayLengthY - 1 || GridZ < 0 || GridZ > GridArrayLengthZ - 1; 
+	for(int Version = SinceVersion; Version < ChangedBoxes.Num(); Version++)
+	{
+		const FChangedBox& Box = ChangedBoxes[Version]; 
+		if(Box.Min.X <= Max.X && Box.Max.X >= Min.X && Box.Min.Y <= Max.Y && Box.Max.Y >= Min.Y && Box.Min.Z <= Max.Z && Box.Max.Z >= Min.Z)
+			return true; 
+	}
+
+	return false; 
 }
 
-void AMapGrid::DrawDebugStuff() const
+bool AMapGrid::ExportGrid(FString& OutFilePath) const
 {
-	// Draw border of grid 
-	DrawDebugBox(GetWorld(), GetActorLocation() + FVector::UpVector * (GridSize.Z / 2), GridSize / 2, FColor::Red, false, -1, 0, 10); 
+	OutFilePath = FPaths::ProjectSavedDir() / TEXT("AudioSystem") / FString::Printf(TEXT("Grid_%016llx.agrid"), GridHash); 
 
-	// draw each node where un-walkable (audio blocking) nodes are red and walkable green 
-	for(int x = 0; x < GridArrayLengthX; x++)
+	const std::vector<uint8_t> Data = AudioCore::SaveGrid(OccupancyGrid); 
+	return FFileHelper::SaveArrayToFile(TArrayView<const uint8>(Data.data(), static_cast<int32>(Data.size())), *OutFilePath); 
+}
+
+bool AMapGrid::ExportCollisionMesh(FString& OutFilePath) const
+{
+	AudioCore::FCollisionMesh Mesh; 
+	FVector GridBottomLeft; 
+	GetGridLayout(Mesh.LengthX, Mesh.LengthY, Mesh.LengthZ, GridBottomLeft); 
+	Mesh.NodeDiameter = NodeRadius * 2; 
+	Mesh.BottomLeft = ToCoreVector(GridBottomLeft); 
+
+	// Everything that could overlap a node's sphere 
+	const TArray<AActor*> ActorsToIgnore; 
+	TArray<UPrimitiveComponent*> Components; 
+	UKismetSystemLibrary::BoxOverlapComponents(this, GetActorLocation() + FVector::UpVector * (GridSize.Z / 2), GridSize / 2 + FVector(NodeRadius), AudioBlockingObjects, UPrimitiveComponent::StaticClass(), ActorsToIgnore, Components); 
+
+	int NumSkipped = 0; 
+	for(const UPrimitiveComponent* Component : Components)
 	{
-		for(int y = 0; y < GridArrayLengthY; y++)
+		const UBodySetup* BodySetup = Component->GetBodySetup(); 
+		if(!BodySetup)
+			continue;
+
+		const FTransform& ComponentTransform = Component->GetComponentTransform(); 
+
+		// Overlaps are tested against the triangles of complex collision, which only has a surface 
+		if(BodySetup->GetCollisionTraceFlag() == CTF_UseComplexAsSimple)
 		{
-			for(int z = 0; z < GridArrayLengthZ; z++)
+			const UStaticMeshComponent* MeshComponent = Cast<UStaticMeshComponent>(Component); 
+			const UStaticMesh* StaticMesh = MeshComponent ? MeshComponent->GetStaticMesh() : nullptr; 
+			if(!StaticMesh || !StaticMesh->GetRenderData() || StaticMesh->GetRenderData()->LODResources.IsEmpty())
 			{
-				const FGridNode* Node = GetNodeFromArray(x, y, z);
-				FColor Color = Node->IsWalkable() ? FColor::Green : FColor::Red; 
-				DrawDebugBox(GetWorld(), Node->GetWorldCoordinate(), FVector(NodeRadius, NodeRadius, 1), Color, true);
+				NumSkipped++; 
+				continue;
 			}
+
+			const FStaticMeshLODResources& LOD = StaticMesh->GetRenderData()->LODResources[0]; 
+			TArray<FVector> Vertices; 
+			for(uint32 Vertex = 0; Vertex < LOD.VertexBuffers.PositionVertexBuffer.GetNumVertices(); Vertex++)
+				Vertices.Add(FVector(LOD.VertexBuffers.PositionVertexBuffer.VertexPosition(Vertex))); 
+
+			TArray<uint32> MeshIndices; 
+			LOD.IndexBuffer.GetCopy(MeshIndices); 
+			TArray<int32> Indices; 
+			for(const uint32 Index : MeshIndices)
+				Indices.Add(static_cast<int32>(Index)); 
+
+			Mesh.Bodies.push_back(MakeTransformedBody(Vertices, Indices, ComponentTransform, false)); 
+			continue;
 		}
+
+		const FKAggregateGeom& Geometry = BodySetup->AggGeom; 
+		for(const FKBoxElem& Box : Geometry.BoxElems)
+		{
+			const FTransform Transform = Box.GetTransform() * ComponentTransform; 
+			Mesh.Bodies.push_back(AudioCore::MakeBoxBody(ToCoreVector(Transform.GetLocation()), ToCoreVector(Transform.TransformVector(FVector(Box.X / 2, 0, 0))),
+				ToCoreVector(Transform.TransformVector(FVector(0, Box.Y / 2, 0))), ToCoreVector(Transform.TransformVector(FVector(0, 0, Box.Z / 2))))); 
+		}
+
+		for(const FKSphereElem& Sphere : Geometry.SphereElems)
+			Mesh.Bodies.push_back(MakeSphylBody(Sphere.GetTransform() * ComponentTransform, Sphere.Radius, 0)); 
+
+		for(const FKSphylElem& Sphyl : Geometry.SphylElems)
+			Mesh.Bodies.push_back(MakeSphylBody(Sphyl.GetTransform() * ComponentTransform, Sphyl.Radius, Sphyl.Length / 2)); 
+
+		for(const FKConvexElem& Convex : Geometry.ConvexElems)
+			Mesh.Bodies.push_back(MakeTransformedBody(Convex.VertexData, Convex.IndexData, Convex.GetTransform() * ComponentTransform, true)); 
+
+		NumSkipped += Geometry.TaperedCapsuleElems.Num() + Geometry.LevelSetElems.Num(); 
 	}
 
+	if(NumSkipped > 0)
+		UE_LOG(LogTemp, Warning, TEXT("%i collision shapes could not be exported, the voxelized grid will not block audio there"), NumSkipped)
+
+	OutFilePath = FPaths::ProjectSavedDir() / TEXT("AudioSystem") / FString::Printf(TEXT("Collision_%s.acol"), *GetWorld()->GetMapName()); 
+
+	const std::vector<uint8_t> Data = AudioCore::SaveCollisionMesh(Mesh); 
+	return FFileHelper::SaveArrayToFile(TArrayView<const uint8>(Data.data(), static_cast<int32>(Data.size())), *OutFilePath); 
+}
+
+int AMapGrid::GetIndex (const int IndexX, const int IndexY, const int IndexZ) const
+{
+	return OccupancyGrid.GetIndex(IndexX, IndexY, IndexZ); 
+}
+
+void AMapGrid::AddToArray(const int IndexX, const int IndexY, const int IndexZ, const FGridNode Node)
+{
+	const int Index = GetIndex(IndexX, IndexY, IndexZ); 
+	Nodes[Index] = Node;
+	OccupancyGrid.SetWalkable(Index, Node.IsWalkable()); 
+}
+
+FGridNode* AMapGrid::GetNodeFromArray(const int IndexX, const int IndexY, const int IndexZ) const
+{
+	return &Nodes[GetIndex(IndexX, IndexY, IndexZ)]; 
+}
+
+FGridNode* AMapGrid::GetNodeFromWorldLocation(const FVector WorldLoc) const
+{
+	// Clamped between array index bounds by the occupancy grid 
+	return GetNodeFromIndex(OccupancyGrid.WorldToIndex(ToCoreVector(WorldLoc))); 
+}
+
+bool AMapGrid::IsOutOfBounds(const int GridX, const int GridY, const int GridZ) const
+{
+	return OccupancyGrid.IsOutOfBounds(GridX, GridY, GridZ); 
+}
+
+void AMapGrid::DrawDebugStuff()
+{
+	// Draw border of grid 
+	DrawDebugBox(GetWorld(), GetActorLocation() + FVector::UpVector * (GridSize.Z / 2), GridSize / 2, FColor::Red, false, -1, 0, 10); 
+
+	// Un-walkable (audio blocking) nodes are red and walkable green, the nodes to draw are picked on tick 
+	WalkableNodeInstances = CreateNodeInstances(FLinearColor::Green); 
+	BlockedNodeInstances = CreateNodeInstances(FLinearColor::Red); 
+
 	// prints some stuff 
 	UE_LOG(LogTemp, Warning, TEXT("diameter: %f"), NodeDiameter)
-	UE_LOG(LogTemp, Warning, TEXT("Grid Length: (X: %i, Y: %i, Z: %i)"), GridArrayLengthX, GridArrayLengthY, GridArrayLengthZ)
+	UE_LOG(LogTemp, Warning, TEXT("Grid Length: (X: %i, Y: %i, Z: %i)"), OccupancyGrid.GetLengthX(), OccupancyGrid.GetLengthY(), OccupancyGrid.GetLengthZ())
 	UE_LOG(LogTemp, Warning, TEXT("GridSize: %s"), *GridSize.ToString())
 
-	UE_LOG(LogTemp, Warning, TEXT("Number of nodes: %i"), GridArrayLengthX * GridArrayLengthY * GridArrayLengthZ)
+	UE_LOG(LogTemp, Warning, TEXT("Number of nodes: %i"), OccupancyGrid.Num())
+}
+
+void AMapGrid::UpdateDebugNodes()
+{
+	// The listener is the player's camera 
+	const APlayerCameraManager* CameraManager = UGameplayStatics::GetPlayerCameraManager(this, 0); 
+	if(!CameraManager || !WalkableNodeInstances || !BlockedNodeInstances)
+		return; 
+
+	AudioCore::FGridCoord Center = OccupancyGrid.WorldToCoord(ToCoreVector(CameraManager->GetCameraLocation())); 
+	if(GridDebugView == EGridDebugView::ZSlice)
+		Center.Z = FMath::Clamp(DebugSliceZ, 0, OccupancyGrid.GetLengthZ() - 1); 
+
+	// Still in the same node, the same nodes would be picked 
+	if(Center == DebugCenter && DebugGridVersion == GridVersion)
+		return; 
+
+	DebugCenter = Center; 
+	DebugGridVersion = GridVersion; 
+
+	AudioCore::FGridCoord Min(Center.X - DebugRadius, Center.Y - DebugRadius, Center.Z - DebugRadius); 
+	AudioCore::FGridCoord Max(Center.X + DebugRadius, Center.Y + DebugRadius, Center.Z + DebugRadius); 
+	if(GridDebugView == EGridDebugView::ZSlice)
+	{
+		Min = AudioCore::FGridCoord(0, 0, Center.Z); 
+		Max = AudioCore::FGridCoord(OccupancyGrid.GetLengthX() - 1, OccupancyGrid.GetLengthY() - 1, Center.Z); 
+	}
+
+	AudioCore::CollectDebugCells(OccupancyGrid, Center, Min, Max, MaxDebugNodes, bDrawWalkableNodes, DebugCells); 
+	SetNodeInstances(WalkableNodeInstances, DebugCells.WalkableCells); 
+	SetNodeInstances(BlockedNodeInstances, DebugCells.BlockedCells); 
+
+	if(DebugCells.bCapped && !bDebugNodesCapped)
+		UE_LOG(LogTemp, Warning, TEXT("Drawing only the %i grid nodes closest to the listener, see MaxDebugNodes"), MaxDebugNodes)
+
+	bDebugNodesCapped = DebugCells.bCapped; 
+}
+
+UInstancedStaticMeshComponent* AMapGrid::CreateNodeInstances(const FLinearColor& Color)
+{
+	UInstancedStaticMeshComponent* Instances = NewObject<UInstancedStaticMeshComponent>(this); 
+	Instances->SetStaticMesh(LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"))); 
+	Instances->SetCollisionEnabled(ECollisionEnabled::NoCollision); 
+	Instances->SetCastShadow(false); 
+
+	// The basic shapes' material has a colour parameter 
+	if(UMaterialInstanceDynamic* Material = Instances->CreateAndSetMaterialInstanceDynamic(0))
+		Material->SetVectorParameterValue(TEXT("Color"), Color); 
+
+	Instances->RegisterComponent(); 
+	return Instances; 
+}
+
+void AMapGrid::SetNodeInstances(UInstancedStaticMeshComponent* Instances, const std::vector<int>& Cells) const
+{
+	// Flat boxes a bit smaller than the node so neighbouring nodes can be told apart, the cube mesh is 100 units wide 
+	const FVector Scale(NodeDiameter * 0.009f, NodeDiameter * 0.009f, 0.02f); 
+
+	TArray<FTransform> Transforms; 
+	Transforms.Reserve(static_cast<int32>(Cells.size())); 
+	for(const int Cell : Cells)
+		Transforms.Add(FTransform(FQuat::Identity, GetNodeFromIndex(Cell)->GetWorldCoordinate(), Scale)); 
+
+	Instances->ClearInstances(); 
+	Instances->AddInstances(Transforms, false, true); 
 }
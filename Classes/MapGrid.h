@@ -4,9 +4,31 @@
 
 #include "CoreMinimal.h"
 #include "GridNode.h"
+#include "Core/GridDebugView.h"
+#include "Core/GridLandmarks.h"
+#include "Core/GridLevels.h"
+#include "Core/GridNearestWalkable.h"
+#include "Core/GridNeighbours.h"
+#include "Core/GridRegions.h"
+#include "Core/GridTransmission.h"
+#include "Core/GridWallDistance.h"
+#include "Core/OccupancyGrid.h"
 #include "GameFramework/Actor.h"
 #include "MapGrid.generated.h"
 
+// Every node has 26 neighbours (including diagonals) 
+using FGridNeighbourTable = AudioCore::TGridNeighbours<26>; 
+
+// Which nodes are drawn when the grid's nodes are drawn 
+UENUM()
+enum class EGridDebugView : uint8
+{
+	// The nodes within DebugRadius nodes of the listener, follows the listener 
+	AroundListener,
+	// One layer of nodes at DebugSliceZ, the closest to the listener first if there are more than MaxDebugNodes 
+	ZSlice
+};
+
 UCLASS()
 class GRIM_API AMapGrid : public AActor
 {
@@ -33,14 +55,67 @@ public:
 
 	FVector GetGridSize() const { return GridSize; }
 	
-	TArray<FGridNode*> GetNeighbours(const FGridNode* Node) const;
+	// Allocation free lookup of a node's neighbour indexes, built when the grid is created. Iterate a node's neighbours
+	// with GetNeighbourTable().GetNeighbours(Index) 
+	const FGridNeighbourTable& GetNeighbourTable() const { return NeighbourTable; }
+
+	// The engine independent walkability data, indexes into it are the same as for the nodes 
+	const AudioCore::FOccupancyGrid& GetOccupancyGrid() const { return OccupancyGrid; }
+
+	// The occupancy grid (level 0) and its coarser levels, used to search faster for sources far from the listener 
+	const AudioCore::FGridLevels& GetGridLevels() const { return GridLevels; }
+
+	// Which nodes are connected to each other, used to skip searches between nodes no path can connect 
+	const AudioCore::FGridRegions& GetGridRegions() const { return GridRegions; }
+
+	// Distances to the landmark nodes, empty unless NumLandmarks is set 
+	const AudioCore::FGridLandmarks& GetLandmarks() const { return Landmarks; }
+
+	// The walkable node closest to each blocked node near walkable space, used when the listener is in a blocked node 
+	const AudioCore::FGridNearestWalkable& GetNearestWalkable() const { return NearestWalkable; }
 
-	// Temporary bool to know if to draw path, will be removed 
+	// How much sound each blocked node lets through, every blocked node is opaque unless bBakeTransmission is set 
+	const AudioCore::FGridTransmission& GetTransmission() const { return Transmission; }
+
+	// Distance from every node to the nearest blocked node, not built unless bBakeWallDistance is set 
+	const AudioCore::FGridWallDistance& GetWallDistance() const { return WallDistance; }
+
+	/* Bakes the nodes inside the area again, call after the geometry in it has changed (e.g. a door opened or closed).
+	 * Only the connected regions the changed nodes touch are labelled again */
+	UFUNCTION(BlueprintCallable)
+	void UpdateGridInArea(const FBox& Area);
+
+	// Changes every time the grid is updated, cached paths from an older version may go through geometry that changed 
+	int GetGridVersion() const { return GridVersion; }
+
+	// True if a node inside the box (inclusive) has changed since the grid version, data that only covers the box is
+	// still valid otherwise 
+	bool HasChangedInBox(const int SinceVersion, const AudioCore::FGridCoord& Min, const AudioCore::FGridCoord& Max) const;
+
+	FGridNode* GetNodeFromIndex(const int Index) const { return &Nodes[Index]; }
+
+	int GetNodeIndex(const FGridNode* Node) const { return static_cast<int>(Node - Nodes); }
+
+	// Draws the sounds' cached paths, read once per tick by the sound propagation component 
 	UPROPERTY(EditAnywhere)
 	bool bDrawPath = true;
 
 	float GetNodeDiameter() const { return NodeDiameter; }
 
+	// Identifies the baked grid, stored in recordings so they are replayed against the same grid 
+	uint64 GetGridHash() const { return GridHash; }
+
+	/* Saves the baked grid to Saved/AudioSystem/Grid_<hash>.agrid so it can be loaded by the headless tools.
+	 * Returns false if the file could not be written */
+	UFUNCTION(BlueprintCallable)
+	bool ExportGrid(FString& OutFilePath) const;
+
+	/* Saves the static collision blocking audio inside the grid to Saved/AudioSystem/Collision_<map>.acol, to voxelize
+	 * the grid offline with Headless/GridVoxelize instead of one sphere overlap per node. Simple collision shapes are
+	 * exported as solids and complex collision as surfaces. Returns false if the file could not be written */
+	UFUNCTION(BlueprintCallable)
+	bool ExportCollisionMesh(FString& OutFilePath) const;
+
 private:
 
 #pragma region DataMembers
@@ -48,7 +123,55 @@ private:
 	// 1D array (will be used as if it was 3D) keeping track of all nodes,
 	// Unreal does not seem to like creating 3D arrays with Array[][][]
 	// https://stackoverflow.com/a/34363187 (source to convert 3D array to 1D) 
-	FGridNode* Nodes; 
+	FGridNode* Nodes = nullptr; 
+
+	// Holds the array sizes and walkability of every node, shared with the pathfinding 
+	AudioCore::FOccupancyGrid OccupancyGrid; 
+
+	FGridNeighbourTable NeighbourTable; 
+
+	AudioCore::FGridLevels GridLevels; 
+
+	AudioCore::FGridRegions GridRegions; 
+
+	AudioCore::FGridLandmarks Landmarks; 
+
+	AudioCore::FGridNearestWalkable NearestWalkable; 
+
+	AudioCore::FGridTransmission Transmission; 
+
+	AudioCore::FGridWallDistance WallDistance; 
+
+	int GridVersion = 0; 
+
+	// The box around the nodes every grid update changed, indexed by the version the update was made on 
+	struct FChangedBox
+	{
+		AudioCore::FGridCoord Min;
+		AudioCore::FGridCoord Max;
+	};
+
+	TArray<FChangedBox> ChangedBoxes; 
+
+	// How many coarser levels to build on top of the grid during the bake, each has 8 times fewer nodes than the one
+	// below it. A coarse node only blocks audio if all of the nodes it covers do 
+	UPROPERTY(EditAnywhere, meta=(ClampMin=0, ClampMax=4))
+	int NumCoarseLevels = 2; 
+
+	// Landmark nodes to bake distances to (2 bytes per node each), the pathfinder uses them to expand far fewer nodes in
+	// levels with many walls and finds the shortest paths. 0 keeps the straight line heuristic 
+	UPROPERTY(EditAnywhere, meta=(ClampMin=0, ClampMax=8))
+	int NumLandmarks = 0; 
+
+	/* Bakes every node's distance to the nearest blocked node (2 bytes per node), the occlusion uses it for the
+	 * listener's distance to walls and the propagation's visibility tests skip the empty space with it */
+	UPROPERTY(EditAnywhere)
+	bool bBakeWallDistance = false; 
+
+	/* Stores the nodes in 4x4x4 bricks instead of rows so most of a node's neighbours are next to it in memory, which
+	 * makes searches on large grids faster. Grid sizes are padded to multiples of 4 nodes */
+	UPROPERTY(EditAnywhere)
+	bool bBrickCellLayout = false; 
 
 	// Radius for each node, smaller radius means more accurate but more performance expensive 
 	UPROPERTY(EditAnywhere)
@@ -60,23 +183,51 @@ private:
 	UPROPERTY(EditAnywhere) 
 	FVector GridSize = FVector(100, 100, 100); 
 
-	// Holds the array sizes 
-	int GridArrayLengthX; 
-	int GridArrayLengthY; 
-	int GridArrayLengthZ; 
-
 	FVector GridBottomLeftLocation; 
 
+	uint64 GridHash = 0; 
+
 	// Object that should be considered to block audio, default: world static 
 	UPROPERTY(EditAnywhere)
 	TArray<TEnumAsByte<EObjectTypeQuery>> AudioBlockingObjects { TEnumAsByte<EObjectTypeQuery>::EnumType::ObjectTypeQuery1 };
 
+	/* Bakes how much sound every blocked node lets through from the materials overlapping it, so the sound propagation's
+	 * transmission search can go through thin or soft walls. Costs one more overlap per blocked node */
+	UPROPERTY(EditAnywhere)
+	bool bBakeTransmission = false; 
+
+	// Same as the audio occlusion component's, materials with a custom occlusion multiplier. Others block with 1 
+	UPROPERTY(EditAnywhere, meta=(EditCondition="bBakeTransmission"))
+	TMap<UMaterialInterface*, float> MaterialOcclusionMap; 
+
+	// Same as the audio occlusion component's, how far audio can travel through a mesh until it is completely blocked 
+	UPROPERTY(EditAnywhere, meta=(EditCondition="bBakeTransmission"))
+	float MaxMeshDistanceToBlockAllAudio = 900.f; 
+
+	/* Grid voxelized offline by Headless/GridVoxelize (relative to the project folder), loaded instead of baking the
+	 * nodes with sphere overlaps. Ignored if it was made for a grid with another size or location. Updates with
+	 * UpdateGridInArea still use overlaps */
+	UPROPERTY(EditAnywhere, meta=(FilePathFilter="agrid"))
+	FFilePath VoxelizedGridFile; 
+
 #pragma endregion 
 
 #pragma region Functions 
 
 	void CreateGrid();
 
+	// Number of nodes along each axis and where the grid starts, from the grid's size and location 
+	void GetGridLayout(int& OutLengthX, int& OutLengthY, int& OutLengthZ, FVector& OutBottomLeft) const;
+
+	// Loads VoxelizedGridFile, returns false if it is not set or does not match the grid 
+	bool LoadVoxelizedGrid(AudioCore::FOccupancyGrid& OutGrid) const;
+
+	// Does the sphere overlap at the node's location, a node is walkable if nothing blocking audio overlaps it 
+	bool IsNodeWalkable(const FVector& NodePos) const;
+
+	// Occlusion of sound passing through the blocked node, from the material of the meshes overlapping it that blocks most 
+	float GetNodeOcclusion(const FVector& NodePos) const;
+
 	void AddToArray(const int IndexX, const int IndexY, const int IndexZ, const FGridNode Node);
 
 	FGridNode* GetNodeFromArray(const int IndexX, const int IndexY, const int IndexZ) const;
@@ -92,13 +243,58 @@ private:
 	// Draws the grid's nodes if true, red nodes block audio, green ones do not 
 	UPROPERTY(EditAnywhere)
 	bool bDrawGridNodes = true; 
+
+	// Draws the nodes around the listener or one layer of them, large grids have far too many nodes to draw them all 
+	UPROPERTY(EditAnywhere)
+	EGridDebugView GridDebugView = EGridDebugView::AroundListener; 
+
+	// How many nodes from the listener's node along each axis are drawn with AroundListener 
+	UPROPERTY(EditAnywhere, meta=(ClampMin=0))
+	int DebugRadius = 12; 
+
+	// The layer of nodes drawn with ZSlice, counted from the bottom of the grid 
+	UPROPERTY(EditAnywhere, meta=(ClampMin=0))
+	int DebugSliceZ = 0; 
+
+	// Walkable nodes are only drawn if set, they are most of the grid and hide the blocked ones 
+	UPROPERTY(EditAnywhere)
+	bool bDrawWalkableNodes = false; 
+
+	// The most nodes drawn at once, the ones closest to the listener are drawn 
+	UPROPERTY(EditAnywhere, meta=(ClampMin=1))
+	int MaxDebugNodes = 20000; 
 	
 	// Determines if the grid's extent should be drawn on tick for easier use in determining what size it should be 
 	// Note: all other debug is disabled if this is active 
 	UPROPERTY(EditAnywhere) 
 	bool bDrawOnlyBoxExtentOnTick = false; 
+
+	// The drawn nodes as instances of one mesh per colour, so they are two draw calls however many nodes are drawn 
+	UPROPERTY()
+	class UInstancedStaticMeshComponent* WalkableNodeInstances = nullptr; 
+
+	UPROPERTY()
+	class UInstancedStaticMeshComponent* BlockedNodeInstances = nullptr; 
+
+	// The nodes currently drawn, reused between updates 
+	AudioCore::FGridDebugCells DebugCells; 
+
+	// Where the drawn nodes were picked from and for which grid version, they are only picked again when either changes 
+	AudioCore::FGridCoord DebugCenter; 
+	int DebugGridVersion = -1; 
+
+	// If the last update drew fewer nodes than it picked from, only the update that first caps them logs it 
+	bool bDebugNodesCapped = false; 
 	
-	void DrawDebugStuff() const;
+	void DrawDebugStuff();
+
+	// Picks the nodes to draw again if the listener has moved to another node or the grid has changed 
+	void UpdateDebugNodes(); 
+
+	UInstancedStaticMeshComponent* CreateNodeInstances(const FLinearColor& Color); 
+
+	// Replaces the instances with one flat box per node 
+	void SetNodeInstances(UInstancedStaticMeshComponent* Instances, const std::vector<int>& Cells) const; 
 
 #pragma endregion
 	
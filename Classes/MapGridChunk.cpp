@@ -0,0 +1,93 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MapGridChunk.h"
+
+#include "AudioCoreConversions.h"
+#include "AudioSystemStats.h"
+#include "ChunkedGridSubsystem.h"
+#include "Core/GridSerialization.h"
+#include "Kismet/KismetSystemLibrary.h"
+
+AMapGridChunk::AMapGridChunk()
+{
+	// Chunks only hold data, nothing to tick 
+	PrimaryActorTick.bCanEverTick = false;
+}
+
+void AMapGridChunk::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Not baked in the editor, bake it now so the chunk still works but warn since it stalls the streaming 
+	if(BakedChunk.IsEmpty())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Grid chunk %s has not been baked, baking it on load"), *GetActorNameOrLabel())
+		BakeChunk(); 
+	}
+
+	if(UChunkedGridSubsystem* Subsystem = GetWorld()->GetSubsystem<UChunkedGridSubsystem>())
+		Subsystem->RegisterChunk(this); 
+
+	if(bDrawChunkExtent)
+	{
+		const FVector Extent = FVector(ChunkSize * GetNodeDiameter() / 2); 
+		DrawDebugBox(GetWorld(), GetChunkBottomLeft() + Extent, Extent, FColor::Blue, true, -1, 0, 10); 
+	}
+}
+
+void AMapGridChunk::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// Level is streamed out, its nodes are no longer searched 
+	if(UChunkedGridSubsystem* Subsystem = GetWorld()->GetSubsystem<UChunkedGridSubsystem>())
+		Subsystem->UnregisterChunk(this); 
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AMapGridChunk::BakeChunk()
+{
+	AUDIO_SYSTEM_SCOPED_TIMER(GridBake); 
+	
+	const std::vector<uint8_t> Data = AudioCore::SaveGrid(CreateChunkGrid()); 
+	BakedChunk = TArray<uint8>(Data.data(), static_cast<int32>(Data.size())); 
+
+	// So the baked data is saved with the level 
+	Modify(); 
+}
+
+bool AMapGridChunk::GetBakedGrid(AudioCore::FOccupancyGrid& OutGrid) const
+{
+	if(!AudioCore::LoadGrid(BakedChunk.GetData(), BakedChunk.Num(), OutGrid))
+		return false;
+
+	// Settings were changed after the bake 
+	return OutGrid.GetLengthX() == ChunkSize && OutGrid.GetNodeDiameter() == GetNodeDiameter(); 
+}
+
+AudioCore::FOccupancyGrid AMapGridChunk::CreateChunkGrid() const
+{
+	const FVector BottomLeft = GetChunkBottomLeft(); 
+	const float NodeDiameter = GetNodeDiameter(); 
+	
+	AudioCore::FOccupancyGrid ChunkGrid;
+	ChunkGrid.Init(ChunkSize, ChunkSize, ChunkSize, NodeDiameter, ToCoreVector(BottomLeft)); 
+
+	TArray<AActor*> ActorsToIgnore { const_cast<AMapGridChunk*>(this) }; 
+
+	for(int Index = 0; Index < ChunkGrid.Num(); Index++)
+	{
+		const FVector NodePos = FromCoreVector(ChunkGrid.IndexToWorld(Index)); 
+
+		// Check overlap to see if the node is un-walkable, same as AMapGrid::CreateGrid 
+		TArray<AActor*> OverlappingActors; 
+		UKismetSystemLibrary::SphereOverlapActors(this, NodePos, NodeRadius, AudioBlockingObjects, AActor::StaticClass(), ActorsToIgnore, OverlappingActors);
+		ChunkGrid.SetWalkable(Index, OverlappingActors.IsEmpty()); 
+	}
+
+	return ChunkGrid; 
+}
+
+FVector AMapGridChunk::GetChunkBottomLeft() const
+{
+	return GridOrigin + FVector(ChunkCoord) * (ChunkSize * GetNodeDiameter()); 
+}
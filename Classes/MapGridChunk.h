@@ -0,0 +1,93 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/OccupancyGrid.h"
+#include "GameFramework/Actor.h"
+#include "MapGridChunk.generated.h"
+
+/*
+ * One chunk of a streamed grid, used instead of AMapGrid in worlds that are too large for one grid. Place one in every
+ * streaming level (or World Partition cell) and bake it in the editor, the chunk is added to the world's
+ * UChunkedGridSubsystem when its level is loaded and removed when it is unloaded. Every chunk in a world has to use the
+ * same ChunkSize, NodeRadius and GridOrigin so the chunks line up and paths can cross from one to the next 
+ */
+UCLASS()
+class GRIM_API AMapGridChunk : public AActor
+{
+	GENERATED_BODY()
+	
+public:	
+	AMapGridChunk();
+
+protected:
+	virtual void BeginPlay() override;
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+public:
+
+	// Bakes the chunk's nodes with sphere overlaps and stores them in the actor so they are saved with the level 
+	UFUNCTION(CallInEditor, Category="Grid Chunk")
+	void BakeChunk();
+
+	// Reads the baked nodes, returns false if the chunk has not been baked or was baked with other settings 
+	bool GetBakedGrid(AudioCore::FOccupancyGrid& OutGrid) const;
+
+	FIntVector GetChunkCoord() const { return ChunkCoord; }
+
+	int GetChunkSize() const { return ChunkSize; }
+
+	float GetNodeDiameter() const { return NodeRadius * 2; }
+
+	FVector GetGridOrigin() const { return GridOrigin; }
+
+private:
+
+#pragma region DataMembers
+
+	// Which chunk this is, chunk (0, 0, 0) starts at GridOrigin and each chunk is ChunkSize nodes along every axis 
+	UPROPERTY(EditAnywhere, Category="Grid Chunk")
+	FIntVector ChunkCoord = FIntVector::ZeroValue; 
+
+	// Nodes along each axis of the chunk, same for every chunk in the world 
+	UPROPERTY(EditAnywhere, Category="Grid Chunk", meta=(ClampMin=4, ClampMax=128))
+	int ChunkSize = 32; 
+
+	// Same as AMapGrid::NodeRadius, same for every chunk in the world 
+	UPROPERTY(EditAnywhere, Category="Grid Chunk")
+	float NodeRadius = 50.f; 
+
+	// Bottom left corner of chunk (0, 0, 0), same for every chunk in the world 
+	UPROPERTY(EditAnywhere, Category="Grid Chunk")
+	FVector GridOrigin = FVector::ZeroVector; 
+
+	// Object that should be considered to block audio, default: world static 
+	UPROPERTY(EditAnywhere, Category="Grid Chunk")
+	TArray<TEnumAsByte<EObjectTypeQuery>> AudioBlockingObjects { TEnumAsByte<EObjectTypeQuery>::EnumType::ObjectTypeQuery1 };
+
+	// The baked nodes written by AudioCore::SaveGrid, a few kilobytes that are loaded without any traces 
+	UPROPERTY()
+	TArray<uint8> BakedChunk; 
+
+#pragma endregion
+
+#pragma region Functions
+
+	// Does the sphere overlaps for every node of the chunk 
+	AudioCore::FOccupancyGrid CreateChunkGrid() const;
+
+	FVector GetChunkBottomLeft() const;
+
+#pragma endregion
+
+#pragma region Debugging
+
+	// Draws the chunk's extent when it is loaded 
+	UPROPERTY(EditAnywhere, Category="Grid Chunk")
+	bool bDrawChunkExtent = false; 
+
+#pragma endregion
+	
+};
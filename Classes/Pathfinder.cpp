@@ -2,160 +2,344 @@
 
 
 #include "Pathfinder.h"
+#include "AudioSystemStats.h"
 #include "MapGrid.h"
+#include "AudioCoreConversions.h"
 #include "Kismet/KismetSystemLibrary.h"
 #include "SoundPropagationComponent.h"
+#include "Core/GridRaycast.h"
 
-// Tried overloading comparison operator (<) in GridNode class but did not seem to work,
-// using a predicate does seem to work even though it is somewhat clunkier
-namespace
+FPathfinder::FPathfinder(AMapGrid* Grid, AActor* Player, USoundPropagationComponent* PropComp) : Grid(Grid),
+	BidirectionalPathfinder(Grid->GetOccupancyGrid()), OpeningSearch(Grid->GetOccupancyGrid()),
+	TransmissionSearch(Grid->GetOccupancyGrid(), Grid->GetTransmission()), Player(Player), PropComp(PropComp)
 {
-	auto HeapPred = [](const FGridNode& Left, const FGridNode& Right)
+	const AudioCore::FGridLevels& Levels = Grid->GetGridLevels(); 
+	LevelPathfinders.reserve(Levels.Num()); 
+	SlicedPathfinders.reserve(Levels.Num()); 
+	for(int Level = 0; Level < Levels.Num(); Level++)
 	{
-		if(Left.GetFCost() == Right.GetFCost()) // If FCost is the same, check HCost 
-			return Left.HCost < Right.HCost; 
+		LevelPathfinders.emplace_back(Levels.GetLevel(Level)); 
+		SlicedPathfinders.emplace_back(Levels.GetLevel(Level)); 
+	}
 
-		// Otherwise, FCost decides priority 
-		return Left.GetFCost() < Right.GetFCost(); 
-	};
-}
+	// The landmarks are baked for the full resolution grid, the pathfinder ignores them if there are none 
+	LevelPathfinders[0].SetLandmarks(&Grid->GetLandmarks()); 
+	SlicedPathfinders[0].SetLandmarks(&Grid->GetLandmarks()); 
+	BidirectionalPathfinder.SetLandmarks(&Grid->GetLandmarks()); 
 
-FPathfinder::FPathfinder(AMapGrid* Grid, AActor* Player, USoundPropagationComponent* PropComp) : Grid(Grid), Player(Player), PropComp(PropComp)
-{
+	LastSearchStats = &LevelPathfinders[0].GetLastStats(); 
 }
 
-bool FPathfinder::FindPath(const FVector& From, const FVector& To, TArray<FGridNode*>& Path, bool& bOutPlayerHasMoved)
+EPathSearchResult FPathfinder::FindPath(const UAudioComponent* AudioComp, const FVector& From, const FVector& To, AudioCore::FPathArena& PathArena, AudioCore::FPathHandle& Path, int& OutPathLevel, const int Level)
 {
-	FGridNode* StartNode = Grid->GetNodeFromWorldLocation(From); 
-	FGridNode* EndNode = GetTargetNode(To);
-	
-	// Surely heap is most effective? TArray seems to have support functions for a heap 
-	TArray<FGridNode*> ToBeChecked; 
-	TSet<FGridNode*> Visited; // Only needs to keep track of which nodes have been visited, set should be effective 
+	AUDIO_SYSTEM_SCOPED_TIMER(FindPath); 
+
+	const bool bTimeSliced = PropComp->MaxNodesExpandedPerFrame > 0; 
 
-	// Target has not moved, simply return 
-	if(EndNode == OldEndNode)
+	// Every frame gets a new node budget and the unfinished search gets to use it first, so it is done within a
+	// bounded number of frames however many other audio comps search 
+	if(BudgetFrame != GFrameCounter)
 	{
-		bOutPlayerHasMoved = false; 
-		return true;
+		BudgetFrame = GFrameCounter; 
+		RemainingExpansions = bTimeSliced ? PropComp->MaxNodesExpandedPerFrame : MAX_int32; 
+		RemainingFieldRebakes = PropComp->MaxFieldRebakesPerFrame; 
+
+		// A changed grid could have made the path blocked, the owner starts a new search instead. A search that was done
+		// a frame ago without its owner asking for it is dropped too, the owner stopped searching (e.g. it is in sight) 
+		if(SlicedSearchOwner && (Grid->GetGridVersion() != SlicedSearchGridVersion || SlicedPathfinders[SlicedSearchLevel].GetStatus() != AudioCore::EGridSearchStatus::Searching))
+			SlicedSearchOwner = nullptr; 
+		
+		if(SlicedSearchOwner)
+			ContinueSearch(SlicedPathfinders[SlicedSearchLevel], SlicedPathIndices); 
 	}
 
-	bOutPlayerHasMoved = true; 
-	
-	// TODO: remove if, bad way of forcing path draw each frame by always updating the path 
-	if(!Grid->bDrawPath) 
-		OldEndNode = EndNode; 
+	// The audio comp's unfinished search is used even if the player has moved since it started, starting over whenever
+	// the player reaches another node would never finish while the player keeps moving 
+	if(SlicedSearchOwner == AudioComp)
+	{
+		const AudioCore::FGridPathfinder& SlicedPathfinder = SlicedPathfinders[SlicedSearchLevel]; 
+		if(SlicedPathfinder.GetStatus() == AudioCore::EGridSearchStatus::Searching)
+			return EPathSearchResult::Pending; 
 
-	// Reset the start node 
-	StartNode->GCost = 0;
-	StartNode->HCost = 0;
+		SlicedSearchOwner = nullptr; 
+		LastSearchStats = &SlicedPathfinder.GetLastStats(); 
 
-	// Add it to be checked 
-	ToBeChecked.HeapPush(StartNode, HeapPred);
+		if(SlicedPathfinder.GetStatus() != AudioCore::EGridSearchStatus::Found)
+		{
+			LastSearches.Remove(AudioComp); 
+			PathArena.SetPath(Path, nullptr, 0); 
+			return EPathSearchResult::NotFound; 
+		}
 
-	// While there are still nodes to check 
-	while(!ToBeChecked.IsEmpty())
+		LastSearches.Add(AudioComp, { SlicedSearchStartNode, SlicedSearchEndNode, SlicedSearchLevel, SlicedSearchGridVersion }); 
+		StorePath(SlicedSearchLevel, SlicedPathIndices, PathArena, Path); 
+		OutPathLevel = SlicedSearchLevel; 
+		return EPathSearchResult::Found; 
+	}
+	
+	FGridNode* StartNode = Grid->GetNodeFromWorldLocation(From); 
+	FGridNode* EndNode = GetTargetNode(To);
+	const int SearchLevel = FMath::Clamp(Level, 0, static_cast<int>(LevelPathfinders.size()) - 1); 
+	
+	// Neither end has moved (and the same level is searched on the same grid), the audio comp's last path is still valid 
+	const FLastSearch* LastSearch = LastSearches.Find(AudioComp); 
+	if(LastSearch && StartNode == LastSearch->StartNode && EndNode == LastSearch->EndNode && SearchLevel == LastSearch->Level && Grid->GetGridVersion() == LastSearch->GridVersion)
 	{
-		// Remove the node with highest priority (most promising path)
-		FGridNode* Current;
-		ToBeChecked.HeapPop(Current, HeapPred);
+		AUDIO_SYSTEM_INC_COUNTER(PathCacheHits, 1); 
+		OutPathLevel = LastSearch->Level; 
+		return EPathSearchResult::Found;
+	}
 
-		Visited.Add(Current);
+	// No path can connect nodes in different regions, no need to search every reachable node to find that out 
+	if(!Grid->GetGridRegions().CanReach(Grid->GetNodeIndex(StartNode), Grid->GetNodeIndex(EndNode)))
+	{
+		AUDIO_SYSTEM_INC_COUNTER(UnreachableRejections, 1); 
+		PathArena.SetPath(Path, nullptr, 0); 
+		return EPathSearchResult::NotFound; 
+	}
 
-		// If we have reached the end node, a path has been found 
-		if(Current == EndNode)
+	// Static audio comps follow their baked distance field down from the listener's node, no search needed 
+	if(FBakedDistanceField* Baked = DistanceFields.Find(AudioComp))
+	{
+		// Paths inside the field's box can only have changed if the grid changed inside it 
+		if(Baked->GridVersion != Grid->GetGridVersion() && !Grid->HasChangedInBox(Baked->GridVersion, Baked->Field.GetMin(), Baked->Field.GetMax()))
+			Baked->GridVersion = Grid->GetGridVersion(); 
+
+		// The others are baked again the same way, only a few per frame so one update does not bake every field at once 
+		if(Baked->GridVersion != Grid->GetGridVersion() && RemainingFieldRebakes > 0)
 		{
-			// Build the path and return 
-			Path = GetPath(StartNode, EndNode);
-			return true; 
+			RemainingFieldRebakes--; 
+			BakeDistanceField(AudioComp, Baked->MaxDistance); 
 		}
 
-		// For each neighbouring node 
-		for(const auto Neighbour : Grid->GetNeighbours(Current))
+		// Only used while the audio comp is where it was baked and the field is up to date, otherwise it is searched 
+		if(Baked->GridVersion == Grid->GetGridVersion() && Baked->Field.GetSourceIndex() == Grid->GetNodeIndex(StartNode))
 		{
-			// Check if it's walkable or has already been visited 
-			if(!Neighbour->IsWalkable() || Visited.Contains(Neighbour))
-				continue; // if so, skip it
+			AUDIO_SYSTEM_INC_COUNTER(DistanceFieldPaths, 1); 
+			if(!Baked->Field.GetPath(Grid->GetOccupancyGrid(), Grid->GetNodeIndex(EndNode), PathIndices))
+			{
+				LastSearches.Remove(AudioComp); 
+				PathArena.SetPath(Path, nullptr, 0); 
+				return EPathSearchResult::NotFound; 
+			}
 
-			// otherwise, calculate the GCost to neighbour
-			const int NewGCostToNeighbour = Current->GCost + GetCostToNode(Current, Neighbour); 
+			// Stored as level 0 so a cache hit reports the level the path is on 
+			LastSearches.Add(AudioComp, { StartNode, EndNode, 0, Grid->GetGridVersion() }); 
+			PathArena.SetPath(Path, PathIndices); 
+			OutPathLevel = 0; 
+			return EPathSearchResult::Found; 
+		}
+	}
 
-			// If new GCost is lower or it has not been added to be checked 
-			if(NewGCostToNeighbour < Neighbour->GCost || !ToBeChecked.Contains(Neighbour))
-			{
-				// Update its G- and HCost (and thus FCost as well)
-				Neighbour->GCost = NewGCostToNeighbour;
-				Neighbour->HCost = GetCostToNode(Neighbour, EndNode);
+	const AudioCore::FGridLevels& Levels = Grid->GetGridLevels(); 
 
-				// Set its parent to current to keep track of where we came from (shortest path to the node)
-				Neighbour->Parent = Current;
+	// The path is returned from the end node to the node after the start node, i.e. searched from the audio source but
+	// handled as if it is from the player 
+	const int StartIndex = Levels.GetCoarseIndex(SearchLevel, Grid->GetNodeIndex(StartNode));
+	const int EndIndex = Levels.GetCoarseIndex(SearchLevel, Grid->GetNodeIndex(EndNode)); 
+	
+	// Long paths on the full resolution grid are searched from both ends, the path comes back in the same order. It
+	// cannot be spread over several frames so it is not used with a node budget 
+	bool bFoundPath = false; 
+	if(!bTimeSliced && SearchLevel == 0 && PropComp->BidirectionalSearchDistance > 0 && FVector::Dist(From, To) >= PropComp->BidirectionalSearchDistance)
+	{
+		bFoundPath = BidirectionalPathfinder.FindPath(StartIndex, EndIndex, PathIndices); 
+		LastSearchStats = &BidirectionalPathfinder.GetLastStats(); 
+		AUDIO_SYSTEM_INC_COUNTER(NodesExpanded, LastSearchStats->NodesExpanded); 
+	}
+	else
+	{
+		// Only one search can be left unfinished. While another audio comp's is, a search that runs out of budget would be
+		// thrown away with every node it expanded, so it waits until that one is done instead of starting at all 
+		if(bTimeSliced && SlicedSearchOwner)
+		{
+			AUDIO_SYSTEM_INC_COUNTER(PendingSearches, 1); 
+			return EPathSearchResult::Pending; 
+		}
+		
+		AudioCore::FGridPathfinder& LevelPathfinder = bTimeSliced ? SlicedPathfinders[SearchLevel] : LevelPathfinders[SearchLevel]; 
+		std::vector<int>& Indices = bTimeSliced ? SlicedPathIndices : PathIndices; 
 
-				// Add neighbour to be checked if not already present 
-				if(!ToBeChecked.Contains(Neighbour))
-					ToBeChecked.HeapPush(Neighbour, HeapPred); 
-			}
+		LevelPathfinder.BeginPath(StartIndex, EndIndex); 
+		const AudioCore::EGridSearchStatus Status = ContinueSearch(LevelPathfinder, Indices); 
+		if(Status == AudioCore::EGridSearchStatus::Searching)
+		{
+			// Only happens with a budget 
+			AUDIO_SYSTEM_INC_COUNTER(PendingSearches, 1); 
+			SlicedSearchOwner = AudioComp; 
+			SlicedSearchLevel = SearchLevel; 
+			SlicedSearchGridVersion = Grid->GetGridVersion(); 
+			SlicedSearchStartNode = StartNode; 
+			SlicedSearchEndNode = EndNode; 
+			return EPathSearchResult::Pending; 
 		}
+
+		bFoundPath = Status == AudioCore::EGridSearchStatus::Found; 
+		LastSearchStats = &LevelPathfinder.GetLastStats(); 
+		if(bFoundPath && bTimeSliced)
+			PathIndices.swap(SlicedPathIndices); 
+	}
+	
+	if(!bFoundPath)
+	{
+		// No path found, clear path and return 
+		LastSearches.Remove(AudioComp); 
+		PathArena.SetPath(Path, nullptr, 0); 
+		return EPathSearchResult::NotFound; 
 	}
 
-	// No path found, clear path and return 
-	Path.Empty(); 
-	return false; 
+	LastSearches.Add(AudioComp, { StartNode, EndNode, SearchLevel, Grid->GetGridVersion() }); 
+	StorePath(SearchLevel, PathIndices, PathArena, Path); 
+	OutPathLevel = SearchLevel; 
+	return EPathSearchResult::Found; 
 }
 
-FGridNode* FPathfinder::GetTargetNode(const FVector& TargetLocation) const
+size_t FPathfinder::BakeDistanceField(const UAudioComponent* AudioComp, const float MaxDistance)
 {
-	FGridNode* TargetNode = Grid->GetNodeFromWorldLocation(TargetLocation);
+	FBakedDistanceField& Baked = DistanceFields.FindOrAdd(AudioComp); 
+	Baked.MaxDistance = MaxDistance; 
+	Baked.GridVersion = Grid->GetGridVersion(); 
 
-	const TArray<AActor*> ActorsToIgnore { Player }; 
+	const int SourceIndex = Grid->GetNodeIndex(Grid->GetNodeFromWorldLocation(AudioComp->GetComponentLocation())); 
+	Baked.Field.Build(Grid->GetOccupancyGrid(), SourceIndex, FMath::CeilToInt(MaxDistance / Grid->GetNodeDiameter())); 
+	return Baked.Field.GetMemoryUsage(); 
+}
+
+AudioCore::EGridSearchStatus FPathfinder::ContinueSearch(AudioCore::FGridPathfinder& LevelPathfinder, std::vector<int>& OutPathIndices)
+{
+	const int ExpandedBefore = LevelPathfinder.GetLastStats().NodesExpanded; 
+	const AudioCore::EGridSearchStatus Status = LevelPathfinder.ContinuePath(RemainingExpansions, OutPathIndices); 
+	const int Expanded = LevelPathfinder.GetLastStats().NodesExpanded - ExpandedBefore; 
+
+	// Without a budget it stays at MAX_int32 
+	if(PropComp->MaxNodesExpandedPerFrame > 0)
+		RemainingExpansions -= Expanded; 
 
-	// If player resides in an un-walkable node, check its neighbours for a walkable node with line of sight to player
-	// The player's node can become a node on other side of walls if it was not for the line trace 
-	if(!TargetNode->IsWalkable())
+	AUDIO_SYSTEM_INC_COUNTER(NodesExpanded, Expanded); 
+	return Status; 
+}
+
+void FPathfinder::StorePath(const int Level, std::vector<int>& Indices, AudioCore::FPathArena& PathArena, AudioCore::FPathHandle& Path) const
+{
+	// Coarse nodes are mapped to a walkable node they cover 
+	const AudioCore::FGridLevels& Levels = Grid->GetGridLevels(); 
+	if(Level > 0)
 	{
-		for(const auto Neighbour : Grid->GetNeighbours(TargetNode))
-		{
-			if(Neighbour->IsWalkable())
-			{
-				// Neighbour is valid if no hit occured for the line trace, i.e. has line of sight to player 
-				FHitResult HitResult; 
-				if(!UKismetSystemLibrary::LineTraceSingleForObjects(PropComp, Neighbour->GetWorldCoordinate(), Player->GetActorLocation(), PropComp->AudioBlockingTypes, false, ActorsToIgnore, EDrawDebugTrace::ForOneFrame, HitResult, true)) 
-					return Neighbour;
-			}
-		}
+		for(int& Index : Indices)
+			Index = Levels.GetBaseIndex(Level, Index); 
 	}
-	
-	return TargetNode; 
+
+	PathArena.SetPath(Path, Indices); 
 }
 
-TArray<FGridNode*> FPathfinder::GetPath(const FGridNode* StartNode, FGridNode* EndNode)
+bool FPathfinder::FindTransmissionRoute(const FVector& From, const FVector& To, const AudioCore::FTransmissionSettings& Settings, FTransmissionRoute& InOutRoute, AudioCore::FPathArena& PathArena, AudioCore::FPathHandle& Path)
 {
-	// Construct the path by building it using the nodes' parents
-	TArray<FGridNode*> Path;
+	AUDIO_SYSTEM_SCOPED_TIMER(FindPath); 
+
+	const int SourceIndex = Grid->GetNodeIndex(Grid->GetNodeFromWorldLocation(From)); 
+	const int ListenerIndex = Grid->GetNodeIndex(GetTargetNode(To));
+
+	// Neither has moved and the grid has not changed, the route and what is heard through it are still valid 
+	if(SourceIndex == InOutRoute.SourceIndex && ListenerIndex == InOutRoute.ListenerIndex && Grid->GetGridVersion() == InOutRoute.GridVersion)
+	{
+		AUDIO_SYSTEM_INC_COUNTER(PathCacheHits, 1); 
+		return InOutRoute.Result.bFound; 
+	}
+
+	InOutRoute.SourceIndex = SourceIndex;
+	InOutRoute.ListenerIndex = ListenerIndex; 
+	InOutRoute.GridVersion = Grid->GetGridVersion(); 
+
+	// The straight line through the walls starts at the camera like the occlusion component's traces 
+	const FVector CameraLocation = PropComp->CameraComp->GetComponentLocation();
+	const bool bFound = TransmissionSearch.Search(SourceIndex, ListenerIndex, ToCoreVector(From), ToCoreVector(CameraLocation), Settings, InOutRoute.Result, PathIndices); 
+	AUDIO_SYSTEM_INC_COUNTER(NodesExpanded, TransmissionSearch.GetLastStats().NodesExpanded); 
 
-	// Set current to EndNode 
-	FGridNode* Current = EndNode;
+	// Empty if there is no route 
+	PathArena.SetPath(Path, PathIndices); 
+	return bFound; 
+}
 
-	// While not reached start 
-	while(Current != StartNode)
+bool FPathfinder::FindOpenings(const FVector& From, const FVector& To, const AudioCore::FPropagationSearchSettings& Settings, const TArray<AActor*>& ActorsToIgnore, FPropagationOpenings& InOutOpenings)
+{
+	AUDIO_SYSTEM_SCOPED_TIMER(FindPath); 
+	
+	const int SourceIndex = Grid->GetNodeIndex(Grid->GetNodeFromWorldLocation(From)); 
+	const int ListenerIndex = Grid->GetNodeIndex(GetTargetNode(To));
+
+	// Neither has moved and the grid has not changed, the openings are still valid 
+	if(SourceIndex == InOutOpenings.SourceIndex && ListenerIndex == InOutOpenings.ListenerIndex && Grid->GetGridVersion() == InOutOpenings.GridVersion)
 	{
-		// Add the current node to the path and set current to its target 
-		Path.Add(Current);
-		Current = Current->Parent; 
+		AUDIO_SYSTEM_INC_COUNTER(PathCacheHits, 1); 
+		return !InOutOpenings.Openings.empty(); 
 	}
 
-	// Reverse the path since we constructed it "backwards". Note below: 
-	// Since we want to search the path from the audio source but later handle it as if it is from the player.
-	// It works out perfectly for us with not reversing it 
-	//Algo::Reverse(Path);
+	InOutOpenings.SourceIndex = SourceIndex;
+	InOutOpenings.ListenerIndex = ListenerIndex; 
+	InOutOpenings.GridVersion = Grid->GetGridVersion(); 
+
+	const AudioCore::FOccupancyGrid& OccupancyGrid = Grid->GetOccupancyGrid(); 
+	const AudioCore::FGridWallDistance& WallDistance = Grid->GetWallDistance(); 
+	const FVector CameraLocation = PropComp->CameraComp->GetComponentLocation();
+	const AudioCore::FVec3 GridCameraLocation = ToCoreVector(CameraLocation); 
+
+	// Every expanded node is tested so it is first traced through the grid, which is cheap, and only nodes the grid
+	// says are visible are confirmed with a line trace. With the wall distances baked the empty space is skipped 
+	const auto IsVisible = [&](const int Index)
+	{
+		const FVector NodeLocation = Grid->GetNodeFromIndex(Index)->GetWorldCoordinate(); 
+		const AudioCore::FVec3 GridNodeLocation = ToCoreVector(NodeLocation); 
+		const bool bGridVisible = WallDistance.IsBuilt() ? WallDistance.HasLineOfSight(GridNodeLocation, GridCameraLocation) : AudioCore::HasLineOfSight(OccupancyGrid, GridNodeLocation, GridCameraLocation); 
+		if(!bGridVisible)
+			return false;
+
+		FHitResult HitResult; 
+		return !PropComp->DoLineTrace(HitResult, NodeLocation, ActorsToIgnore); 
+	};
+
+	OpeningSearch.FindOpenings(SourceIndex, ListenerIndex, Settings, IsVisible, InOutOpenings.Openings); 
+	AUDIO_SYSTEM_INC_COUNTER(NodesExpanded, OpeningSearch.GetLastStats().NodesExpanded); 
 
-	return Path; 
+	return !InOutOpenings.Openings.empty(); 
 }
 
-int FPathfinder::GetCostToNode(const FGridNode* From, const FGridNode* To) const
+FGridNode* FPathfinder::GetTargetNode(const FVector& TargetLocation)
 {
-	// Euclidean distance (The dot product of a vector with itself is its magnitude squared) 
-	const FVector DirectionalVector = To->GetWorldCoordinate() - From->GetWorldCoordinate(); 
-	// Should return sqrt of Dot Product (or just DirVec.Size) but I think it gives better result without it,
-	// (although I think it punishes diagonal movement?) 
-	return DirectionalVector.Dot(DirectionalVector); // Seems to be the best (and fastest) approach 
+	FGridNode* TargetNode = Grid->GetNodeFromWorldLocation(TargetLocation);
+	if(TargetNode->IsWalkable())
+		return TargetNode; 
+
+	if(TargetNode == LastBlockedTargetNode && LastTargetFrame == GFrameCounter)
+		return LastResolvedTargetNode; 
+
+	FGridNode* PreviousTargetNode = LastResolvedTargetNode; 
+	LastBlockedTargetNode = TargetNode; 
+	LastResolvedTargetNode = TargetNode; 
+	LastTargetFrame = GFrameCounter; 
+
+	// If player resides in an un-walkable node, the nearest walkable node is used if it has line of sight to the player.
+	// The player's node can become a node on other side of walls if it was not for the line trace. One table read and
+	// at most one trace 
+	const int NearestIndex = Grid->GetNearestWalkable().GetNearestWalkable(Grid->GetNodeIndex(TargetNode)); 
+	if(NearestIndex == AudioCore::InvalidIndex)
+		return LastResolvedTargetNode; 
+
+	FHitResult HitResult; 
+	AUDIO_SYSTEM_INC_COUNTER(LineTraces, 1); 
+	const TArray<AActor*> ActorsToIgnore { Player }; 
+	if(!UKismetSystemLibrary::LineTraceSingleForObjects(PropComp, Grid->GetNodeFromIndex(NearestIndex)->GetWorldCoordinate(), Player->GetActorLocation(), PropComp->AudioBlockingTypes, false, ActorsToIgnore, EDrawDebugTrace::None, HitResult, true))
+	{
+		LastResolvedTargetNode = Grid->GetNodeFromIndex(NearestIndex); 
+		return LastResolvedTargetNode; 
+	}
+
+	// The nearest node is behind a wall from the player. The node the listener was last resolved to is kept if it is
+	// still walkable and next to the listener's node (e.g. the player moved along the wall into another blocked node),
+	// otherwise no path is found until the listener can be seen again 
+	const bool bPreviousIsNeighbour = PreviousTargetNode && FMath::Abs(PreviousTargetNode->GridX - TargetNode->GridX) <= 1 &&
+		FMath::Abs(PreviousTargetNode->GridY - TargetNode->GridY) <= 1 && FMath::Abs(PreviousTargetNode->GridZ - TargetNode->GridZ) <= 1; 
+	if(bPreviousIsNeighbour && PreviousTargetNode->IsWalkable())
+		LastResolvedTargetNode = PreviousTargetNode; 
+
+	return LastResolvedTargetNode; 
 }
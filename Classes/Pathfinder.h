@@ -3,9 +3,42 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Core/BidirectionalGridPathfinder.h"
+#include "Core/EmitterDistanceField.h"
+#include "Core/GridPathfinder.h"
+#include "Core/PathArena.h"
+#include "Core/PropagationSearch.h"
+#include "Core/TransmissionSearch.h"
 
+class UAudioComponent;
 class USoundPropagationComponent;
 
+// Result of FPathfinder::FindPath, Pending if the search is spread over several frames and has not finished yet 
+enum class EPathSearchResult : uint8
+{
+	Found,
+	NotFound,
+	Pending
+};
+
+// Openings found for one audio source, reused while neither the source nor the listener moves to another node 
+struct FPropagationOpenings
+{
+	int SourceIndex = INDEX_NONE;
+	int ListenerIndex = INDEX_NONE;
+	int GridVersion = INDEX_NONE;
+	std::vector<AudioCore::FPropagationOpening> Openings;
+};
+
+// The transmission search's result for one audio source, reused while neither the source nor the listener moves to another node 
+struct FTransmissionRoute
+{
+	int SourceIndex = INDEX_NONE;
+	int ListenerIndex = INDEX_NONE;
+	int GridVersion = INDEX_NONE;
+	AudioCore::FTransmissionResult Result;
+};
+
 /**
  * 
  */
@@ -14,19 +47,120 @@ class GRIM_API FPathfinder
 public:
 	FPathfinder(class AMapGrid* Grid, AActor* Player, USoundPropagationComponent* PropComp); 
 
-	bool FindPath(const FVector& From, const FVector& To, TArray<class FGridNode*>& Path, bool& bOutPlayerHasMoved);
+	/* Finds a path on the grid level (see AMapGrid::GetGridLevels), level 0 is the full resolution grid, and stores it
+	 * in the arena as full resolution node indexes. Paths on coarser levels have one node per coarse node, so a path's
+	 * length in full resolution nodes is its length << OutPathLevel, the level the path was found on. That is not always
+	 * Level, a continued search keeps the level it started on and distance fields are on level 0. The stored path is
+	 * left as it is if neither end has moved since it was found, and emptied if there is none.
+	 * With USoundPropagationComponent::MaxNodesExpandedPerFrame set, a search that runs out of the frame's budget
+	 * returns Pending and the audio comp's search is continued the next time it calls (one audio comp at a time, other
+	 * audio comps that need a search meanwhile return Pending without searching) */
+	EPathSearchResult FindPath(const UAudioComponent* AudioComp, const FVector& From, const FVector& To, AudioCore::FPathArena& PathArena, AudioCore::FPathHandle& Path, int& OutPathLevel, const int Level = 0);
+
+	/* Finds up to Settings.MaxOpenings places the sound at From can be heard from at To with a single search, closest
+	 * first. Returns false if there are none. The openings are only searched again if From or To changed node since
+	 * InOutOpenings was last filled */
+	bool FindOpenings(const FVector& From, const FVector& To, const AudioCore::FPropagationSearchSettings& Settings, const TArray<AActor*>& ActorsToIgnore, FPropagationOpenings& InOutOpenings);
+
+	/* Finds the cheapest route from From to the listener at To where walls can be crossed for the occlusion they add
+	 * (see AMapGrid::bBakeTransmission), and stores it in the arena like FindPath. The route is only searched again if
+	 * From or To changed node since InOutRoute was last filled. Returns false if the listener cannot be reached */
+	bool FindTransmissionRoute(const FVector& From, const FVector& To, const AudioCore::FTransmissionSettings& Settings, FTransmissionRoute& InOutRoute, AudioCore::FPathArena& PathArena, AudioCore::FPathHandle& Path);
+
+	// Counters from the latest finished search, summed over every frame of it if it was spread over several 
+	const AudioCore::FGridSearchStats& GetLastSearchStats() const { return *LastSearchStats; }
+
+	/* Bakes the distance field of an audio comp that never moves, FindPath then follows it from the listener's node
+	 * instead of searching. Only nodes at most MaxDistance away along every axis are stored, paths longer than that are
+	 * not heard anyway. Its paths are always on the full resolution grid. Returns the field's size in bytes */
+	size_t BakeDistanceField(const UAudioComponent* AudioComp, const float MaxDistance);
+
+	bool HasDistanceField(const UAudioComponent* AudioComp) const { return DistanceFields.Contains(AudioComp); }
+
+	// Forgets the audio comp's last search and distance field, call when it is destroyed 
+	void RemoveAudioComp(const UAudioComponent* AudioComp)
+	{
+		LastSearches.Remove(AudioComp); 
+		DistanceFields.Remove(AudioComp); 
+	}
 
 private:
 	AMapGrid* Grid;
 
-	FGridNode* OldEndNode = nullptr;
+	// What an audio comp's last found path was searched between, on which level and grid version 
+	struct FLastSearch
+	{
+		FGridNode* StartNode = nullptr;
+		FGridNode* EndNode = nullptr;
+		int Level = 0;
+		int GridVersion = 0;
+	};
+
+	// Every audio comp's last found path, its path is still valid while none of it has changed 
+	TMap<const UAudioComponent*, FLastSearch> LastSearches; 
+
+	// A static audio comp's distance field and the grid version it is valid for, baked again when the grid changes in it 
+	struct FBakedDistanceField
+	{
+		AudioCore::FEmitterDistanceField Field;
+		float MaxDistance = 0;
+		int GridVersion = 0;
+	};
+
+	TMap<const UAudioComponent*, FBakedDistanceField> DistanceFields; 
+
+	// Does the actual A* search on the grid's occupancy data, one per grid level 
+	std::vector<AudioCore::FGridPathfinder> LevelPathfinders;
+
+	// Searches long paths on the full resolution grid from both ends, see USoundPropagationComponent::BidirectionalSearchDistance 
+	AudioCore::FBidirectionalGridPathfinder BidirectionalPathfinder; 
+
+	// The pathfinder of the latest finished search's stats 
+	const AudioCore::FGridSearchStats* LastSearchStats = nullptr; 
+
+	// Searches that run out of the frame's node budget are continued in these, one per grid level 
+	std::vector<AudioCore::FGridPathfinder> SlicedPathfinders; 
+
+	// The audio comp whose search is unfinished in SlicedPathfinders, nullptr if there is none 
+	const UAudioComponent* SlicedSearchOwner = nullptr; 
+
+	int SlicedSearchLevel = 0; 
+	int SlicedSearchGridVersion = 0; 
+	FGridNode* SlicedSearchStartNode = nullptr; 
+	FGridNode* SlicedSearchEndNode = nullptr; 
+
+	// The unfinished search's path once it is found, kept apart since other audio comps search before its owner calls 
+	std::vector<int> SlicedPathIndices; 
+
+	// Nodes the searches may still expand and distance fields that may still be baked again during BudgetFrame 
+	int RemainingExpansions = 0; 
+	int RemainingFieldRebakes = 0; 
+	uint64 BudgetFrame = 0; 
+
+	// Reused between searches so the path indexes do not allocate every search 
+	std::vector<int> PathIndices; 
+
+	// Finds several openings per source, used instead of the level pathfinders when more than one is wanted 
+	AudioCore::FPropagationSearch OpeningSearch; 
+
+	// Searches through the walls that let sound through, used instead of the level pathfinders with the transmission search 
+	AudioCore::FTransmissionSearch TransmissionSearch; 
+
+	/* The node the listener is in, or the nearest walkable node if that one is blocked and the listener can be seen from
+	 * it, otherwise the node it was last resolved to if that is still next to it. Every audio comp asks for it so the
+	 * result is reused for the rest of the frame */
+	FGridNode* GetTargetNode(const FVector& TargetLocation);
 
-	TArray<FGridNode*> GetPath(const FGridNode* StartNode, FGridNode* EndNode);
+	// The blocked node the listener was in when GetTargetNode was last called, the node it resolved to and the frame 
+	FGridNode* LastBlockedTargetNode = nullptr; 
+	FGridNode* LastResolvedTargetNode = nullptr; 
+	uint64 LastTargetFrame = 0; 
 
-	// Returns an approximate cost to travel between nodes (ignoring obstacles)
-	int GetCostToNode(const FGridNode* From, const FGridNode* To) const;
+	// Continues the search with what is left of the frame's node budget and takes what it expanded from the budget 
+	AudioCore::EGridSearchStatus ContinueSearch(AudioCore::FGridPathfinder& LevelPathfinder, std::vector<int>& OutPathIndices); 
 
-	FGridNode* GetTargetNode(const FVector& TargetLocation) const;
+	// Stores the path's indexes on the grid level in the arena as full resolution node indexes, Indices is changed to them 
+	void StorePath(const int Level, std::vector<int>& Indices, AudioCore::FPathArena& PathArena, AudioCore::FPathHandle& Path) const; 
 
 	AActor* Player; 
 
@@ -3,13 +3,20 @@
 
 #include "SoundPropagationComponent.h"
 
+#include "AudioOcclusionComponent.h"
+#include "AudioParameterSubsystem.h"
 #include "AudioPlayTimes.h"
+#include "AudioSystemStats.h"
+#include "AudioTraceCache.h"
+#include "ChunkedGridSubsystem.h"
 #include "MapGrid.h"
 #include "Pathfinder.h"
+#include "SourceEffectParamSmoothing.h"
 #include "Camera/CameraComponent.h"
 #include "Components/AudioComponent.h"
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetMathLibrary.h"
+#include "Sound/SoundBase.h"
 #include "GridNode.h"
 #include "ParameterSettings.h"
 
@@ -36,25 +43,61 @@ void USoundPropagationComponent::BeginPlay()
 		return; 
 	}
 	
-	const auto Grid = Cast<AMapGrid>(UGameplayStatics::GetActorOfClass(this, AMapGrid::StaticClass()));
+	Grid = Cast<AMapGrid>(UGameplayStatics::GetActorOfClass(this, AMapGrid::StaticClass()));
 
-	if(!Grid)
+	if(Grid)
 	{
-		UE_LOG(LogTemp, Error, TEXT("There is no grid in the level. Sound propagation needs a grid added"))
-		SetComponentTickEnabled(false); 
-		return; 
+		GridNodeDiameter = Grid->GetNodeDiameter(); 
+		Pathfinder = new FPathfinder(Grid, GetOwner(), this);
+	}
+	else // No grid covering the whole level, use the grid chunks of the streamed levels instead 
+	{
+		ChunkedGrid = GetWorld()->GetSubsystem<UChunkedGridSubsystem>(); 
+		
+		if(!ChunkedGrid)
+		{
+			UE_LOG(LogTemp, Error, TEXT("There is no grid in the level. Sound propagation needs a grid or grid chunks added"))
+			SetComponentTickEnabled(false); 
+			return; 
+		}
+
+		UE_LOG(LogTemp, Log, TEXT("There is no grid in the level, sound propagation uses the streamed grid chunks"))
 	}
 
-	GridNodeDiameter = Grid->GetNodeDiameter(); 
-	
-	Pathfinder = new FPathfinder(Grid, GetOwner(), this);
+	// The transmission search needs the whole level's grid, and the occlusion settings it muffles the sounds with 
+	bTransmissionSearch = bTransmissionSearch && Pathfinder; 
+	AudioOccComp = GetOwner()->FindComponentByClass<UAudioOcclusionComponent>(); 
+	if(AudioOccComp)
+		OcclusionSettings = AudioOccComp->GetOcclusionSettings(); 
 
 	SetAudioComponents(); 
 
+	if(Pathfinder && bBakeStaticEmitterFields)
+		BakeStaticEmitterFields(); 
+
+	if(Grid && bBakeAudibleSets)
+	{
+		AudibleAudioComps.Bake(Grid->GetOccupancyGrid(), AudioComponents, AudibleSetRegionSize, StaticEmitterTag); 
+		UE_LOG(LogTemp, Log, TEXT("Baked audible sets for %i audio comps: %.1f KB"), AudioComponents.Num(), AudibleAudioComps.GetMemoryUsage() / 1024.f)
+	}
+
 	AudioPlayTimes = GetOwner()->FindComponentByClass<UAudioPlayTimes>();
 	AudioPlayTimes->SetPlayTimes(AudioComponents);
 
 	CameraComp = GetOwner()->FindComponentByClass<UCameraComponent>(); 
+
+	ParamUpdates = GetWorld()->GetSubsystem<UAudioParameterSubsystem>(); 
+
+	bSmoothPropagatedOnAudioThread = USourceEffectParamSmoothingPreset::IsInChain(PropagationSourceEffectChain); 
+
+	// The transmission search sets the volume and low pass of the sounds themselves 
+	if(bTransmissionSearch)
+	{
+		for(UAudioComponent* AudioComp : AudioComponents)
+			ParamUpdates->SetSmoothedOnAudioThread(AudioComp, AudioComp->Sound ? AudioComp->Sound->SourceEffectChain : nullptr); 
+	}
+
+	TraceCache = GetWorld()->GetSubsystem<UAudioTraceCache>(); 
 }
 
 void USoundPropagationComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
@@ -76,10 +119,25 @@ void USoundPropagationComponent::TickComponent(float DeltaTime, ELevelTick TickT
 	if(!bEnabled)
 		return;
 
+	AUDIO_SYSTEM_SCOPED_TIMER(PropagationTick); 
+
 	// SetAudioComponents(); 
+
+	VolumeBatch.Reset();
+	BatchedPropAudioComps.Reset(); 
+	PropagatedNodeIndices.Reset(); 
 	
+	// Only the audio comps that could be heard from the listener's region if the audible sets are baked 
+	const TArray<UAudioComponent*>* AudioCompsToUpdate = &AudioComponents; 
+	if(AudibleAudioComps.IsBaked())
+	{
+		AudibleAudioComps.GetCandidates(GetOwner()->GetActorLocation(), CandidateAudioComps); 
+		AudioCompsToUpdate = &CandidateAudioComps; 
+		AUDIO_SYSTEM_INC_COUNTER(AudibleSetCandidates, CandidateAudioComps.Num()); 
+	}
+
 	// Update each audio component's sound propagation 
-	for(const auto& AudioComp : AudioComponents) 
+	for(const auto& AudioComp : *AudioCompsToUpdate) 
 	{
 		if(!IsValid(AudioComp))
 			continue; 
@@ -90,6 +148,19 @@ void USoundPropagationComponent::TickComponent(float DeltaTime, ELevelTick TickT
 		if(AudioComp->AttenuationSettings->Attenuation.FalloffDistance > DistanceToAudio)
 			UpdateSoundPropagation(AudioComp, DeltaTime); 
 	}
+
+	ApplyVolumeBatch(DeltaTime); 
+
+	AUDIO_SYSTEM_SET_VALUE(PathArenaKB, PathArena.GetMemoryUsage() / 1024); 
+
+	if(Grid && Grid->bDrawPath)
+		DrawPaths(); 
+
+	// Every propagated sound, an audio comp heard through several openings has one for each 
+	int NumPropagatedEmitters = 0;
+	for(const auto& Pair : PropagatedSounds)
+		NumPropagatedEmitters += Pair.Value.Sounds.Num(); 
+	AUDIO_SYSTEM_SET_VALUE(PropagatedEmitters, NumPropagatedEmitters); 
 }
 
 void USoundPropagationComponent::SetAudioComponents()
@@ -132,6 +203,24 @@ void USoundPropagationComponent::SetAudioComponents()
 	}
 }
 
+void USoundPropagationComponent::BakeStaticEmitterFields()
+{
+	size_t TotalBytes = 0; 
+	for(const UAudioComponent* AudioComp : AudioComponents)
+	{
+		if(AudioComp->Mobility != EComponentMobility::Static && !AudioComp->ComponentHasTag(StaticEmitterTag))
+			continue; 
+
+		// No path longer than the falloff distance is heard, so no node further away than it is stored 
+		const size_t Bytes = Pathfinder->BakeDistanceField(AudioComp, AudioComp->AttenuationSettings->Attenuation.GetMaxFalloffDistance()); 
+		TotalBytes += Bytes; 
+
+		UE_LOG(LogTemp, Log, TEXT("Baked distance field for %s: %.1f KB"), *AudioComp->GetOwner()->GetActorNameOrLabel(), Bytes / 1024.f)
+	}
+
+	AUDIO_SYSTEM_SET_VALUE(DistanceFieldKB, TotalBytes / 1024); 
+}
+
 bool USoundPropagationComponent::ActorShouldBeIgnored(const AActor* Actor)
 {
 	for(const auto UnwantedClass : ActorClassesToIgnore)
@@ -145,112 +234,270 @@ bool USoundPropagationComponent::ActorShouldBeIgnored(const AActor* Actor)
 
 void USoundPropagationComponent::UpdateSoundPropagation(UAudioComponent* AudioComp, const float DeltaTime)
 {
-	// const auto StartTime = FDateTime::Now().GetMillisecond(); // FOR DEBUGGING
-	
 	// Actors to ignore when doing line traces 
 	const TArray<AActor*> ActorsToIgnore { GetOwner(), AudioComp->GetOwner() };
 
 	// First do a line trace from the audio source to the player to see if there is direct line of sight
-	// if so, then pathfinding is unnecessary because no propagation will occur 
-	FHitResult HitResultToPlayer;
-	DoLineTrace(HitResultToPlayer, AudioComp->GetComponentLocation(), ActorsToIgnore); 
-
-	if(!HitResultToPlayer.bBlockingHit) // Nothing blocking the sound 
+	// if so, then pathfinding is unnecessary because no propagation will occur. The occlusion traces the same line so
+	// it is shared through the trace cache 
+	if(!TraceCache->IsBlocked(AudioComp, CameraComp, AudioBlockingTypes)) // Nothing blocking the sound 
 	{
 		// Remove eventual propagated sound and return 
-		RemovePropagatedSound(AudioComp, DeltaTime);
+		RemovePropagatedSound(AudioComp);
+
+		// Nothing muffles it either, the occlusion component does not reset it for the transmission search 
+		if(bTransmissionSearch)
+		{
+			TransmissionRoutes.FindOrAdd(AudioComp); 
+			ParamUpdates->SetVolume(AudioComp, 1);
+			ParamUpdates->SetLowPassFilterEnabled(AudioComp, false);
+		}
+		
+		return; 
+	}
+
+	if(ChunkedGrid)
+	{
+		UpdateSoundPropagationOnChunks(AudioComp, ActorsToIgnore, DeltaTime);
+		return; 
+	}
+
+	if(bTransmissionSearch)
+	{
+		UpdateSoundPropagationWithTransmission(AudioComp, DeltaTime); 
+		return; 
+	}
+
+	if(MaxPropagatedOpenings > 1)
+	{
+		UpdateSoundPropagationThroughOpenings(AudioComp, ActorsToIgnore, DeltaTime);
 		return; 
 	}
 
-	bool bPlayerHasMoved = true;
+	// Far away sources search a coarser grid level, sources with a distance field do not search at all 
+	const float DistanceToAudio = FVector::Dist(GetOwner()->GetActorLocation(), AudioComp->GetComponentLocation()); 
+	const float DistanceFraction = DistanceToAudio / AudioComp->AttenuationSettings->Attenuation.GetMaxFalloffDistance(); 
+	const int GridLevel = Pathfinder->HasDistanceField(AudioComp) ? 0 : AudioCore::SelectGridLevel(DistanceFraction, GridLevelDistanceFractions.GetData(), GridLevelDistanceFractions.Num(), Grid->GetGridLevels().Num()); 
 
-	TArray<FGridNode*> Path; 
+	// The path is stored in the arena, a source whose path has not changed keeps it there as it is 
+	AudioCore::FPathHandle& PathHandle = PathHandles.FindOrAdd(AudioComp); 
+	int PathLevel = GridLevel; 
+	const EPathSearchResult SearchResult = Pathfinder->FindPath(AudioComp, AudioComp->GetComponentLocation(), GetOwner()->GetActorLocation(), PathArena, PathHandle, PathLevel, GridLevel); 
+
+	// The new path is still being searched, the propagated sound stays where the last path put it until it is done 
+	if(SearchResult == EPathSearchResult::Pending)
+	{
+		// The stored path may have been searched on another level than this tick's, so its length is kept already scaled 
+		if(const FLastPropagation* LastPropagation = LastPropagations.Find(AudioComp))
+		{
+			UpdatePropagatedSound(AudioComp, 0, Grid->GetNodeFromIndex(LastPropagation->NodeIndex)->GetWorldCoordinate(), LastPropagation->PathLength, DeltaTime); 
+			PropagatedNodeIndices.Add(AudioComp, LastPropagation->NodeIndex); 
+		}
+		
+		return; 
+	}
 	
-	if(!Pathfinder->FindPath(AudioComp->GetComponentLocation(), GetOwner()->GetActorLocation(), Path, bPlayerHasMoved))
+	if(SearchResult == EPathSearchResult::NotFound)
 	{
 		// No path found, remove eventual propagated sound and return 
-		RemovePropagatedSound(AudioComp, DeltaTime); 
+		RemovePropagatedSound(AudioComp); 
 		return; 
 	}
 
-	// If player has not moved then path is not calculated so FindPath does not set Path, so we can get the stored path 
-	if(!bPlayerHasMoved && Paths.Contains(AudioComp)) 
-		Path = Paths[AudioComp];
-	else // Player has moved so there is a new path, store it 
-		Paths.Add(AudioComp, Path); 
+	const AudioCore::FPathView Path = PathArena.GetPath(PathHandle); 
 	
 	// Iterate through path and find the last node with line of sight to player, that's the location to propagate the sound to 
-	for(int i = 1; i < Path.Num(); i++)
+	for(int i = 1; i < Path.Num; i++)
 	{
 		FHitResult HitResult;
-		DoLineTrace(HitResult, Path[i]->GetWorldCoordinate(), ActorsToIgnore); 
+		DoLineTrace(HitResult, Grid->GetNodeFromIndex(Path[i])->GetWorldCoordinate(), ActorsToIgnore); 
 		
 		// If nothing is blocking from the node to player, check next node 
 		if(!HitResult.bBlockingHit)
 			continue;
-		
-		UAudioComponent* PropAudioComp = nullptr; 
-		
-		// if we do not have a propagated sound for that audio comp in the world already 
-		if(!PropagatedSounds.Contains(AudioComp))
-		{
-			PropAudioComp = SpawnPropagatedSound(AudioComp, Path[i - 1]->GetWorldCoordinate(), Path.Num()); 
-		} else  // If we do have a propagated sound for that audio comp  
-		{
-			// Get the propagated audio component 
-			PropAudioComp = PropagatedSounds[AudioComp];
 
-			// if it's in the wrong location, lerp it to the correct location to prevent abrupt direction changes,
-			// otherwise it's in the correct place already so we dont have to do anything 
-			if(!PropAudioComp->GetComponentLocation().Equals(Path[i - 1]->GetWorldCoordinate()))
-				MovePropagatedAudioComp(PropAudioComp, Path[i - 1], DeltaTime);
-		}
+		// Every node on a coarse level covers 2^Level full resolution nodes along the path. The level is the one the path
+		// was found on, a search continued over several frames can have started on another level than this tick's 
+		UpdatePropagatedSound(AudioComp, 0, Grid->GetNodeFromIndex(Path[i - 1])->GetWorldCoordinate(), Path.Num << PathLevel, DeltaTime); 
+
+		// Only one path so any other propagated sounds (from when there were more openings) are faded out 
+		FadeOutPropagatedSounds(AudioComp, 1); 
 
-		// Call volume change each update when it's not been removed to lerp the volume
-		if(PropAudioComp)
-			SetPropagatedSoundVolume(AudioComp, PropAudioComp, Path.Num(), DeltaTime); 
+		PropagatedNodeIndices.Add(AudioComp, Path[i - 1]); 
+		LastPropagations.Add(AudioComp, { Path[i - 1], Path.Num << PathLevel }); 
 		
 		break; // Found the node with block so no need to traverse the path any further 
 	}
+}
+
+void USoundPropagationComponent::DrawPaths() const
+{
+	// The stored paths of the sounds propagated this tick, nothing is searched again to draw them 
+	for(const auto& Pair : PropagatedNodeIndices)
+	{
+		const AudioCore::FPathHandle* PathHandle = PathHandles.Find(Pair.Key); 
+		if(!PathHandle)
+			continue; 
+
+		const AudioCore::FPathView Path = PathArena.GetPath(*PathHandle); 
+		for(int i = 1; i < Path.Num; i++)
+			DrawDebugLine(GetWorld(), Grid->GetNodeFromIndex(Path[i - 1])->GetWorldCoordinate(), Grid->GetNodeFromIndex(Path[i])->GetWorldCoordinate(), FColor::Red, false, -1, 0, 3); 
+	}
+}
+
+void USoundPropagationComponent::UpdateSoundPropagationWithTransmission(UAudioComponent* AudioComp, const float DeltaTime)
+{
+	AudioCore::FTransmissionSettings Settings;
+	Settings.OcclusionDistance = TransmissionOcclusionDistance; 
+	Settings.MaxDistance = AudioComp->AttenuationSettings->Attenuation.GetMaxFalloffDistance(); // Silent past it anyway 
+
+	FTransmissionRoute& Route = TransmissionRoutes.FindOrAdd(AudioComp); 
+	AudioCore::FPathHandle& PathHandle = PathHandles.FindOrAdd(AudioComp); 
+	Pathfinder->FindTransmissionRoute(AudioComp->GetComponentLocation(), GetOwner()->GetActorLocation(), Settings, Route, PathArena, PathHandle); 
+	const AudioCore::FTransmissionResult& Result = Route.Result; 
+
+	// The sound itself is muffled by the walls the same way the occlusion component muffles it, only changes are sent 
+	const float LowPassValue = AudioCore::GetLowPassValue(Result.DistanceToWall, OcclusionSettings.DistanceToWallOffset, OcclusionSettings.DistanceToWallToStopAddingLowPass); 
+	ParamUpdates->SetVolume(AudioComp, AudioCore::GetOccludedVolume(Result.DirectOcclusion)); 
+	ParamUpdates->SetLowPassFilterEnabled(AudioComp, true); 
+	ParamUpdates->SetLowPassFilterFrequency(AudioComp, AudioCore::GetLowPassFrequency(LowPassValue, OcclusionSettings.MaxLowPassFrequency)); 
+
+	// Heard through the wall or not at all, there is no way around it to propagate the sound to 
+	if(Result.OpeningIndex == INDEX_NONE)
+	{
+		RemovePropagatedSound(AudioComp); 
+		return; 
+	}
+
+	UpdatePropagatedSound(AudioComp, 0, Grid->GetNodeFromIndex(Result.OpeningIndex)->GetWorldCoordinate(), Result.OpeningPathSize, DeltaTime); 
+	FadeOutPropagatedSounds(AudioComp, 1); 
+	PropagatedNodeIndices.Add(AudioComp, Result.OpeningIndex); 
+}
+
+void USoundPropagationComponent::UpdateSoundPropagationThroughOpenings(UAudioComponent* AudioComp, const TArray<AActor*>& ActorsToIgnore, const float DeltaTime)
+{
+	AudioCore::FPropagationSearchSettings Settings;
+	Settings.MaxOpenings = MaxPropagatedOpenings;
+	Settings.MinOpeningSeparation = MinOpeningSeparation;
+	Settings.MaxDistance = AudioComp->AttenuationSettings->Attenuation.GetMaxFalloffDistance(); // Silent past it anyway 
+
+	FPropagationOpenings& FoundOpenings = Openings.FindOrAdd(AudioComp); 
+	if(!Pathfinder->FindOpenings(AudioComp->GetComponentLocation(), GetOwner()->GetActorLocation(), Settings, ActorsToIgnore, FoundOpenings))
+	{
+		// Cannot be heard from anywhere, remove eventual propagated sounds and return 
+		RemovePropagatedSound(AudioComp);
+		return; 
+	}
+
+	// Each opening gets its own propagated sound with a volume from its own path length 
+	const int NumOpenings = static_cast<int>(FoundOpenings.Openings.size()); 
+	for(int Slot = 0; Slot < NumOpenings; Slot++)
+	{
+		const AudioCore::FPropagationOpening& Opening = FoundOpenings.Openings[Slot]; 
+		UpdatePropagatedSound(AudioComp, Slot, Grid->GetNodeFromIndex(Opening.Index)->GetWorldCoordinate(), Opening.PathSize, DeltaTime); 
+	}
+
+	// Fewer openings than last time, fade out the ones that are no longer found 
+	FadeOutPropagatedSounds(AudioComp, NumOpenings); 
+
+	PropagatedNodeIndices.Add(AudioComp, FoundOpenings.Openings[0].Index); 
+}
+
+void USoundPropagationComponent::UpdateSoundPropagationOnChunks(UAudioComponent* AudioComp, const TArray<AActor*>& ActorsToIgnore, const float DeltaTime)
+{
+	// The path is kept between ticks, it is only searched again when either end moves or chunks are streamed in or out 
+	TArray<FVector>& Path = ChunkPaths.FindOrAdd(AudioComp); 
+	if(!ChunkedGrid->FindPath(AudioComp, AudioComp->GetComponentLocation(), GetOwner()->GetActorLocation(), AudioBlockingTypes, ActorsToIgnore, Path))
+	{
+		// No path through the loaded chunks, remove eventual propagated sound and return 
+		RemovePropagatedSound(AudioComp);
+		return; 
+	}
+
+	GridNodeDiameter = ChunkedGrid->GetNodeDiameter(); 
+
+	// Same as the single path on the grid, the sound is propagated to the last node with line of sight to the player 
+	for(int i = 1; i < Path.Num(); i++)
+	{
+		FHitResult HitResult;
+		DoLineTrace(HitResult, Path[i], ActorsToIgnore); 
+		
+		if(!HitResult.bBlockingHit)
+			continue;
+
+		UpdatePropagatedSound(AudioComp, 0, Path[i - 1], Path.Num(), DeltaTime); 
+		FadeOutPropagatedSounds(AudioComp, 1); 
+		break; 
+	}
+}
+
+void USoundPropagationComponent::UpdatePropagatedSound(UAudioComponent* AudioComp, const int Slot, const FVector& NodeLocation, const int PathSize, const float DeltaTime)
+{
+	TArray<UAudioComponent*>& Sounds = PropagatedSounds.FindOrAdd(AudioComp).Sounds; 
 	
-	// TODO: THIS IS ONLY FOR DEBUGGING! REMOVE WHEN DONE!
-	// Draw the path (only drawn while there is line of sight), 
-	if(Cast<AMapGrid>(UGameplayStatics::GetActorOfClass(this, AMapGrid::StaticClass()))->bDrawPath)
-		for(auto Node : Path)
-			DrawDebugSphere(GetWorld(), Node->GetWorldCoordinate(), 30, 10, FColor::Red); 
-
-	// DEBUGGING 
-	// const auto EndTime = FDateTime::Now().GetMillisecond();
-	//if(EndTime - StartTime != 0)
-	//	UE_LOG(LogTemp, Warning, TEXT("Update time: %i ms"), EndTime - StartTime)
+	UAudioComponent* PropAudioComp = nullptr; 
+
+	// if we do not have a propagated sound for that slot in the world already 
+	if(!Sounds.IsValidIndex(Slot))
+	{
+		PropAudioComp = SpawnPropagatedSound(AudioComp, NodeLocation); 
+		Sounds.SetNum(Slot + 1);
+		Sounds[Slot] = PropAudioComp; 
+	} else  // If we do have a propagated sound for that slot 
+	{
+		// Get the propagated audio component 
+		PropAudioComp = Sounds[Slot];
+
+		// if it's in the wrong location, lerp it to the correct location to prevent abrupt direction changes,
+		// otherwise it's in the correct place already so we dont have to do anything 
+		if(!PropAudioComp->GetComponentLocation().Equals(NodeLocation))
+			MovePropagatedAudioComp(PropAudioComp, NodeLocation, DeltaTime);
+	}
+
+	// Call volume change each update when it's not been removed to lerp the volume
+	if(PropAudioComp)
+		SetPropagatedSoundVolume(AudioComp, PropAudioComp, PathSize); 
 }
 
 bool USoundPropagationComponent::DoLineTrace(FHitResult& HitResultOut, const FVector& StartLoc, const TArray<AActor*>& ActorsToIgnore) const
 {
+	AUDIO_SYSTEM_INC_COUNTER(LineTraces, 1); 
+	
 	// Line trace from the node to player to see if there is line of sight  
 	return UKismetSystemLibrary::LineTraceSingleForObjects(GetWorld(), StartLoc,
 		CameraComp->GetComponentLocation(), AudioBlockingTypes, false,
 		ActorsToIgnore, EDrawDebugTrace::ForOneFrame, HitResultOut, true); 
 }
 
-void USoundPropagationComponent::RemovePropagatedSound(const UAudioComponent* AudioComp, const float DeltaTime)
+void USoundPropagationComponent::RemovePropagatedSound(const UAudioComponent* AudioComp)
+{
+	PropagatedNodeIndices.Remove(AudioComp); 
+	LastPropagations.Remove(AudioComp); 
+	FadeOutPropagatedSounds(AudioComp, 0); 
+}
+
+void USoundPropagationComponent::FadeOutPropagatedSounds(const UAudioComponent* AudioComp, const int FirstSlot)
 {
 	// if there is propagated sound in the level 
-	if(PropagatedSounds.Contains(AudioComp))
-	{
-		// Volume is set to near zero because of UE optimizations which would lead to the original audio and the
-		// propagated sound would be out of sync 
-		UAudioComponent* PropAudio = PropagatedSounds[AudioComp]; 
-		const float NewVolume = FMath::FInterpConstantTo(PropAudio->VolumeMultiplier, 0.01f, DeltaTime, PropVolumeLerpSpeed); 
-		PropAudio->SetVolumeMultiplier(NewVolume); // Interpolates volume to zero
+	const FPropagatedSoundSet* SoundSet = PropagatedSounds.Find(AudioComp); 
+	if(!SoundSet)
+		return;
 
-		// UE_LOG(LogTemp, Warning, TEXT("Prop vol: %f"), NewVolume)
+	// Volume is interpolated to near zero because of UE optimizations which would lead to the original audio and the
+	// propagated sound would be out of sync 
+	for(int Slot = FirstSlot; Slot < SoundSet->Sounds.Num(); Slot++)
+	{
+		UAudioComponent* PropAudio = SoundSet->Sounds[Slot]; 
+		VolumeBatch.AddRemoved(ParamUpdates->GetVolume(PropAudio));
+		BatchedPropAudioComps.Add(PropAudio); 
 	}
 }
 
-UAudioComponent* USoundPropagationComponent::SpawnPropagatedSound(UAudioComponent* AudioComp, const FVector& SpawnLocation, const int PathSize) 
+UAudioComponent* USoundPropagationComponent::SpawnPropagatedSound(UAudioComponent* AudioComp, const FVector& SpawnLocation) 
 {
-	UAudioComponent* PropagatedAudioComp = DuplicateObject<UAudioComponent>(AudioComp, AudioComp->GetOwner(), FName(FString("PropagatedSound"))); 
+	// Unique name since an audio comp can have several propagated sounds 
+	const FName Name = MakeUniqueObjectName(AudioComp->GetOwner(), UAudioComponent::StaticClass(), FName(FString("PropagatedSound"))); 
+	UAudioComponent* PropagatedAudioComp = DuplicateObject<UAudioComponent>(AudioComp, AudioComp->GetOwner(), Name); 
 
 	AudioComp->GetOwner()->AddInstanceComponent(PropagatedAudioComp);
 	PropagatedAudioComp->RegisterComponent();
@@ -258,42 +505,43 @@ UAudioComponent* USoundPropagationComponent::SpawnPropagatedSound(UAudioComponen
 	
 	PropagatedAudioComp->AttenuationSettings = PropagatedSoundAttenuation;
 	PropagatedAudioComp->SetSourceEffectChain(PropagationSourceEffectChain); 
+	ParamUpdates->SetSmoothedOnAudioThread(PropagatedAudioComp, PropagationSourceEffectChain); 
 
 	// Plays the propagated audio source at the correct start time to keep it in sync with the original
 	const float PlayTime = AudioPlayTimes->GetPlayTime(AudioComp);
 	PropagatedAudioComp->Play(PlayTime); 
-	
-	PropagatedSounds.Add(AudioComp, PropagatedAudioComp);
 
 	return PropagatedAudioComp; 
 }
 
-void USoundPropagationComponent::MovePropagatedAudioComp(UAudioComponent* PropAudioComp, const FGridNode* ToNode, const float DeltaTime) const
+void USoundPropagationComponent::MovePropagatedAudioComp(UAudioComponent* PropAudioComp, const FVector& TargetLoc, const float DeltaTime) const
 {
 	// Moves the Propagated audio component to its correct location 
 	const FVector CurrentLoc = PropAudioComp->GetComponentLocation();
-	const FVector TargetLoc = ToNode->GetWorldCoordinate(); 
 	const FVector InterpolatedLoc = UKismetMathLibrary::VInterpTo_Constant(CurrentLoc, TargetLoc, DeltaTime, PropagateLerpSpeed); 
 	PropAudioComp->SetWorldLocation(InterpolatedLoc);
 }
 
-void USoundPropagationComponent::SetPropagatedSoundVolume(const UAudioComponent* AudioComp, UAudioComponent* PropAudioComp, const int PathSize, const float DeltaTime) const
+void USoundPropagationComponent::SetPropagatedSoundVolume(const UAudioComponent* AudioComp, UAudioComponent* PropAudioComp, const int PathSize)
 {
 	const float FalloffDistance = AudioComp->AttenuationSettings->Attenuation.GetMaxFalloffDistance(); 
 
-	// This is an approximation that assumes each node traveled is the same length (diagonal travels are longer)
-	const int DistanceFromPropToOriginal = PathSize * GridNodeDiameter; 
-
-	// Calculates the volume by seeing how much percentage the distance from the source is of the max fall off distance,
-	// giving a value close to 0 when it's close to the audio source and vice versa. That's why 1 - Value is needed 
-	const float TargetVolume = 1 - FMath::Clamp(DistanceFromPropToOriginal / FalloffDistance, 0, 1);
-
-	// Interpolates volume changes to it is not as abrupt 
-	const float NewVolume = FMath::FInterpConstantTo(PropAudioComp->VolumeMultiplier, TargetVolume, DeltaTime, PropVolumeLerpSpeed); 
+	// The batch approximates the distance from the path size, closer to the audio source gives higher volume 
+	VolumeBatch.AddPropagated(ParamUpdates->GetVolume(PropAudioComp), PathSize, GridNodeDiameter, FalloffDistance);
+	BatchedPropAudioComps.Add(PropAudioComp); 
+}
 
-	// UE_LOG(LogTemp, Warning, TEXT("Prop vol: %f"), NewVolume)
-	
-	PropAudioComp->SetVolumeMultiplier(NewVolume); 
+void USoundPropagationComponent::ApplyVolumeBatch(const float DeltaTime)
+{
+	// Interpolates volume changes so they are not as abrupt, unless the smoothing effect ramps them on the audio thread
+	// in which case a step of 1 goes straight to the target 
+	if(bSmoothPropagatedOnAudioThread)
+		VolumeBatch.Compute(1, 1); 
+	else
+		VolumeBatch.Compute(DeltaTime, PropVolumeLerpSpeed);
+
+	for(int i = 0; i < BatchedPropAudioComps.Num(); i++)
+		ParamUpdates->SetVolume(BatchedPropAudioComps[i], VolumeBatch.GetVolume(i)); 
 }
 
 void USoundPropagationComponent::ActorWithCompDestroyed(AActor* DestroyedActor)
@@ -307,11 +555,39 @@ void USoundPropagationComponent::ActorWithCompDestroyed(AActor* DestroyedActor)
 		{
 			AudioComponents.Remove(AudioComp);
 
+			// The propagated sounds are owned by the same actor so they are destroyed with it 
+			if(const FPropagatedSoundSet* SoundSet = PropagatedSounds.Find(AudioComp))
+			{
+				for(const UAudioComponent* PropAudioComp : SoundSet->Sounds)
+					ParamUpdates->RemoveAudioComponent(PropAudioComp); 
+			}
+
 			if(PropagatedSounds.Contains(AudioComp))
 				PropagatedSounds.Remove(AudioComp);
 
-			if(Paths.Contains(AudioComp))
-				Paths.Remove(AudioComp); 
+			if(AudioCore::FPathHandle* PathHandle = PathHandles.Find(AudioComp))
+			{
+				PathArena.Release(*PathHandle); 
+				PathHandles.Remove(AudioComp); 
+			}
+
+			if(Pathfinder)
+				Pathfinder->RemoveAudioComp(AudioComp); 
+
+			ChunkPaths.Remove(AudioComp); 
+
+			if(ChunkedGrid)
+				ChunkedGrid->RemoveAudioComp(AudioComp); 
+
+			AudibleAudioComps.Remove(AudioComp); 
+
+			TransmissionRoutes.Remove(AudioComp); 
+
+			Openings.Remove(AudioComp); 
+
+			PropagatedNodeIndices.Remove(AudioComp); 
+
+			LastPropagations.Remove(AudioComp); 
 		}
 	}
 	
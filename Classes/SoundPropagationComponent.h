@@ -3,10 +3,23 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "AudibleAudioComps.h"
 #include "Components/ActorComponent.h"
 #include "Components/AudioComponent.h"
+#include "Core/OcclusionBatch.h"
+#include "Pathfinder.h"
 #include "SoundPropagationComponent.generated.h"
 
+// The propagated sounds spawned for one audio comp, one per opening it is heard through with the closest first 
+USTRUCT()
+struct FPropagatedSoundSet
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<UAudioComponent*> Sounds; 
+};
+
 
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class GRIM_API USoundPropagationComponent : public UActorComponent
@@ -27,6 +40,9 @@ public:
 	// Called every frame
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
+	// If the sound's occlusion is done by the transmission search, the audio occlusion component skips it then 
+	bool HandlesOcclusion(const UAudioComponent* AudioComp) const { return TransmissionRoutes.Contains(AudioComp); }
+
 private:
 
 #pragma region DataMembers 
@@ -41,9 +57,59 @@ private:
 
 	class FPathfinder* Pathfinder = nullptr;
 
-	// Map containing the original audio component and the spawned, propagated audio component
+	// Map containing the original audio component and the spawned, propagated audio components
 	UPROPERTY()
-	TMap<UAudioComponent*, UAudioComponent*> PropagatedSounds; // TODO? Can this map replace the audio comp array? 
+	TMap<UAudioComponent*, FPropagatedSoundSet> PropagatedSounds; // TODO? Can this map replace the audio comp array? 
+
+	/* How many places each sound can be heard from, e.g. a sound in a room with two doorways is heard from both. With
+	 * 1 the sound is propagated along the single best path. More than 1 finds the openings with one wider search per
+	 * sound, which expands more nodes than the single path does */
+	UPROPERTY(EditAnywhere, meta=(ClampMin=1))
+	int MaxPropagatedOpenings = 1;
+
+	// Openings closer to each other than this many nodes count as the same opening, e.g. two nodes in one doorway 
+	UPROPERTY(EditAnywhere, meta=(ClampMin=1))
+	float MinOpeningSeparation = 3.f; 
+
+	/* Sources further away search coarser grid levels (see AMapGrid::NumCoarseLevels) since the precision of a fine path
+	 * is not heard that far away. Level i + 1 is used from the i:th fraction of the source's falloff distance. Only used
+	 * for the single path, the multi opening search always uses the full resolution grid */
+	UPROPERTY(EditAnywhere)
+	TArray<float> GridLevelDistanceFractions { 0.4f, 0.7f }; 
+
+	/* Sources at least this far from the listener are searched from both the source and the listener at once. It only
+	 * pays off with landmarks (AMapGrid::NumLandmarks) in levels with many floors and walls, without them it finds shorter
+	 * paths but expands more nodes than the default search. Only used on the full resolution grid, 0 never uses it */
+	UPROPERTY(EditAnywhere, meta=(ClampMin=0))
+	float BidirectionalSearchDistance = 0.f; 
+
+	/* Most grid nodes the path searches may expand in one frame, so one long search cannot stall a frame. A search that
+	 * runs out is continued the next frames while its propagated sound stays where the previous path put it, the other
+	 * sources needing a new path wait for it to finish before they start searching. Only used
+	 * for the single path on AMapGrid, and the search from both ends (BidirectionalSearchDistance) is not used with it.
+	 * 0 lets every search run to the end */
+	UPROPERTY(EditAnywhere, meta=(ClampMin=0))
+	int MaxNodesExpandedPerFrame = 0; 
+
+	// The openings of every audio comp when MaxPropagatedOpenings is more than 1, reused while nothing moves 
+	TMap<UAudioComponent*, FPropagationOpenings> Openings; 
+
+	/* Folds the occlusion into the propagation. One search per sound, through the walls as much as their baked materials
+	 * let sound through (see AMapGrid::bBakeTransmission), decides both how muffled the sound itself is and where it is
+	 * propagated to. The audio occlusion component leaves these sounds alone, so a sound costs at most the one trace
+	 * that finds it is blocked. Only used on AMapGrid, and instead of the openings and the coarse grid levels */
+	UPROPERTY(EditAnywhere)
+	bool bTransmissionSearch = false; 
+
+	// How many units longer a route around the walls may be than one through walls that block all sound, see AudioCore::FTransmissionSettings 
+	UPROPERTY(EditAnywhere, meta=(ClampMin=0, EditCondition="bTransmissionSearch"))
+	float TransmissionOcclusionDistance = 1000.f; 
+
+	// The route of every audio comp with the transmission search, reused while nothing moves 
+	TMap<const UAudioComponent*, FTransmissionRoute> TransmissionRoutes; 
+
+	// The audio occlusion component's settings for the sounds the transmission search muffles, its defaults if there is none 
+	AudioCore::FOcclusionSettings OcclusionSettings; 
 
 	// Which sound attenuation that the propagated sound should use 
 	UPROPERTY(EditAnywhere)
@@ -54,6 +120,36 @@ private:
 	UPROPERTY(EditAnywhere)
 	float PropagateLerpSpeed = 3500.f;
 
+	/* Bakes a distance field at begin play for every audio comp that is static or has StaticEmitterTag, their paths are
+	 * then followed down from the listener's node without any search. Each field stores 2 bytes per node within the
+	 * sound's falloff distance along every axis, the size of each is logged */
+	UPROPERTY(EditAnywhere)
+	bool bBakeStaticEmitterFields = false; 
+
+	// Most distance fields baked again in one frame after the grid is updated in their area, the audio comps waiting for
+	// theirs are searched like the others until then 
+	UPROPERTY(EditAnywhere, meta=(ClampMin=1, EditCondition="bBakeStaticEmitterFields"))
+	int MaxFieldRebakesPerFrame = 1; 
+
+	// Audio comps with this tag are treated as static even if they are not (distance fields and audible sets), for
+	// sounds on actors that never move 
+	UPROPERTY(EditAnywhere)
+	FName StaticEmitterTag = FName("StaticEmitter"); 
+
+	/* Bakes potentially audible sets at begin play, the grid is split into regions of AudibleSetRegionSize nodes along
+	 * every axis and each tick only considers the static audio comps that can be heard from the listener's region (and
+	 * every audio comp that moves) instead of every audio comp in the level */
+	UPROPERTY(EditAnywhere)
+	bool bBakeAudibleSets = false; 
+
+	UPROPERTY(EditAnywhere, meta=(ClampMin=1, EditCondition="bBakeAudibleSets"))
+	int AudibleSetRegionSize = 8; 
+
+	FAudibleAudioComps AudibleAudioComps; 
+
+	// The audio comps to update this tick when the audible sets are baked, kept to not allocate every tick 
+	TArray<UAudioComponent*> CandidateAudioComps; 
+
 	// Used to determine distance between propagated sound and the original sound source which will determine volume 
 	float GridNodeDiameter;
 
@@ -77,43 +173,117 @@ private:
 	UPROPERTY(EditDefaultsOnly)
 	FName PropagateCompTag = FName("Propagate");
 
-	// Map containing every audio comp with a path so path does not need to be recalculated if player has not moved
-	TMap<UAudioComponent*, TArray<class FGridNode*>> Paths; 
+	// Every audio comp's path as node indexes, kept between ticks so a path does not need to be recalculated (or copied)
+	// if the player has not moved. The audio comps only hold handles to their paths 
+	AudioCore::FPathArena PathArena; 
+	TMap<const UAudioComponent*, AudioCore::FPathHandle> PathHandles; 
 
+	// Grid index of the node each propagated sound is currently placed at (or moving towards). Emptied at the start of
+	// every tick so it only contains audio comps that were propagated this tick 
+	TMap<const UAudioComponent*, int> PropagatedNodeIndices; 
+
+	// The node each sound was last propagated to on the single path and the path's length in full resolution nodes, kept
+	// between ticks so a pending search keeps using them. The stored path's grid level can differ from the search's 
+	struct FLastPropagation
+	{
+		int NodeIndex = 0;
+		int PathLength = 0;
+	};
+
+	TMap<const UAudioComponent*, FLastPropagation> LastPropagations; 
+
+	UPROPERTY()
+	class AMapGrid* Grid = nullptr; 
+
+	// Used instead of the grid when the level has no AMapGrid, searches the grid chunks of the streamed in levels 
+	UPROPERTY()
+	class UChunkedGridSubsystem* ChunkedGrid = nullptr; 
+
+	// Path of every audio comp when searching the grid chunks, kept between ticks since the chunked grid only searches
+	// a path again when it can have changed 
+	TMap<UAudioComponent*, TArray<FVector>> ChunkPaths; 
+
+	/* Source effects of every propagated sound. With a USourceEffectParamSmoothingPreset in it the volume changes are
+	 * ramped on the audio thread by the effect's speed instead of by PropVolumeLerpSpeed on the game thread */
 	UPROPERTY(EditAnywhere)
 	USoundEffectSourcePresetChain* PropagationSourceEffectChain;
 
+	// If the propagation source effect chain smooths the volume changes, set at begin play 
+	bool bSmoothPropagatedOnAudioThread = false; 
+
 	// Speed of the interpolation of volume changes for the propagated sound 
 	UPROPERTY(EditAnywhere) 
 	float PropVolumeLerpSpeed = 0.5f; 
 
+	// Volume changes of every propagated sound this tick, interpolated together at the end of the tick 
+	AudioCore::FPropagatedVolumeBatch VolumeBatch;
+
+	// The propagated audio comp for each entry in the volume batch, in the same order 
+	UPROPERTY()
+	TArray<UAudioComponent*> BatchedPropAudioComps; 
+
+	// Volume changes go through it so only audible changes are sent to the audio thread 
+	UPROPERTY()
+	class UAudioParameterSubsystem* ParamUpdates = nullptr; 
+
+	// Traces shared with the audio occlusion component this frame 
+	UPROPERTY()
+	class UAudioTraceCache* TraceCache = nullptr; 
+
 #pragma endregion
 
 #pragma region Functions 
 
 	// So Pathfinder class can use this class' data members when performing its line trace 
 	friend class FPathfinder;
+
+	// So the recorder can read the audio comps and their paths 
+	friend class UAudioTrajectoryRecorder; 
 	
 	// Called in begin play to fill the array with the audio comps in the level 
 	void SetAudioComponents();
+
+	// Bakes the distance fields of the static audio comps, see bBakeStaticEmitterFields 
+	void BakeStaticEmitterFields(); 
 	
 	void UpdateSoundPropagation(UAudioComponent* AudioComp, const float DeltaTime);
 
 	bool DoLineTrace(FHitResult& HitResultOut, const FVector& StartLoc, const TArray<AActor*>& ActorsToIgnore) const;
 
-	void RemovePropagatedSound(const UAudioComponent* AudioComp, const float DeltaTime);
+	// Muffles and propagates the sound from one transmission search, see bTransmissionSearch 
+	void UpdateSoundPropagationWithTransmission(UAudioComponent* AudioComp, const float DeltaTime);
+
+	// Propagates the sound through every opening found with the multi opening search 
+	void UpdateSoundPropagationThroughOpenings(UAudioComponent* AudioComp, const TArray<AActor*>& ActorsToIgnore, const float DeltaTime);
+
+	// Propagates the sound along a path through the loaded grid chunks, used when there is no AMapGrid 
+	void UpdateSoundPropagationOnChunks(UAudioComponent* AudioComp, const TArray<AActor*>& ActorsToIgnore, const float DeltaTime);
+
+	// Spawns or moves the propagated sound at the slot towards the node location and updates its volume 
+	void UpdatePropagatedSound(UAudioComponent* AudioComp, const int Slot, const FVector& NodeLocation, const int PathSize, const float DeltaTime);
+
+	void RemovePropagatedSound(const UAudioComponent* AudioComp);
+
+	// Fades out the audio comp's propagated sounds from the slot and onwards 
+	void FadeOutPropagatedSounds(const UAudioComponent* AudioComp, const int FirstSlot);
 
 	// Returns the created propagated audio component 
-	UAudioComponent* SpawnPropagatedSound(UAudioComponent* AudioComp, const FVector& SpawnLocation, const int PathSize);
+	UAudioComponent* SpawnPropagatedSound(UAudioComponent* AudioComp, const FVector& SpawnLocation);
 
-	// Returns the volume multiplier that the propagated audio source should have based on length from the original
+	// Adds the propagated audio source to the volume batch, its target volume is based on length from the original
 	// source to the propagated audio source 
-	void SetPropagatedSoundVolume(const UAudioComponent* AudioComp, UAudioComponent* PropAudioComp, int PathSize, const float DeltaTime) const;
+	void SetPropagatedSoundVolume(const UAudioComponent* AudioComp, UAudioComponent* PropAudioComp, int PathSize);
+
+	// Interpolates the volume of every propagated sound in the volume batch and requests it to be set 
+	void ApplyVolumeBatch(const float DeltaTime);
+
+	// Draws the cached path of every sound propagated along a single path this tick 
+	void DrawPaths() const;
 
 	UFUNCTION()
 	void ActorWithCompDestroyed(AActor* DestroyedActor);
 
-	void MovePropagatedAudioComp(UAudioComponent* PropAudioComp, const class FGridNode* ToNode, const float DeltaTime) const;
+	void MovePropagatedAudioComp(UAudioComponent* PropAudioComp, const FVector& TargetLoc, const float DeltaTime) const;
 
 #pragma endregion 
 
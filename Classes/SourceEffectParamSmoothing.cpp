@@ -0,0 +1,62 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SourceEffectParamSmoothing.h"
+
+void FSourceEffectParamSmoothing::Init(const FSoundEffectSourceInitData& InitData)
+{
+	AudioComponentId = InitData.AudioComponentId; 
+	TargetsVersion = 0; 
+
+	// Starts at the targets already sent, or unchanged if there are none yet
+	AudioCore::FSmoothingTargets Targets; 
+	GetTargetTable().TryGet(AudioComponentId, Targets, TargetsVersion); 
+	Filter.Init(InitData.SampleRate, InitData.NumSourceChannels, Targets); 
+
+	OnPresetChanged(); 
+}
+
+void FSourceEffectParamSmoothing::OnPresetChanged()
+{
+	GET_EFFECT_SETTINGS(SourceEffectParamSmoothing); 
+
+	AudioCore::FSmoothingSpeeds Speeds; 
+	Speeds.GainPerSecond = Settings.GainPerSecond; 
+	Speeds.OctavesPerSecond = Settings.OctavesPerSecond; 
+	Filter.SetSpeeds(Speeds); 
+}
+
+void FSourceEffectParamSmoothing::ProcessAudio(const FSoundEffectSourceInputData& InData, float* OutAudioBufferData)
+{
+	// Only read when the game thread sent something new, the filter ramps towards it over the coming buffers
+	AudioCore::FSmoothingTargets Targets; 
+	if(GetTargetTable().TryGet(AudioComponentId, Targets, TargetsVersion))
+		Filter.SetTargets(Targets); 
+
+	const int32 NumFrames = InData.NumSamples / FMath::Max(Filter.GetNumChannels(), 1); 
+	Filter.Process(InData.InputSourceEffectBufferPtr, OutAudioBufferData, NumFrames); 
+}
+
+AudioCore::FSmoothingTargetTable& FSourceEffectParamSmoothing::GetTargetTable()
+{
+	static AudioCore::FSmoothingTargetTable TargetTable; 
+	return TargetTable; 
+}
+
+void USourceEffectParamSmoothingPreset::SetSettings(const FSourceEffectParamSmoothingSettings& InSettings)
+{
+	UpdateSettings(InSettings); 
+}
+
+bool USourceEffectParamSmoothingPreset::IsInChain(const USoundEffectSourcePresetChain* Chain)
+{
+	if(!Chain)
+		return false; 
+
+	for(const FSourceEffectChainEntry& Entry : Chain->Chain)
+	{
+		if(!Entry.bBypass && Cast<USourceEffectParamSmoothingPreset>(Entry.Preset))
+			return true; 
+	}
+
+	return false; 
+}
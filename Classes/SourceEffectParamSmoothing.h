@@ -0,0 +1,69 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/ParamSmoothing.h"
+#include "Sound/SoundEffectSource.h"
+#include "SourceEffectParamSmoothing.generated.h"
+
+USTRUCT(BlueprintType)
+struct GRIM_API FSourceEffectParamSmoothingSettings
+{
+	GENERATED_BODY()
+
+	// How fast the gain moves towards the volume the audio system sets, in volume per second (0 = instantly)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = SourceEffect, meta=(ClampMin=0))
+	float GainPerSecond = 0.5f;
+
+	// How fast the low pass cutoff moves towards the frequency the audio system sets, in octaves per second (0 = instantly)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = SourceEffect, meta=(ClampMin=0))
+	float OctavesPerSecond = 12.f;
+};
+
+/*
+ * Applies the volume and low pass the audio system sets on an audio component on the audio render thread instead,
+ * moving them towards the latest targets one sample at a time so the smoothing does not depend on the frame rate. The
+ * game thread only sends new targets when they change enough to be heard, see UAudioParameterSubsystem
+ */
+class GRIM_API FSourceEffectParamSmoothing : public FSoundEffectSource
+{
+public:
+	virtual void Init(const FSoundEffectSourceInitData& InitData) override;
+
+	virtual void OnPresetChanged() override;
+
+	virtual void ProcessAudio(const FSoundEffectSourceInputData& InData, float* OutAudioBufferData) override;
+
+	// Targets of every smoothed audio comp by its audio component id, shared by every instance of the effect
+	static AudioCore::FSmoothingTargetTable& GetTargetTable();
+
+private:
+
+	AudioCore::FSmoothedGainFilter Filter;
+
+	uint64 AudioComponentId = 0;
+
+	// Version of the targets last read from the table
+	uint32 TargetsVersion = 0;
+};
+
+// Add to the propagation source effect chain (or a sound's own chain) to smooth the audio system's changes on the audio thread
+UCLASS(ClassGroup = AudioSourceEffect, meta = (BlueprintSpawnableComponent))
+class GRIM_API USourceEffectParamSmoothingPreset : public USoundEffectSourcePreset
+{
+	GENERATED_BODY()
+
+public:
+
+	EFFECT_PRESET_METHODS(SourceEffectParamSmoothing)
+
+	UFUNCTION(BlueprintCallable, Category = "Audio|Effects")
+	void SetSettings(const FSourceEffectParamSmoothingSettings& InSettings);
+
+	// True if the chain has a smoothing preset that is not bypassed
+	static bool IsInChain(const USoundEffectSourcePresetChain* Chain);
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = SourceEffect, meta = (ShowOnlyInnerProperties))
+	FSourceEffectParamSmoothingSettings Settings;
+};
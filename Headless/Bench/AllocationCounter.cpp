@@ -0,0 +1,57 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BenchUtils.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Replaces the global allocation functions for the whole benchmark executable so suites can check that their hot
+// paths do not allocate. Only the plain and array forms are replaced, the others forward to these by default
+
+namespace
+{
+	std::atomic<uint64_t> AllocationCount { 0 };
+}
+
+void* operator new(const std::size_t Size)
+{
+	AllocationCount.fetch_add(1, std::memory_order_relaxed);
+	if(void* Memory = std::malloc(Size == 0 ? 1 : Size))
+		return Memory;
+
+	throw std::bad_alloc();
+}
+
+void* operator new[](const std::size_t Size)
+{
+	return operator new(Size);
+}
+
+void operator delete(void* Memory) noexcept
+{
+	std::free(Memory);
+}
+
+void operator delete[](void* Memory) noexcept
+{
+	std::free(Memory);
+}
+
+void operator delete(void* Memory, std::size_t) noexcept
+{
+	std::free(Memory);
+}
+
+void operator delete[](void* Memory, std::size_t) noexcept
+{
+	std::free(Memory);
+}
+
+namespace AudioBench
+{
+	uint64_t GetAllocationCount()
+	{
+		return AllocationCount.load(std::memory_order_relaxed);
+	}
+}
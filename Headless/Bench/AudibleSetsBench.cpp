@@ -0,0 +1,140 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BenchSuites.h"
+#include "SyntheticGrids.h"
+#include "Core/GridAudibleSets.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+
+using namespace AudioCore;
+
+namespace AudioBench
+{
+	namespace
+	{
+		// Falloff distances of the sources in nodes, from small props to loud machines
+		constexpr int MinFalloffNodes = 5;
+		constexpr int MaxFalloffNodes = 30;
+
+		// Every tenth source moves and is a candidate everywhere
+		constexpr int MovingSourceInterval = 10;
+
+		struct FBenchSource
+		{
+			FVec3 Location;
+			float FalloffDistance = 0;
+		};
+
+		// The sources within falloff distance of the listener, the check the components do for every candidate
+		template<typename CandidatesType>
+		void GetInRange(const std::vector<FBenchSource>& Sources, const CandidatesType& Candidates, const FVec3& Listener, std::vector<int>& OutInRange)
+		{
+			for(const int Id : Candidates)
+			{
+				if(Sources[Id].FalloffDistance > FVec3::Dist(Listener, Sources[Id].Location))
+					OutInRange.push_back(Id);
+			}
+		}
+
+		// Every id from 0, what the components looped over before
+		struct FAllSources
+		{
+			struct FIterator
+			{
+				int Id;
+
+				int operator*() const { return Id; }
+				FIterator& operator++() { Id++; return *this; }
+				bool operator!=(const FIterator& Other) const { return Id != Other.Id; }
+			};
+
+			int Num;
+
+			FIterator begin() const { return { 0 }; }
+			FIterator end() const { return { Num }; }
+		};
+	}
+
+	void RunAudibleSetsBench(const FBenchOptions& Options, FBenchReport& Report)
+	{
+		const char* Suite = "audible_sets";
+		const int NumQueries = Options.bQuick ? 200 : 2000;
+		const int RegionSize = 8;
+
+		for(FGridScenario& Scenario : MakeStandardScenarios(Options.bQuick, Options.Seed))
+		{
+			const FOccupancyGrid& Grid = Scenario.Grid;
+			std::mt19937 Random(Options.Seed);
+			std::uniform_int_distribution<int> FalloffNodes(MinFalloffNodes, MaxFalloffNodes);
+
+			// About one source per 200 walkable cells, so the level has many more sources than any listener hears
+			int NumWalkable = 0;
+			for(int Index = 0; Index < Grid.Num(); Index++)
+				NumWalkable += Grid.IsWalkable(Index) ? 1 : 0;
+			const int NumSources = std::max(NumWalkable / 200, 16);
+
+			std::vector<FBenchSource> Sources(static_cast<size_t>(NumSources));
+			for(FBenchSource& Source : Sources)
+			{
+				Source.Location = Grid.IndexToWorld(GetRandomWalkableIndex(Grid, Random));
+				Source.FalloffDistance = FalloffNodes(Random) * SyntheticNodeDiameter;
+			}
+
+			FStopwatch Stopwatch;
+			FGridAudibleSets Sets;
+			Sets.Init(Grid, RegionSize);
+			for(int Id = 0; Id < NumSources; Id++)
+			{
+				if(Id % MovingSourceInterval == 0)
+					Sets.AddMovingSource();
+				else
+					Sets.AddStaticSource(Sources[Id].Location, Sources[Id].FalloffDistance);
+			}
+			Sets.Build();
+			const double BakeSeconds = Stopwatch.GetElapsedSeconds();
+
+			std::vector<FVec3> Listeners;
+			for(int Query = 0; Query < NumQueries; Query++)
+				Listeners.push_back(Grid.IndexToWorld(GetRandomWalkableIndex(Grid, Random)));
+
+			// Every source, checked by distance like the components did before
+			std::vector<std::vector<int>> AllInRange(Listeners.size());
+			Stopwatch.Restart();
+			for(size_t Query = 0; Query < Listeners.size(); Query++)
+				GetInRange(Sources, FAllSources{ NumSources }, Listeners[Query], AllInRange[Query]);
+			const double AllSeconds = Stopwatch.GetElapsedSeconds();
+
+			// Only the listener's region's sources and the moving ones
+			std::vector<std::vector<int>> SetInRange(Listeners.size());
+			long long NumCandidates = 0;
+			Stopwatch.Restart();
+			for(size_t Query = 0; Query < Listeners.size(); Query++)
+			{
+				const FAudibleSourceList RegionSources = Sets.GetSources(Sets.GetRegion(Listeners[Query]));
+				GetInRange(Sources, RegionSources, Listeners[Query], SetInRange[Query]);
+				GetInRange(Sources, Sets.GetMovingSources(), Listeners[Query], SetInRange[Query]);
+				NumCandidates += RegionSources.Num + static_cast<long long>(Sets.GetMovingSources().size());
+			}
+			const double SetSeconds = Stopwatch.GetElapsedSeconds();
+
+			// The sets may only leave out sources that are out of range, so both have to find the same ones
+			int NumMissed = 0;
+			for(size_t Query = 0; Query < Listeners.size(); Query++)
+			{
+				std::sort(SetInRange[Query].begin(), SetInRange[Query].end());
+				for(const int Id : AllInRange[Query])
+					NumMissed += std::binary_search(SetInRange[Query].begin(), SetInRange[Query].end(), Id) ? 0 : 1;
+			}
+
+			Report.Add(Suite, Scenario.Name, "sources", NumSources, "sources", false);
+			Report.Add(Suite, Scenario.Name, "candidates_per_query", static_cast<double>(NumCandidates) / NumQueries, "sources", false);
+			Report.Add(Suite, Scenario.Name, "all_sources_us", AllSeconds * 1e6 / NumQueries, "us", false);
+			Report.Add(Suite, Scenario.Name, "audible_sets_us", SetSeconds * 1e6 / NumQueries, "us", false);
+			Report.Add(Suite, Scenario.Name, "bake_ms", BakeSeconds * 1e3, "ms", false);
+			Report.Add(Suite, Scenario.Name, "memory_kb", Sets.GetMemoryUsage() / 1024.0, "KB", false);
+			Report.Add(Suite, Scenario.Name, "missed_sources", NumMissed, "sources", false);
+		}
+	}
+}
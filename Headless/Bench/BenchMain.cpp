@@ -0,0 +1,113 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BenchSuites.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace AudioBench;
+
+namespace
+{
+	struct FSuite
+	{
+		const char* Name;
+		void (*Run)(const FBenchOptions&, FBenchReport&);
+	};
+
+	// Add new suites here
+	const FSuite Suites[] =
+	{
+		{ "pathfinding", &RunPathfindingBench },
+		{ "occlusion_math", &RunOcclusionMathBench },
+		{ "occlusion_batch", &RunOcclusionBatchBench },
+		{ "neighbours", &RunNeighbourBench },
+		{ "propagation", &RunPropagationBench },
+		{ "grid_levels", &RunGridLevelsBench },
+		{ "chunked_grid", &RunChunkedGridBench },
+		{ "param_updates", &RunParamUpdatesBench },
+		{ "regions", &RunRegionsBench },
+		{ "landmarks", &RunLandmarksBench },
+		{ "bidirectional", &RunBidirectionalBench },
+		{ "cell_layout", &RunCellLayoutBench },
+		{ "time_sliced", &RunTimeSlicedBench },
+		{ "nearest_walkable", &RunNearestWalkableBench },
+		{ "voxelizer", &RunVoxelizerBench },
+		{ "occlusion_parallel", &RunOcclusionParallelBench },
+		{ "debug_view", &RunDebugViewBench },
+		{ "distance_field", &RunDistanceFieldBench },
+		{ "path_arena", &RunPathArenaBench },
+		{ "transmission", &RunTransmissionBench },
+		{ "param_smoothing", &RunParamSmoothingBench },
+		{ "audible_sets", &RunAudibleSetsBench },
+		{ "wall_distance", &RunWallDistanceBench },
+	};
+
+	void PrintUsage()
+	{
+		std::printf("Usage: AudioSystemBench [--quick] [--suite NAME]... [--seed N] [--csv PATH] [--baseline PATH] [--tolerance FRACTION]\n");
+		std::printf("Suites:");
+		for(const FSuite& Suite : Suites)
+			std::printf(" %s", Suite.Name);
+		std::printf("\n");
+	}
+}
+
+int main(int Argc, char** Argv)
+{
+	FBenchOptions Options;
+	std::vector<std::string> SelectedSuites;
+	std::string CsvPath;
+	std::string BaselinePath;
+	double Tolerance = 0.25;
+
+	for(int i = 1; i < Argc; i++)
+	{
+		const bool bHasValue = i + 1 < Argc;
+		if(std::strcmp(Argv[i], "--quick") == 0)
+			Options.bQuick = true;
+		else if(std::strcmp(Argv[i], "--suite") == 0 && bHasValue)
+			SelectedSuites.push_back(Argv[++i]);
+		else if(std::strcmp(Argv[i], "--seed") == 0 && bHasValue)
+			Options.Seed = static_cast<uint32_t>(std::strtoul(Argv[++i], nullptr, 10));
+		else if(std::strcmp(Argv[i], "--csv") == 0 && bHasValue)
+			CsvPath = Argv[++i];
+		else if(std::strcmp(Argv[i], "--baseline") == 0 && bHasValue)
+			BaselinePath = Argv[++i];
+		else if(std::strcmp(Argv[i], "--tolerance") == 0 && bHasValue)
+			Tolerance = std::strtod(Argv[++i], nullptr);
+		else
+		{
+			PrintUsage();
+			return 2;
+		}
+	}
+
+	FBenchReport Report;
+	for(const FSuite& Suite : Suites)
+	{
+		bool bSelected = SelectedSuites.empty();
+		for(const std::string& Selected : SelectedSuites)
+			bSelected |= Selected == Suite.Name;
+
+		if(bSelected)
+			Suite.Run(Options, Report);
+	}
+
+	Report.Print();
+
+	if(!CsvPath.empty() && !Report.WriteCsv(CsvPath))
+	{
+		std::printf("Could not write %s\n", CsvPath.c_str());
+		return 1;
+	}
+
+	// Non zero exit code on regressions so CI fails
+	if(!BaselinePath.empty())
+		return Report.CompareWithBaseline(BaselinePath, Tolerance) == 0 ? 0 : 1;
+
+	return 0;
+}
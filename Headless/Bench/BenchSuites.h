@@ -0,0 +1,56 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "BenchUtils.h"
+
+namespace AudioBench
+{
+	// Every suite adds its results to the report, see BenchMain.cpp for how they are selected from the command line
+
+	void RunPathfindingBench(const FBenchOptions& Options, FBenchReport& Report);
+
+	void RunOcclusionMathBench(const FBenchOptions& Options, FBenchReport& Report);
+
+	void RunOcclusionBatchBench(const FBenchOptions& Options, FBenchReport& Report);
+
+	void RunNeighbourBench(const FBenchOptions& Options, FBenchReport& Report);
+
+	void RunPropagationBench(const FBenchOptions& Options, FBenchReport& Report);
+
+	void RunGridLevelsBench(const FBenchOptions& Options, FBenchReport& Report);
+
+	void RunChunkedGridBench(const FBenchOptions& Options, FBenchReport& Report);
+
+	void RunParamUpdatesBench(const FBenchOptions& Options, FBenchReport& Report);
+
+	void RunRegionsBench(const FBenchOptions& Options, FBenchReport& Report);
+
+	void RunLandmarksBench(const FBenchOptions& Options, FBenchReport& Report);
+
+	void RunBidirectionalBench(const FBenchOptions& Options, FBenchReport& Report);
+
+	void RunCellLayoutBench(const FBenchOptions& Options, FBenchReport& Report);
+
+	void RunTimeSlicedBench(const FBenchOptions& Options, FBenchReport& Report);
+
+	void RunNearestWalkableBench(const FBenchOptions& Options, FBenchReport& Report);
+
+	void RunVoxelizerBench(const FBenchOptions& Options, FBenchReport& Report);
+
+	void RunOcclusionParallelBench(const FBenchOptions& Options, FBenchReport& Report);
+
+	void RunDebugViewBench(const FBenchOptions& Options, FBenchReport& Report);
+
+	void RunDistanceFieldBench(const FBenchOptions& Options, FBenchReport& Report);
+
+	void RunPathArenaBench(const FBenchOptions& Options, FBenchReport& Report);
+
+	void RunTransmissionBench(const FBenchOptions& Options, FBenchReport& Report);
+
+	void RunParamSmoothingBench(const FBenchOptions& Options, FBenchReport& Report);
+
+	void RunAudibleSetsBench(const FBenchOptions& Options, FBenchReport& Report);
+
+	void RunWallDistanceBench(const FBenchOptions& Options, FBenchReport& Report);
+}
@@ -0,0 +1,100 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BenchUtils.h"
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+namespace AudioBench
+{
+	void FBenchReport::Add(const std::string& Suite, const std::string& Scenario, const std::string& Metric, const double Value, const std::string& Unit, const bool bHigherIsBetter)
+	{
+		Results.push_back({ Suite, Scenario, Metric, Value, Unit, bHigherIsBetter });
+	}
+
+	void FBenchReport::Print() const
+	{
+		std::string LastSuite;
+		for(const FBenchResult& Result : Results)
+		{
+			if(Result.Suite != LastSuite)
+			{
+				std::printf("\n[%s]\n", Result.Suite.c_str());
+				LastSuite = Result.Suite;
+			}
+
+			std::printf("  %-28s %-34s %14.3f %s\n", Result.Scenario.c_str(), Result.Metric.c_str(), Result.Value, Result.Unit.c_str());
+		}
+	}
+
+	bool FBenchReport::WriteCsv(const std::string& Path) const
+	{
+		std::ofstream File(Path);
+		if(!File)
+			return false;
+
+		File << "suite,scenario,metric,value,unit,higher_is_better\n";
+		for(const FBenchResult& Result : Results)
+		{
+			File << Result.Suite << ',' << Result.Scenario << ',' << Result.Metric << ',' << Result.Value << ','
+				<< Result.Unit << ',' << (Result.bHigherIsBetter ? 1 : 0) << '\n';
+		}
+
+		return true;
+	}
+
+	int FBenchReport::CompareWithBaseline(const std::string& Path, const double Tolerance) const
+	{
+		std::ifstream File(Path);
+		if(!File)
+		{
+			std::printf("Could not open baseline %s\n", Path.c_str());
+			return 1;
+		}
+
+		// Key is suite/scenario/metric
+		std::map<std::string, double> Baseline;
+		std::string Line;
+		std::getline(File, Line); // Header
+		while(std::getline(File, Line))
+		{
+			std::stringstream Stream(Line);
+			std::string Suite, Scenario, Metric, Value;
+			std::getline(Stream, Suite, ',');
+			std::getline(Stream, Scenario, ',');
+			std::getline(Stream, Metric, ',');
+			std::getline(Stream, Value, ',');
+			if(!Value.empty())
+				Baseline[Suite + "/" + Scenario + "/" + Metric] = std::stod(Value);
+		}
+
+		int Regressions = 0;
+		for(const FBenchResult& Result : Results)
+		{
+			const auto Found = Baseline.find(Result.Suite + "/" + Result.Scenario + "/" + Result.Metric);
+			if(Found == Baseline.end() || Found->second == 0)
+				continue;
+
+			// Positive change is always worse
+			const double Change = (Result.Value - Found->second) / std::abs(Found->second) * (Result.bHigherIsBetter ? -1 : 1);
+			if(Change > Tolerance)
+			{
+				std::printf("REGRESSION %s/%s/%s: %.3f -> %.3f %s (%.1f%% worse)\n", Result.Suite.c_str(), Result.Scenario.c_str(),
+					Result.Metric.c_str(), Found->second, Result.Value, Result.Unit.c_str(), Change * 100);
+				Regressions++;
+			}
+		}
+
+		return Regressions;
+	}
+
+	void AddLatencyPercentiles(FBenchReport& Report, const std::string& Suite, const std::string& Scenario, const std::string& MetricPrefix, std::vector<double>& SamplesMicroseconds)
+	{
+		Report.Add(Suite, Scenario, MetricPrefix + "_p50", GetPercentile(SamplesMicroseconds, 50), "us", false);
+		Report.Add(Suite, Scenario, MetricPrefix + "_p90", GetPercentile(SamplesMicroseconds, 90), "us", false);
+		Report.Add(Suite, Scenario, MetricPrefix + "_p99", GetPercentile(SamplesMicroseconds, 99), "us", false);
+	}
+}
@@ -0,0 +1,95 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace AudioBench
+{
+	// Settings shared by every suite, set from the command line
+	struct FBenchOptions
+	{
+		// Fewer iterations, used in CI where only regressions matter
+		bool bQuick = false;
+
+		// Seed for all synthetic data so runs are comparable
+		uint32_t Seed = 1891;
+	};
+
+	// One measured value. Rows are printed and optionally written to CSV and compared against a baseline
+	struct FBenchResult
+	{
+		std::string Suite;
+		std::string Scenario;
+		std::string Metric;
+		double Value = 0;
+		std::string Unit;
+
+		// Decides which direction counts as a regression when comparing against a baseline
+		bool bHigherIsBetter = false;
+	};
+
+	class FBenchReport
+	{
+	public:
+		void Add(const std::string& Suite, const std::string& Scenario, const std::string& Metric, const double Value, const std::string& Unit, const bool bHigherIsBetter);
+
+		void Print() const;
+
+		bool WriteCsv(const std::string& Path) const;
+
+		/* Compares against a CSV written by an earlier run. Returns the number of metrics that got worse by more than
+		 * Tolerance (0.2 = 20%), metrics missing from the baseline are ignored */
+		int CompareWithBaseline(const std::string& Path, const double Tolerance) const;
+
+	private:
+		std::vector<FBenchResult> Results;
+	};
+
+	class FStopwatch
+	{
+	public:
+		FStopwatch() : Start(std::chrono::steady_clock::now()) {}
+
+		void Restart() { Start = std::chrono::steady_clock::now(); }
+
+		double GetElapsedSeconds() const
+		{
+			return std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+		}
+
+		double GetElapsedMicroseconds() const { return GetElapsedSeconds() * 1e6; }
+
+	private:
+		std::chrono::steady_clock::time_point Start;
+	};
+
+	// Nearest rank percentile, Percent between 0 and 100. Sorts the passed samples
+	inline double GetPercentile(std::vector<double>& Samples, const double Percent)
+	{
+		if(Samples.empty())
+			return 0;
+
+		std::sort(Samples.begin(), Samples.end());
+		const size_t Rank = static_cast<size_t>(Percent / 100.0 * static_cast<double>(Samples.size() - 1) + 0.5);
+		return Samples[std::min(Rank, Samples.size() - 1)];
+	}
+
+	// Keeps the optimizer from removing work whose result is otherwise unused
+	template<typename ValueType>
+	void DoNotOptimize(const ValueType& Value)
+	{
+		static volatile const void* Sink;
+		Sink = &Value;
+	}
+
+	// Number of heap allocations made by the benchmark executable so far, see AllocationCounter.cpp
+	uint64_t GetAllocationCount();
+
+	// Adds the p50, p90 and p99 of the samples (in microseconds) to the report
+	void AddLatencyPercentiles(FBenchReport& Report, const std::string& Suite, const std::string& Scenario, const std::string& MetricPrefix, std::vector<double>& SamplesMicroseconds);
+}
@@ -0,0 +1,139 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BenchSuites.h"
+#include "SyntheticGrids.h"
+#include "Core/BidirectionalGridPathfinder.h"
+#include "Core/GridLandmarks.h"
+#include "Core/GridPathfinder.h"
+
+#include <cstdlib>
+#include <string>
+
+using namespace AudioCore;
+
+namespace AudioBench
+{
+	namespace
+	{
+		// Sum of the step costs along the path in one axis steps, -1 if it is not a connected walkable path from the
+		// start cell to the end cell in the "backwards" order the pathfinders return
+		int GetPathCost(const FOccupancyGrid& Grid, const int Start, const int End, const std::vector<int>& Path)
+		{
+			if(Path.empty() || Path.front() != End)
+				return -1;
+
+			int Cost = 0;
+			int Previous = Start;
+			for(auto Cell = Path.rbegin(); Cell != Path.rend(); ++Cell)
+			{
+				const FGridCoord From = Grid.GetCoord(Previous);
+				const FGridCoord To = Grid.GetCoord(*Cell);
+				if(!Grid.IsWalkable(*Cell) || std::abs(From.X - To.X) > 1 || std::abs(From.Y - To.Y) > 1 || std::abs(From.Z - To.Z) > 1)
+					return -1;
+
+				Cost += (From.X != To.X) + (From.Y != To.Y) + (From.Z != To.Z);
+				Previous = *Cell;
+			}
+
+			return Cost;
+		}
+
+		// Queries between cells at least half the grid's size apart along the axes, where the single search's frontier
+		// grows the widest
+		std::vector<FGridQuery> MakeLongQueries(const FOccupancyGrid& Grid, const int NumQueries, std::mt19937& Random)
+		{
+			const int MinSteps = (Grid.GetLengthX() + Grid.GetLengthY() + Grid.GetLengthZ()) / 2;
+			std::vector<FGridQuery> Queries;
+			for(int Attempt = 0; Attempt < NumQueries * 1000 && static_cast<int>(Queries.size()) < NumQueries; Attempt++)
+			{
+				const FGridQuery Query { GetRandomWalkableIndex(Grid, Random), GetRandomWalkableIndex(Grid, Random) };
+				const FGridCoord Start = Grid.GetCoord(Query.Start);
+				const FGridCoord End = Grid.GetCoord(Query.End);
+				if(std::abs(Start.X - End.X) + std::abs(Start.Y - End.Y) + std::abs(Start.Z - End.Z) >= MinSteps)
+					Queries.push_back(Query);
+			}
+
+			return Queries;
+		}
+	}
+
+	void RunBidirectionalBench(const FBenchOptions& Options, FBenchReport& Report)
+	{
+		const char* Suite = "bidirectional";
+		const int NumQueries = Options.bQuick ? 20 : 100;
+		std::mt19937 Random(Options.Seed);
+
+		for(FGridScenario& Scenario : MakeStandardScenarios(Options.bQuick, Options.Seed))
+		{
+			const FOccupancyGrid& Grid = Scenario.Grid;
+			const std::vector<FGridQuery> Queries = MakeLongQueries(Grid, NumQueries, Random);
+			if(Queries.empty())
+				continue;
+
+			FGridLandmarks Landmarks;
+			Landmarks.Build(Grid, 8, 4);
+
+			FGridPathfinder Pathfinder(Grid);
+			FBidirectionalGridPathfinder BidirectionalPathfinder(Grid);
+			std::vector<int> Path;
+
+			// Both heuristics, the default squared distance and the landmarks
+			for(const bool bUseLandmarks : { false, true })
+			{
+				Pathfinder.SetLandmarks(bUseLandmarks ? &Landmarks : nullptr);
+				BidirectionalPathfinder.SetLandmarks(bUseLandmarks ? &Landmarks : nullptr);
+
+				double Seconds = 0;
+				double BidirectionalSeconds = 0;
+				long long Expanded = 0;
+				long long BidirectionalExpanded = 0;
+				int NumMismatches = 0;
+				int NumInvalidPaths = 0;
+				double TotalCostRatio = 0;
+				int NumCostRatios = 0;
+
+				for(const FGridQuery& Query : Queries)
+				{
+					FStopwatch Stopwatch;
+					const bool bFound = Pathfinder.FindPath(Query.Start, Query.End, Path);
+					Seconds += Stopwatch.GetElapsedSeconds();
+					Expanded += Pathfinder.GetLastStats().NodesExpanded;
+					const int Cost = bFound ? GetPathCost(Grid, Query.Start, Query.End, Path) : -1;
+
+					Stopwatch.Restart();
+					const bool bBidirectionalFound = BidirectionalPathfinder.FindPath(Query.Start, Query.End, Path);
+					BidirectionalSeconds += Stopwatch.GetElapsedSeconds();
+					BidirectionalExpanded += BidirectionalPathfinder.GetLastStats().NodesExpanded;
+
+					if(bFound != bBidirectionalFound)
+					{
+						NumMismatches++;
+						continue;
+					}
+
+					if(!bFound)
+						continue;
+
+					const int BidirectionalCost = GetPathCost(Grid, Query.Start, Query.End, Path);
+					if(BidirectionalCost < 0)
+						NumInvalidPaths++;
+					else if(Cost > 0)
+					{
+						TotalCostRatio += static_cast<double>(BidirectionalCost) / Cost;
+						NumCostRatios++;
+					}
+				}
+
+				const double Num = static_cast<double>(Queries.size());
+				const std::string Prefix = bUseLandmarks ? "alt_" : "default_";
+				Report.Add(Suite, Scenario.Name, Prefix + "single_us_per_query", Seconds * 1e6 / Num, "us", false);
+				Report.Add(Suite, Scenario.Name, Prefix + "bidirectional_us_per_query", BidirectionalSeconds * 1e6 / Num, "us", false);
+				Report.Add(Suite, Scenario.Name, Prefix + "single_nodes_expanded_mean", Expanded / Num, "nodes", false);
+				Report.Add(Suite, Scenario.Name, Prefix + "bidirectional_nodes_expanded_mean", BidirectionalExpanded / Num, "nodes", false);
+				Report.Add(Suite, Scenario.Name, Prefix + "reachability_mismatches", NumMismatches, "queries", false);
+				Report.Add(Suite, Scenario.Name, Prefix + "invalid_paths", NumInvalidPaths, "queries", false);
+				Report.Add(Suite, Scenario.Name, Prefix + "path_cost_ratio", NumCostRatios > 0 ? TotalCostRatio / NumCostRatios : 0, "x", false);
+			}
+		}
+	}
+}
@@ -0,0 +1,156 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BenchSuites.h"
+#include "SyntheticGrids.h"
+#include "Core/GridNeighbours.h"
+#include "Core/GridPathfinder.h"
+#include "Core/GridRaycast.h"
+
+#include <algorithm>
+#include <string>
+
+using namespace AudioCore;
+
+namespace AudioBench
+{
+	namespace
+	{
+		// Sums the walkable neighbours of the cells in the given order so both layouts do the same work
+		double MeasureNeighbourAccesses(const FOccupancyGrid& Grid, const std::vector<FGridCoord>& Order, const int NumRepeats, long long& OutNumWalkable)
+		{
+			const TGridNeighbours<26> Neighbours(Grid);
+			OutNumWalkable = 0;
+
+			const FStopwatch Stopwatch;
+			for(int Repeat = 0; Repeat < NumRepeats; Repeat++)
+			{
+				for(const FGridCoord& Coord : Order)
+				{
+					for(const int Neighbour : Neighbours.GetNeighbours(Grid.GetIndex(Coord)))
+						OutNumWalkable += Grid.IsWalkable(Neighbour) ? 1 : 0;
+				}
+			}
+
+			DoNotOptimize(OutNumWalkable);
+
+			return static_cast<double>(Order.size()) * NumRepeats * 26 / Stopwatch.GetElapsedSeconds();
+		}
+
+		// The same path on both layouts has the same cells, compared by coordinates since the indexes differ
+		bool IsSamePath(const FOccupancyGrid& Grid, const std::vector<int>& Path, const FOccupancyGrid& OtherGrid, const std::vector<int>& OtherPath)
+		{
+			if(Path.size() != OtherPath.size())
+				return false;
+
+			for(size_t i = 0; i < Path.size(); i++)
+			{
+				const FGridCoord Coord = Grid.GetCoord(Path[i]);
+				const FGridCoord OtherCoord = OtherGrid.GetCoord(OtherPath[i]);
+				if(Coord.X != OtherCoord.X || Coord.Y != OtherCoord.Y || Coord.Z != OtherCoord.Z)
+					return false;
+			}
+
+			return true;
+		}
+	}
+
+	void RunCellLayoutBench(const FBenchOptions& Options, FBenchReport& Report)
+	{
+		const char* Suite = "cell_layout";
+		const int NumRepeats = Options.bQuick ? 1 : 3;
+		std::mt19937 Random(Options.Seed);
+
+		// A large open field on top of the standard scenarios, where the linear layout's plane sized jumps hurt the most
+		std::vector<FGridScenario> Scenarios = MakeStandardScenarios(Options.bQuick, Options.Seed);
+		Scenarios.push_back(Options.bQuick ? MakeOpenField(128, 128, 32, 20, Random) : MakeOpenField(256, 256, 64, 50, Random));
+		Scenarios.back().Name = "large_open_field";
+
+		for(FGridScenario& Scenario : Scenarios)
+		{
+			const FOccupancyGrid& Linear = Scenario.Grid;
+			const FOccupancyGrid Bricks = CopyWithLayout(Linear, ECellLayout::Bricks);
+			Report.Add(Suite, Scenario.Name, "bricks_padding_ratio", static_cast<double>(Bricks.Num()) / Linear.Num(), "x", false);
+
+			// Every cell in the order the linear layout stores them, then shuffled like a search's scattered accesses
+			std::vector<FGridCoord> Order;
+			Order.reserve(static_cast<size_t>(Linear.Num()));
+			for(int Index = 0; Index < Linear.Num(); Index++)
+				Order.push_back(Linear.GetCoord(Index));
+
+			std::vector<FGridCoord> ShuffledOrder = Order;
+			std::shuffle(ShuffledOrder.begin(), ShuffledOrder.end(), Random);
+
+			long long LinearWalkable = 0;
+			long long BricksWalkable = 0;
+			Report.Add(Suite, Scenario.Name, "linear_sequential_accesses_per_second", MeasureNeighbourAccesses(Linear, Order, NumRepeats, LinearWalkable), "accesses/s", true);
+			Report.Add(Suite, Scenario.Name, "bricks_sequential_accesses_per_second", MeasureNeighbourAccesses(Bricks, Order, NumRepeats, BricksWalkable), "accesses/s", true);
+			Report.Add(Suite, Scenario.Name, "linear_shuffled_accesses_per_second", MeasureNeighbourAccesses(Linear, ShuffledOrder, NumRepeats, LinearWalkable), "accesses/s", true);
+			Report.Add(Suite, Scenario.Name, "bricks_shuffled_accesses_per_second", MeasureNeighbourAccesses(Bricks, ShuffledOrder, NumRepeats, BricksWalkable), "accesses/s", true);
+
+			// Padding is blocked so both layouts have to see the same walkable neighbours
+			Report.Add(Suite, Scenario.Name, "neighbour_mismatches", static_cast<double>(std::abs(LinearWalkable - BricksWalkable)), "neighbours", false);
+
+			// A* on the same queries, the bricks queries are the same cells by coordinates
+			FGridPathfinder LinearPathfinder(Linear);
+			FGridPathfinder BricksPathfinder(Bricks);
+			std::vector<int> LinearPath;
+			std::vector<int> BricksPath;
+			double LinearSeconds = 0;
+			double BricksSeconds = 0;
+			long long LinearExpanded = 0;
+			long long BricksExpanded = 0;
+			int NumMismatches = 0;
+			for(const FGridQuery& Query : Scenario.Queries)
+			{
+				const int BricksStart = Bricks.GetIndex(Linear.GetCoord(Query.Start));
+				const int BricksEnd = Bricks.GetIndex(Linear.GetCoord(Query.End));
+
+				FStopwatch Stopwatch;
+				const bool bLinearFound = LinearPathfinder.FindPath(Query.Start, Query.End, LinearPath);
+				LinearSeconds += Stopwatch.GetElapsedSeconds();
+				LinearExpanded += LinearPathfinder.GetLastStats().NodesExpanded;
+
+				Stopwatch.Restart();
+				const bool bBricksFound = BricksPathfinder.FindPath(BricksStart, BricksEnd, BricksPath);
+				BricksSeconds += Stopwatch.GetElapsedSeconds();
+				BricksExpanded += BricksPathfinder.GetLastStats().NodesExpanded;
+
+				// Ties are broken the same way on both layouts only if the neighbours come in the same order, which they do
+				if(bLinearFound != bBricksFound || !IsSamePath(Linear, LinearPath, Bricks, BricksPath))
+					NumMismatches++;
+			}
+
+			const double NumQueries = static_cast<double>(Scenario.Queries.size());
+			Report.Add(Suite, Scenario.Name, "linear_astar_us_per_query", LinearSeconds * 1e6 / NumQueries, "us", false);
+			Report.Add(Suite, Scenario.Name, "bricks_astar_us_per_query", BricksSeconds * 1e6 / NumQueries, "us", false);
+			Report.Add(Suite, Scenario.Name, "linear_nodes_expanded_mean", LinearExpanded / NumQueries, "nodes", false);
+			Report.Add(Suite, Scenario.Name, "bricks_nodes_expanded_mean", BricksExpanded / NumQueries, "nodes", false);
+			Report.Add(Suite, Scenario.Name, "path_mismatches", NumMismatches, "queries", false);
+
+			// Ray marches between the query cells, like the occlusion traces
+			double LinearTraceSeconds = 0;
+			double BricksTraceSeconds = 0;
+			int NumTraceMismatches = 0;
+			for(const FGridQuery& Query : Scenario.Queries)
+			{
+				const FVec3 From = Linear.IndexToWorld(Query.Start);
+				const FVec3 To = Linear.IndexToWorld(Query.End);
+
+				FStopwatch Stopwatch;
+				const FGridTraceResult LinearTrace = TraceGrid(Linear, From, To);
+				LinearTraceSeconds += Stopwatch.GetElapsedSeconds();
+
+				Stopwatch.Restart();
+				const FGridTraceResult BricksTrace = TraceGrid(Bricks, From, To);
+				BricksTraceSeconds += Stopwatch.GetElapsedSeconds();
+
+				if(LinearTrace.NumBlockedRuns != BricksTrace.NumBlockedRuns)
+					NumTraceMismatches++;
+			}
+
+			Report.Add(Suite, Scenario.Name, "linear_trace_us", LinearTraceSeconds * 1e6 / NumQueries, "us", false);
+			Report.Add(Suite, Scenario.Name, "bricks_trace_us", BricksTraceSeconds * 1e6 / NumQueries, "us", false);
+			Report.Add(Suite, Scenario.Name, "trace_mismatches", NumTraceMismatches, "queries", false);
+		}
+	}
+}
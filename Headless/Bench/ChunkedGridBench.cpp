@@ -0,0 +1,149 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BenchSuites.h"
+#include "SyntheticGrids.h"
+#include "Core/ChunkedGrid.h"
+#include "Core/ChunkedGridPathfinder.h"
+#include "Core/GridPathfinder.h"
+#include "Core/GridSerialization.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+using namespace AudioCore;
+
+namespace AudioBench
+{
+	namespace
+	{
+		// A chunk written by SaveGrid, like the baked data of a streamed level
+		struct FBakedChunk
+		{
+			FGridCoord ChunkCoord;
+			std::vector<uint8_t> Data;
+		};
+
+		int GetNumChunks(const int Length, const int ChunkSize) { return (Length + ChunkSize - 1) / ChunkSize; }
+	}
+
+	void RunChunkedGridBench(const FBenchOptions& Options, FBenchReport& Report)
+	{
+		const char* Suite = "chunked_grid";
+		const int ChunkSize = 8;
+
+		// Chunks kept loaded in each direction around the listener when streaming
+		const int StreamingRadius = 1;
+
+		for(FGridScenario& Scenario : MakeStandardScenarios(Options.bQuick, Options.Seed))
+		{
+			const FOccupancyGrid& Grid = Scenario.Grid;
+			const int NumChunksX = GetNumChunks(Grid.GetLengthX(), ChunkSize);
+			const int NumChunksY = GetNumChunks(Grid.GetLengthY(), ChunkSize);
+			const int NumChunksZ = GetNumChunks(Grid.GetLengthZ(), ChunkSize);
+
+			std::vector<FBakedChunk> BakedChunks;
+			for(int x = 0; x < NumChunksX; x++)
+			{
+				for(int y = 0; y < NumChunksY; y++)
+				{
+					for(int z = 0; z < NumChunksZ; z++)
+					{
+						const FGridCoord ChunkCoord(x, y, z);
+						BakedChunks.push_back({ ChunkCoord, SaveGrid(ExtractChunk(Grid, ChunkCoord, ChunkSize)) });
+					}
+				}
+			}
+
+			// Every chunk loaded, the whole grid is searchable
+			FChunkedGrid Chunked;
+			Chunked.Init(ChunkSize, Grid.GetNodeDiameter(), Grid.GetBottomLeft());
+
+			const FStopwatch LoadStopwatch;
+			for(const FBakedChunk& Chunk : BakedChunks)
+				Chunked.LoadChunk(Chunk.ChunkCoord, Chunk.Data.data(), Chunk.Data.size());
+
+			Report.Add(Suite, Scenario.Name, "chunks", static_cast<double>(BakedChunks.size()), "chunks", false);
+			Report.Add(Suite, Scenario.Name, "load_us_per_chunk", LoadStopwatch.GetElapsedSeconds() * 1e6 / BakedChunks.size(), "us", false);
+			Report.Add(Suite, Scenario.Name, "monolithic_memory", static_cast<double>(Grid.Num()) * (FOccupancyGrid::GetBytesPerCell() + FGridPathfinder::GetBytesPerNode()), "bytes", false);
+
+			FGridPathfinder Pathfinder(Grid);
+			FChunkedGridPathfinder ChunkedPathfinder(Chunked);
+			std::vector<int> Path;
+			std::vector<int> ChunkedPath;
+
+			double MonolithicSeconds = 0;
+			double ChunkedSeconds = 0;
+			long long ChunkedExpanded = 0;
+			int NumMismatches = 0;
+
+			for(const FGridQuery& Query : Scenario.Queries)
+			{
+				const int Start = Chunked.WorldToCell(Grid.IndexToWorld(Query.Start));
+				const int End = Chunked.WorldToCell(Grid.IndexToWorld(Query.End));
+
+				FStopwatch Stopwatch;
+				const bool bFound = Pathfinder.FindPath(Query.Start, Query.End, Path);
+				MonolithicSeconds += Stopwatch.GetElapsedSeconds();
+
+				Stopwatch.Restart();
+				const bool bChunkedFound = ChunkedPathfinder.FindPath(Start, End, ChunkedPath);
+				ChunkedSeconds += Stopwatch.GetElapsedSeconds();
+				ChunkedExpanded += ChunkedPathfinder.GetLastStats().NodesExpanded;
+
+				// Same costs and tie breaking, so the paths should be the same cell for cell
+				bool bSame = bFound == bChunkedFound && Path.size() == ChunkedPath.size();
+				for(size_t i = 0; bSame && i < Path.size(); i++)
+					bSame = Grid.GetIndex(Chunked.GetGlobalCoord(ChunkedPath[i])) == Path[i];
+
+				if(!bSame)
+					NumMismatches++;
+			}
+
+			const double NumQueries = static_cast<double>(Scenario.Queries.size());
+			Report.Add(Suite, Scenario.Name, "monolithic_us_per_query", MonolithicSeconds * 1e6 / NumQueries, "us", false);
+			Report.Add(Suite, Scenario.Name, "chunked_us_per_query", ChunkedSeconds * 1e6 / NumQueries, "us", false);
+			Report.Add(Suite, Scenario.Name, "chunked_nodes_expanded_mean", ChunkedExpanded / NumQueries, "nodes", false);
+			Report.Add(Suite, Scenario.Name, "path_mismatches", NumMismatches, "queries", false);
+			Report.Add(Suite, Scenario.Name, "all_loaded_memory", static_cast<double>(Chunked.GetMemoryUsage() + ChunkedPathfinder.GetMemoryUsage()), "bytes", false);
+
+			// A listener walking along the grid with only the chunks around it loaded, like level streaming would
+			FChunkedGrid Streamed;
+			Streamed.Init(ChunkSize, Grid.GetNodeDiameter(), Grid.GetBottomLeft());
+			FChunkedGridPathfinder StreamedPathfinder(Streamed);
+
+			size_t PeakMemory = 0;
+			int NumStreamSteps = 0;
+			double StreamSeconds = 0;
+			const int ListenerY = NumChunksY / 2;
+			const int ListenerZ = NumChunksZ / 2;
+
+			for(int ListenerX = 0; ListenerX < NumChunksX; ListenerX++)
+			{
+				const FStopwatch Stopwatch;
+				for(const FBakedChunk& Chunk : BakedChunks)
+				{
+					const bool bInWindow = std::abs(Chunk.ChunkCoord.X - ListenerX) <= StreamingRadius &&
+						std::abs(Chunk.ChunkCoord.Y - ListenerY) <= StreamingRadius && std::abs(Chunk.ChunkCoord.Z - ListenerZ) <= StreamingRadius;
+
+					if(bInWindow && !Streamed.IsChunkLoaded(Chunk.ChunkCoord))
+						Streamed.LoadChunk(Chunk.ChunkCoord, Chunk.Data.data(), Chunk.Data.size());
+					else if(!bInWindow && Streamed.IsChunkLoaded(Chunk.ChunkCoord))
+						Streamed.UnloadChunk(Chunk.ChunkCoord);
+				}
+				StreamSeconds += Stopwatch.GetElapsedSeconds();
+				NumStreamSteps++;
+
+				// A search inside the window so the search state grows to what the window needs
+				const FVec3 ListenerLoc = Streamed.GetChunkBottomLeft(FGridCoord(ListenerX, ListenerY, ListenerZ));
+				const int Cell = Streamed.WorldToCell(ListenerLoc);
+				if(Cell != InvalidIndex)
+					StreamedPathfinder.FindPath(Cell, Cell, Path);
+
+				PeakMemory = std::max(PeakMemory, Streamed.GetMemoryUsage() + StreamedPathfinder.GetMemoryUsage());
+			}
+
+			Report.Add(Suite, Scenario.Name, "streamed_peak_memory", static_cast<double>(PeakMemory), "bytes", false);
+			Report.Add(Suite, Scenario.Name, "streamed_us_per_step", StreamSeconds * 1e6 / NumStreamSteps, "us", false);
+		}
+	}
+}
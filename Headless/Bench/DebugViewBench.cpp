@@ -0,0 +1,137 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BenchSuites.h"
+#include "SyntheticGrids.h"
+#include "Core/GridDebugView.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+using namespace AudioCore;
+
+namespace AudioBench
+{
+	namespace
+	{
+		// The defaults of AMapGrid
+		constexpr int DebugRadius = 12;
+		constexpr int MaxDebugCells = 20000;
+
+		int GetShellDistance(const FOccupancyGrid& Grid, const int Index, const FGridCoord& Center)
+		{
+			const FGridCoord Coord = Grid.GetCoord(Index);
+			return std::max({ std::abs(Coord.X - Center.X), std::abs(Coord.Y - Center.Y), std::abs(Coord.Z - Center.Z) });
+		}
+
+		/* Cells in the area that should have been picked before the furthest picked cell but were not, or picked cells
+		 * outside the area. Blocked cells only */
+		int CountMisplacedCells(const FOccupancyGrid& Grid, const FGridCoord& Center, const FGridCoord& Min, const FGridCoord& Max, const FGridDebugCells& Cells)
+		{
+			std::vector<char> bPicked(static_cast<size_t>(Grid.Num()), 0);
+			int FurthestShell = 0;
+			int NumMisplaced = 0;
+			for(const int Index : Cells.BlockedCells)
+			{
+				bPicked[Index] = 1;
+				FurthestShell = std::max(FurthestShell, GetShellDistance(Grid, Index, Center));
+
+				const FGridCoord Coord = Grid.GetCoord(Index);
+				if(Coord.X < Min.X || Coord.Y < Min.Y || Coord.Z < Min.Z || Coord.X > Max.X || Coord.Y > Max.Y || Coord.Z > Max.Z)
+					NumMisplaced++;
+			}
+
+			for(int X = std::max(Min.X, 0); X <= std::min(Max.X, Grid.GetLengthX() - 1); X++)
+			{
+				for(int Y = std::max(Min.Y, 0); Y <= std::min(Max.Y, Grid.GetLengthY() - 1); Y++)
+				{
+					for(int Z = std::max(Min.Z, 0); Z <= std::min(Max.Z, Grid.GetLengthZ() - 1); Z++)
+					{
+						const int Index = Grid.GetIndex(X, Y, Z);
+						const bool bShouldBePicked = !Grid.IsWalkable(Index) && (!Cells.bCapped || GetShellDistance(Grid, Index, Center) < FurthestShell);
+						if(bShouldBePicked && !bPicked[Index])
+							NumMisplaced++;
+					}
+				}
+			}
+
+			return NumMisplaced;
+		}
+	}
+
+	void RunDebugViewBench(const FBenchOptions& Options, FBenchReport& Report)
+	{
+		const char* Suite = "debug_view";
+		const int NumUpdates = Options.bQuick ? 50 : 500;
+
+		for(FGridScenario& Scenario : MakeStandardScenarios(Options.bQuick, Options.Seed))
+		{
+			const FOccupancyGrid& Grid = Scenario.Grid;
+			std::mt19937 Random(Options.Seed);
+
+			// Every update is for a new listener node, like the map grid does when the listener moves to another node
+			std::vector<FGridCoord> Centers;
+			for(int i = 0; i < NumUpdates; i++)
+				Centers.push_back(Grid.GetCoord(GetRandomWalkableIndex(Grid, Random)));
+
+			FGridDebugCells Cells;
+			struct FView
+			{
+				const char* Name;
+				bool bSlice;
+				bool bIncludeWalkable;
+			};
+
+			for(const FView& View : { FView{ "region", false, false }, FView{ "region_walkable", false, true }, FView{ "slice", true, false } })
+			{
+				const std::string Prefix = std::string(View.Name) + "_";
+				const auto GetArea = [&](const FGridCoord& Center, FGridCoord& OutMin, FGridCoord& OutMax)
+				{
+					if(View.bSlice)
+					{
+						OutMin = FGridCoord(0, 0, Center.Z);
+						OutMax = FGridCoord(Grid.GetLengthX() - 1, Grid.GetLengthY() - 1, Center.Z);
+					}
+					else
+					{
+						OutMin = FGridCoord(Center.X - DebugRadius, Center.Y - DebugRadius, Center.Z - DebugRadius);
+						OutMax = FGridCoord(Center.X + DebugRadius, Center.Y + DebugRadius, Center.Z + DebugRadius);
+					}
+				};
+
+				long long NumCells = 0;
+				int NumCapped = 0;
+				const FStopwatch Stopwatch;
+				for(const FGridCoord& Center : Centers)
+				{
+					FGridCoord Min, Max;
+					GetArea(Center, Min, Max);
+					CollectDebugCells(Grid, Center, Min, Max, MaxDebugCells, View.bIncludeWalkable, Cells);
+					NumCells += Cells.Num();
+					NumCapped += Cells.bCapped ? 1 : 0;
+				}
+				const double Seconds = Stopwatch.GetElapsedSeconds();
+
+				Report.Add(Suite, Scenario.Name, Prefix + "update_us", Seconds * 1e6 / NumUpdates, "us", false);
+				Report.Add(Suite, Scenario.Name, Prefix + "cells_per_update", static_cast<double>(NumCells) / NumUpdates, "cells", false);
+				Report.Add(Suite, Scenario.Name, Prefix + "grid_fraction", static_cast<double>(NumCells) / NumUpdates / Grid.Num(), "x", false);
+				Report.Add(Suite, Scenario.Name, Prefix + "capped_ratio", static_cast<double>(NumCapped) / NumUpdates, "x", false);
+
+				// Picks closest first and stays inside the area, checked for a few of the updates
+				int NumMisplaced = 0;
+				for(int i = 0; i < std::min(NumUpdates, 10); i++)
+				{
+					FGridCoord Min, Max;
+					GetArea(Centers[i], Min, Max);
+					CollectDebugCells(Grid, Centers[i], Min, Max, MaxDebugCells, false, Cells);
+					NumMisplaced += CountMisplacedCells(Grid, Centers[i], Min, Max, Cells);
+				}
+				Report.Add(Suite, Scenario.Name, Prefix + "misplaced_cells", NumMisplaced, "cells", false);
+			}
+
+			// A small cap has to cut off the furthest cells and nothing else
+			FGridCoord Min(0, 0, 0), Max(Grid.GetLengthX() - 1, Grid.GetLengthY() - 1, Grid.GetLengthZ() - 1);
+			CollectDebugCells(Grid, Centers[0], Min, Max, 500, false, Cells);
+			Report.Add(Suite, Scenario.Name, "small_cap_misplaced_cells", CountMisplacedCells(Grid, Centers[0], Min, Max, Cells), "cells", false);
+		}
+	}
+}
@@ -0,0 +1,125 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BenchSuites.h"
+#include "SyntheticGrids.h"
+#include "Core/EmitterDistanceField.h"
+#include "Core/GridLandmarks.h"
+#include "Core/GridPathfinder.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+using namespace AudioCore;
+
+namespace AudioBench
+{
+	namespace
+	{
+		/* Sum of the pathfinder's step costs along the path, in one axis steps. -1 if a step is not between neighbours or
+		 * goes through a blocked cell */
+		int GetPathCost(const FOccupancyGrid& Grid, const int Start, const std::vector<int>& Path)
+		{
+			int Cost = 0;
+			int Previous = Start;
+			for(auto Cell = Path.rbegin(); Cell != Path.rend(); ++Cell)
+			{
+				const FGridCoord From = Grid.GetCoord(Previous);
+				const FGridCoord To = Grid.GetCoord(*Cell);
+				if(std::abs(From.X - To.X) > 1 || std::abs(From.Y - To.Y) > 1 || std::abs(From.Z - To.Z) > 1 || !Grid.IsWalkable(*Cell))
+					return -1;
+
+				Cost += (From.X != To.X) + (From.Y != To.Y) + (From.Z != To.Z);
+				Previous = *Cell;
+			}
+
+			return Cost;
+		}
+	}
+
+	void RunDistanceFieldBench(const FBenchOptions& Options, FBenchReport& Report)
+	{
+		const char* Suite = "distance_field";
+		const int NumEmitters = Options.bQuick ? 8 : 32;
+		const int NumListeners = Options.bQuick ? 50 : 200;
+		const int MaxPathNodes = Options.bQuick ? 24 : 40;
+
+		for(FGridScenario& Scenario : MakeStandardScenarios(Options.bQuick, Options.Seed))
+		{
+			const FOccupancyGrid& Grid = Scenario.Grid;
+			std::mt19937 Random(Options.Seed);
+
+			// What the propagation searches with today, and the landmark search that always finds the cheapest path
+			FGridPathfinder Pathfinder(Grid);
+			FGridLandmarks Landmarks;
+			Landmarks.Build(Grid, 8, 4);
+			FGridPathfinder ShortestPathfinder(Grid);
+			ShortestPathfinder.SetLandmarks(&Landmarks);
+
+			FEmitterDistanceField Field;
+			std::vector<int> Path;
+			double BuildSeconds = 0;
+			double FieldSeconds = 0;
+			double SearchSeconds = 0;
+			size_t MaxBytes = 0;
+			size_t TotalBytes = 0;
+			long long NumReachableCells = 0;
+			int NumLookups = 0;
+			int NumMismatches = 0;
+			int NumInvalidPaths = 0;
+			for(int Emitter = 0; Emitter < NumEmitters; Emitter++)
+			{
+				const int Source = GetRandomWalkableIndex(Grid, Random);
+
+				const FStopwatch BuildStopwatch;
+				Field.Build(Grid, Source, MaxPathNodes);
+				BuildSeconds += BuildStopwatch.GetElapsedSeconds();
+				MaxBytes = std::max(MaxBytes, Field.GetMemoryUsage());
+				TotalBytes += Field.GetMemoryUsage();
+				NumReachableCells += Field.GetNumReachableCells();
+
+				// Listeners anywhere in the field's box, reachable or not
+				const FGridCoord Min = Field.GetMin(), Max = Field.GetMax();
+				std::uniform_int_distribution<int> PickX(Min.X, Max.X), PickY(Min.Y, Max.Y), PickZ(Min.Z, Max.Z);
+				for(int Listener = 0; Listener < NumListeners; Listener++)
+				{
+					const int ListenerIndex = Grid.GetIndex(PickX(Random), PickY(Random), PickZ(Random));
+					if(!Grid.IsWalkable(ListenerIndex))
+						continue;
+
+					NumLookups++;
+					FStopwatch Stopwatch;
+					const bool bFieldFound = Field.GetPath(Grid, ListenerIndex, Path);
+					FieldSeconds += Stopwatch.GetElapsedSeconds();
+					const int FieldCost = bFieldFound ? GetPathCost(Grid, Source, Path) : -1;
+					if(bFieldFound && (FieldCost < 0 || FieldCost != Field.GetDistance(Grid, ListenerIndex)))
+						NumInvalidPaths++;
+
+					Stopwatch.Restart();
+					Pathfinder.FindPath(Source, ListenerIndex, Path);
+					SearchSeconds += Stopwatch.GetElapsedSeconds();
+
+					/* Every shortest path of at most MaxPathNodes nodes has to be found with the same cost. Longer ones can leave
+					 * the field's box, the field then finds a more expensive path inside it or none, which is fine since the
+					 * sound is not heard over that many nodes */
+					const bool bShortestFound = ShortestPathfinder.FindPath(Source, ListenerIndex, Path);
+					const bool bExpected = bShortestFound && static_cast<int>(Path.size()) <= MaxPathNodes;
+					if(bExpected && (!bFieldFound || GetPathCost(Grid, Source, Path) != FieldCost))
+						NumMismatches++;
+				}
+			}
+
+			Report.Add(Suite, Scenario.Name, "build_ms_per_emitter", BuildSeconds * 1e3 / NumEmitters, "ms", false);
+			Report.Add(Suite, Scenario.Name, "kb_per_emitter_mean", TotalBytes / 1024.0 / NumEmitters, "KB", false);
+			Report.Add(Suite, Scenario.Name, "kb_per_emitter_max", MaxBytes / 1024.0, "KB", false);
+			Report.Add(Suite, Scenario.Name, "reachable_cells_per_emitter", static_cast<double>(NumReachableCells) / NumEmitters, "cells", false);
+			if(NumLookups == 0)
+				continue;
+
+			Report.Add(Suite, Scenario.Name, "field_path_us", FieldSeconds * 1e6 / NumLookups, "us", false);
+			Report.Add(Suite, Scenario.Name, "search_us", SearchSeconds * 1e6 / NumLookups, "us", false);
+			Report.Add(Suite, Scenario.Name, "speedup", FieldSeconds > 0 ? SearchSeconds / FieldSeconds : 0, "x", true);
+			Report.Add(Suite, Scenario.Name, "cost_mismatches", NumMismatches, "paths", false);
+			Report.Add(Suite, Scenario.Name, "invalid_paths", NumInvalidPaths, "paths", false);
+		}
+	}
+}
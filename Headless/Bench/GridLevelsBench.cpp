@@ -0,0 +1,139 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BenchSuites.h"
+#include "SyntheticGrids.h"
+#include "Core/GridLevels.h"
+#include "Core/GridPathfinder.h"
+
+#include <random>
+
+using namespace AudioCore;
+
+namespace AudioBench
+{
+	namespace
+	{
+		// Every coarse cell has to be as walkable and map to the same base cell on both
+		bool HaveSameLevels(const FGridLevels& Levels, const FGridLevels& Other)
+		{
+			for(int Level = 1; Level < Levels.Num(); Level++)
+			{
+				const FOccupancyGrid& Grid = Levels.GetLevel(Level);
+				for(int Index = 0; Index < Grid.Num(); Index++)
+				{
+					const FGridCoord Coord = Grid.GetCoord(Index);
+					if(Grid.IsOutOfBounds(Coord.X, Coord.Y, Coord.Z))
+						continue;
+
+					if(Grid.IsWalkable(Index) != Other.GetLevel(Level).IsWalkable(Index) || Levels.GetBaseIndex(Level, Index) != Other.GetBaseIndex(Level, Index))
+						return false;
+				}
+			}
+
+			return true;
+		}
+	}
+
+	void RunGridLevelsBench(const FBenchOptions& Options, FBenchReport& Report)
+	{
+		const char* Suite = "grid_levels";
+		const int NumCoarseLevels = 2;
+		const int NumUpdates = Options.bQuick ? 20 : 100;
+
+		for(FGridScenario& Scenario : MakeStandardScenarios(Options.bQuick, Options.Seed))
+		{
+			const FStopwatch BuildStopwatch;
+			FGridLevels Levels;
+			Levels.Build(Scenario.Grid, NumCoarseLevels);
+			Report.Add(Suite, Scenario.Name, "build_ms", BuildStopwatch.GetElapsedSeconds() * 1e3, "ms", false);
+			Report.Add(Suite, Scenario.Name, "coarse_memory", static_cast<double>(Levels.GetMemoryUsage()), "bytes", false);
+
+			// Path lengths on level 0, the coarse levels are compared against them
+			std::vector<float> BaseLengths;
+
+			for(int Level = 0; Level < Levels.Num(); Level++)
+			{
+				const FOccupancyGrid& Grid = Levels.GetLevel(Level);
+				FGridPathfinder Pathfinder(Grid);
+				std::vector<int> Path;
+
+				double TotalSeconds = 0;
+				long long TotalExpanded = 0;
+				int NumMismatches = 0;
+				double TotalLengthRatio = 0;
+				int NumLengthRatios = 0;
+
+				for(size_t QueryIndex = 0; QueryIndex < Scenario.Queries.size(); QueryIndex++)
+				{
+					const FGridQuery& Query = Scenario.Queries[QueryIndex];
+					const int Start = Levels.GetCoarseIndex(Level, Query.Start);
+					const int End = Levels.GetCoarseIndex(Level, Query.End);
+
+					const FStopwatch Stopwatch;
+					const bool bFound = Pathfinder.FindPath(Start, End, Path);
+					TotalSeconds += Stopwatch.GetElapsedSeconds();
+					TotalExpanded += Pathfinder.GetLastStats().NodesExpanded;
+
+					// Path length in world units, which is what the propagated volume is based on
+					const float Length = bFound ? Path.size() * Grid.GetNodeDiameter() : -1.f;
+					if(Level == 0)
+					{
+						BaseLengths.push_back(Length);
+						continue;
+					}
+
+					// Coarse levels can only connect more, never less
+					if(bFound != (BaseLengths[QueryIndex] >= 0))
+						NumMismatches++;
+					else if(bFound && BaseLengths[QueryIndex] > 0)
+					{
+						TotalLengthRatio += Length / BaseLengths[QueryIndex];
+						NumLengthRatios++;
+					}
+				}
+
+				const double NumQueries = static_cast<double>(Scenario.Queries.size());
+				const std::string Prefix = "level" + std::to_string(Level) + "_";
+				Report.Add(Suite, Scenario.Name, Prefix + "cells", Grid.Num(), "cells", false);
+				Report.Add(Suite, Scenario.Name, Prefix + "us_per_query", TotalSeconds * 1e6 / NumQueries, "us", false);
+				Report.Add(Suite, Scenario.Name, Prefix + "nodes_expanded_mean", TotalExpanded / NumQueries, "nodes", false);
+				if(Level > 0)
+				{
+					Report.Add(Suite, Scenario.Name, Prefix + "reachability_mismatches", NumMismatches, "queries", false);
+					Report.Add(Suite, Scenario.Name, Prefix + "path_length_ratio", NumLengthRatios > 0 ? TotalLengthRatio / NumLengthRatios : 0, "x", false);
+				}
+			}
+
+			// Close and open random cells, like doors. The levels are updated in place and have to match building them again
+			FOccupancyGrid& BaseGrid = Scenario.Grid;
+			std::mt19937 Random(Options.Seed);
+			double UpdateSeconds = 0;
+			double RebuildSeconds = 0;
+			int NumUpdateMismatches = 0;
+			for(int Update = 0; Update < NumUpdates; Update++)
+			{
+				const int Cell = GetRandomWalkableIndex(BaseGrid, Random);
+				for(const bool bWalkable : { false, true })
+				{
+					BaseGrid.SetWalkable(Cell, bWalkable);
+
+					FStopwatch Stopwatch;
+					Levels.UpdateCells({ Cell });
+					UpdateSeconds += Stopwatch.GetElapsedSeconds();
+
+					Stopwatch.Restart();
+					FGridLevels Rebuilt;
+					Rebuilt.Build(BaseGrid, NumCoarseLevels);
+					RebuildSeconds += Stopwatch.GetElapsedSeconds();
+
+					if(!HaveSameLevels(Levels, Rebuilt))
+						NumUpdateMismatches++;
+				}
+			}
+
+			Report.Add(Suite, Scenario.Name, "update_us", UpdateSeconds * 1e6 / (NumUpdates * 2), "us", false);
+			Report.Add(Suite, Scenario.Name, "rebuild_us", RebuildSeconds * 1e6 / (NumUpdates * 2), "us", false);
+			Report.Add(Suite, Scenario.Name, "update_mismatches", NumUpdateMismatches, "updates", false);
+		}
+	}
+}
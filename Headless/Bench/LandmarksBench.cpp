@@ -0,0 +1,111 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BenchSuites.h"
+#include "SyntheticGrids.h"
+#include "Core/GridLandmarks.h"
+#include "Core/GridPathfinder.h"
+
+#include <string>
+
+using namespace AudioCore;
+
+namespace AudioBench
+{
+	namespace
+	{
+		// Sum of the pathfinder's step costs along the path, in one axis steps
+		int GetPathCost(const FOccupancyGrid& Grid, const int Start, const std::vector<int>& Path)
+		{
+			int Cost = 0;
+			int Previous = Start;
+			for(auto Cell = Path.rbegin(); Cell != Path.rend(); ++Cell)
+			{
+				const FGridCoord From = Grid.GetCoord(Previous);
+				const FGridCoord To = Grid.GetCoord(*Cell);
+				Cost += (From.X != To.X) + (From.Y != To.Y) + (From.Z != To.Z);
+				Previous = *Cell;
+			}
+
+			return Cost;
+		}
+	}
+
+	void RunLandmarksBench(const FBenchOptions& Options, FBenchReport& Report)
+	{
+		const char* Suite = "landmarks";
+		const int NumThreads = 4;
+		const int LandmarkCounts[] = { 4, 8 };
+
+		for(FGridScenario& Scenario : MakeStandardScenarios(Options.bQuick, Options.Seed))
+		{
+			const FOccupancyGrid& Grid = Scenario.Grid;
+
+			// The squared distance heuristic the pathfinder uses without landmarks
+			FGridPathfinder Pathfinder(Grid);
+			std::vector<int> Path;
+			double DefaultSeconds = 0;
+			long long DefaultExpanded = 0;
+			std::vector<int> DefaultCosts;
+			for(const FGridQuery& Query : Scenario.Queries)
+			{
+				const FStopwatch Stopwatch;
+				const bool bFound = Pathfinder.FindPath(Query.Start, Query.End, Path);
+				DefaultSeconds += Stopwatch.GetElapsedSeconds();
+				DefaultExpanded += Pathfinder.GetLastStats().NodesExpanded;
+				DefaultCosts.push_back(bFound ? GetPathCost(Grid, Query.Start, Path) : -1);
+			}
+
+			const double NumQueries = static_cast<double>(Scenario.Queries.size());
+			Report.Add(Suite, Scenario.Name, "default_us_per_query", DefaultSeconds * 1e6 / NumQueries, "us", false);
+			Report.Add(Suite, Scenario.Name, "default_nodes_expanded_mean", DefaultExpanded / NumQueries, "nodes", false);
+
+			for(const int NumLandmarks : LandmarkCounts)
+			{
+				const std::string Prefix = "alt" + std::to_string(NumLandmarks) + "_";
+
+				FGridLandmarks Landmarks;
+				FStopwatch BuildStopwatch;
+				Landmarks.Build(Grid, NumLandmarks, 1);
+				Report.Add(Suite, Scenario.Name, Prefix + "build_ms_1_thread", BuildStopwatch.GetElapsedSeconds() * 1e3, "ms", false);
+
+				BuildStopwatch.Restart();
+				Landmarks.Build(Grid, NumLandmarks, NumThreads);
+				Report.Add(Suite, Scenario.Name, Prefix + "build_ms_4_threads", BuildStopwatch.GetElapsedSeconds() * 1e3, "ms", false);
+				Report.Add(Suite, Scenario.Name, Prefix + "bytes_per_node", static_cast<double>(Landmarks.GetMemoryUsage()) / Grid.Num(), "bytes", false);
+
+				Pathfinder.SetLandmarks(&Landmarks);
+				double Seconds = 0;
+				long long Expanded = 0;
+				double TotalCostRatio = 0;
+				int NumCostRatios = 0;
+				int NumMismatches = 0;
+				for(size_t QueryIndex = 0; QueryIndex < Scenario.Queries.size(); QueryIndex++)
+				{
+					const FGridQuery& Query = Scenario.Queries[QueryIndex];
+					const FStopwatch Stopwatch;
+					const bool bFound = Pathfinder.FindPath(Query.Start, Query.End, Path);
+					Seconds += Stopwatch.GetElapsedSeconds();
+					Expanded += Pathfinder.GetLastStats().NodesExpanded;
+
+					if(bFound != (DefaultCosts[QueryIndex] >= 0))
+						NumMismatches++;
+					else if(bFound && DefaultCosts[QueryIndex] > 0)
+					{
+						TotalCostRatio += static_cast<double>(GetPathCost(Grid, Query.Start, Path)) / DefaultCosts[QueryIndex];
+						NumCostRatios++;
+					}
+				}
+
+				Pathfinder.SetLandmarks(nullptr);
+
+				Report.Add(Suite, Scenario.Name, Prefix + "us_per_query", Seconds * 1e6 / NumQueries, "us", false);
+				Report.Add(Suite, Scenario.Name, Prefix + "nodes_expanded_mean", Expanded / NumQueries, "nodes", false);
+				Report.Add(Suite, Scenario.Name, Prefix + "expanded_ratio", DefaultExpanded > 0 ? static_cast<double>(Expanded) / DefaultExpanded : 0, "x", false);
+				Report.Add(Suite, Scenario.Name, Prefix + "reachability_mismatches", NumMismatches, "queries", false);
+
+				// Below 1 where the squared distance heuristic returned longer paths than necessary
+				Report.Add(Suite, Scenario.Name, Prefix + "path_cost_ratio", NumCostRatios > 0 ? TotalCostRatio / NumCostRatios : 0, "x", false);
+			}
+		}
+	}
+}
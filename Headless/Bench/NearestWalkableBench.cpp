@@ -0,0 +1,202 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BenchSuites.h"
+#include "SyntheticGrids.h"
+#include "Core/GridNearestWalkable.h"
+#include "Core/GridRaycast.h"
+
+#include <algorithm>
+#include <climits>
+#include <utility>
+
+using namespace AudioCore;
+
+namespace AudioBench
+{
+	namespace
+	{
+		// Squared distance in cells to the closest walkable cell at most MaxOffset away along every axis, INT_MAX if none
+		int GetNearestDistanceSquared(const FOccupancyGrid& Grid, const int Index)
+		{
+			const FGridCoord Coord = Grid.GetCoord(Index);
+			int Nearest = INT_MAX;
+			for(int x = -FGridNearestWalkable::MaxOffset; x <= FGridNearestWalkable::MaxOffset; x++)
+			{
+				for(int y = -FGridNearestWalkable::MaxOffset; y <= FGridNearestWalkable::MaxOffset; y++)
+				{
+					for(int z = -FGridNearestWalkable::MaxOffset; z <= FGridNearestWalkable::MaxOffset; z++)
+					{
+						if(!Grid.IsOutOfBounds(Coord.X + x, Coord.Y + y, Coord.Z + z) && Grid.IsWalkable(Grid.GetIndex(Coord.X + x, Coord.Y + y, Coord.Z + z)))
+							Nearest = std::min(Nearest, x * x + y * y + z * z);
+					}
+				}
+			}
+
+			return Nearest;
+		}
+
+		// Cells whose stored nearest walkable cell is not one of the closest ones
+		int CountMismatches(const FOccupancyGrid& Grid, const FGridNearestWalkable& NearestWalkable)
+		{
+			int NumMismatches = 0;
+			for(int Index = 0; Index < Grid.Num(); Index++)
+			{
+				const FGridCoord Coord = Grid.GetCoord(Index);
+				if(Grid.IsOutOfBounds(Coord.X, Coord.Y, Coord.Z))
+					continue;
+
+				const int Nearest = NearestWalkable.GetNearestWalkable(Index);
+				int Distance = INT_MAX;
+				if(Nearest != InvalidIndex)
+				{
+					const FGridCoord NearestCoord = Grid.GetCoord(Nearest);
+					const int DeltaX = NearestCoord.X - Coord.X, DeltaY = NearestCoord.Y - Coord.Y, DeltaZ = NearestCoord.Z - Coord.Z;
+					Distance = Grid.IsWalkable(Nearest) ? DeltaX * DeltaX + DeltaY * DeltaY + DeltaZ * DeltaZ : -1;
+				}
+
+				if(Distance != GetNearestDistanceSquared(Grid, Index))
+					NumMismatches++;
+			}
+
+			return NumMismatches;
+		}
+
+		/* Stands in for the physics line trace to the listener. The listener's own cell is blocked, but the geometry that
+		 * blocks it is not where the listener stands, so only blocked cells before the last stretch of the ray count */
+		bool CanSeeListener(const FOccupancyGrid& Grid, const FVec3& From, const FVec3& Listener)
+		{
+			const FGridTraceResult Trace = TraceGrid(Grid, From, Listener);
+			return !Trace.bBlocked || (Trace.NumBlockedRuns == 1 && Trace.BlockedDistance <= Grid.GetNodeRadius() * 1.75f);
+		}
+
+		// The way FPathfinder::GetTargetNode used to work, a line of sight check to every walkable neighbour until one sees
+		// the listener. Returns the number of checks in OutNumTraces
+		int FindTargetByNeighbours(const FOccupancyGrid& Grid, const int Index, const FVec3& Listener, int& OutNumTraces)
+		{
+			const FGridCoord Coord = Grid.GetCoord(Index);
+			for(int x = -1; x <= 1; x++)
+			{
+				for(int y = -1; y <= 1; y++)
+				{
+					for(int z = -1; z <= 1; z++)
+					{
+						if((x == 0 && y == 0 && z == 0) || Grid.IsOutOfBounds(Coord.X + x, Coord.Y + y, Coord.Z + z))
+							continue;
+
+						const int Neighbour = Grid.GetIndex(Coord.X + x, Coord.Y + y, Coord.Z + z);
+						if(!Grid.IsWalkable(Neighbour))
+							continue;
+
+						OutNumTraces++;
+						if(CanSeeListener(Grid, Grid.IndexToWorld(Neighbour), Listener))
+							return Neighbour;
+					}
+				}
+			}
+
+			return Index;
+		}
+	}
+
+	void RunNearestWalkableBench(const FBenchOptions& Options, FBenchReport& Report)
+	{
+		const char* Suite = "nearest_walkable";
+		const int NumLookups = Options.bQuick ? 1000 : 10000;
+		const int NumUpdates = Options.bQuick ? 20 : 100;
+
+		for(FGridScenario& Scenario : MakeStandardScenarios(Options.bQuick, Options.Seed))
+		{
+			FOccupancyGrid& Grid = Scenario.Grid;
+
+			const FStopwatch BuildStopwatch;
+			FGridNearestWalkable NearestWalkable;
+			NearestWalkable.Build(Grid);
+			Report.Add(Suite, Scenario.Name, "build_ms", BuildStopwatch.GetElapsedSeconds() * 1e3, "ms", false);
+			Report.Add(Suite, Scenario.Name, "bytes_per_node", static_cast<double>(NearestWalkable.GetMemoryUsage()) / Grid.Num(), "bytes", false);
+			Report.Add(Suite, Scenario.Name, "nearest_mismatches", CountMismatches(Grid, NearestWalkable), "cells", false);
+
+			// Listeners anywhere inside blocked cells next to walkable space, where the old lookup had something to find
+			std::vector<int> BlockedCells;
+			for(int Index = 0; Index < Grid.Num(); Index++)
+			{
+				const FGridCoord Coord = Grid.GetCoord(Index);
+				if(!Grid.IsOutOfBounds(Coord.X, Coord.Y, Coord.Z) && !Grid.IsWalkable(Index) && GetNearestDistanceSquared(Grid, Index) <= 3)
+					BlockedCells.push_back(Index);
+			}
+
+			if(BlockedCells.empty())
+				continue;
+
+			std::mt19937 Random(Options.Seed);
+			std::uniform_int_distribution<size_t> Pick(0, BlockedCells.size() - 1);
+			std::uniform_real_distribution<float> InsideCell(-Grid.GetNodeRadius(), Grid.GetNodeRadius());
+			std::vector<std::pair<int, FVec3>> Lookups;
+			for(int i = 0; i < NumLookups; i++)
+			{
+				const int Cell = BlockedCells[Pick(Random)];
+				const FVec3 Center = Grid.IndexToWorld(Cell);
+				Lookups.emplace_back(Cell, FVec3(Center.X + InsideCell(Random), Center.Y + InsideCell(Random), Center.Z + InsideCell(Random)));
+			}
+
+			double NeighbourSeconds = 0;
+			double TableSeconds = 0;
+			int NeighbourTraces = 0;
+			int TableTraces = 0;
+			int NeighbourFound = 0;
+			int TableFound = 0;
+			for(const auto& [Cell, Listener] : Lookups)
+			{
+				FStopwatch Stopwatch;
+				NeighbourFound += FindTargetByNeighbours(Grid, Cell, Listener, NeighbourTraces) != Cell ? 1 : 0;
+				NeighbourSeconds += Stopwatch.GetElapsedSeconds();
+
+				// Same as FPathfinder::GetTargetNode, one confirming check of the nearest walkable cell
+				Stopwatch.Restart();
+				const int Nearest = NearestWalkable.GetNearestWalkable(Cell);
+				if(Nearest != InvalidIndex)
+				{
+					TableTraces++;
+					TableFound += CanSeeListener(Grid, Grid.IndexToWorld(Nearest), Listener) ? 1 : 0;
+				}
+				TableSeconds += Stopwatch.GetElapsedSeconds();
+			}
+
+			Report.Add(Suite, Scenario.Name, "neighbour_scan_ns", NeighbourSeconds * 1e9 / NumLookups, "ns", false);
+			Report.Add(Suite, Scenario.Name, "table_ns", TableSeconds * 1e9 / NumLookups, "ns", false);
+			Report.Add(Suite, Scenario.Name, "neighbour_scan_traces_per_lookup", static_cast<double>(NeighbourTraces) / NumLookups, "traces", false);
+			Report.Add(Suite, Scenario.Name, "table_traces_per_lookup", static_cast<double>(TableTraces) / NumLookups, "traces", false);
+			Report.Add(Suite, Scenario.Name, "neighbour_scan_found_ratio", static_cast<double>(NeighbourFound) / NumLookups, "x", true);
+			Report.Add(Suite, Scenario.Name, "table_found_ratio", static_cast<double>(TableFound) / NumLookups, "x", true);
+
+			// Close and open random cells and compare against building everything again
+			double UpdateSeconds = 0;
+			int NumUpdateMismatches = 0;
+			for(int Update = 0; Update < NumUpdates; Update++)
+			{
+				const int Cell = GetRandomWalkableIndex(Grid, Random);
+				for(const bool bWalkable : { false, true })
+				{
+					Grid.SetWalkable(Cell, bWalkable);
+
+					const FStopwatch Stopwatch;
+					NearestWalkable.UpdateCells({ Cell });
+					UpdateSeconds += Stopwatch.GetElapsedSeconds();
+
+					FGridNearestWalkable Rebuilt;
+					Rebuilt.Build(Grid);
+					for(int Index = 0; Index < Grid.Num(); Index++)
+					{
+						if(NearestWalkable.GetNearestWalkable(Index) != Rebuilt.GetNearestWalkable(Index))
+						{
+							NumUpdateMismatches++;
+							break;
+						}
+					}
+				}
+			}
+
+			Report.Add(Suite, Scenario.Name, "update_us", UpdateSeconds * 1e6 / (NumUpdates * 2), "us", false);
+			Report.Add(Suite, Scenario.Name, "update_mismatches", NumUpdateMismatches, "updates", false);
+		}
+	}
+}
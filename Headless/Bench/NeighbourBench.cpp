@@ -0,0 +1,127 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BenchSuites.h"
+#include "SyntheticGrids.h"
+#include "Core/GridNeighbours.h"
+#include "Core/GridPathfinder.h"
+
+#include <cstdio>
+
+using namespace AudioCore;
+
+namespace AudioBench
+{
+	namespace
+	{
+		// The way AMapGrid::GetNeighbours used to work, a new array with a bounds check per neighbour for every cell
+		std::vector<int> GetNeighboursLegacy(const FOccupancyGrid& Grid, const int Index)
+		{
+			std::vector<int> Neighbours;
+			const FGridCoord Coord = Grid.GetCoord(Index);
+			for(int x = -1; x <= 1; x++)
+			{
+				for(int y = -1; y <= 1; y++)
+				{
+					for(int z = -1; z <= 1; z++)
+					{
+						if(x == 0 && y == 0 && z == 0)
+							continue;
+
+						if(Grid.IsOutOfBounds(Coord.X + x, Coord.Y + y, Coord.Z + z))
+							continue;
+
+						Neighbours.push_back(Grid.GetIndex(Coord.X + x, Coord.Y + y, Coord.Z + z));
+					}
+				}
+			}
+			return Neighbours;
+		}
+
+		struct FNeighbourPass
+		{
+			double NanosecondsPerCell = 0;
+			double AllocationsPerCell = 0;
+			long long NumWalkableNeighbours = 0;
+		};
+
+		// Visits every neighbour of every cell and counts the walkable ones, so all variants do the same work
+		template<typename FunctionType>
+		FNeighbourPass MeasurePass(const FOccupancyGrid& Grid, const int NumRepeats, FunctionType CountWalkableNeighbours)
+		{
+			FNeighbourPass Pass;
+			const uint64_t AllocationsBefore = GetAllocationCount();
+			const FStopwatch Stopwatch;
+			for(int Repeat = 0; Repeat < NumRepeats; Repeat++)
+			{
+				for(int Index = 0; Index < Grid.Num(); Index++)
+					Pass.NumWalkableNeighbours += CountWalkableNeighbours(Index);
+			}
+
+			DoNotOptimize(Pass.NumWalkableNeighbours);
+
+			const double NumCells = static_cast<double>(Grid.Num()) * NumRepeats;
+			Pass.NanosecondsPerCell = Stopwatch.GetElapsedSeconds() * 1e9 / NumCells;
+			Pass.AllocationsPerCell = static_cast<double>(GetAllocationCount() - AllocationsBefore) / NumCells;
+			return Pass;
+		}
+
+		// Returns the number of walkable neighbours found so the caller can check them
+		template<int Connectivity>
+		long long AddConnectivityResults(FBenchReport& Report, const char* Suite, FGridScenario& Scenario, const int NumRepeats)
+		{
+			const TGridNeighbours<Connectivity> Neighbours(Scenario.Grid);
+			const FNeighbourPass Pass = MeasurePass(Scenario.Grid, NumRepeats, [&](const int Index)
+			{
+				int Count = 0;
+				for(const int Neighbour : Neighbours.GetNeighbours(Index))
+					Count += Scenario.Grid.IsWalkable(Neighbour) ? 1 : 0;
+				return Count;
+			});
+
+			const std::string Prefix = "table" + std::to_string(Connectivity) + "_";
+			Report.Add(Suite, Scenario.Name, Prefix + "ns_per_cell", Pass.NanosecondsPerCell, "ns", false);
+			Report.Add(Suite, Scenario.Name, Prefix + "allocations_per_cell", Pass.AllocationsPerCell, "allocs", false);
+
+			// A* with fewer neighbours expands more nodes but does less work per node
+			TGridPathfinder<Connectivity> Pathfinder(Scenario.Grid);
+			std::vector<int> Path;
+			long long TotalExpanded = 0;
+			const FStopwatch Stopwatch;
+			for(const FGridQuery& Query : Scenario.Queries)
+			{
+				Pathfinder.FindPath(Query.Start, Query.End, Path);
+				TotalExpanded += Pathfinder.GetLastStats().NodesExpanded;
+			}
+			const double NumQueries = static_cast<double>(Scenario.Queries.size());
+			Report.Add(Suite, Scenario.Name, "astar" + std::to_string(Connectivity) + "_us_per_query", Stopwatch.GetElapsedMicroseconds() / NumQueries, "us", false);
+			Report.Add(Suite, Scenario.Name, "astar" + std::to_string(Connectivity) + "_nodes_expanded_mean", TotalExpanded / NumQueries, "nodes", false);
+
+			return Pass.NumWalkableNeighbours;
+		}
+	}
+
+	void RunNeighbourBench(const FBenchOptions& Options, FBenchReport& Report)
+	{
+		const char* Suite = "neighbours";
+		const int NumRepeats = Options.bQuick ? 2 : 10;
+
+		for(FGridScenario& Scenario : MakeStandardScenarios(Options.bQuick, Options.Seed))
+		{
+			const FNeighbourPass Legacy = MeasurePass(Scenario.Grid, NumRepeats, [&](const int Index)
+			{
+				int Count = 0;
+				for(const int Neighbour : GetNeighboursLegacy(Scenario.Grid, Index))
+					Count += Scenario.Grid.IsWalkable(Neighbour) ? 1 : 0;
+				return Count;
+			});
+			Report.Add(Suite, Scenario.Name, "legacy_ns_per_cell", Legacy.NanosecondsPerCell, "ns", false);
+			Report.Add(Suite, Scenario.Name, "legacy_allocations_per_cell", Legacy.AllocationsPerCell, "allocs", false);
+
+			if(AddConnectivityResults<26>(Report, Suite, Scenario, NumRepeats) != Legacy.NumWalkableNeighbours)
+				std::printf("WARNING: %s neighbour table does not match the legacy neighbours\n", Scenario.Name.c_str());
+
+			AddConnectivityResults<18>(Report, Suite, Scenario, NumRepeats);
+			AddConnectivityResults<6>(Report, Suite, Scenario, NumRepeats);
+		}
+	}
+}
@@ -0,0 +1,105 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BenchSuites.h"
+#include "Core/OcclusionBatch.h"
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+using namespace AudioCore;
+
+namespace AudioBench
+{
+	namespace
+	{
+		// Median frame time in microseconds of running the compute function
+		template<typename FunctionType>
+		double MeasureMedian(const int NumRepeats, FunctionType Function)
+		{
+			std::vector<double> Times;
+			for(int Repeat = 0; Repeat < NumRepeats; Repeat++)
+			{
+				const FStopwatch Stopwatch;
+				Function();
+				Times.push_back(Stopwatch.GetElapsedMicroseconds());
+			}
+			return GetPercentile(Times, 50);
+		}
+	}
+
+	void RunOcclusionBatchBench(const FBenchOptions& Options, FBenchReport& Report)
+	{
+		const char* Suite = "occlusion_batch";
+		const int NumRepeats = Options.bQuick ? 50 : 300;
+		const FOcclusionSettings Settings;
+
+		for(const int NumSources : { 1000, 10000 })
+		{
+			std::mt19937 Random(Options.Seed);
+			std::uniform_real_distribution<float> Distance(0.f, 1200.f);
+			std::uniform_real_distribution<float> Material(0.5f, 2.f);
+			std::uniform_real_distribution<float> Volume(0.01f, 1.f);
+			std::uniform_int_distribution<int> NumHits(1, 4);
+			std::uniform_int_distribution<int> PathSize(2, 60);
+
+			FOcclusionBatch Batch;
+			FPropagatedVolumeBatch PropagatedBatch;
+			for(int Source = 0; Source < NumSources; Source++)
+			{
+				// Low pass is only updated at an interval, roughly every other source here
+				Batch.AddSource(Source % 2 == 0 ? Distance(Random) : -1.f);
+				const int Hits = NumHits(Random);
+				for(int i = 0; i < Hits; i++)
+					Batch.AddHit(Distance(Random), Material(Random));
+
+				if(Source % 5 == 0)
+					PropagatedBatch.AddRemoved(Volume(Random));
+				else
+					PropagatedBatch.AddPropagated(Volume(Random), PathSize(Random), 100.f, 3000.f);
+			}
+
+			// Both paths have to agree before their timings mean anything
+			Batch.ComputeScalar(Settings);
+			PropagatedBatch.ComputeScalar(1 / 60.f, 0.5f);
+			std::vector<float> Expected;
+			for(int i = 0; i < NumSources; i++)
+			{
+				Expected.push_back(Batch.GetVolume(i));
+				Expected.push_back(Batch.GetLowPassFrequency(i) / Settings.MaxLowPassFrequency);
+				Expected.push_back(PropagatedBatch.GetVolume(i));
+			}
+
+			Batch.Compute(Settings);
+			PropagatedBatch.Compute(1 / 60.f, 0.5f);
+			float MaxError = 0;
+			for(int i = 0; i < NumSources; i++)
+			{
+				MaxError = std::max(MaxError, std::abs(Expected[i * 3] - Batch.GetVolume(i)));
+				MaxError = std::max(MaxError, std::abs(Expected[i * 3 + 1] - Batch.GetLowPassFrequency(i) / Settings.MaxLowPassFrequency));
+				MaxError = std::max(MaxError, std::abs(Expected[i * 3 + 2] - PropagatedBatch.GetVolume(i)));
+			}
+			if(MaxError > 1e-5f)
+				std::printf("WARNING: batch kernel differs from the scalar path by %f\n", MaxError);
+
+			const double ScalarMicroseconds = MeasureMedian(NumRepeats, [&]()
+			{
+				Batch.ComputeScalar(Settings);
+				PropagatedBatch.ComputeScalar(1 / 60.f, 0.5f);
+				DoNotOptimize(Batch);
+			});
+
+			const double BatchMicroseconds = MeasureMedian(NumRepeats, [&]()
+			{
+				Batch.Compute(Settings);
+				PropagatedBatch.Compute(1 / 60.f, 0.5f);
+				DoNotOptimize(Batch);
+			});
+
+			const std::string Scenario = "sources_" + std::to_string(NumSources);
+			Report.Add(Suite, Scenario, "scalar_ns_per_source", ScalarMicroseconds * 1000 / NumSources, "ns", false);
+			Report.Add(Suite, Scenario, "simd_ns_per_source", BatchMicroseconds * 1000 / NumSources, "ns", false);
+			Report.Add(Suite, Scenario, "simd_speedup", ScalarMicroseconds / BatchMicroseconds, "x", true);
+		}
+	}
+}
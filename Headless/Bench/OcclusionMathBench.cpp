@@ -0,0 +1,86 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BenchSuites.h"
+#include "Core/OcclusionMath.h"
+
+#include <random>
+#include <vector>
+
+using namespace AudioCore;
+
+namespace AudioBench
+{
+	namespace
+	{
+		// Default values of UAudioOcclusionComponent
+		constexpr float MaxMeshDistanceToBlockAllAudio = 900.f;
+		constexpr float DistanceToWallToStopAddingLowPass = 700.f;
+		constexpr float DistanceToWallOffset = 60.f;
+		constexpr float MaxLowPassFrequency = 17000.f;
+
+		// What the traces would have given for one source
+		struct FSourceHits
+		{
+			std::vector<float> RayTravelDistances;
+			std::vector<float> MaterialValues;
+			float DistanceToMesh = 0;
+		};
+	}
+
+	void RunOcclusionMathBench(const FBenchOptions& Options, FBenchReport& Report)
+	{
+		const char* Suite = "occlusion_math";
+		std::mt19937 Random(Options.Seed);
+		std::uniform_real_distribution<float> Distance(0.f, 1200.f);
+		std::uniform_real_distribution<float> Material(0.5f, 2.f);
+		std::uniform_int_distribution<int> NumHits(1, 4);
+
+		const int NumSources = Options.bQuick ? 1000 : 10000;
+		const int NumRepeats = Options.bQuick ? 20 : 100;
+
+		std::vector<FSourceHits> Sources(NumSources);
+		for(FSourceHits& Source : Sources)
+		{
+			const int Hits = NumHits(Random);
+			for(int i = 0; i < Hits; i++)
+			{
+				Source.RayTravelDistances.push_back(Distance(Random));
+				Source.MaterialValues.push_back(Material(Random));
+			}
+			Source.DistanceToMesh = Distance(Random);
+		}
+
+		std::vector<float> Volumes(NumSources);
+		std::vector<float> Frequencies(NumSources);
+		std::vector<double> Latencies;
+
+		for(int Repeat = 0; Repeat < NumRepeats; Repeat++)
+		{
+			const FStopwatch Stopwatch;
+			for(int SourceIndex = 0; SourceIndex < NumSources; SourceIndex++)
+			{
+				const FSourceHits& Source = Sources[SourceIndex];
+
+				// Same steps as UAudioOcclusionComponent::UpdateAudioComp and SetLowPassFilter
+				float TotalOccValue = 0;
+				for(size_t i = 0; i < Source.RayTravelDistances.size(); i++)
+				{
+					const float Thickness = GetThicknessValue(Source.RayTravelDistances[i], MaxMeshDistanceToBlockAllAudio);
+					TotalOccValue += GetOcclusionValue(Thickness, Source.MaterialValues[i]);
+				}
+
+				Volumes[SourceIndex] = GetOccludedVolume(TotalOccValue);
+				const float LowPassValue = GetLowPassValue(Source.DistanceToMesh, DistanceToWallOffset, DistanceToWallToStopAddingLowPass);
+				Frequencies[SourceIndex] = GetLowPassFrequency(LowPassValue, MaxLowPassFrequency);
+			}
+			Latencies.push_back(Stopwatch.GetElapsedMicroseconds());
+			DoNotOptimize(Volumes);
+			DoNotOptimize(Frequencies);
+		}
+
+		const std::string Scenario = "sources_" + std::to_string(NumSources);
+		const double MedianMicroseconds = GetPercentile(Latencies, 50);
+		Report.Add(Suite, Scenario, "ns_per_source", MedianMicroseconds * 1000 / NumSources, "ns", false);
+		AddLatencyPercentiles(Report, Suite, Scenario, "frame_latency", Latencies);
+	}
+}
@@ -0,0 +1,117 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BenchSuites.h"
+#include "SyntheticGrids.h"
+#include "Core/OcclusionSnapshot.h"
+#include "Core/ParallelFor.h"
+
+#include <string>
+
+using namespace AudioCore;
+
+namespace AudioBench
+{
+	namespace
+	{
+		// Fall off distance of every source, far enough that most of a standard grid is in range
+		constexpr float FalloffDistance = 50 * SyntheticNodeDiameter;
+
+		// The volume and low pass of every source in the batch, in snapshot order
+		struct FFrameResult
+		{
+			std::vector<int> Sources;
+			std::vector<float> Volumes;
+			std::vector<float> LowPassFrequencies;
+
+			bool operator==(const FFrameResult& Other) const
+			{
+				return Sources == Other.Sources && Volumes == Other.Volumes && LowPassFrequencies == Other.LowPassFrequencies;
+			}
+		};
+	}
+
+	void RunOcclusionParallelBench(const FBenchOptions& Options, FBenchReport& Report)
+	{
+		const char* Suite = "occlusion_parallel";
+		const int NumSources = Options.bQuick ? 512 : 4096;
+		const int NumFrames = Options.bQuick ? 10 : 50;
+		const int ThreadCounts[] = { 1, 4, 16 };
+
+		for(FGridScenario& Scenario : MakeStandardScenarios(Options.bQuick, Options.Seed))
+		{
+			const FOccupancyGrid& Grid = Scenario.Grid;
+			std::mt19937 Random(Options.Seed);
+
+			// Sources stay where they are, the listener moves every frame
+			std::vector<FOcclusionSnapshot> Snapshots(static_cast<size_t>(NumFrames));
+			std::vector<FVec3> SourceLocations;
+			for(int Source = 0; Source < NumSources; Source++)
+				SourceLocations.push_back(Grid.IndexToWorld(GetRandomWalkableIndex(Grid, Random)));
+
+			for(int Frame = 0; Frame < NumFrames; Frame++)
+			{
+				FOcclusionSnapshot& Snapshot = Snapshots[Frame];
+				Snapshot.ListenerLocation = Grid.IndexToWorld(GetRandomWalkableIndex(Grid, Random));
+				Snapshot.CameraLocation = Snapshot.ListenerLocation;
+				Snapshot.bUpdateLowPass = Frame % 2 == 0;
+				for(const FVec3& Location : SourceLocations)
+					Snapshot.AddSource(Location, FalloffDistance);
+			}
+
+			std::vector<FFrameResult> SingleThreadResults(static_cast<size_t>(NumFrames));
+			double SingleThreadSeconds = 0;
+			for(const int NumThreads : ThreadCounts)
+			{
+				// Kept between frames like the component keeps them, and the threads like the engine keeps its task threads
+				// so only the work is measured and not starting threads
+				FTaskThreads Threads(NumThreads);
+				std::vector<FSourceOcclusion> Results;
+				FOcclusionBatch Batch;
+				FFrameResult FrameResult;
+
+				int NumMismatches = 0;
+				long long NumInRange = 0;
+				const FStopwatch Stopwatch;
+				for(int Frame = 0; Frame < NumFrames; Frame++)
+				{
+					// Per source work in parallel, then the batch and its results in snapshot order
+					TraceOcclusionOnGrid(Grid, Snapshots[Frame], Threads, Results);
+					Batch.Reset();
+					FillOcclusionBatch(Results, Batch, FrameResult.Sources);
+					Batch.Compute(FOcclusionSettings());
+
+					FrameResult.Volumes.resize(Batch.Num());
+					FrameResult.LowPassFrequencies.resize(Batch.Num());
+					for(int i = 0; i < Batch.Num(); i++)
+					{
+						FrameResult.Volumes[i] = Batch.GetVolume(i);
+						FrameResult.LowPassFrequencies[i] = Batch.ShouldUpdateLowPass(i) ? Batch.GetLowPassFrequency(i) : -1.f;
+					}
+
+					for(const FSourceOcclusion& Result : Results)
+						NumInRange += Result.bInRange ? 1 : 0;
+
+					// Every thread count has to give exactly the single threaded result
+					if(NumThreads == 1)
+						SingleThreadResults[Frame] = FrameResult;
+					else if(!(FrameResult == SingleThreadResults[Frame]))
+						NumMismatches++;
+				}
+				const double Seconds = Stopwatch.GetElapsedSeconds();
+
+				const std::string Prefix = "threads" + std::to_string(NumThreads) + "_";
+				Report.Add(Suite, Scenario.Name, Prefix + "ms_per_frame", Seconds * 1e3 / NumFrames, "ms", false);
+				if(NumThreads == 1)
+				{
+					SingleThreadSeconds = Seconds;
+					Report.Add(Suite, Scenario.Name, "sources_in_range_per_frame", static_cast<double>(NumInRange) / NumFrames, "sources", false);
+				}
+				else
+				{
+					Report.Add(Suite, Scenario.Name, Prefix + "speedup", Seconds > 0 ? SingleThreadSeconds / Seconds : 0, "x", true);
+					Report.Add(Suite, Scenario.Name, Prefix + "frame_mismatches", NumMismatches, "frames", false);
+				}
+			}
+		}
+	}
+}
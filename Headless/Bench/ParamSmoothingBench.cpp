@@ -0,0 +1,173 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BenchSuites.h"
+#include "Core/AudioParamUpdates.h"
+#include "Core/OcclusionMath.h"
+#include "Core/ParamSmoothing.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+
+using namespace AudioCore;
+
+namespace AudioBench
+{
+	namespace
+	{
+		constexpr float SampleRate = 48000.f;
+		constexpr int NumChannels = 2;
+		constexpr int BufferFrames = 256;
+
+		// Same as USoundPropagationComponent::PropVolumeLerpSpeed and the smoothing effect's default
+		constexpr float GainPerSecond = 0.5f;
+
+		// A propagated sound whose path length changes now and then, and that is occluded part of the time
+		struct FSimulatedSource
+		{
+			float TargetGain = 1.f;
+			float TargetCutoff = BypassedCutoffFrequency;
+
+			// Game thread interpolation, the volume that is set on the audio comp and the one the audio thread last got
+			float InterpolatedGain = 1.f;
+			float AppliedGain = 1.f;
+
+			// Audio thread smoothing, the targets the game thread sent it and what it should be at computed in doubles
+			FSmoothingTargets SentTargets;
+			FSmoothedGainFilter Filter;
+			uint32_t TargetsVersion = 0;
+			double ReferenceGain = 1.0;
+			double ReferenceTargetGain = 1.0;
+		};
+	}
+
+	void RunParamSmoothingBench(const FBenchOptions& Options, FBenchReport& Report)
+	{
+		const char* Suite = "param_smoothing";
+		const int NumSources = Options.bQuick ? 64 : 256;
+		const float Seconds = Options.bQuick ? 2.f : 10.f;
+
+		for(const int FramesPerSecond : { 30, 60, 144 })
+		{
+			std::mt19937 Random(Options.Seed);
+			std::uniform_real_distribution<float> GainDistribution(0.05f, 1.f);
+			std::uniform_real_distribution<float> CutoffDistribution(300.f, 8000.f);
+			std::uniform_real_distribution<float> Chance(0.f, 1.f);
+			std::normal_distribution<float> Noise(0.f, 0.25f);
+
+			std::vector<FSimulatedSource> Sources(static_cast<size_t>(NumSources));
+			for(FSimulatedSource& Source : Sources)
+				Source.Filter.Init(SampleRate, NumChannels, FSmoothingTargets());
+
+			std::vector<float> Input(static_cast<size_t>(BufferFrames) * NumChannels);
+			for(float& Sample : Input)
+				Sample = Noise(Random);
+			std::vector<float> Output(Input.size());
+
+			FAudioParamUpdates InterpolatedUpdates;
+			FAudioParamUpdates TargetUpdates;
+			FSmoothingTargetTable TargetTable;
+			long long InterpolatedSent = 0;
+			long long TargetSent = 0;
+			float MaxFrameGainStep = 0;
+			float MaxSampleGainStep = 0;
+			double MaxGainError = 0;
+			int NumRampMismatches = 0;
+			double ProcessSeconds = 0;
+			long long NumProcessedSamples = 0;
+
+			const float DeltaTime = 1.f / FramesPerSecond;
+			const int NumFrames = static_cast<int>(Seconds * FramesPerSecond);
+			const double SamplesPerFrame = SampleRate / FramesPerSecond;
+			double RenderedSamples = 0;
+			for(int Frame = 0; Frame < NumFrames; Frame++)
+			{
+				// Game thread: new paths and walls about twice a second per source
+				for(int i = 0; i < NumSources; i++)
+				{
+					FSimulatedSource& Source = Sources[i];
+					if(Chance(Random) < 2.f * DeltaTime)
+						Source.TargetGain = GainDistribution(Random);
+					if(Chance(Random) < 2.f * DeltaTime)
+						Source.TargetCutoff = Chance(Random) < 0.3f ? BypassedCutoffFrequency : CutoffDistribution(Random);
+
+					// What the component did before, a step every frame that is set on the audio comp
+					Source.InterpolatedGain = InterpConstantTo(Source.InterpolatedGain, Source.TargetGain, DeltaTime, GainPerSecond);
+					InterpolatedUpdates.Set(&Source, EAudioParam::Volume, Source.InterpolatedGain);
+
+					// With the smoothing effect only the targets are set and only changes that can be heard are sent
+					TargetUpdates.Set(&Source, EAudioParam::Volume, Source.TargetGain);
+					TargetUpdates.Set(&Source, EAudioParam::LowPassFrequency, Source.TargetCutoff);
+				}
+
+				InterpolatedUpdates.Flush([&](const void* Target, const EAudioParam, const float Value)
+				{
+					FSimulatedSource& Source = *const_cast<FSimulatedSource*>(static_cast<const FSimulatedSource*>(Target));
+					MaxFrameGainStep = std::max(MaxFrameGainStep, std::abs(Value - Source.AppliedGain));
+					Source.AppliedGain = Value;
+				});
+				InterpolatedSent += InterpolatedUpdates.GetLastStats().Sent;
+
+				TargetUpdates.Flush([&](const void* Target, const EAudioParam Param, const float Value)
+				{
+					// Like UAudioParameterSubsystem, keyed by index in place of the audio component id
+					FSimulatedSource& Source = *const_cast<FSimulatedSource*>(static_cast<const FSimulatedSource*>(Target));
+					if(Param == EAudioParam::Volume)
+						Source.SentTargets.Gain = Value;
+					else
+						Source.SentTargets.CutoffFrequency = Value;
+					TargetTable.Set(static_cast<uint64_t>(&Source - Sources.data()), Source.SentTargets);
+				});
+				TargetSent += TargetUpdates.GetLastStats().Sent;
+
+				// Audio thread: every buffer that is due by the end of the frame, targets are read at the start of each
+				const int NumBuffers = static_cast<int>((RenderedSamples + SamplesPerFrame) / BufferFrames) - static_cast<int>(RenderedSamples / BufferFrames);
+				RenderedSamples += SamplesPerFrame;
+				for(int Buffer = 0; Buffer < NumBuffers; Buffer++)
+				{
+					const FStopwatch Stopwatch;
+					for(int i = 0; i < NumSources; i++)
+					{
+						FSimulatedSource& Source = Sources[i];
+						FSmoothingTargets Targets;
+						if(TargetTable.TryGet(static_cast<uint64_t>(i), Targets, Source.TargetsVersion))
+						{
+							Source.Filter.SetTargets(Targets);
+							Source.ReferenceTargetGain = Targets.Gain;
+						}
+
+						const float GainBefore = Source.Filter.GetGain();
+						Source.Filter.Process(Input.data(), Output.data(), BufferFrames);
+
+						// A buffer only moves the gain by the speed, so no sample can have moved it by more than one step
+						MaxSampleGainStep = std::max(MaxSampleGainStep, std::abs(Source.Filter.GetGain() - GainBefore) / BufferFrames);
+					}
+					ProcessSeconds += Stopwatch.GetElapsedSeconds();
+					NumProcessedSamples += static_cast<long long>(NumSources) * BufferFrames * NumChannels;
+
+					// The ramp has to move at exactly the speed, whatever the frame rate
+					for(FSimulatedSource& Source : Sources)
+					{
+						const double Step = static_cast<double>(GainPerSecond) * BufferFrames / SampleRate;
+						const double Distance = Source.ReferenceTargetGain - Source.ReferenceGain;
+						Source.ReferenceGain += std::clamp(Distance, -Step, Step);
+
+						const double Error = std::abs(Source.Filter.GetGain() - Source.ReferenceGain);
+						MaxGainError = std::max(MaxGainError, Error);
+						NumRampMismatches += Error > 1e-3 ? 1 : 0;
+					}
+				}
+			}
+
+			const std::string Scenario = std::to_string(FramesPerSecond) + "_fps";
+			Report.Add(Suite, Scenario, "interpolated_commands_per_second", InterpolatedSent / Seconds / NumSources, "commands", false);
+			Report.Add(Suite, Scenario, "target_commands_per_second", TargetSent / Seconds / NumSources, "commands", false);
+			Report.Add(Suite, Scenario, "interpolated_max_gain_step", MaxFrameGainStep, "gain", false);
+			Report.Add(Suite, Scenario, "smoothed_max_gain_step", MaxSampleGainStep, "gain", false);
+			Report.Add(Suite, Scenario, "smoothing_ns_per_sample", ProcessSeconds * 1e9 / std::max<long long>(NumProcessedSamples, 1), "ns", false);
+			Report.Add(Suite, Scenario, "max_gain_error", MaxGainError, "gain", false);
+			Report.Add(Suite, Scenario, "ramp_mismatches", NumRampMismatches, "buffers", false);
+		}
+	}
+}
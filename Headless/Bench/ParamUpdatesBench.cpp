@@ -0,0 +1,136 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BenchSuites.h"
+#include "Core/AudioParamUpdates.h"
+#include "Core/OcclusionBatch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+using namespace AudioCore;
+
+namespace AudioBench
+{
+	namespace
+	{
+		// What the audio components do each frame, in about the same mix as a level with a few rooms
+		enum class ESourceKind
+		{
+			Unoccluded, // Volume 1 and low pass disabled every frame, see UAudioOcclusionComponent::ResetAudioComponentOnNoBlock
+			Occluded, // Volume from the occlusion every frame, low pass at the low pass interval
+			Propagated, // Volume interpolated towards the path length target, see USoundPropagationComponent
+		};
+
+		struct FSimulatedSource
+		{
+			ESourceKind Kind = ESourceKind::Unoccluded;
+			float Phase = 0;
+			int PathSize = 10;
+
+			// What the audio thread has, filled by the flush
+			float SentValues[NumAudioParams] = {};
+		};
+	}
+
+	void RunParamUpdatesBench(const FBenchOptions& Options, FBenchReport& Report)
+	{
+		const char* Suite = "param_updates";
+		const int NumFrames = Options.bQuick ? 300 : 1800;
+		const float DeltaTime = 1 / 60.f;
+
+		// Same as the components' defaults
+		const int LowPassInterval = 6;
+		const float PropVolumeLerpSpeed = 0.5f;
+
+		for(const int NumSources : { 1000, 10000 })
+		{
+			std::mt19937 Random(Options.Seed);
+			std::uniform_real_distribution<float> Phase(0.f, 6.28f);
+			std::uniform_int_distribution<int> Kind(0, 9);
+			std::uniform_int_distribution<int> PathSize(2, 60);
+
+			std::vector<FSimulatedSource> Sources(NumSources);
+			for(FSimulatedSource& Source : Sources)
+			{
+				const int Roll = Kind(Random);
+				Source.Kind = Roll < 3 ? ESourceKind::Unoccluded : Roll < 8 ? ESourceKind::Occluded : ESourceKind::Propagated;
+				Source.Phase = Phase(Random);
+				Source.PathSize = PathSize(Random);
+			}
+
+			FAudioParamUpdates Updates;
+			FPropagatedVolumeBatch VolumeBatch;
+			std::vector<int> BatchedSources;
+
+			long long TotalRequested = 0;
+			long long TotalSent = 0;
+			float MaxVolumeErrorDecibels = 0;
+			double SetSeconds = 0;
+
+			for(int Frame = 0; Frame < NumFrames; Frame++)
+			{
+				// The listener walks around so the occlusion changes slowly, paths change now and then
+				const float Time = Frame * DeltaTime;
+				VolumeBatch.Reset();
+				BatchedSources.clear();
+
+				const FStopwatch Stopwatch;
+				for(int i = 0; i < NumSources; i++)
+				{
+					FSimulatedSource& Source = Sources[i];
+					switch(Source.Kind)
+					{
+					case ESourceKind::Unoccluded:
+						Updates.Set(&Source, EAudioParam::Volume, 1.f);
+						Updates.Set(&Source, EAudioParam::LowPassEnabled, 0.f);
+						break;
+					case ESourceKind::Occluded:
+						Updates.Set(&Source, EAudioParam::Volume, 0.4f + 0.3f * std::sin(Time * 0.5f + Source.Phase));
+						if(Frame % LowPassInterval == 0)
+						{
+							Updates.Set(&Source, EAudioParam::LowPassEnabled, 1.f);
+							Updates.Set(&Source, EAudioParam::LowPassFrequency, 3000.f + 2000.f * std::sin(Time * 0.3f + Source.Phase));
+						}
+						break;
+					case ESourceKind::Propagated:
+						if(Frame % 120 == 0)
+							Source.PathSize = PathSize(Random);
+
+						VolumeBatch.AddPropagated(Updates.GetRequested(&Source, EAudioParam::Volume, 1.f), Source.PathSize, 100.f, 3000.f);
+						BatchedSources.push_back(i);
+						break;
+					}
+				}
+
+				VolumeBatch.Compute(DeltaTime, PropVolumeLerpSpeed);
+				for(int i = 0; i < VolumeBatch.Num(); i++)
+					Updates.Set(&Sources[BatchedSources[i]], EAudioParam::Volume, VolumeBatch.GetVolume(i));
+				SetSeconds += Stopwatch.GetElapsedSeconds();
+
+				Updates.Flush([](const void* Target, const EAudioParam Param, const float Value)
+				{
+					const_cast<FSimulatedSource*>(static_cast<const FSimulatedSource*>(Target))->SentValues[static_cast<int>(Param)] = Value;
+				});
+
+				TotalRequested += Updates.GetLastStats().Requested;
+				TotalSent += Updates.GetLastStats().Sent;
+
+				// What is heard can only be off by the threshold from what was asked for
+				for(const FSimulatedSource& Source : Sources)
+				{
+					const float Requested = Updates.GetRequested(&Source, EAudioParam::Volume, 1.f);
+					const float Sent = Source.SentValues[static_cast<int>(EAudioParam::Volume)];
+					if(Requested > 0 && Sent > 0)
+						MaxVolumeErrorDecibels = std::max(MaxVolumeErrorDecibels, std::abs(20.f * std::log10(Requested / Sent)));
+				}
+			}
+
+			const std::string Scenario = std::to_string(NumSources) + "_sources";
+			Report.Add(Suite, Scenario, "commands_per_frame_before", static_cast<double>(TotalRequested) / NumFrames, "commands", false);
+			Report.Add(Suite, Scenario, "commands_per_frame_after", static_cast<double>(TotalSent) / NumFrames, "commands", false);
+			Report.Add(Suite, Scenario, "max_volume_error", MaxVolumeErrorDecibels, "dB", false);
+			Report.Add(Suite, Scenario, "ns_per_request", SetSeconds * 1e9 / std::max<long long>(TotalRequested, 1), "ns", false);
+		}
+	}
+}
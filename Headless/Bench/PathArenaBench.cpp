@@ -0,0 +1,173 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BenchSuites.h"
+#include "Core/PathArena.h"
+
+#include <algorithm>
+#include <random>
+
+using namespace AudioCore;
+
+namespace AudioBench
+{
+	namespace
+	{
+		// What happens to one source's path in one tick
+		struct FPathEvent
+		{
+			// Length of the new path, 0 if the path is still valid
+			int Length = 0;
+
+			// The source was destroyed and another one took its place
+			bool bReplaced = false;
+		};
+
+		// The path a source gets, different cells every time it changes
+		void MakePath(const int Length, const int Seed, std::vector<int>& OutPath)
+		{
+			OutPath.resize(Length);
+			for(int i = 0; i < Length; i++)
+				OutPath[i] = Seed * 7919 + i;
+		}
+
+		long long SumPath(const int* Cells, const int Num)
+		{
+			long long Sum = 0;
+			for(int i = 0; i < Num; i++)
+				Sum += static_cast<long long>(Cells[i]) * (i + 1);
+			return Sum;
+		}
+	}
+
+	void RunPathArenaBench(const FBenchOptions& Options, FBenchReport& Report)
+	{
+		const char* Suite = "path_arena";
+		const char* Scenario = "drifting_paths";
+		const int NumSources = Options.bQuick ? 64 : 512;
+		const int NumTicks = Options.bQuick ? 200 : 1000;
+		const int NumWarmupTicks = NumTicks / 4;
+		const int MinLength = 4;
+		const int MaxLength = Options.bQuick ? 160 : 400;
+		std::mt19937 Random(Options.Seed);
+
+		// A third of the paths change every tick, by a few nodes as the listener moves, and a source is replaced now and then
+		std::uniform_int_distribution<int> StartLength(MinLength, MaxLength);
+		std::uniform_int_distribution<int> Drift(-6, 6);
+		std::uniform_real_distribution<float> Chance(0, 1);
+		std::vector<FPathEvent> Events(static_cast<size_t>(NumTicks) * NumSources);
+		std::vector<int> Lengths(static_cast<size_t>(NumSources));
+		for(int& Length : Lengths)
+			Length = StartLength(Random);
+
+		for(int Tick = 0; Tick < NumTicks; Tick++)
+		{
+			for(int Source = 0; Source < NumSources; Source++)
+			{
+				FPathEvent& Event = Events[static_cast<size_t>(Tick) * NumSources + Source];
+				if(Tick == 0)
+					Event.Length = Lengths[Source];
+				else if(Chance(Random) < 0.002f)
+				{
+					Event.bReplaced = true;
+					Event.Length = Lengths[Source] = StartLength(Random);
+				}
+				else if(Chance(Random) < 0.33f)
+					Event.Length = Lengths[Source] = std::clamp(Lengths[Source] + Drift(Random), MinLength, MaxLength);
+			}
+		}
+
+		// What the component did before, a new path every tick that is copied into or out of every source's stored path
+		std::vector<std::vector<int>> StoredPaths(static_cast<size_t>(NumSources));
+		std::vector<int> Indices;
+		std::vector<long long> CopySums(static_cast<size_t>(NumTicks));
+		uint64_t CopyAllocations = 0;
+		double CopySeconds = 0;
+		for(int Tick = 0; Tick < NumTicks; Tick++)
+		{
+			const uint64_t AllocationsBefore = GetAllocationCount();
+			const FStopwatch Stopwatch;
+			long long Sum = 0;
+			for(int Source = 0; Source < NumSources; Source++)
+			{
+				const FPathEvent& Event = Events[static_cast<size_t>(Tick) * NumSources + Source];
+				if(Event.bReplaced)
+					StoredPaths[Source] = std::vector<int>();
+
+				std::vector<int> Path;
+				if(Event.Length > 0)
+				{
+					MakePath(Event.Length, Tick * NumSources + Source, Indices);
+					Path.assign(Indices.begin(), Indices.end());
+					StoredPaths[Source] = std::vector<int>(Path);
+				}
+				else
+					Path = StoredPaths[Source];
+
+				Sum += SumPath(Path.data(), static_cast<int>(Path.size()));
+			}
+
+			CopySums[Tick] = Sum;
+			if(Tick >= NumWarmupTicks)
+			{
+				CopySeconds += Stopwatch.GetElapsedSeconds();
+				CopyAllocations += GetAllocationCount() - AllocationsBefore;
+			}
+		}
+
+		// The arena, each source only holds a handle and its path is read where it is stored
+		FPathArena Arena;
+		std::vector<FPathHandle> Handles(static_cast<size_t>(NumSources));
+		uint64_t ArenaAllocations = 0;
+		double ArenaSeconds = 0;
+		int NumSumMismatches = 0;
+		for(int Tick = 0; Tick < NumTicks; Tick++)
+		{
+			const uint64_t AllocationsBefore = GetAllocationCount();
+			const FStopwatch Stopwatch;
+			long long Sum = 0;
+			for(int Source = 0; Source < NumSources; Source++)
+			{
+				const FPathEvent& Event = Events[static_cast<size_t>(Tick) * NumSources + Source];
+				if(Event.bReplaced)
+					Arena.Release(Handles[Source]);
+
+				if(Event.Length > 0)
+				{
+					MakePath(Event.Length, Tick * NumSources + Source, Indices);
+					Arena.SetPath(Handles[Source], Indices);
+				}
+
+				const FPathView Path = Arena.GetPath(Handles[Source]);
+				Sum += SumPath(Path.Cells, Path.Num);
+			}
+
+			NumSumMismatches += Sum != CopySums[Tick] ? 1 : 0;
+			if(Tick >= NumWarmupTicks)
+			{
+				ArenaSeconds += Stopwatch.GetElapsedSeconds();
+				ArenaAllocations += GetAllocationCount() - AllocationsBefore;
+			}
+		}
+
+		// Every stored path has to be exactly the last one the source got
+		int NumPathMismatches = 0;
+		size_t NumPathCells = 0;
+		for(int Source = 0; Source < NumSources; Source++)
+		{
+			const FPathView Path = Arena.GetPath(Handles[Source]);
+			NumPathCells += StoredPaths[Source].size();
+			if(Path.Num != static_cast<int>(StoredPaths[Source].size()) || !std::equal(Path.Cells, Path.Cells + Path.Num, StoredPaths[Source].begin()))
+				NumPathMismatches++;
+		}
+
+		const int NumMeasuredTicks = NumTicks - NumWarmupTicks;
+		Report.Add(Suite, Scenario, "copy_us_per_tick", CopySeconds * 1e6 / NumMeasuredTicks, "us", false);
+		Report.Add(Suite, Scenario, "arena_us_per_tick", ArenaSeconds * 1e6 / NumMeasuredTicks, "us", false);
+		Report.Add(Suite, Scenario, "copy_allocations_per_tick", static_cast<double>(CopyAllocations) / NumMeasuredTicks, "allocations", false);
+		Report.Add(Suite, Scenario, "arena_allocations_per_tick", static_cast<double>(ArenaAllocations) / NumMeasuredTicks, "allocations", false);
+		Report.Add(Suite, Scenario, "arena_bytes_per_path_byte", NumPathCells > 0 ? static_cast<double>(Arena.GetMemoryUsage()) / (NumPathCells * sizeof(int)) : 0, "x", false);
+		Report.Add(Suite, Scenario, "compactions", Arena.GetNumCompactions(), "compactions", false);
+		Report.Add(Suite, Scenario, "tick_mismatches", NumSumMismatches, "ticks", false);
+		Report.Add(Suite, Scenario, "path_mismatches", NumPathMismatches, "paths", false);
+	}
+}
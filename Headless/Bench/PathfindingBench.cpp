@@ -0,0 +1,61 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BenchSuites.h"
+#include "SyntheticGrids.h"
+#include "Core/GridPathfinder.h"
+
+#include <cstdio>
+
+using namespace AudioCore;
+
+namespace AudioBench
+{
+	void RunPathfindingBench(const FBenchOptions& Options, FBenchReport& Report)
+	{
+		const char* Suite = "pathfinding";
+
+		for(FGridScenario& Scenario : MakeStandardScenarios(Options.bQuick, Options.Seed))
+		{
+			FGridPathfinder Pathfinder(Scenario.Grid);
+			std::vector<int> Path;
+
+			// Warm up so the state arrays are allocated before measuring
+			Pathfinder.FindPath(Scenario.Queries[0].Start, Scenario.Queries[0].End, Path);
+
+			std::vector<double> Latencies;
+			double TotalSeconds = 0;
+			long long TotalExpanded = 0;
+			int NumFound = 0;
+
+			for(const FGridQuery& Query : Scenario.Queries)
+			{
+				const FStopwatch Stopwatch;
+				const bool bFound = Pathfinder.FindPath(Query.Start, Query.End, Path);
+				const double Seconds = Stopwatch.GetElapsedSeconds();
+
+				TotalSeconds += Seconds;
+				Latencies.push_back(Seconds * 1e6);
+				TotalExpanded += Pathfinder.GetLastStats().NodesExpanded;
+				NumFound += bFound ? 1 : 0;
+			}
+
+			// Every array has grown to fit by now, so repeating queries shows the steady state allocations (should be 0)
+			const int NumAllocationQueries = std::min(static_cast<int>(Scenario.Queries.size()), 16);
+			const uint64_t AllocationsBefore = GetAllocationCount();
+			for(int i = 0; i < NumAllocationQueries; i++)
+				Pathfinder.FindPath(Scenario.Queries[i].Start, Scenario.Queries[i].End, Path);
+			const uint64_t Allocations = GetAllocationCount() - AllocationsBefore;
+
+			const int NumQueries = static_cast<int>(Scenario.Queries.size());
+			if((NumFound == NumQueries) != Scenario.bExpectReachable)
+				std::printf("WARNING: %s found %i of %i paths\n", Scenario.Name.c_str(), NumFound, NumQueries);
+
+			Report.Add(Suite, Scenario.Name, "cells", Scenario.Grid.Num(), "cells", true);
+			Report.Add(Suite, Scenario.Name, "expansions_per_second", TotalExpanded / TotalSeconds, "nodes/s", true);
+			Report.Add(Suite, Scenario.Name, "nodes_expanded_mean", static_cast<double>(TotalExpanded) / NumQueries, "nodes", false);
+			AddLatencyPercentiles(Report, Suite, Scenario.Name, "path_query_latency", Latencies);
+			Report.Add(Suite, Scenario.Name, "allocations_per_query", static_cast<double>(Allocations) / NumAllocationQueries, "allocs", false);
+			Report.Add(Suite, Scenario.Name, "memory_per_node", FOccupancyGrid::GetBytesPerCell() + FGridPathfinder::GetBytesPerNode(), "bytes", false);
+		}
+	}
+}
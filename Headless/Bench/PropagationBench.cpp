@@ -0,0 +1,102 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BenchSuites.h"
+#include "SyntheticGrids.h"
+#include "Core/GridPathfinder.h"
+#include "Core/GridRaycast.h"
+#include "Core/PropagationSearch.h"
+
+using namespace AudioCore;
+
+namespace AudioBench
+{
+	namespace
+	{
+		struct FPropagationTotals
+		{
+			double Seconds = 0;
+			long long NodesExpanded = 0;
+			long long VisibilityTests = 0;
+			long long NumOpenings = 0;
+		};
+	}
+
+	void RunPropagationBench(const FBenchOptions& Options, FBenchReport& Report)
+	{
+		const char* Suite = "propagation";
+
+		for(FGridScenario& Scenario : MakeStandardScenarios(Options.bQuick, Options.Seed))
+		{
+			const FOccupancyGrid& Grid = Scenario.Grid;
+
+			// Only sources the listener cannot see are propagated, the rest are skipped before any search
+			std::vector<FGridQuery> Queries;
+			for(const FGridQuery& Query : Scenario.Queries)
+			{
+				if(!HasLineOfSight(Grid, Grid.IndexToWorld(Query.Start), Grid.IndexToWorld(Query.End)))
+					Queries.push_back(Query);
+			}
+
+			if(Queries.empty())
+				continue;
+
+			// The current flow, A* to the listener and then line of sight tests along the path from the listener's end
+			// until the first cell the listener cannot see
+			FGridPathfinder Pathfinder(Grid);
+			std::vector<int> Path;
+			FPropagationTotals Single;
+			for(const FGridQuery& Query : Queries)
+			{
+				const FVec3 ListenerLocation = Grid.IndexToWorld(Query.End);
+				const FStopwatch Stopwatch;
+				if(Pathfinder.FindPath(Query.Start, Query.End, Path))
+				{
+					for(size_t i = 1; i < Path.size(); i++)
+					{
+						Single.VisibilityTests++;
+						if(!HasLineOfSight(Grid, Grid.IndexToWorld(Path[i]), ListenerLocation))
+						{
+							Single.NumOpenings++;
+							break;
+						}
+					}
+				}
+				Single.Seconds += Stopwatch.GetElapsedSeconds();
+				Single.NodesExpanded += Pathfinder.GetLastStats().NodesExpanded;
+			}
+
+			const double NumQueries = static_cast<double>(Queries.size());
+			Report.Add(Suite, Scenario.Name, "single_us_per_source", Single.Seconds * 1e6 / NumQueries, "us", false);
+			Report.Add(Suite, Scenario.Name, "single_nodes_expanded_mean", Single.NodesExpanded / NumQueries, "nodes", false);
+			Report.Add(Suite, Scenario.Name, "single_visibility_tests_mean", Single.VisibilityTests / NumQueries, "tests", false);
+
+			// One expansion per source for every opening count
+			FPropagationSearch Search(Grid);
+			std::vector<FPropagationOpening> Openings;
+			for(const int MaxOpenings : { 1, 2, 4 })
+			{
+				FPropagationSearchSettings Settings;
+				Settings.MaxOpenings = MaxOpenings;
+
+				FPropagationTotals Multi;
+				for(const FGridQuery& Query : Queries)
+				{
+					const FVec3 ListenerLocation = Grid.IndexToWorld(Query.End);
+					const auto IsVisible = [&](const int Index) { return HasLineOfSight(Grid, Grid.IndexToWorld(Index), ListenerLocation); };
+
+					const FStopwatch Stopwatch;
+					Multi.NumOpenings += Search.FindOpenings(Query.Start, Query.End, Settings, IsVisible, Openings);
+					Multi.Seconds += Stopwatch.GetElapsedSeconds();
+					Multi.NodesExpanded += Search.GetLastStats().NodesExpanded;
+					Multi.VisibilityTests += Search.GetLastStats().VisibilityTests;
+				}
+
+				const std::string Prefix = "k" + std::to_string(MaxOpenings) + "_";
+				Report.Add(Suite, Scenario.Name, Prefix + "us_per_source", Multi.Seconds * 1e6 / NumQueries, "us", false);
+				Report.Add(Suite, Scenario.Name, Prefix + "nodes_expanded_mean", Multi.NodesExpanded / NumQueries, "nodes", false);
+				Report.Add(Suite, Scenario.Name, Prefix + "visibility_tests_mean", Multi.VisibilityTests / NumQueries, "tests", false);
+				Report.Add(Suite, Scenario.Name, Prefix + "openings_mean", Multi.NumOpenings / NumQueries, "openings", true);
+			}
+		}
+	}
+}
@@ -0,0 +1,143 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BenchSuites.h"
+#include "SyntheticGrids.h"
+#include "Core/GridPathfinder.h"
+#include "Core/GridRegions.h"
+
+#include <unordered_map>
+
+using namespace AudioCore;
+
+namespace AudioBench
+{
+	namespace
+	{
+		// True if both label the grid into the same regions, the ids themselves do not have to match
+		bool HaveSameRegions(const FOccupancyGrid& Grid, const FGridRegions& Left, const FGridRegions& Right)
+		{
+			std::unordered_map<int, int> LeftToRight;
+			std::unordered_map<int, int> RightToLeft;
+			for(int Index = 0; Index < Grid.Num(); Index++)
+			{
+				const int LeftRegion = Left.GetRegion(Index);
+				const int RightRegion = Right.GetRegion(Index);
+				if((LeftRegion == FGridRegions::InvalidRegion) != (RightRegion == FGridRegions::InvalidRegion))
+					return false;
+
+				if(LeftRegion == FGridRegions::InvalidRegion)
+					continue;
+
+				if(LeftToRight.emplace(LeftRegion, RightRegion).first->second != RightRegion ||
+					RightToLeft.emplace(RightRegion, LeftRegion).first->second != LeftRegion)
+					return false;
+			}
+
+			return Left.NumRegions() == Right.NumRegions();
+		}
+	}
+
+	void RunRegionsBench(const FBenchOptions& Options, FBenchReport& Report)
+	{
+		const char* Suite = "regions";
+		const int NumUpdates = Options.bQuick ? 20 : 100;
+
+		for(FGridScenario& Scenario : MakeStandardScenarios(Options.bQuick, Options.Seed))
+		{
+			FOccupancyGrid& Grid = Scenario.Grid;
+
+			const FStopwatch BuildStopwatch;
+			FGridRegions Regions;
+			Regions.Build(Grid);
+			Report.Add(Suite, Scenario.Name, "build_ms", BuildStopwatch.GetElapsedSeconds() * 1e3, "ms", false);
+			Report.Add(Suite, Scenario.Name, "regions", Regions.NumRegions(), "regions", false);
+			Report.Add(Suite, Scenario.Name, "memory", static_cast<double>(Regions.GetMemoryUsage()), "bytes", false);
+
+			// Unreachable queries are where the labels pay off, the search has to visit every reachable cell to give up
+			FGridPathfinder Pathfinder(Grid);
+			std::vector<int> Path;
+			double SearchSeconds = 0;
+			double RejectSeconds = 0;
+			int NumMismatches = 0;
+
+			for(const FGridQuery& Query : Scenario.Queries)
+			{
+				FStopwatch Stopwatch;
+				const bool bFound = Pathfinder.FindPath(Query.Start, Query.End, Path);
+				SearchSeconds += Stopwatch.GetElapsedSeconds();
+
+				Stopwatch.Restart();
+				const bool bCanReach = Regions.CanReach(Query.Start, Query.End);
+				RejectSeconds += Stopwatch.GetElapsedSeconds();
+
+				if(bFound != bCanReach)
+					NumMismatches++;
+			}
+
+			const double NumQueries = static_cast<double>(Scenario.Queries.size());
+			Report.Add(Suite, Scenario.Name, "search_us_per_query", SearchSeconds * 1e6 / NumQueries, "us", false);
+			Report.Add(Suite, Scenario.Name, "can_reach_us_per_query", RejectSeconds * 1e6 / NumQueries, "us", false);
+			Report.Add(Suite, Scenario.Name, "reachability_mismatches", NumMismatches, "queries", false);
+
+			// Close and open random cells, like doors, and compare against labelling everything again
+			std::mt19937 Random(Options.Seed);
+			double UpdateSeconds = 0;
+			double RebuildSeconds = 0;
+			int NumLabelMismatches = 0;
+
+			for(int Update = 0; Update < NumUpdates; Update++)
+			{
+				const int Cell = GetRandomWalkableIndex(Grid, Random);
+				for(const bool bWalkable : { false, true })
+				{
+					Grid.SetWalkable(Cell, bWalkable);
+
+					FStopwatch Stopwatch;
+					Regions.UpdateCells({ Cell });
+					UpdateSeconds += Stopwatch.GetElapsedSeconds();
+
+					Stopwatch.Restart();
+					FGridRegions Rebuilt;
+					Rebuilt.Build(Grid);
+					RebuildSeconds += Stopwatch.GetElapsedSeconds();
+
+					if(!HaveSameRegions(Grid, Regions, Rebuilt))
+						NumLabelMismatches++;
+				}
+			}
+
+			// A wall across the middle of the grid, which splits the regions it cuts through and merges them when opened
+			std::vector<int> WallCells;
+			for(int y = 0; y < Grid.GetLengthY(); y++)
+			{
+				for(int z = 0; z < Grid.GetLengthZ(); z++)
+				{
+					const int Cell = Grid.GetIndex(Grid.GetLengthX() / 2, y, z);
+					if(Grid.IsWalkable(Cell))
+						WallCells.push_back(Cell);
+				}
+			}
+
+			double WallSeconds = 0;
+			for(const bool bWalkable : { false, true })
+			{
+				for(const int Cell : WallCells)
+					Grid.SetWalkable(Cell, bWalkable);
+
+				const FStopwatch Stopwatch;
+				Regions.UpdateCells(WallCells);
+				WallSeconds += Stopwatch.GetElapsedSeconds();
+
+				FGridRegions Rebuilt;
+				Rebuilt.Build(Grid);
+				if(!HaveSameRegions(Grid, Regions, Rebuilt))
+					NumLabelMismatches++;
+			}
+
+			Report.Add(Suite, Scenario.Name, "update_us", UpdateSeconds * 1e6 / (NumUpdates * 2), "us", false);
+			Report.Add(Suite, Scenario.Name, "wall_update_us", WallSeconds * 1e6 / 2, "us", false);
+			Report.Add(Suite, Scenario.Name, "rebuild_us", RebuildSeconds * 1e6 / (NumUpdates * 2), "us", false);
+			Report.Add(Suite, Scenario.Name, "update_label_mismatches", NumLabelMismatches, "updates", false);
+		}
+	}
+}
@@ -0,0 +1,227 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SyntheticGrids.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+
+using namespace AudioCore;
+
+namespace AudioBench
+{
+	namespace
+	{
+		void InitGrid(FOccupancyGrid& Grid, const int LengthX, const int LengthY, const int LengthZ, const bool bWalkable)
+		{
+			Grid.Init(LengthX, LengthY, LengthZ, SyntheticNodeDiameter, FVec3());
+			for(int i = 0; i < Grid.Num(); i++)
+				Grid.SetWalkable(i, bWalkable);
+		}
+
+		// Random walkable cell with Z in [MinZ, MaxZ]
+		int GetRandomWalkableIndexInZRange(const FOccupancyGrid& Grid, const int MinZ, const int MaxZ, std::mt19937& Random)
+		{
+			std::uniform_int_distribution<int> RandomX(0, Grid.GetLengthX() - 1);
+			std::uniform_int_distribution<int> RandomY(0, Grid.GetLengthY() - 1);
+			std::uniform_int_distribution<int> RandomZ(MinZ, MaxZ);
+
+			for(int Attempt = 0; Attempt < 100000; Attempt++)
+			{
+				const int Index = Grid.GetIndex(RandomX(Random), RandomY(Random), RandomZ(Random));
+				if(Grid.IsWalkable(Index))
+					return Index;
+			}
+
+			return InvalidIndex;
+		}
+	}
+
+	int GetRandomWalkableIndex(const FOccupancyGrid& Grid, std::mt19937& Random)
+	{
+		return GetRandomWalkableIndexInZRange(Grid, 0, Grid.GetLengthZ() - 1, Random);
+	}
+
+	FGridScenario MakeOpenField(const int LengthX, const int LengthY, const int LengthZ, const int NumQueries, std::mt19937& Random)
+	{
+		FGridScenario Scenario;
+		Scenario.Name = "open_field";
+		InitGrid(Scenario.Grid, LengthX, LengthY, LengthZ, true);
+
+		for(int i = 0; i < NumQueries; i++)
+			Scenario.Queries.push_back({ GetRandomWalkableIndex(Scenario.Grid, Random), GetRandomWalkableIndex(Scenario.Grid, Random) });
+
+		return Scenario;
+	}
+
+	FGridScenario MakeMaze(const int CellsPerSide, const int LengthZ, const int NumQueries, std::mt19937& Random)
+	{
+		FGridScenario Scenario;
+		Scenario.Name = "maze";
+
+		// Maze cells are on odd grid coordinates with walls in between
+		const int Length = CellsPerSide * 2 + 1;
+		InitGrid(Scenario.Grid, Length, Length, LengthZ, false);
+		FOccupancyGrid& Grid = Scenario.Grid;
+
+		const auto Carve = [&Grid, LengthZ](const int X, const int Y)
+		{
+			for(int z = 0; z < LengthZ; z++)
+				Grid.SetWalkable(Grid.GetIndex(X, Y, z), true);
+		};
+
+		// Iterative depth first search (recursive backtracker)
+		std::vector<uint8_t> Visited(static_cast<size_t>(CellsPerSide) * CellsPerSide, 0);
+		std::vector<std::pair<int, int>> Stack { { 0, 0 } };
+		Visited[0] = 1;
+		Carve(1, 1);
+
+		const int Directions[4][2] { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+		while(!Stack.empty())
+		{
+			const auto [CellX, CellY] = Stack.back();
+
+			int Candidates[4];
+			int NumCandidates = 0;
+			for(int i = 0; i < 4; i++)
+			{
+				const int NextX = CellX + Directions[i][0];
+				const int NextY = CellY + Directions[i][1];
+				if(NextX >= 0 && NextX < CellsPerSide && NextY >= 0 && NextY < CellsPerSide && !Visited[NextY * CellsPerSide + NextX])
+					Candidates[NumCandidates++] = i;
+			}
+
+			if(NumCandidates == 0)
+			{
+				Stack.pop_back();
+				continue;
+			}
+
+			const int Direction = Candidates[std::uniform_int_distribution<int>(0, NumCandidates - 1)(Random)];
+			const int NextX = CellX + Directions[Direction][0];
+			const int NextY = CellY + Directions[Direction][1];
+			Visited[NextY * CellsPerSide + NextX] = 1;
+
+			// Carve the wall between the cells and the next cell itself
+			Carve(CellX * 2 + 1 + Directions[Direction][0], CellY * 2 + 1 + Directions[Direction][1]);
+			Carve(NextX * 2 + 1, NextY * 2 + 1);
+			Stack.push_back({ NextX, NextY });
+		}
+
+		for(int i = 0; i < NumQueries; i++)
+			Scenario.Queries.push_back({ GetRandomWalkableIndex(Grid, Random), GetRandomWalkableIndex(Grid, Random) });
+
+		return Scenario;
+	}
+
+	FGridScenario MakeMultiFloorBuilding(const int LengthXY, const int NumFloors, const int NumQueries, std::mt19937& Random)
+	{
+		constexpr int FloorHeight = 6;
+		constexpr int RoomSize = 16;
+		constexpr int StairSize = 3;
+
+		FGridScenario Scenario;
+		Scenario.Name = "multi_floor_building";
+		InitGrid(Scenario.Grid, LengthXY, LengthXY, NumFloors * FloorHeight, true);
+		FOccupancyGrid& Grid = Scenario.Grid;
+
+		for(int Floor = 0; Floor < NumFloors; Floor++)
+		{
+			const int SlabZ = Floor * FloorHeight;
+
+			// Stairwells alternate between two corners so every floor has to be crossed to get to the next
+			const int StairStart = Floor % 2 == 1 ? 2 : LengthXY - 2 - StairSize;
+
+			for(int x = 0; x < LengthXY; x++)
+			{
+				for(int y = 0; y < LengthXY; y++)
+				{
+					const bool bStairwell = Floor > 0 && x >= StairStart && x < StairStart + StairSize && y >= StairStart && y < StairStart + StairSize;
+					if(!bStairwell)
+						Grid.SetWalkable(Grid.GetIndex(x, y, SlabZ), false);
+
+					// Room walls with two cells wide and three cells high doorways in the middle of each room side
+					const bool bWallX = x > 0 && x % RoomSize == 0;
+					const bool bWallY = y > 0 && y % RoomSize == 0;
+					if(!bWallX && !bWallY)
+						continue;
+
+					for(int z = SlabZ + 1; z < SlabZ + FloorHeight; z++)
+					{
+						const bool bDoorHeight = z <= SlabZ + 3;
+						const bool bDoorX = bWallX && !bWallY && y % RoomSize >= RoomSize / 2 - 1 && y % RoomSize <= RoomSize / 2;
+						const bool bDoorY = bWallY && !bWallX && x % RoomSize >= RoomSize / 2 - 1 && x % RoomSize <= RoomSize / 2;
+						if(!(bDoorHeight && (bDoorX || bDoorY)))
+							Grid.SetWalkable(Grid.GetIndex(x, y, z), false);
+					}
+				}
+			}
+		}
+
+		// From the ground floor to the top floor
+		const int TopFloorZ = (NumFloors - 1) * FloorHeight;
+		for(int i = 0; i < NumQueries; i++)
+		{
+			Scenario.Queries.push_back({ GetRandomWalkableIndexInZRange(Grid, 1, FloorHeight - 1, Random),
+				GetRandomWalkableIndexInZRange(Grid, TopFloorZ + 1, TopFloorZ + FloorHeight - 1, Random) });
+		}
+
+		return Scenario;
+	}
+
+	FGridScenario MakeUnreachableTarget(const int LengthXY, const int LengthZ, const int NumQueries, std::mt19937& Random)
+	{
+		constexpr int RoomHalfSize = 3;
+
+		FGridScenario Scenario;
+		Scenario.Name = "unreachable_target";
+		Scenario.bExpectReachable = false;
+		InitGrid(Scenario.Grid, LengthXY, LengthXY, LengthZ, true);
+		FOccupancyGrid& Grid = Scenario.Grid;
+
+		// Sealed room in the middle, the grid's bottom and top close it vertically
+		const int Center = LengthXY / 2;
+		for(int x = Center - RoomHalfSize; x <= Center + RoomHalfSize; x++)
+		{
+			for(int y = Center - RoomHalfSize; y <= Center + RoomHalfSize; y++)
+			{
+				const bool bWall = x == Center - RoomHalfSize || x == Center + RoomHalfSize || y == Center - RoomHalfSize || y == Center + RoomHalfSize;
+				if(!bWall)
+					continue;
+
+				for(int z = 0; z < LengthZ; z++)
+					Grid.SetWalkable(Grid.GetIndex(x, y, z), false);
+			}
+		}
+
+		const int Target = Grid.GetIndex(Center, Center, LengthZ / 2);
+		for(int i = 0; i < NumQueries; i++)
+		{
+			int Start;
+			do
+			{
+				Start = GetRandomWalkableIndex(Grid, Random);
+				const FGridCoord Coord = Grid.GetCoord(Start);
+				if(std::abs(Coord.X - Center) > RoomHalfSize || std::abs(Coord.Y - Center) > RoomHalfSize)
+					break;
+			} while(true);
+
+			Scenario.Queries.push_back({ Start, Target });
+		}
+
+		return Scenario;
+	}
+
+	std::vector<FGridScenario> MakeStandardScenarios(const bool bQuick, const uint32_t Seed)
+	{
+		std::mt19937 Random(Seed);
+		const int NumQueries = bQuick ? 40 : 400;
+
+		std::vector<FGridScenario> Scenarios;
+		Scenarios.push_back(MakeOpenField(bQuick ? 64 : 128, bQuick ? 64 : 128, 4, NumQueries, Random));
+		Scenarios.push_back(MakeMaze(bQuick ? 31 : 63, 3, NumQueries, Random));
+		Scenarios.push_back(MakeMultiFloorBuilding(bQuick ? 48 : 96, 4, NumQueries / 4, Random));
+		Scenarios.push_back(MakeUnreachableTarget(bQuick ? 48 : 96, 4, bQuick ? 10 : 50, Random));
+		return Scenarios;
+	}
+}
@@ -0,0 +1,52 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "Core/OccupancyGrid.h"
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace AudioBench
+{
+	// A path query from a source cell to a listener cell
+	struct FGridQuery
+	{
+		int Start = 0;
+		int End = 0;
+	};
+
+	// A synthetic grid and the queries to run on it
+	struct FGridScenario
+	{
+		std::string Name;
+		AudioCore::FOccupancyGrid Grid;
+		std::vector<FGridQuery> Queries;
+
+		// False if the queries are not expected to find a path
+		bool bExpectReachable = true;
+	};
+
+	// Node diameter used by every synthetic grid, same as the default NodeRadius of 50 on AMapGrid
+	constexpr float SyntheticNodeDiameter = 100.f;
+
+	// Everything walkable
+	FGridScenario MakeOpenField(const int LengthX, const int LengthY, const int LengthZ, const int NumQueries, std::mt19937& Random);
+
+	// Perfect maze (one route between any two cells) with one cell thick walls that go from floor to ceiling
+	FGridScenario MakeMaze(const int CellsPerSide, const int LengthZ, const int NumQueries, std::mt19937& Random);
+
+	// Floors stacked on top of each other with rooms, doorways and stairwells. Queries go between different floors
+	FGridScenario MakeMultiFloorBuilding(const int LengthXY, const int NumFloors, const int NumQueries, std::mt19937& Random);
+
+	// Open field with the target sealed inside a closed room so every query explores every reachable cell
+	FGridScenario MakeUnreachableTarget(const int LengthXY, const int LengthZ, const int NumQueries, std::mt19937& Random);
+
+	// The four scenarios above at the size used by the benchmarks
+	std::vector<FGridScenario> MakeStandardScenarios(const bool bQuick, const uint32_t Seed);
+
+	// Returns a random walkable cell, or InvalidIndex if the grid has none
+	int GetRandomWalkableIndex(const AudioCore::FOccupancyGrid& Grid, std::mt19937& Random);
+}
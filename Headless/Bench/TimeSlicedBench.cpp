@@ -0,0 +1,88 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BenchSuites.h"
+#include "SyntheticGrids.h"
+#include "Core/GridPathfinder.h"
+
+#include <algorithm>
+#include <string>
+
+using namespace AudioCore;
+
+namespace AudioBench
+{
+	void RunTimeSlicedBench(const FBenchOptions& Options, FBenchReport& Report)
+	{
+		const char* Suite = "time_sliced";
+		const int Budgets[] = { 256, 1024, 4096 };
+
+		for(FGridScenario& Scenario : MakeStandardScenarios(Options.bQuick, Options.Seed))
+		{
+			const FOccupancyGrid& Grid = Scenario.Grid;
+
+			// The whole search in one call, the longest one is the frame spike the budget is there to avoid
+			FGridPathfinder Pathfinder(Grid);
+			std::vector<std::vector<int>> Paths(Scenario.Queries.size());
+			std::vector<bool> Found(Scenario.Queries.size());
+			double Seconds = 0;
+			double MaxSeconds = 0;
+			for(size_t QueryIndex = 0; QueryIndex < Scenario.Queries.size(); QueryIndex++)
+			{
+				const FGridQuery& Query = Scenario.Queries[QueryIndex];
+				const FStopwatch Stopwatch;
+				Found[QueryIndex] = Pathfinder.FindPath(Query.Start, Query.End, Paths[QueryIndex]);
+				const double QuerySeconds = Stopwatch.GetElapsedSeconds();
+				Seconds += QuerySeconds;
+				MaxSeconds = std::max(MaxSeconds, QuerySeconds);
+			}
+
+			const double NumQueries = static_cast<double>(Scenario.Queries.size());
+			Report.Add(Suite, Scenario.Name, "full_us_per_query", Seconds * 1e6 / NumQueries, "us", false);
+			Report.Add(Suite, Scenario.Name, "full_max_us", MaxSeconds * 1e6, "us", false);
+
+			FGridPathfinder SlicedPathfinder(Grid);
+			std::vector<int> Path;
+			for(const int Budget : Budgets)
+			{
+				double SlicedSeconds = 0;
+				double MaxSliceSeconds = 0;
+				long long NumSlices = 0;
+				int MaxSlices = 0;
+				int NumMismatches = 0;
+				for(size_t QueryIndex = 0; QueryIndex < Scenario.Queries.size(); QueryIndex++)
+				{
+					const FGridQuery& Query = Scenario.Queries[QueryIndex];
+
+					// One slice per frame until the search is done
+					int QuerySlices = 0;
+					EGridSearchStatus Status = EGridSearchStatus::Searching;
+					SlicedPathfinder.BeginPath(Query.Start, Query.End);
+					while(Status == EGridSearchStatus::Searching)
+					{
+						const FStopwatch Stopwatch;
+						Status = SlicedPathfinder.ContinuePath(Budget, Path);
+						const double SliceSeconds = Stopwatch.GetElapsedSeconds();
+						SlicedSeconds += SliceSeconds;
+						MaxSliceSeconds = std::max(MaxSliceSeconds, SliceSeconds);
+						QuerySlices++;
+					}
+
+					NumSlices += QuerySlices;
+					MaxSlices = std::max(MaxSlices, QuerySlices);
+
+					// Suspending must not change the search, so the path is exactly the one found in a single call
+					const bool bFound = Status == EGridSearchStatus::Found;
+					if(bFound != Found[QueryIndex] || (bFound && Path != Paths[QueryIndex]))
+						NumMismatches++;
+				}
+
+				const std::string Prefix = "budget" + std::to_string(Budget) + "_";
+				Report.Add(Suite, Scenario.Name, Prefix + "max_slice_us", MaxSliceSeconds * 1e6, "us", false);
+				Report.Add(Suite, Scenario.Name, Prefix + "frames_per_query_mean", NumSlices / NumQueries, "frames", false);
+				Report.Add(Suite, Scenario.Name, Prefix + "frames_per_query_max", MaxSlices, "frames", false);
+				Report.Add(Suite, Scenario.Name, Prefix + "total_time_ratio", Seconds > 0 ? SlicedSeconds / Seconds : 0, "x", false);
+				Report.Add(Suite, Scenario.Name, Prefix + "path_mismatches", NumMismatches, "queries", false);
+			}
+		}
+	}
+}
@@ -0,0 +1,207 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BenchSuites.h"
+#include "SyntheticGrids.h"
+#include "Core/GridNeighbours.h"
+#include "Core/GridPathfinder.h"
+#include "Core/GridRaycast.h"
+#include "Core/TransmissionSearch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <queue>
+
+using namespace AudioCore;
+
+namespace AudioBench
+{
+	namespace
+	{
+		// Same default as UAudioOcclusionComponent
+		constexpr float MaxMeshDistanceToBlockAllAudio = 900.f;
+
+		/* A third of the walls block everything, the others are soft, normal or hard materials (see the occlusion
+		 * component's material values). Walls of one material are in blocks of cells so routes through them are real walls */
+		void BakeSyntheticTransmission(const FOccupancyGrid& Grid, FGridTransmission& OutTransmission)
+		{
+			const float MaterialValues[] = { 0.5f, 1.f, 2.f };
+
+			OutTransmission.Init(Grid);
+			for(int Index = 0; Index < Grid.Num(); Index++)
+			{
+				const FGridCoord Coord = Grid.GetCoord(Index);
+				if(Grid.IsWalkable(Index) || Grid.IsOutOfBounds(Coord.X, Coord.Y, Coord.Z))
+					continue;
+
+				const int Material = (Coord.X / 4 * 7 + Coord.Y / 4 * 13 + Coord.Z / 4 * 5) % 4;
+				if(Material < 3)
+					OutTransmission.SetOcclusion(Index, GetCellOcclusion(Grid.GetNodeDiameter(), MaterialValues[Material], MaxMeshDistanceToBlockAllAudio));
+			}
+		}
+
+		// Dijkstra over walkable cells with the transmission search's step lengths, the listener's cell is always entered
+		float GetShortestDistance(const FOccupancyGrid& Grid, const int Start, const int End)
+		{
+			const TGridNeighbours<26> Neighbours(Grid);
+			std::vector<float> Distances(static_cast<size_t>(Grid.Num()), std::numeric_limits<float>::max());
+			using FEntry = std::pair<float, int>;
+			std::priority_queue<FEntry, std::vector<FEntry>, std::greater<FEntry>> Open;
+			Distances[Start] = 0;
+			Open.push({ 0.f, Start });
+			while(!Open.empty())
+			{
+				const auto [Distance, Index] = Open.top();
+				Open.pop();
+				if(Index == End)
+					return Distance;
+
+				if(Distance > Distances[Index])
+					continue;
+
+				const uint8_t BoundaryMask = Neighbours.GetBoundaryMask(Index);
+				for(int Direction = 0; Direction < TGridNeighbours<26>::NumDirections; Direction++)
+				{
+					const int Neighbour = Neighbours.GetNeighbour(Index, Direction);
+					if(!Neighbours.IsInside(BoundaryMask, Direction) || (!Grid.IsWalkable(Neighbour) && Neighbour != End))
+						continue;
+
+					const float NewDistance = Distance + Grid.GetNodeDiameter() * std::sqrt(static_cast<float>(Neighbours.GetDistanceSquared(Direction)));
+					if(NewDistance < Distances[Neighbour])
+					{
+						Distances[Neighbour] = NewDistance;
+						Open.push({ NewDistance, Neighbour });
+					}
+				}
+			}
+
+			return -1;
+		}
+
+		// False if a step of the route is not between neighbours or goes through a cell that blocks everything
+		bool IsValidRoute(const FOccupancyGrid& Grid, const FGridTransmission& Transmission, const int Start, const std::vector<int>& Path)
+		{
+			int Previous = Start;
+			for(auto Cell = Path.rbegin(); Cell != Path.rend(); ++Cell)
+			{
+				const FGridCoord From = Grid.GetCoord(Previous);
+				const FGridCoord To = Grid.GetCoord(*Cell);
+				const bool bLastCell = Cell + 1 == Path.rend();
+				if(std::abs(From.X - To.X) > 1 || std::abs(From.Y - To.Y) > 1 || std::abs(From.Z - To.Z) > 1 || (Transmission.IsOpaque(*Cell) && !bLastCell))
+					return false;
+
+				Previous = *Cell;
+			}
+
+			return true;
+		}
+
+		/* The traces one blocked source costs with separate passes: the propagation's blocked check, the occlusion's
+		 * thickness traces from both ends and the propagation's line of sight check of every path node until one is
+		 * blocked. Done with grid traces, returns the number of traces */
+		int TraceSeparately(const FOccupancyGrid& Grid, FGridPathfinder& Pathfinder, const int Source, const int Listener, std::vector<int>& Path)
+		{
+			const FVec3 SourceLocation = Grid.IndexToWorld(Source);
+			const FVec3 ListenerLocation = Grid.IndexToWorld(Listener);
+			int NumTraces = 3;
+			TraceGrid(Grid, ListenerLocation, SourceLocation);
+			TraceGrid(Grid, SourceLocation, ListenerLocation);
+
+			if(!Pathfinder.FindPath(Source, Listener, Path))
+				return NumTraces;
+
+			for(size_t i = 1; i < Path.size(); i++)
+			{
+				NumTraces++;
+				if(!HasLineOfSight(Grid, Grid.IndexToWorld(Path[i]), ListenerLocation))
+					break;
+			}
+
+			return NumTraces;
+		}
+	}
+
+	void RunTransmissionBench(const FBenchOptions& Options, FBenchReport& Report)
+	{
+		const char* Suite = "transmission";
+		const int MaxQueries = Options.bQuick ? 20 : 100;
+
+		for(FGridScenario& Scenario : MakeStandardScenarios(Options.bQuick, Options.Seed))
+		{
+			const FOccupancyGrid& Grid = Scenario.Grid;
+
+			// Only blocked sources are searched, the others are heard directly
+			std::vector<FGridQuery> Queries;
+			for(const FGridQuery& Query : Scenario.Queries)
+			{
+				if(static_cast<int>(Queries.size()) < MaxQueries && !HasLineOfSight(Grid, Grid.IndexToWorld(Query.Start), Grid.IndexToWorld(Query.End)))
+					Queries.push_back(Query);
+			}
+
+			if(Queries.empty())
+				continue;
+
+			const int NumQueries = static_cast<int>(Queries.size());
+			FGridTransmission Transmission;
+			BakeSyntheticTransmission(Grid, Transmission);
+			FGridTransmission OpaqueTransmission;
+			OpaqueTransmission.Init(Grid);
+
+			FGridPathfinder Pathfinder(Grid);
+			FTransmissionSearch Search(Grid, Transmission);
+			FTransmissionSearch OpaqueSearch(Grid, OpaqueTransmission);
+			FTransmissionSettings Settings;
+			FTransmissionResult Result;
+			std::vector<int> Path;
+
+			double SeparateSeconds = 0;
+			double CombinedSeconds = 0;
+			long long SeparateTraces = 0;
+			long long VisibilityTests = 0;
+			long long NodesExpanded = 0;
+			int NumTransmitted = 0;
+			int NumPropagated = 0;
+			int NumUnreachable = 0;
+			int NumInvalidRoutes = 0;
+			int NumDistanceMismatches = 0;
+			for(const FGridQuery& Query : Queries)
+			{
+				FStopwatch Stopwatch;
+				SeparateTraces += TraceSeparately(Grid, Pathfinder, Query.Start, Query.End, Path);
+				SeparateSeconds += Stopwatch.GetElapsedSeconds();
+
+				Stopwatch.Restart();
+				const bool bFound = Search.Search(Query.Start, Query.End, Grid.IndexToWorld(Query.Start), Grid.IndexToWorld(Query.End), Settings, Result, Path);
+				CombinedSeconds += Stopwatch.GetElapsedSeconds();
+
+				NodesExpanded += Search.GetLastStats().NodesExpanded;
+				NumUnreachable += bFound ? 0 : 1;
+				NumTransmitted += bFound && Result.RouteOcclusion > 0 ? 1 : 0;
+				NumInvalidRoutes += bFound && !IsValidRoute(Grid, Transmission, Query.Start, Path) ? 1 : 0;
+
+				/* With every wall opaque the search is the propagation alone, the route has to be one of the shortest around
+				 * the walls and the sound is propagated to where the listener first sees it */
+				const bool bOpaqueFound = OpaqueSearch.Search(Query.Start, Query.End, Grid.IndexToWorld(Query.Start), Grid.IndexToWorld(Query.End), Settings, Result, Path);
+				VisibilityTests += OpaqueSearch.GetLastStats().VisibilityTests;
+				NumPropagated += Result.OpeningIndex != InvalidIndex ? 1 : 0;
+				const float Shortest = GetShortestDistance(Grid, Query.Start, Query.End);
+				if(bOpaqueFound != (Shortest >= 0) || (bOpaqueFound && std::abs(Result.RouteDistance - Shortest) > Shortest * 1e-4f))
+					NumDistanceMismatches++;
+			}
+
+			Report.Add(Suite, Scenario.Name, "separate_traces_per_source", static_cast<double>(SeparateTraces) / NumQueries, "traces", false);
+			Report.Add(Suite, Scenario.Name, "combined_traces_per_source", 1, "traces", false);
+			Report.Add(Suite, Scenario.Name, "separate_us", SeparateSeconds * 1e6 / NumQueries, "us", false);
+			Report.Add(Suite, Scenario.Name, "combined_us", CombinedSeconds * 1e6 / NumQueries, "us", false);
+			Report.Add(Suite, Scenario.Name, "opaque_grid_visibility_tests_per_source", static_cast<double>(VisibilityTests) / NumQueries, "tests", false);
+			Report.Add(Suite, Scenario.Name, "nodes_expanded_per_source", static_cast<double>(NodesExpanded) / NumQueries, "nodes", false);
+			Report.Add(Suite, Scenario.Name, "transmitted_ratio", static_cast<double>(NumTransmitted) / NumQueries, "x", false);
+			Report.Add(Suite, Scenario.Name, "opaque_propagated_ratio", static_cast<double>(NumPropagated) / NumQueries, "x", false);
+			Report.Add(Suite, Scenario.Name, "unreachable_ratio", static_cast<double>(NumUnreachable) / NumQueries, "x", false);
+			Report.Add(Suite, Scenario.Name, "invalid_routes", NumInvalidRoutes, "routes", false);
+			Report.Add(Suite, Scenario.Name, "opaque_distance_mismatches", NumDistanceMismatches, "routes", false);
+		}
+	}
+}
@@ -0,0 +1,188 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BenchSuites.h"
+#include "SyntheticGrids.h"
+#include "Core/GridSerialization.h"
+#include "Core/GridVoxelizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <thread>
+
+using namespace AudioCore;
+
+namespace AudioBench
+{
+	namespace
+	{
+		// An oriented box, its axes are unit vectors
+		struct FOrientedBox
+		{
+			FVec3 Center;
+			FVec3 Axes[3];
+			float HalfExtents[3];
+			bool bClosed = true;
+		};
+
+		/* What a sphere overlap against the box finds, computed from the box itself rather than its triangles. A closed
+		 * box overlaps if its closest point is close enough, an open one only if its surface is */
+		bool SphereOverlapsBox(const FOrientedBox& Box, const FVec3& SphereCenter, const float Radius)
+		{
+			const FVec3 Delta = SphereCenter - Box.Center;
+			float DistanceSquared = 0;
+			float DistanceInside = INFINITY;
+			for(int Axis = 0; Axis < 3; Axis++)
+			{
+				const float Projected = Delta.Dot(Box.Axes[Axis]);
+				const float Outside = std::abs(Projected) - Box.HalfExtents[Axis];
+				DistanceSquared += Outside > 0 ? Outside * Outside : 0;
+				DistanceInside = std::min(DistanceInside, -Outside);
+			}
+
+			if(DistanceSquared > 0)
+				return DistanceSquared <= Radius * Radius;
+
+			return Box.bClosed || DistanceInside <= Radius;
+		}
+
+		// Random rotation from a random unit quaternion
+		void RandomAxes(std::mt19937& Random, FVec3 (&OutAxes)[3])
+		{
+			std::normal_distribution<float> Normal;
+			float W = Normal(Random), X = Normal(Random), Y = Normal(Random), Z = Normal(Random);
+			const float Length = std::sqrt(W * W + X * X + Y * Y + Z * Z);
+			W /= Length, X /= Length, Y /= Length, Z /= Length;
+
+			OutAxes[0] = FVec3(1 - 2 * (Y * Y + Z * Z), 2 * (X * Y + W * Z), 2 * (X * Z - W * Y));
+			OutAxes[1] = FVec3(2 * (X * Y - W * Z), 1 - 2 * (X * X + Z * Z), 2 * (Y * Z + W * X));
+			OutAxes[2] = FVec3(2 * (X * Z + W * Y), 2 * (Y * Z - W * X), 1 - 2 * (X * X + Y * Y));
+		}
+
+		// Every blocked cell of the grid as a box a bit smaller than the cell, the node's sphere only reaches its own box
+		FCollisionMesh MakeMeshFromGrid(const FOccupancyGrid& Grid)
+		{
+			FCollisionMesh Mesh;
+			Mesh.LengthX = Grid.GetLengthX();
+			Mesh.LengthY = Grid.GetLengthY();
+			Mesh.LengthZ = Grid.GetLengthZ();
+			Mesh.NodeDiameter = Grid.GetNodeDiameter();
+			Mesh.BottomLeft = Grid.GetBottomLeft();
+
+			const float HalfExtent = Grid.GetNodeDiameter() * 0.4f;
+			for(int Index = 0; Index < Grid.Num(); Index++)
+			{
+				if(!Grid.IsWalkable(Index))
+					Mesh.Bodies.push_back(MakeBoxBody(Grid.IndexToWorld(Index), FVec3(HalfExtent, 0, 0), FVec3(0, HalfExtent, 0), FVec3(0, 0, HalfExtent)));
+			}
+
+			return Mesh;
+		}
+
+		int CountDifferentCells(const FOccupancyGrid& Grid, const FOccupancyGrid& OtherGrid)
+		{
+			int NumDifferent = 0;
+			for(int Index = 0; Index < Grid.Num(); Index++)
+				NumDifferent += Grid.IsWalkable(Index) != OtherGrid.IsWalkable(Index) ? 1 : 0;
+			return NumDifferent;
+		}
+
+		// Voxelizes the mesh on every thread count and reports the time of each, returns the grid of the last one
+		FOccupancyGrid MeasureVoxelize(const char* Suite, const std::string& ScenarioName, const FCollisionMesh& Mesh, const std::vector<int>& ThreadCounts, FBenchReport& Report)
+		{
+			FOccupancyGrid Grid;
+			double SingleThreadSeconds = 0;
+			for(const int NumThreads : ThreadCounts)
+			{
+				const FStopwatch Stopwatch;
+				const FVoxelizerStats Stats = VoxelizeGrid(Mesh, Grid, NumThreads);
+				const double Seconds = Stopwatch.GetElapsedSeconds();
+
+				const std::string Prefix = "threads" + std::to_string(NumThreads) + "_";
+				Report.Add(Suite, ScenarioName, Prefix + "ms", Seconds * 1e3, "ms", false);
+				if(NumThreads == 1)
+				{
+					SingleThreadSeconds = Seconds;
+					Report.Add(Suite, ScenarioName, "triangles", Stats.NumTriangles, "triangles", false);
+					Report.Add(Suite, ScenarioName, "box_tests_per_triangle", Stats.NumTriangles > 0 ? static_cast<double>(Stats.NumBoxTests) / Stats.NumTriangles : 0, "tests", false);
+					Report.Add(Suite, ScenarioName, "sphere_test_ratio", Stats.NumBoxTests > 0 ? static_cast<double>(Stats.NumSphereTests) / Stats.NumBoxTests : 0, "x", false);
+					Report.Add(Suite, ScenarioName, "cells_per_second", Grid.Num() / Seconds, "cells/s", true);
+				}
+				else
+					Report.Add(Suite, ScenarioName, Prefix + "speedup", Seconds > 0 ? SingleThreadSeconds / Seconds : 0, "x", true);
+			}
+
+			return Grid;
+		}
+	}
+
+	void RunVoxelizerBench(const FBenchOptions& Options, FBenchReport& Report)
+	{
+		const char* Suite = "voxelizer";
+		std::mt19937 Random(Options.Seed);
+
+		// 1 and 4 threads, and every core of the machine if it has more
+		std::vector<int> ThreadCounts = { 1, 4 };
+		const int NumCores = static_cast<int>(std::thread::hardware_concurrency());
+		if(NumCores > 4)
+			ThreadCounts.push_back(NumCores);
+
+		// The synthetic grids turned into boxes have to come back exactly the same
+		for(FGridScenario& Scenario : MakeStandardScenarios(Options.bQuick, Options.Seed))
+		{
+			const FCollisionMesh Mesh = MakeMeshFromGrid(Scenario.Grid);
+			const FOccupancyGrid Voxelized = MeasureVoxelize(Suite, Scenario.Name, Mesh, ThreadCounts, Report);
+			Report.Add(Suite, Scenario.Name, "cell_mismatches", CountDifferentCells(Scenario.Grid, Voxelized), "cells", false);
+			Report.Add(Suite, Scenario.Name, "grid_hash_mismatch", GetGridHash(Scenario.Grid) != GetGridHash(Voxelized) ? 1 : 0, "grids", false);
+		}
+
+		// Randomly rotated boxes of every size, a quarter of them open, against the exact sphere overlap per cell
+		const int LengthXY = Options.bQuick ? 64 : 128;
+		const int LengthZ = Options.bQuick ? 16 : 32;
+		const int NumBoxes = Options.bQuick ? 150 : 600;
+
+		FCollisionMesh Mesh;
+		Mesh.LengthX = LengthXY;
+		Mesh.LengthY = LengthXY;
+		Mesh.LengthZ = LengthZ;
+		Mesh.NodeDiameter = SyntheticNodeDiameter;
+
+		std::uniform_real_distribution<float> Position(-2 * SyntheticNodeDiameter, (LengthXY + 2) * SyntheticNodeDiameter);
+		std::uniform_real_distribution<float> Height(-2 * SyntheticNodeDiameter, (LengthZ + 2) * SyntheticNodeDiameter);
+		std::uniform_real_distribution<float> Extent(0.2f * SyntheticNodeDiameter, 6 * SyntheticNodeDiameter);
+		std::vector<FOrientedBox> Boxes(static_cast<size_t>(NumBoxes));
+		for(int i = 0; i < NumBoxes; i++)
+		{
+			FOrientedBox& Box = Boxes[i];
+			Box.Center = FVec3(Position(Random), Position(Random), Height(Random));
+			RandomAxes(Random, Box.Axes);
+			for(float& HalfExtent : Box.HalfExtents)
+				HalfExtent = Extent(Random);
+			Box.bClosed = i % 4 != 0;
+
+			Mesh.Bodies.push_back(MakeBoxBody(Box.Center, Box.Axes[0] * Box.HalfExtents[0], Box.Axes[1] * Box.HalfExtents[1], Box.Axes[2] * Box.HalfExtents[2]));
+			Mesh.Bodies.back().bClosed = Box.bClosed;
+		}
+
+		const FOccupancyGrid Voxelized = MeasureVoxelize(Suite, "rotated_boxes", Mesh, ThreadCounts, Report);
+
+		// One sphere test per cell against every box, the way the bake tests every node
+		FOccupancyGrid Reference;
+		Reference.Init(Mesh.LengthX, Mesh.LengthY, Mesh.LengthZ, Mesh.NodeDiameter, Mesh.BottomLeft);
+		const FStopwatch Stopwatch;
+		for(int Index = 0; Index < Reference.Num(); Index++)
+		{
+			const FVec3 Center = Reference.IndexToWorld(Index);
+			const bool bBlocked = std::any_of(Boxes.begin(), Boxes.end(), [&](const FOrientedBox& Box) { return SphereOverlapsBox(Box, Center, Reference.GetNodeRadius()); });
+			Reference.SetWalkable(Index, !bBlocked);
+		}
+
+		Report.Add(Suite, "rotated_boxes", "per_cell_overlap_ms", Stopwatch.GetElapsedSeconds() * 1e3, "ms", false);
+		Report.Add(Suite, "rotated_boxes", "cell_mismatches", CountDifferentCells(Reference, Voxelized), "cells", false);
+
+		int NumBlocked = 0;
+		for(int Index = 0; Index < Voxelized.Num(); Index++)
+			NumBlocked += Voxelized.IsWalkable(Index) ? 0 : 1;
+		Report.Add(Suite, "rotated_boxes", "blocked_ratio", static_cast<double>(NumBlocked) / Voxelized.Num(), "x", false);
+	}
+}
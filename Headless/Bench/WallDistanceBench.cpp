@@ -0,0 +1,147 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BenchSuites.h"
+#include "SyntheticGrids.h"
+#include "Core/GridRaycast.h"
+#include "Core/GridWallDistance.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+
+using namespace AudioCore;
+
+namespace AudioBench
+{
+	namespace
+	{
+		// Squared distance in cells from the cell to the closest blocked cell, checking every blocked cell
+		int GetNearestBlockedSquared(const FOccupancyGrid& Grid, const std::vector<FGridCoord>& BlockedCoords, const int Index)
+		{
+			const FGridCoord Coord = Grid.GetCoord(Index);
+			int Nearest = INT_MAX;
+			for(const FGridCoord& Blocked : BlockedCoords)
+			{
+				const int DeltaX = Blocked.X - Coord.X, DeltaY = Blocked.Y - Coord.Y, DeltaZ = Blocked.Z - Coord.Z;
+				Nearest = std::min(Nearest, DeltaX * DeltaX + DeltaY * DeltaY + DeltaZ * DeltaZ);
+			}
+
+			return Nearest;
+		}
+	}
+
+	void RunWallDistanceBench(const FBenchOptions& Options, FBenchReport& Report)
+	{
+		const char* Suite = "wall_distance";
+		const int NumCheckedCells = Options.bQuick ? 200 : 1000;
+		const int NumQueries = Options.bQuick ? 2000 : 20000;
+
+		// 1 and 4 threads, and every core of the machine if it has more
+		std::vector<int> ThreadCounts = { 1, 4 };
+		const int NumCores = static_cast<int>(std::thread::hardware_concurrency());
+		if(NumCores > 4)
+			ThreadCounts.push_back(NumCores);
+
+		for(FGridScenario& Scenario : MakeStandardScenarios(Options.bQuick, Options.Seed))
+		{
+			const FOccupancyGrid& Grid = Scenario.Grid;
+			std::mt19937 Random(Options.Seed);
+
+			FGridWallDistance WallDistance;
+			double SingleThreadSeconds = 0;
+			for(const int NumThreads : ThreadCounts)
+			{
+				const FStopwatch Stopwatch;
+				WallDistance.Build(Grid, NumThreads);
+				const double Seconds = Stopwatch.GetElapsedSeconds();
+
+				const std::string Prefix = "threads" + std::to_string(NumThreads) + "_";
+				Report.Add(Suite, Scenario.Name, Prefix + "bake_ms", Seconds * 1e3, "ms", false);
+				if(NumThreads == 1)
+					SingleThreadSeconds = Seconds;
+				else
+					Report.Add(Suite, Scenario.Name, Prefix + "speedup", Seconds > 0 ? SingleThreadSeconds / Seconds : 0, "x", true);
+			}
+			Report.Add(Suite, Scenario.Name, "memory_kb", WallDistance.GetMemoryUsage() / 1024.0, "KB", false);
+
+			// The transform is exact, every checked cell has to match the closest blocked cell found by brute force rounded
+			// down to eighths of a cell
+			std::vector<FGridCoord> BlockedCoords;
+			for(int Index = 0; Index < Grid.Num(); Index++)
+			{
+				const FGridCoord Coord = Grid.GetCoord(Index);
+				if(!Grid.IsWalkable(Index) && !Grid.IsOutOfBounds(Coord.X, Coord.Y, Coord.Z))
+					BlockedCoords.push_back(Coord);
+			}
+
+			int NumDistanceMismatches = 0;
+			for(int i = 0; i < NumCheckedCells && !BlockedCoords.empty(); i++)
+			{
+				const int Index = GetRandomWalkableIndex(Grid, Random);
+				const float Nearest = std::min(std::sqrt(static_cast<float>(GetNearestBlockedSquared(Grid, BlockedCoords, Index))), FGridWallDistance::MaxDistance);
+				const float Expected = std::floor(Nearest * FGridWallDistance::StepsPerCell) / FGridWallDistance::StepsPerCell * Grid.GetNodeDiameter();
+				NumDistanceMismatches += std::abs(WallDistance.GetDistance(Index) - Expected) > 1e-3f * Grid.GetNodeDiameter() ? 1 : 0;
+			}
+
+			// Wall proximity of the listener, one lookup in place of a closest point query per occluded source
+			std::vector<FVec3> Listeners;
+			for(int Query = 0; Query < NumQueries; Query++)
+				Listeners.push_back(Grid.IndexToWorld(GetRandomWalkableIndex(Grid, Random)));
+
+			FStopwatch Stopwatch;
+			int NumNearWall = 0;
+			for(const FVec3& Listener : Listeners)
+				NumNearWall += WallDistance.GetDistanceToWall(Listener) < Grid.GetNodeDiameter() ? 1 : 0;
+			const double LookupSeconds = Stopwatch.GetElapsedSeconds();
+
+			/* Line of sight between random walkable cells, walking every cell against sphere tracing the empty space. The
+			 * ends are somewhere inside their cells, segments between cell centers often only touch the edge or corner of a
+			 * blocked cell and whether that blocks depends on where a walk starts */
+			std::uniform_real_distribution<float> Offset(-0.4f * Grid.GetNodeDiameter(), 0.4f * Grid.GetNodeDiameter());
+			const auto GetRandomLocation = [&]()
+			{
+				return Grid.IndexToWorld(GetRandomWalkableIndex(Grid, Random)) + FVec3(Offset(Random), Offset(Random), Offset(Random));
+			};
+
+			std::vector<std::pair<FVec3, FVec3>> Segments;
+			for(int Query = 0; Query < NumQueries; Query++)
+			{
+				const FVec3 From = GetRandomLocation();
+				Segments.emplace_back(From, GetRandomLocation());
+			}
+
+			std::vector<char> CellVisible(Segments.size());
+			Stopwatch.Restart();
+			for(size_t Query = 0; Query < Segments.size(); Query++)
+				CellVisible[Query] = HasLineOfSight(Grid, Segments[Query].first, Segments[Query].second) ? 1 : 0;
+			const double CellSeconds = Stopwatch.GetElapsedSeconds();
+
+			std::vector<char> TracedVisible(Segments.size());
+			Stopwatch.Restart();
+			for(size_t Query = 0; Query < Segments.size(); Query++)
+				TracedVisible[Query] = WallDistance.HasLineOfSight(Segments[Query].first, Segments[Query].second) ? 1 : 0;
+			const double TracedSeconds = Stopwatch.GetElapsedSeconds();
+
+			int NumVisible = 0;
+			int NumSightMismatches = 0;
+			for(size_t Query = 0; Query < Segments.size(); Query++)
+			{
+				NumVisible += CellVisible[Query];
+				NumSightMismatches += CellVisible[Query] != TracedVisible[Query] ? 1 : 0;
+			}
+
+			Report.Add(Suite, Scenario.Name, "distance_mismatches", NumDistanceMismatches, "cells", false);
+			Report.Add(Suite, Scenario.Name, "wall_lookup_ns", LookupSeconds * 1e9 / NumQueries, "ns", false);
+			Report.Add(Suite, Scenario.Name, "near_wall_ratio", static_cast<double>(NumNearWall) / NumQueries, "ratio", false);
+			Report.Add(Suite, Scenario.Name, "visible_ratio", static_cast<double>(NumVisible) / NumQueries, "ratio", false);
+			Report.Add(Suite, Scenario.Name, "cell_walk_us", CellSeconds * 1e6 / NumQueries, "us", false);
+			Report.Add(Suite, Scenario.Name, "sphere_traced_us", TracedSeconds * 1e6 / NumQueries, "us", false);
+			Report.Add(Suite, Scenario.Name, "sphere_trace_speedup", TracedSeconds > 0 ? CellSeconds / TracedSeconds : 0, "x", true);
+			Report.Add(Suite, Scenario.Name, "sight_mismatches", NumSightMismatches, "queries", false);
+		}
+	}
+}
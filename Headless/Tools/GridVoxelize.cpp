@@ -0,0 +1,110 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+/*
+ * Bakes a grid offline from the collision exported with AMapGrid::ExportCollisionMesh and saves it as an .agrid file the
+ * game loads instead of baking (AMapGrid's Voxelized Grid File). Pass the grid the game baked itself (AMapGrid::ExportGrid)
+ * with --compare to check that both agree
+ */
+
+#include "ToolUtils.h"
+#include "Core/GridSerialization.h"
+#include "Core/GridVoxelizer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+using namespace AudioCore;
+
+namespace
+{
+	void PrintUsage()
+	{
+		std::printf("Usage: GridVoxelize <level.acol> <out.agrid> [--threads N] [--compare PATH]\n");
+	}
+}
+
+int main(int Argc, char** Argv)
+{
+	if(Argc < 3)
+	{
+		PrintUsage();
+		return 2;
+	}
+
+	int NumThreads = static_cast<int>(std::max(std::thread::hardware_concurrency(), 1u));
+	std::string ComparePath;
+	for(int i = 3; i < Argc; i++)
+	{
+		const bool bHasValue = i + 1 < Argc;
+		if(std::strcmp(Argv[i], "--threads") == 0 && bHasValue)
+			NumThreads = std::max(std::atoi(Argv[++i]), 1);
+		else if(std::strcmp(Argv[i], "--compare") == 0 && bHasValue)
+			ComparePath = Argv[++i];
+		else
+		{
+			PrintUsage();
+			return 2;
+		}
+	}
+
+	std::vector<uint8_t> MeshData;
+	FCollisionMesh Mesh;
+	if(!AudioTools::ReadFile(Argv[1], MeshData) || !LoadCollisionMesh(MeshData.data(), MeshData.size(), Mesh))
+	{
+		std::printf("Could not load collision mesh %s\n", Argv[1]);
+		return 1;
+	}
+
+	std::printf("%zu bodies, %d triangles, grid %d x %d x %d with %.1f unit nodes\n", Mesh.Bodies.size(), Mesh.NumTriangles(),
+		Mesh.LengthX, Mesh.LengthY, Mesh.LengthZ, Mesh.NodeDiameter);
+
+	FOccupancyGrid Grid;
+	const auto StartTime = std::chrono::steady_clock::now();
+	const FVoxelizerStats Stats = VoxelizeGrid(Mesh, Grid, NumThreads);
+	const double Milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - StartTime).count();
+
+	std::printf("Voxelized %d nodes in %.2f ms on %d threads, %d blocked, %lld box tests, %lld sphere tests\n", Grid.Num(), Milliseconds,
+		NumThreads, Stats.NumBlockedCells, Stats.NumBoxTests, Stats.NumSphereTests);
+
+	if(!AudioTools::WriteFile(Argv[2], SaveGrid(Grid)))
+	{
+		std::printf("Could not write %s\n", Argv[2]);
+		return 1;
+	}
+
+	std::printf("Saved grid %016" PRIx64 " to %s\n", GetGridHash(Grid), Argv[2]);
+
+	if(ComparePath.empty())
+		return 0;
+
+	std::vector<uint8_t> CompareData;
+	FOccupancyGrid CompareGrid;
+	if(!AudioTools::ReadFile(ComparePath, CompareData) || !LoadGrid(CompareData.data(), CompareData.size(), CompareGrid))
+	{
+		std::printf("Could not load grid %s\n", ComparePath.c_str());
+		return 1;
+	}
+
+	if(CompareGrid.GetLengthX() != Grid.GetLengthX() || CompareGrid.GetLengthY() != Grid.GetLengthY() || CompareGrid.GetLengthZ() != Grid.GetLengthZ())
+	{
+		std::printf("%s is a %d x %d x %d grid\n", ComparePath.c_str(), CompareGrid.GetLengthX(), CompareGrid.GetLengthY(), CompareGrid.GetLengthZ());
+		return 1;
+	}
+
+	int NumOnlyBlockedHere = 0;
+	int NumOnlyBlockedThere = 0;
+	for(int Index = 0; Index < Grid.Num(); Index++)
+	{
+		NumOnlyBlockedHere += !Grid.IsWalkable(Index) && CompareGrid.IsWalkable(Index) ? 1 : 0;
+		NumOnlyBlockedThere += Grid.IsWalkable(Index) && !CompareGrid.IsWalkable(Index) ? 1 : 0;
+	}
+
+	std::printf("%d nodes only blocked in the voxelized grid, %d only in %s\n", NumOnlyBlockedHere, NumOnlyBlockedThere, ComparePath.c_str());
+	return NumOnlyBlockedHere + NumOnlyBlockedThere == 0 ? 0 : 3;
+}
@@ -0,0 +1,33 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace AudioTools
+{
+	// Reads a whole file, returns false if it could not be opened
+	inline bool ReadFile(const std::string& Path, std::vector<uint8_t>& OutData)
+	{
+		std::ifstream File(Path, std::ios::binary);
+		if(!File)
+			return false;
+
+		OutData.assign(std::istreambuf_iterator<char>(File), std::istreambuf_iterator<char>());
+		return true;
+	}
+
+	inline bool WriteFile(const std::string& Path, const std::vector<uint8_t>& Data)
+	{
+		std::ofstream File(Path, std::ios::binary);
+		if(!File)
+			return false;
+
+		File.write(reinterpret_cast<const char*>(Data.data()), static_cast<std::streamsize>(Data.size()));
+		return static_cast<bool>(File);
+	}
+}
@@ -0,0 +1,341 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+/*
+ * Replays a trajectory recorded by UAudioTrajectoryRecorder against the grid it was recorded on and runs the
+ * propagation and occlusion pipeline headless, with grid ray marches in place of physics traces. Prints per frame
+ * timing and how the found paths differ from the recorded ones or from an earlier replay (--dump-paths on build A,
+ * --diff-paths on build B)
+ */
+
+#include "ToolUtils.h"
+#include "Core/GridNearestWalkable.h"
+#include "Core/GridPathfinder.h"
+#include "Core/GridRegions.h"
+#include "Core/GridRaycast.h"
+#include "Core/GridSerialization.h"
+#include "Core/OcclusionMath.h"
+#include "Core/TrajectoryLog.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <unordered_map>
+#include <utility>
+
+using namespace AudioCore;
+
+namespace
+{
+	// Default value of UAudioOcclusionComponent
+	constexpr float MaxMeshDistanceToBlockAllAudio = 900.f;
+
+	// What the pipeline computed for one source in one frame
+	struct FSourceResult
+	{
+		int PathLength = -1;
+
+		// With the Linear layout, so replays with different layouts can be compared
+		int PropagatedIndex = InvalidIndex;
+	};
+
+	// Path cached per source, only searched again when the listener changes cell
+	struct FCachedPath
+	{
+		int EndIndex = InvalidIndex;
+		bool bFound = false;
+		std::vector<int> Path;
+	};
+
+	struct FFrameStats
+	{
+		double Milliseconds = 0;
+		int NumSources = 0;
+		int NumSearches = 0;
+		int NodesExpanded = 0;
+		int NumDiffs = 0;
+	};
+
+	class FReplayPipeline
+	{
+	public:
+		explicit FReplayPipeline(const FOccupancyGrid& InGrid) : Grid(InGrid), Pathfinder(InGrid)
+		{
+			Regions.Build(InGrid);
+			NearestWalkable.Build(InGrid);
+		}
+
+		FSourceResult UpdateSource(const FTrajectoryFrame& Frame, const FTrajectorySource& Source, FFrameStats& Stats)
+		{
+			FSourceResult Result;
+
+			// Occlusion, the grid's blocked distance stands in for the mesh thickness
+			const FGridTraceResult Trace = TraceGrid(Grid, Frame.CameraLocation, Source.Position);
+			const float Occlusion = GetOcclusionValue(GetThicknessValue(Trace.BlockedDistance, MaxMeshDistanceToBlockAllAudio), 1.f);
+			OcclusionVolumeSum += GetOccludedVolume(Occlusion);
+
+			// Direct line of sight, nothing to propagate
+			if(!Trace.bBlocked)
+				return Result;
+
+			const int StartIndex = Grid.WorldToIndex(Source.Position);
+			const int EndIndex = GetTargetIndex(Frame.ListenerLocation);
+
+			FCachedPath& Cached = CachedPaths[Source.Id];
+			if(Cached.EndIndex != EndIndex)
+			{
+				Cached.EndIndex = EndIndex;
+				Cached.Path.clear();
+
+				// Same as FPathfinder::FindPath, sources in another region are rejected without a search
+				Cached.bFound = false;
+				if(Regions.CanReach(StartIndex, EndIndex))
+				{
+					Cached.bFound = Pathfinder.FindPath(StartIndex, EndIndex, Cached.Path);
+					Stats.NumSearches++;
+					Stats.NodesExpanded += Pathfinder.GetLastStats().NodesExpanded;
+				}
+			}
+
+			if(!Cached.bFound)
+				return Result;
+
+			// Last node (seen from the listener) with line of sight to the camera
+			const std::vector<int>& Path = Cached.Path;
+			for(size_t i = 1; i < Path.size(); i++)
+			{
+				if(HasLineOfSight(Grid, Grid.IndexToWorld(Path[i]), Frame.CameraLocation))
+					continue;
+
+				Result.PathLength = static_cast<int>(Path.size());
+				Result.PropagatedIndex = Grid.GetLinearIndex(Path[i - 1]);
+				break;
+			}
+
+			return Result;
+		}
+
+	private:
+		const FOccupancyGrid& Grid;
+		FGridPathfinder Pathfinder;
+		FGridRegions Regions;
+		FGridNearestWalkable NearestWalkable;
+		std::unordered_map<uint32_t, FCachedPath> CachedPaths;
+
+		// Keeps the occlusion math from being optimized away
+		float OcclusionVolumeSum = 0;
+
+		// Same as FPathfinder::GetTargetNode but with grid line of sight
+		int GetTargetIndex(const FVec3& ListenerLocation) const
+		{
+			const int Index = Grid.WorldToIndex(ListenerLocation);
+			if(Grid.IsWalkable(Index))
+				return Index;
+
+			const int Nearest = NearestWalkable.GetNearestWalkable(Index);
+			if(Nearest != InvalidIndex && HasLineOfSight(Grid, Grid.IndexToWorld(Nearest), ListenerLocation))
+				return Nearest;
+
+			return Index;
+		}
+	};
+
+	using FPathDump = std::map<std::pair<int, uint32_t>, FSourceResult>;
+
+	bool LoadPathDump(const std::string& Path, FPathDump& OutDump)
+	{
+		FILE* File = std::fopen(Path.c_str(), "r");
+		if(!File)
+			return false;
+
+		int FrameIndex;
+		uint32_t SourceId;
+		FSourceResult Result;
+		while(std::fscanf(File, "%d,%" SCNu32 ",%d,%d", &FrameIndex, &SourceId, &Result.PathLength, &Result.PropagatedIndex) == 4)
+			OutDump[{ FrameIndex, SourceId }] = Result;
+
+		std::fclose(File);
+		return true;
+	}
+
+	bool IsSameResult(const FSourceResult& A, const FSourceResult& B)
+	{
+		return A.PathLength == B.PathLength && A.PropagatedIndex == B.PropagatedIndex;
+	}
+
+	void PrintUsage()
+	{
+		std::printf("Usage: TrajectoryReplay <grid.agrid> <trajectory.atrj> [--quiet] [--bricks] [--frames-csv PATH] [--dump-paths PATH] [--diff-paths PATH]\n");
+	}
+}
+
+int main(int Argc, char** Argv)
+{
+	if(Argc < 3)
+	{
+		PrintUsage();
+		return 2;
+	}
+
+	bool bQuiet = false;
+	ECellLayout Layout = ECellLayout::Linear;
+	std::string FramesCsvPath;
+	std::string DumpPath;
+	std::string DiffPath;
+	for(int i = 3; i < Argc; i++)
+	{
+		const bool bHasValue = i + 1 < Argc;
+		if(std::strcmp(Argv[i], "--quiet") == 0)
+			bQuiet = true;
+		else if(std::strcmp(Argv[i], "--bricks") == 0)
+			Layout = ECellLayout::Bricks;
+		else if(std::strcmp(Argv[i], "--frames-csv") == 0 && bHasValue)
+			FramesCsvPath = Argv[++i];
+		else if(std::strcmp(Argv[i], "--dump-paths") == 0 && bHasValue)
+			DumpPath = Argv[++i];
+		else if(std::strcmp(Argv[i], "--diff-paths") == 0 && bHasValue)
+			DiffPath = Argv[++i];
+		else
+		{
+			PrintUsage();
+			return 2;
+		}
+	}
+
+	std::vector<uint8_t> GridData;
+	FOccupancyGrid Grid;
+	if(!AudioTools::ReadFile(Argv[1], GridData) || !LoadGrid(GridData.data(), GridData.size(), Grid, Layout))
+	{
+		std::printf("Could not load grid %s\n", Argv[1]);
+		return 1;
+	}
+
+	std::vector<uint8_t> LogData;
+	if(!AudioTools::ReadFile(Argv[2], LogData))
+	{
+		std::printf("Could not open %s\n", Argv[2]);
+		return 1;
+	}
+
+	FTrajectoryReader Reader(LogData.data(), LogData.size());
+	if(!Reader.ReadHeader())
+	{
+		std::printf("%s is not a trajectory log\n", Argv[2]);
+		return 1;
+	}
+
+	if(Reader.GetGridHash() != GetGridHash(Grid))
+		std::printf("WARNING: the trajectory was recorded on grid %016" PRIx64 " but the loaded grid is %016" PRIx64 "\n", Reader.GetGridHash(), GetGridHash(Grid));
+
+	// Compare against the recorded paths unless an earlier replay was passed
+	FPathDump Baseline;
+	const bool bDiffAgainstDump = !DiffPath.empty();
+	if(bDiffAgainstDump && !LoadPathDump(DiffPath, Baseline))
+	{
+		std::printf("Could not open %s\n", DiffPath.c_str());
+		return 1;
+	}
+
+	FILE* DumpFile = DumpPath.empty() ? nullptr : std::fopen(DumpPath.c_str(), "w");
+	FILE* FramesCsv = FramesCsvPath.empty() ? nullptr : std::fopen(FramesCsvPath.c_str(), "w");
+	if(FramesCsv)
+		std::fprintf(FramesCsv, "frame,ms,sources,searches,nodes_expanded,path_diffs\n");
+
+	FReplayPipeline Pipeline(Grid);
+	FTrajectoryFrame Frame;
+	std::vector<double> FrameTimes;
+	long long TotalDiffs = 0;
+	long long TotalCompared = 0;
+
+	for(int FrameIndex = 0; Reader.ReadFrame(Frame); FrameIndex++)
+	{
+		FFrameStats Stats;
+		std::vector<std::pair<uint32_t, FSourceResult>> Results;
+
+		const auto StartTime = std::chrono::steady_clock::now();
+		for(const FTrajectorySource& Source : Frame.Sources)
+		{
+			// Only sources within fall off distance are updated, same as the components
+			if(Source.FalloffDistance <= FVec3::Dist(Frame.ListenerLocation, Source.Position))
+				continue;
+
+			Stats.NumSources++;
+			Results.push_back({ Source.Id, Pipeline.UpdateSource(Frame, Source, Stats) });
+		}
+		Stats.Milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - StartTime).count();
+		FrameTimes.push_back(Stats.Milliseconds);
+
+		for(size_t i = 0; i < Results.size(); i++)
+		{
+			const auto& [SourceId, Result] = Results[i];
+			if(DumpFile)
+				std::fprintf(DumpFile, "%d,%" PRIu32 ",%d,%d\n", FrameIndex, SourceId, Result.PathLength, Result.PropagatedIndex);
+
+			FSourceResult Expected;
+			if(bDiffAgainstDump)
+			{
+				const auto Found = Baseline.find({ FrameIndex, SourceId });
+				if(Found == Baseline.end())
+					continue;
+				Expected = Found->second;
+			}
+			else
+			{
+				// Recorded results only exist for sources the game propagated
+				const auto Recorded = std::find_if(Frame.Sources.begin(), Frame.Sources.end(), [Id = SourceId](const FTrajectorySource& Source) { return Source.Id == Id; });
+				Expected.PathLength = Recorded->RecordedPathLength;
+				Expected.PropagatedIndex = Recorded->RecordedPropagatedIndex;
+			}
+
+			TotalCompared++;
+			if(!IsSameResult(Result, Expected))
+			{
+				Stats.NumDiffs++;
+				if(!bQuiet)
+				{
+					std::printf("  frame %d source %" PRIu32 ": path length %d -> %d, propagated node %d -> %d\n", FrameIndex, SourceId,
+						Expected.PathLength, Result.PathLength, Expected.PropagatedIndex, Result.PropagatedIndex);
+				}
+			}
+		}
+		TotalDiffs += Stats.NumDiffs;
+
+		if(!bQuiet)
+		{
+			std::printf("frame %d: %.3f ms, %d sources, %d searches, %d nodes expanded, %d path diffs\n", FrameIndex, Stats.Milliseconds,
+				Stats.NumSources, Stats.NumSearches, Stats.NodesExpanded, Stats.NumDiffs);
+		}
+
+		if(FramesCsv)
+		{
+			std::fprintf(FramesCsv, "%d,%.4f,%d,%d,%d,%d\n", FrameIndex, Stats.Milliseconds, Stats.NumSources, Stats.NumSearches,
+				Stats.NodesExpanded, Stats.NumDiffs);
+		}
+	}
+
+	if(DumpFile)
+		std::fclose(DumpFile);
+	if(FramesCsv)
+		std::fclose(FramesCsv);
+
+	if(FrameTimes.empty())
+	{
+		std::printf("No frames in %s\n", Argv[2]);
+		return 1;
+	}
+
+	double TotalMilliseconds = 0;
+	for(const double Time : FrameTimes)
+		TotalMilliseconds += Time;
+
+	std::sort(FrameTimes.begin(), FrameTimes.end());
+	const auto Percentile = [&FrameTimes](const double Percent) { return FrameTimes[static_cast<size_t>(Percent / 100 * (FrameTimes.size() - 1) + 0.5)]; };
+
+	std::printf("\n%zu frames, mean %.3f ms, p50 %.3f ms, p99 %.3f ms, max %.3f ms\n", FrameTimes.size(), TotalMilliseconds / FrameTimes.size(),
+		Percentile(50), Percentile(99), FrameTimes.back());
+	std::printf("%lld of %lld source results differ from the %s\n", TotalDiffs, TotalCompared, bDiffAgainstDump ? "earlier replay" : "recording");
+
+	return 0;
+}